@@ -1272,6 +1272,14 @@ void ChCollisionSystemBullet::Run() {
     }
 }
 
+// Model that reports the contacts of a collision object: if the contact is on a sub shape
+// added with ChModelBullet::AddSubModel(), this is the model owning the sub shape.
+static ChCollisionModel* GetContactModel(ChModelBullet* model, int index) {
+    if (index >= 0 && index < model->GetNumSubModels())
+        return model->GetSubModel(index);
+    return model;
+}
+
 void ChCollisionSystemBullet::ReportContacts(ChContactContainerBase* mcontactcontainer) {
     // This should remove all old contacts (or at least rewind the index)
     mcontactcontainer->BeginAddContact();
@@ -1285,19 +1293,13 @@ void ChCollisionSystemBullet::ReportContacts(ChContactContainerBase* mcontactcon
         btCollisionObject* obB = static_cast<btCollisionObject*>(contactManifold->getBody1());
         contactManifold->refreshContactPoints(obA->getWorldTransform(), obB->getWorldTransform());
 
-        icontact.modelA = (ChCollisionModel*)obA->getUserPointer();
-        icontact.modelB = (ChCollisionModel*)obB->getUserPointer();
-
-        double envelopeA = icontact.modelA->GetEnvelope();
-        double envelopeB = icontact.modelB->GetEnvelope();
-
-        double marginA = icontact.modelA->GetSafeMargin();
-        double marginB = icontact.modelB->GetSafeMargin();
+        ChModelBullet* objmodelA = (ChModelBullet*)obA->getUserPointer();
+        ChModelBullet* objmodelB = (ChModelBullet*)obB->getUserPointer();
 
         // Execute custom broadphase callback, if any
         bool do_narrow_contactgeneration = true;
         if (this->broad_callback)
-            do_narrow_contactgeneration = this->broad_callback->BroadCallback(icontact.modelA, icontact.modelB);
+            do_narrow_contactgeneration = this->broad_callback->BroadCallback(objmodelA, objmodelB);
 
         if (do_narrow_contactgeneration) {
             int numContacts = contactManifold->getNumContacts();
@@ -1305,6 +1307,15 @@ void ChCollisionSystemBullet::ReportContacts(ChContactContainerBase* mcontactcon
             for (int j = 0; j < numContacts; j++) {
                 btManifoldPoint& pt = contactManifold->getContactPoint(j);
 
+                icontact.modelA = GetContactModel(objmodelA, pt.m_index0);
+                icontact.modelB = GetContactModel(objmodelB, pt.m_index1);
+
+                double envelopeA = icontact.modelA->GetEnvelope();
+                double envelopeB = icontact.modelB->GetEnvelope();
+
+                double marginA = icontact.modelA->GetSafeMargin();
+                double marginB = icontact.modelB->GetSafeMargin();
+
                 if (pt.getDistance() <
                     marginA + marginB)  // to discard "too far" constraints (the Bullet engine also has its threshold)
                 {
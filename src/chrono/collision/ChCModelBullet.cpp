@@ -62,6 +62,7 @@ int ChModelBullet::ClearModel() {
     if (shapes.size() > 0) {
         // deletes shared pointers, so also deletes shapes if uniquely referenced
         shapes.clear();
+        submodels.clear();
 
         // tell to the parent collision system to remove this from collision system,
         // if still connected to a physical system
@@ -699,10 +700,40 @@ bool ChModelBullet::AddCopyOfAnotherModel(ChCollisionModel* another) {
 
     this->bt_collision_object->setCollisionShape(((ChModelBullet*)another)->GetBulletModel()->getCollisionShape());
     this->shapes = ((ChModelBullet*)another)->shapes;
+    this->submodels = ((ChModelBullet*)another)->submodels;
 
     return true;
 }
 
+bool ChModelBullet::AddSubModel(ChModelBullet* submodel) {
+    if (submodel->shapes.size() != 1 || submodel->shapes[0]->isCompound())
+        return false;
+    if (shapes.size() > 0 && submodels.size() == 0)
+        return false;
+
+    // always use a compound, even with a single sub model, so that the index of the
+    // child shape tells which sub model must report the contact
+    if (shapes.size() == 0) {
+        btCompoundShape* mcompound = new btCompoundShape(true);
+        shapes.push_back(std::shared_ptr<btCollisionShape>(mcompound));
+        bt_collision_object->setCollisionShape(mcompound);
+    }
+    // vector=  | compound | shape of submodel 0 | shape of submodel 1 | ...
+    shapes.push_back(submodel->shapes[0]);
+    submodels.push_back(submodel);
+
+    btTransform mtransform;
+    mtransform.setIdentity();
+    ((btCompoundShape*)shapes[0].get())->addChildShape(mtransform, submodel->shapes[0].get());
+
+    return true;
+}
+
+void ChModelBullet::RefitSubModels() {
+    if (submodels.size() > 0)
+        ((btCompoundShape*)shapes[0].get())->refitAabbTreeFromChildren();
+}
+
 void ChModelBullet::SetFamily(int mfamily) {
     ChCollisionModel::SetFamily(mfamily);
     onFamilyChange();
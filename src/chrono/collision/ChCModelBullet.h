@@ -48,6 +48,9 @@ class ChApi ChModelBullet : public ChCollisionModel {
     // Vector of shared pointers to geometric objects.
     std::vector<std::shared_ptr<btCollisionShape>> shapes;
 
+    // Models that own the sub shapes of the compound, if added with AddSubModel().
+    std::vector<ChModelBullet*> submodels;
+
   public:
     ChModelBullet();
     virtual ~ChModelBullet();
@@ -239,6 +242,26 @@ class ChApi ChModelBullet : public ChCollisionModel {
     /// The 'another' model must be of ChModelBullet subclass.
     virtual bool AddCopyOfAnotherModel(ChCollisionModel* another);
 
+    /// CUSTOM for this class only: add the collision shape of another model (that must
+    /// contain a single, centered shape, ex. a triangle proxy) as a sub shape of this model.
+    /// The shape is shared, not copied, and the contacts on it are reported as contacts of
+    /// the other model, i.e. of its contactable. This allows to collect the shapes of many
+    /// contactables (ex. the triangles of a FEA contact surface) in a single collision object,
+    /// with a single broadphase proxy. The other model must not be added to the collision system.
+    /// A model cannot mix sub models and its own shapes: returns false in such a case.
+    bool AddSubModel(ChModelBullet* submodel);
+
+    /// Get the number of sub models added with AddSubModel().
+    int GetNumSubModels() const { return (int)submodels.size(); }
+
+    /// Get the model that owns the i-th sub shape, as added with AddSubModel().
+    ChModelBullet* GetSubModel(int i) const { return submodels[i]; }
+
+    /// If the sub shapes move respect to each other (ex. triangle proxies pointing to the
+    /// vertexes of a deforming mesh), call this after SyncPosition() to update the bounding
+    /// boxes of the sub shapes. The AABB tree of the compound is refitted, not rebuilt.
+    void RefitSubModels();
+
     virtual void SetFamily(int mfamily);
     virtual int GetFamily();
     virtual void SetFamilyMaskNoCollisionWithFamily(int mfamily);
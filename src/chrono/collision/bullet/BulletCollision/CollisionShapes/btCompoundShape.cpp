@@ -160,6 +160,37 @@ void btCompoundShape::recalculateLocalAabb()
 	}
 }
 
+static void	btRefitInternalNodes(btDbvtNode* node)
+{
+	if (node->isinternal())
+	{
+		btRefitInternalNodes(node->childs[0]);
+		btRefitInternalNodes(node->childs[1]);
+		Merge(node->childs[0]->volume,node->childs[1]->volume,node->volume);
+	}
+}
+
+void btCompoundShape::refitAabbTreeFromChildren()
+{
+	m_localAabbMin = btVector3(btScalar(BT_LARGE_FLOAT),btScalar(BT_LARGE_FLOAT),btScalar(BT_LARGE_FLOAT));
+	m_localAabbMax = btVector3(btScalar(-BT_LARGE_FLOAT),btScalar(-BT_LARGE_FLOAT),btScalar(-BT_LARGE_FLOAT));
+
+	//update the leaves and the local aabb in a single pass over the children
+	for (int j = 0; j < m_children.size(); j++)
+	{
+		btVector3 localAabbMin,localAabbMax;
+		m_children[j].m_childShape->getAabb(m_children[j].m_transform, localAabbMin, localAabbMax);
+		m_localAabbMin.setMin(localAabbMin);
+		m_localAabbMax.setMax(localAabbMax);
+		if (m_dynamicAabbTree)
+			m_children[j].m_node->volume = btDbvtVolume::FromMM(localAabbMin,localAabbMax);
+	}
+
+	//then the internal nodes, bottom-up
+	if (m_dynamicAabbTree && m_dynamicAabbTree->m_root)
+		btRefitInternalNodes(m_dynamicAabbTree->m_root);
+}
+
 ///getAabb's default implementation is brute force, expected derived classes to implement a fast dedicated version
 void btCompoundShape::getAabb(const btTransform& trans,btVector3& aabbMin,btVector3& aabbMax) const
 {
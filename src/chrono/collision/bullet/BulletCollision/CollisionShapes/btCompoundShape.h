@@ -121,6 +121,11 @@ public:
 	Use this yourself if you modify the children or their transforms. */
 	virtual void recalculateLocalAabb(); 
 
+	/** Re-calculate the local Aabb and refit the dynamic aabb tree to the current aabbs of the children,
+	without rebuilding it (the tree topology is kept). Use this if the children deform, for example
+	triangles whose vertices are moved by the user, while their number and order stay the same. */
+	void	refitAabbTreeFromChildren();
+
 	virtual void	setLocalScaling(const btVector3& scaling);
 
 	virtual const btVector3& getLocalScaling() const 
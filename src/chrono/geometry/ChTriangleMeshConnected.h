@@ -61,6 +61,9 @@ class ChApi ChTriangleMeshConnected : public ChTriangleMesh {
     std::vector<ChVector<int>>& getIndicesUV() { return m_face_uv_indices; }
     std::vector<ChVector<int>>& getIndicesColors() { return m_face_col_indices; }
 
+    const std::vector<ChVector<double>>& getCoordsVertices() const { return m_vertices; }
+    const std::vector<ChVector<int>>& getIndicesVertexes() const { return m_face_v_indices; }
+
     // Load a triangle mesh saved as a Wavefront .obj file
     void LoadWavefrontMesh(std::string filename, bool load_normals = true, bool load_uv = false);
 
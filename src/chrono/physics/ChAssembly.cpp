@@ -862,6 +862,94 @@ void ChAssembly::IntLoadResidual_Mv(const unsigned int off,      ///< offset in
     }
 }
 
+void ChAssembly::IntLoadLumpedMass_Md(const unsigned int off,  ///< offset in Md vector
+                                      ChVectorDynamic<>& Md,   ///< result: Md vector, diagonal of the lumped mass
+                                      double& err,             ///< result: not touched if lumping does not introduce errors
+                                      const double c           ///< a scaling factor
+                                      ) {
+    unsigned int displ_v = off - this->offset_w;
+
+    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
+        std::shared_ptr<ChBody> Bpointer = bodylist[ip];
+        if (Bpointer->IsActive())
+            Bpointer->IntLoadLumpedMass_Md(displ_v + Bpointer->GetOffset_w(), Md, err, c);
+    }
+    for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
+        std::shared_ptr<ChLink> Lpointer = linklist[ip];
+        if (Lpointer->IsActive())
+            Lpointer->IntLoadLumpedMass_Md(displ_v + Lpointer->GetOffset_w(), Md, err, c);
+    }
+    for (unsigned int ip = 0; ip < otherphysicslist.size(); ++ip) {
+        std::shared_ptr<ChPhysicsItem> Ppointer = otherphysicslist[ip];
+        Ppointer->IntLoadLumpedMass_Md(displ_v + Ppointer->GetOffset_w(), Md, err, c);
+    }
+}
+
+double ChAssembly::GetStableTimeStep() {
+    // smallest of the (non zero) limits of the sub objects
+    double step = 0;
+    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
+        double mstep = bodylist[ip]->GetStableTimeStep();
+        if (mstep > 0 && (step == 0 || mstep < step))
+            step = mstep;
+    }
+    for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
+        double mstep = linklist[ip]->GetStableTimeStep();
+        if (mstep > 0 && (step == 0 || mstep < step))
+            step = mstep;
+    }
+    for (unsigned int ip = 0; ip < otherphysicslist.size(); ++ip) {
+        double mstep = otherphysicslist[ip]->GetStableTimeStep();
+        if (mstep > 0 && (step == 0 || mstep < step))
+            step = mstep;
+    }
+    return step;
+}
+
+void ChAssembly::IntLoadStableTimeSteps(const unsigned int off,  ///< offset in steps vector
+                                        ChVectorDynamic<>& steps  ///< result: stable step of each speed coordinate
+                                        ) {
+    unsigned int displ_v = off - this->offset_w;
+
+    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
+        std::shared_ptr<ChBody> Bpointer = bodylist[ip];
+        if (Bpointer->IsActive())
+            Bpointer->IntLoadStableTimeSteps(displ_v + Bpointer->GetOffset_w(), steps);
+    }
+    for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
+        std::shared_ptr<ChLink> Lpointer = linklist[ip];
+        if (Lpointer->IsActive())
+            Lpointer->IntLoadStableTimeSteps(displ_v + Lpointer->GetOffset_w(), steps);
+    }
+    for (unsigned int ip = 0; ip < otherphysicslist.size(); ++ip) {
+        std::shared_ptr<ChPhysicsItem> Ppointer = otherphysicslist[ip];
+        Ppointer->IntLoadStableTimeSteps(displ_v + Ppointer->GetOffset_w(), steps);
+    }
+}
+
+void ChAssembly::IntLoadResidual_F_Masked(const unsigned int off,         ///< offset in R residual
+                                          ChVectorDynamic<>& R,           ///< result: the R residual, R += c*F
+                                          const ChVectorDynamic<>& mask,  ///< coordinates that need the forces
+                                          const double c                  ///< a scaling factor
+                                          ) {
+    unsigned int displ_v = off - this->offset_w;
+
+    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
+        std::shared_ptr<ChBody> Bpointer = bodylist[ip];
+        if (Bpointer->IsActive())
+            Bpointer->IntLoadResidual_F_Masked(displ_v + Bpointer->GetOffset_w(), R, mask, c);
+    }
+    for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
+        std::shared_ptr<ChLink> Lpointer = linklist[ip];
+        if (Lpointer->IsActive())
+            Lpointer->IntLoadResidual_F_Masked(displ_v + Lpointer->GetOffset_w(), R, mask, c);
+    }
+    for (unsigned int ip = 0; ip < otherphysicslist.size(); ++ip) {
+        std::shared_ptr<ChPhysicsItem> Ppointer = otherphysicslist[ip];
+        Ppointer->IntLoadResidual_F_Masked(displ_v + Ppointer->GetOffset_w(), R, mask, c);
+    }
+}
+
 void ChAssembly::IntLoadResidual_CqL(const unsigned int off_L,    ///< offset in L multipliers
                                      ChVectorDynamic<>& R,        ///< result: the R residual, R += c*Cq'*L
                                      const ChVectorDynamic<>& L,  ///< the L vector
@@ -314,6 +314,16 @@ class ChApi ChAssembly : public ChPhysicsItem {
                                     ChVectorDynamic<>& R,
                                     const ChVectorDynamic<>& w,
                                     const double c) override;
+    virtual void IntLoadLumpedMass_Md(const unsigned int off,
+                                      ChVectorDynamic<>& Md,
+                                      double& err,
+                                      const double c) override;
+    virtual double GetStableTimeStep() override;
+    virtual void IntLoadStableTimeSteps(const unsigned int off, ChVectorDynamic<>& steps) override;
+    virtual void IntLoadResidual_F_Masked(const unsigned int off,
+                                          ChVectorDynamic<>& R,
+                                          const ChVectorDynamic<>& mask,
+                                          const double c) override;
     virtual void IntLoadResidual_CqL(const unsigned int off_L,
                                      ChVectorDynamic<>& R,
                                      const ChVectorDynamic<>& L,
@@ -14,6 +14,7 @@
 
 #include <stdlib.h>
 #include <algorithm>
+#include <cmath>
 
 #include "chrono/core/ChTransform.h"
 #include "chrono/physics/ChBody.h"
@@ -255,6 +256,23 @@ void ChBody::IntLoadResidual_Mv(const unsigned int off,      // offset in R resi
     R.PasteSumVector(Iw, off + 3, 0);
 }
 
+void ChBody::IntLoadLumpedMass_Md(const unsigned int off,  // offset in Md vector
+                                  ChVectorDynamic<>& Md,   // result: Md vector, diagonal of the lumped mass matrix
+                                  double& err,             // result: not touched if lumping does not introduce errors
+                                  const double c           // a scaling factor
+                                  ) {
+    const ChMatrix33<>& J = GetInertia();
+    Md(off + 0) += c * GetMass();
+    Md(off + 1) += c * GetMass();
+    Md(off + 2) += c * GetMass();
+    Md(off + 3) += c * J(0, 0);
+    Md(off + 4) += c * J(1, 1);
+    Md(off + 5) += c * J(2, 2);
+    // products of inertia cannot be lumped
+    err += std::abs(J(0, 1)) + std::abs(J(0, 2)) + std::abs(J(1, 0)) + std::abs(J(1, 2)) + std::abs(J(2, 0)) +
+           std::abs(J(2, 1));
+}
+
 void ChBody::IntToDescriptor(const unsigned int off_v,  // offset in v, R
                              const ChStateDelta& v,
                              const ChVectorDynamic<>& R,
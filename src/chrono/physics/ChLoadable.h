@@ -85,6 +85,11 @@ public:
             /// otherwise use quadrature over u,v,w in [-1..+1] as box isoparametric coords.
         virtual bool IsTetrahedronIntegrationNeeded() {return false;}
 
+            /// If true, the generalized gravity load (integral of N'*density*g) does not depend on the
+            /// current state, but only on reference quantities, so it can be computed once and reused,
+            /// as done by the automatic gravity of ChMesh. Override and return false if not the case.
+        virtual bool IsGravityLoadConstant() {return true;}
+
 };
 
 
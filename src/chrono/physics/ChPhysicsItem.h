@@ -270,6 +270,48 @@ class ChApi ChPhysicsItem : public ChObj {
                                     const double c               ///< a scaling factor
                                     ) {}
 
+    /// Adds the diagonal of a lumped mass matrix, scaled by c, to Md at given offset:
+    ///    Md += c*diag(M)
+    /// Off-diagonal terms that could not be lumped are added, in absolute value, to err.
+    /// This default implementation takes the row sums of M, computed with IntLoadResidual_Mv;
+    /// children classes with non-diagonal masses should override it.
+    virtual void IntLoadLumpedMass_Md(const unsigned int off,  ///< offset in Md vector
+                                      ChVectorDynamic<>& Md,   ///< result: Md vector, diagonal of the lumped mass matrix
+                                      double& err,             ///< result: not touched if lumping does not introduce errors
+                                      const double c           ///< a scaling factor
+                                      ) {
+        if (!GetDOF_w())
+            return;
+        ChVectorDynamic<> ones(Md.GetRows());
+        ones.FillElem(1.0);
+        IntLoadResidual_Mv(off, Md, ones, c);
+    }
+
+    /// Return an estimate of the largest time step for which explicit integrators are stable
+    /// with this item (zero if this item does not limit the time step).
+    virtual double GetStableTimeStep() { return 0; }
+
+    /// Sets, at given offset, the stable time step of each speed coordinate of this item, for
+    /// explicit integrators with subcycling. This default implementation uses GetStableTimeStep().
+    virtual void IntLoadStableTimeSteps(const unsigned int off,  ///< offset in steps vector
+                                        ChVectorDynamic<>& steps  ///< result: stable step of each speed coordinate
+                                        ) {
+        double step = GetStableTimeStep();
+        for (int i = 0; i < GetDOF_w(); i++)
+            steps(off + i) = step;
+    }
+
+    /// Takes the F force term, scale and adds to R at given offset, as IntLoadResidual_F, but
+    /// only the forces of the coordinates with a non-zero entry in 'mask' are needed.
+    /// This default implementation loads all the forces.
+    virtual void IntLoadResidual_F_Masked(const unsigned int off,         ///< offset in R residual
+                                          ChVectorDynamic<>& R,           ///< result: the R residual, R += c*F
+                                          const ChVectorDynamic<>& mask,  ///< coordinates that need the forces
+                                          const double c                  ///< a scaling factor
+                                          ) {
+        IntLoadResidual_F(off, R, c);
+    }
+
     /// Takes the term Cq'*L, scale and adds to R at given offset:
     ///    R += c*Cq'*L
     virtual void IntLoadResidual_CqL(const unsigned int off_L,    ///< offset in L multipliers
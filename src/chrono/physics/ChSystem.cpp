@@ -755,6 +755,9 @@ void ChSystem::SetIntegrationType(eCh_integrationType m_integration) {
         case INT_NEWMARK:
             timestepper = std::make_shared<ChTimestepperNewmark>(this);
             break;
+        case INT_CENTRAL_DIFFERENCE:
+            timestepper = std::make_shared<ChTimestepperCentralDifference>(this);
+            break;
         default:
             throw ChException("SetIntegrationType: timestepper not supported");
     }
@@ -1108,6 +1111,19 @@ void ChSystem::IntLoadResidual_F(const unsigned int off,  // offset in R residua
     contact_container->IntLoadResidual_F(displ_v + contact_container->GetOffset_w(), R, c);
 }
 
+void ChSystem::IntLoadResidual_F_Masked(const unsigned int off,         // offset in R residual
+                                        ChVectorDynamic<>& R,           // result: the R residual, R += c*F
+                                        const ChVectorDynamic<>& mask,  // coordinates that need the forces
+                                        const double c                  // a scaling factor
+                                        ) {
+    unsigned int displ_v = off - offset_w;
+
+    // Inherit: operate parent method on sub objects (bodies, links, etc.)
+    ChAssembly::IntLoadResidual_F_Masked(off, R, mask, c);
+    // Use also on contact container:
+    contact_container->IntLoadResidual_F_Masked(displ_v + contact_container->GetOffset_w(), R, mask, c);
+}
+
 void ChSystem::IntLoadResidual_Mv(const unsigned int off,      // offset in R residual
                                   ChVectorDynamic<>& R,        // result: the R residual, R += c*M*v
                                   const ChVectorDynamic<>& w,  // the w vector
@@ -1491,6 +1507,15 @@ void ChSystem::LoadResidual_Mv(ChVectorDynamic<>& R,        ///< result: the R r
     IntLoadResidual_Mv(0, R, w, c);
 }
 
+// Increment a vector Md with the diagonal of the lumped mass matrix:
+//    Md += c*diag(M)
+void ChSystem::LoadLumpedMass_Md(ChVectorDynamic<>& Md,  ///< result: Md vector, diagonal of the lumped mass matrix
+                                 double& err,            ///< result: not touched if lumping does not introduce errors
+                                 const double c          ///< a scaling factor
+                                 ) {
+    IntLoadLumpedMass_Md(0, Md, err, c);
+}
+
 // Increment a vectorR with the term Cq'*L:
 //    R += c*Cq'*L
 void ChSystem::LoadResidual_CqL(ChVectorDynamic<>& R,        ///< result: the R residual, R += c*Cq'*L
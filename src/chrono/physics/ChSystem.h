@@ -147,6 +147,7 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorder {
         INT_LEAPFROG = 15,
         INT_NEWMARK = 16,
         INT_CUSTOM__ = 17,
+        INT_CENTRAL_DIFFERENCE = 18,
     };
     CH_ENUM_MAPPER_BEGIN(eCh_integrationType);
     CH_ENUM_VAL(INT_ANITESCU);
@@ -163,12 +164,14 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorder {
     CH_ENUM_VAL(INT_LEAPFROG);
     CH_ENUM_VAL(INT_NEWMARK);
     CH_ENUM_VAL(INT_CUSTOM__);
+    CH_ENUM_VAL(INT_CENTRAL_DIFFERENCE);
     CH_ENUM_MAPPER_END(eCh_integrationType);
 
     /// Sets the method for time integration (time stepper).
     /// Suggested for fast dynamics with hard (DVI) contacts: INT_EULER_IMPLICIT_LINEARIZED,
     /// Suggested for fast dynamics with hard (DVI) contacts and low inter-penetration: INT_EULER_IMPLICIT_PROJECTED,
     /// Suggested for finite element smooth dynamics: INT_HHT, INT_EULER_IMPLICIT_LINEARIZED.
+    /// Suggested for highly dynamic finite element problems without constraints: INT_CENTRAL_DIFFERENCE.
     /// NOTE: for more advanced customization, use SetTimestepper().
     void SetIntegrationType(eCh_integrationType m_integration_type);
 
@@ -471,6 +474,10 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorder {
                                    const unsigned int off_v,
                                    const ChStateDelta& Dv) override;
     virtual void IntLoadResidual_F(const unsigned int off, ChVectorDynamic<>& R, const double c) override;
+    virtual void IntLoadResidual_F_Masked(const unsigned int off,
+                                          ChVectorDynamic<>& R,
+                                          const ChVectorDynamic<>& mask,
+                                          const double c) override;
     virtual void IntLoadResidual_Mv(const unsigned int off,
                                     ChVectorDynamic<>& R,
                                     const ChVectorDynamic<>& w,
@@ -595,6 +602,28 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorder {
                                  const double c               ///< a scaling factor
                                  ) override;
 
+    /// Increment a vector Md with the diagonal of the lumped mass matrix:
+    ///    Md += c*diag(M)
+    virtual void LoadLumpedMass_Md(ChVectorDynamic<>& Md,  ///< result: Md vector, diagonal of the lumped mass matrix
+                                   double& err,            ///< result: not touched if lumping does not introduce errors
+                                   const double c          ///< a scaling factor
+                                   ) override;
+
+    /// Return the smallest stable time step of the items of the system, for explicit
+    /// integrators (zero if none of them limits the time step).
+    virtual double GetStableTimeStep() override { return ChAssembly::GetStableTimeStep(); }
+
+    /// Set the stable time step of each speed coordinate, for explicit integrators with subcycling.
+    virtual void LoadStableTimeSteps(ChVectorDynamic<>& steps) override { IntLoadStableTimeSteps(0, steps); }
+
+    /// Increment a vector R with the term c*F, needed only for the coordinates flagged in mask.
+    virtual void LoadResidual_F_Masked(ChVectorDynamic<>& R,           ///< result: the R residual, R += c*F
+                                       const ChVectorDynamic<>& mask,  ///< coordinates that need the forces
+                                       const double c                  ///< a scaling factor
+                                       ) override {
+        IntLoadResidual_F_Masked(0, R, mask, c);
+    }
+
     /// Increment a vectorR with the term Cq'*L:
     ///    R += c*Cq'*L
     virtual void LoadResidual_CqL(ChVectorDynamic<>& R,        ///< result: the R residual, R += c*Cq'*L
@@ -336,6 +336,41 @@ class ChApi ChIntegrableIIorder : public ChIntegrable {
         throw ChException("LoadResidual_Mv() not implemented, implicit integrators cannot be used. ");
     };
 
+    /// Assuming   M*a = F(x,v,t) + Cq'*L
+    /// increment a vector Md with a diagonal (lumped) approximation of the mass matrix M:
+    ///    Md += c*diag(M)
+    /// The off-diagonal terms of M that could not be lumped are added, in absolute value, to 'err'
+    /// (it stays zero if M is already diagonal). Used by explicit integrators that do not solve
+    /// linear systems.
+    virtual void LoadLumpedMass_Md(ChVectorDynamic<>& Md,  ///< result: Md vector, diagonal of the lumped mass matrix
+                                   double& err,            ///< result: not touched if lumping does not introduce errors
+                                   const double c          ///< a scaling factor
+                                   ) {
+        throw ChException("LoadLumpedMass_Md() not implemented, explicit lumped integrators cannot be used. ");
+    };
+
+    /// Return an estimate of the largest time step for which explicit integrators are stable
+    /// (zero if there is no limit, or if it cannot be estimated).
+    virtual double GetStableTimeStep() { return 0; }
+
+    /// For each speed coordinate, set in 'steps' an estimate of the largest stable time step of
+    /// the parts of the system that act on it (zero if not limited). Used by explicit integrators
+    /// with subcycling, that advance each coordinate with its own multiple of the smallest step.
+    virtual void LoadStableTimeSteps(ChVectorDynamic<>& steps  ///< result: stable step of each speed coordinate
+                                     ) {
+        steps.FillElem(GetStableTimeStep());
+    }
+
+    /// Same as LoadResidual_F, but the forces are needed only for the speed coordinates with a
+    /// non-zero entry in 'mask': the forces on the other coordinates can be left out (or not),
+    /// so that integrators with subcycling can skip the evaluation of forces that are not used.
+    virtual void LoadResidual_F_Masked(ChVectorDynamic<>& R,           ///< result: the R residual, R += c*F
+                                       const ChVectorDynamic<>& mask,  ///< coordinates that need the forces
+                                       const double c                  ///< a scaling factor
+                                       ) {
+        LoadResidual_F(R, c);
+    }
+
     /// Assuming   M*a = F(x,v,t) + Cq'*L
     ///         C(x,t) = 0
     /// increment a vectorR (usually the residual in a Newton Raphson iteration
@@ -12,6 +12,7 @@
 // Authors: Alessandro Tasora, Radu Serban
 // =============================================================================
 
+#include <algorithm>
 #include <cmath>
 
 #include "chrono/timestepper/ChTimestepper.h"
@@ -832,4 +833,134 @@ void ChTimestepperNewmark::Advance(const double dt) {
     mintegrable->StateScatterReactions(L);     // -> system auxiliary data
 }
 
+// -----------------------------------------------------------------------------
+
+// Register into the object factory, to enable run-time dynamic creation and persistence
+ChClassRegister<ChTimestepperCentralDifference> a_registration_ChTimestepperCentralDifference;
+
+// Performs a step of the explicit central difference scheme, with lumped mass
+void ChTimestepperCentralDifference::Advance(const double dt) {
+    // downcast
+    ChIntegrableIIorder* mintegrable = (ChIntegrableIIorder*)this->integrable;
+
+    if (mintegrable->GetNconstr() > 0)
+        throw ChException("ChTimestepperCentralDifference: constraints are not supported");
+
+    // setup main vectors
+    mintegrable->StateSetup(X, V, A);
+
+    // setup auxiliary vectors
+    Xnew.Reset(mintegrable->GetNcoords_x(), GetIntegrable());
+    F.Reset(mintegrable->GetNcoords_v());
+    mask.Reset(mintegrable->GetNcoords_v());
+    L.Reset(0);
+
+    mintegrable->StateGather(X, V, T);  // state <- system
+
+    // lumped mass, stable step and subcycling periods are computed once
+    if (Md.GetRows() != mintegrable->GetNcoords_v())
+        Setup();
+
+    // accelerations at the beginning of the step, reused from the end of the last step if possible
+    if (!acceleration_valid || T != T_acceleration || A.GetRows() != Md.GetRows())
+        ComputeAcceleration(false);
+
+    // number of substeps: all the coordinates must complete their last step at the end of the step
+    num_substeps = 1;
+    if (automatic_substeps && stable_step > 0)
+        num_substeps = std::max(1, (int)std::ceil(dt / (safety_factor * stable_step) - 1e-9));
+    num_substeps = ((num_substeps + max_period - 1) / max_period) * max_period;
+    double h = dt / num_substeps;
+
+    for (int is = 0; is < num_substeps; is++) {
+        // v_half = v + a * H/2, at the start of the step H = period*h of each coordinate
+        for (int i = 0; i < V.GetRows(); i++) {
+            int period = (int)periods(i);
+            if (is % period == 0)
+                V(i) += A(i) * (0.5 * period * h);
+        }
+
+        // x_new = x + v_half * h (linear interpolation for the coordinates in the middle of their step)
+        mintegrable->StateIncrementX(Xnew, X, V * h);
+        X = Xnew;
+        T += h;
+        mintegrable->StateScatter(X, V, T);  // state -> system
+
+        // a_new = Md^-1 * F(x_new, v_half, t+h) and v_new = v_half + a_new * H/2, for the
+        // coordinates at the end of their step
+        if (max_period > 1) {
+            for (int i = 0; i < V.GetRows(); i++)
+                mask(i) = ((is + 1) % (int)periods(i) == 0) ? 1.0 : 0.0;
+        }
+        ComputeAcceleration(max_period > 1);
+        for (int i = 0; i < V.GetRows(); i++) {
+            int period = (int)periods(i);
+            if ((is + 1) % period == 0)
+                V(i) += A(i) * (0.5 * period * h);
+        }
+    }
+
+    mintegrable->StateScatter(X, V, T);        // state -> system
+    mintegrable->StateScatterAcceleration(A);  // -> system auxiliary data
+}
+
+void ChTimestepperCentralDifference::Setup() {
+    ChIntegrableIIorder* mintegrable = (ChIntegrableIIorder*)this->integrable;
+    int n = mintegrable->GetNcoords_v();
+
+    Md.Reset(n);
+    lumping_error = 0;
+    mintegrable->LoadLumpedMass_Md(Md, lumping_error, 1.0);
+    for (int i = 0; i < n; i++) {
+        if (Md(i) <= 0)
+            throw ChException("ChTimestepperCentralDifference: non-positive lumped mass");
+    }
+
+    stable_step = mintegrable->GetStableTimeStep();
+
+    // subcycling: each coordinate gets the largest power of two multiple of the smallest
+    // stable step that does not exceed its own stable step (up to 2^subcycling_levels)
+    periods.Reset(n);
+    periods.FillElem(1.0);
+    max_period = 1;
+    if (subcycling_levels > 0 && stable_step > 0) {
+        ChVectorDynamic<> steps(n);
+        mintegrable->LoadStableTimeSteps(steps);
+        for (int i = 0; i < n; i++) {
+            if (steps(i) <= 0)
+                continue;
+            int level = std::min((int)std::floor(std::log2(steps(i) / stable_step)), subcycling_levels);
+            if (level > 0) {
+                periods(i) = (double)(1 << level);
+                max_period = std::max(max_period, 1 << level);
+            }
+        }
+    }
+
+    acceleration_valid = false;
+    if (verbose)
+        GetLog() << " Central difference: lumped " << n << " masses, lumping error " << lumping_error
+                 << ", stable step " << stable_step << ", max subcycling period " << max_period << "\n";
+}
+
+void ChTimestepperCentralDifference::ComputeAcceleration(bool use_mask) {
+    ChIntegrableIIorder* mintegrable = (ChIntegrableIIorder*)this->integrable;
+
+    F.FillElem(0.0);
+    if (use_mask)
+        mintegrable->LoadResidual_F_Masked(F, mask, 1.0);
+    else
+        mintegrable->LoadResidual_F(F, 1.0);
+
+    if (A.GetRows() != Md.GetRows())
+        A.Reset(Md.GetRows(), GetIntegrable());
+    for (int i = 0; i < Md.GetRows(); i++) {
+        if (!use_mask || mask(i) != 0)
+            A(i) = F(i) / Md(i);
+    }
+
+    acceleration_valid = true;
+    T_acceleration = T;
+}
+
 }  // end namespace chrono
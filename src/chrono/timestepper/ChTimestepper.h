@@ -609,6 +609,135 @@ class ChApi ChTimestepperNewmark : public ChTimestepperIIorder, public ChImplici
     }
 };
 
+/// Explicit central difference timestepper with a lumped (diagonal) mass matrix.
+/// This is the velocity form of the central difference scheme:
+///    v_half = v + a * dt/2
+///    x_new  = x + v_half * dt
+///    a_new  = Md^-1 * F(x_new, v_half, t+dt)
+///    v_new  = v_half + a_new * dt/2
+/// so each step needs a single evaluation of the forces and never assembles or solves a
+/// linear system (the lumped mass is computed once, and again only if the number of
+/// coordinates changes, or after Reset()).
+/// The scheme is only conditionally stable: by default the step is split into substeps
+/// not larger than the stable time step estimated by the integrable object, scaled by a
+/// safety factor (see SetSafetyFactor()).
+/// With subcycling (see SetSubcycling()) each coordinate is advanced with its own step, a
+/// power of two multiple of the substep that is still stable for the parts of the system
+/// acting on it; in between, its position is interpolated linearly (nodal partition of
+/// Belytschko et al.), and the forces of the parts acting only on such coordinates are not
+/// evaluated. This pays off in meshes where a few small or stiff elements set the step.
+/// Constraints (links, DVI contacts) are not supported: use it with penalty (DEM) contacts,
+/// and with fixed nodes/bodies instead of joints.
+/// Collision detection runs once per call to ChSystem::DoStepDynamics(), not in the substeps:
+/// the contacts found at the beginning of the step are used for all its substeps, and contacts
+/// that start within the step are only detected at the next one. Keep the step small when
+/// objects move fast towards each other.
+class ChApi ChTimestepperCentralDifference : public ChTimestepperIIorder {
+    // Chrono simulation of RTTI, needed for serialization
+    CH_RTTI(ChTimestepperCentralDifference, ChTimestepperIIorder);
+
+  protected:
+    ChVectorDynamic<> Md;  ///< lumped mass
+    ChVectorDynamic<> F;   ///< work vector for the forces
+    ChState Xnew;
+    ChVectorDynamic<> periods;  ///< step of each coordinate, in number of substeps
+    ChVectorDynamic<> mask;     ///< coordinates whose forces are needed at the current substep
+    int max_period;
+    int subcycling_levels;
+    double lumping_error;
+    double stable_step;
+    double safety_factor;
+    bool automatic_substeps;
+    int num_substeps;
+    bool acceleration_valid;
+    double T_acceleration;
+
+  public:
+    /// Constructors (default empty)
+    ChTimestepperCentralDifference(ChIntegrableIIorder* mintegrable = nullptr)
+        : ChTimestepperIIorder(mintegrable),
+          max_period(1),
+          subcycling_levels(0),
+          lumping_error(0),
+          stable_step(0),
+          safety_factor(0.9),
+          automatic_substeps(true),
+          num_substeps(0),
+          acceleration_valid(false),
+          T_acceleration(0) {}
+
+    /// Performs an integration timestep
+    virtual void Advance(const double dt  ///< timestep to advance
+                         ) override;
+
+    /// Force the computation of the lumped mass, of the stable time step and of the
+    /// accelerations at the next step (to be called if masses, materials or the state
+    /// were changed between two steps).
+    void Reset() { Md.Reset(0); }
+
+    /// Enable/disable the splitting of the step into substeps not larger than the stable
+    /// time step times the safety factor (default: true).
+    void SetAutomaticSubsteps(bool mas) { automatic_substeps = mas; }
+    bool GetAutomaticSubsteps() const { return automatic_substeps; }
+
+    /// Set the fraction of the estimated stable time step that is used for the substeps (default: 0.9).
+    void SetSafetyFactor(double mf) { safety_factor = mf; }
+    double GetSafetyFactor() const { return safety_factor; }
+
+    /// Enable subcycling, with coordinates advanced with steps up to 2^max_level times the
+    /// substep (default: 0, no subcycling).
+    void SetSubcycling(int max_level) {
+        subcycling_levels = max_level;
+        Reset();
+    }
+    int GetSubcycling() const { return subcycling_levels; }
+
+    /// Get the step of each speed coordinate, in number of substeps (all ones without subcycling).
+    const ChVectorDynamic<>& GetSubcyclingPeriods() const { return periods; }
+
+    /// Get the stable time step estimated by the integrable object (zero if unknown).
+    double GetStableTimeStep() const { return stable_step; }
+
+    /// Get the number of substeps taken in the last call to Advance().
+    int GetNumSubsteps() const { return num_substeps; }
+
+    /// Get the sum of the absolute values of the mass terms that were dropped when lumping
+    /// the mass matrix (zero if the mass matrix was already diagonal).
+    double GetLumpingError() const { return lumping_error; }
+
+    /// Method to allow serialization of transient data to archives.
+    virtual void ArchiveOUT(ChArchiveOut& marchive) override {
+        // version number
+        marchive.VersionWrite(1);
+        // serialize parent class:
+        ChTimestepperIIorder::ArchiveOUT(marchive);
+        // serialize all member data:
+        marchive << CHNVP(safety_factor);
+        marchive << CHNVP(automatic_substeps);
+        marchive << CHNVP(subcycling_levels);
+    }
+
+    /// Method to allow de serialization of transient data from archives.
+    virtual void ArchiveIN(ChArchiveIn& marchive) override {
+        // version number
+        int version = marchive.VersionRead();
+        // deserialize parent class:
+        ChTimestepperIIorder::ArchiveIN(marchive);
+        // stream in all member data:
+        marchive >> CHNVP(safety_factor);
+        marchive >> CHNVP(automatic_substeps);
+        marchive >> CHNVP(subcycling_levels);
+    }
+
+  private:
+    /// Compute the lumped mass, the stable step and the subcycling periods.
+    void Setup();
+
+    /// Compute A = Md^-1 * F at the state currently in the integrable object, for the
+    /// coordinates flagged in the mask (all of them if use_mask is false).
+    void ComputeAcceleration(bool use_mask);
+};
+
 /// @} chrono_timestepper
 
 }  // end namespace chrono
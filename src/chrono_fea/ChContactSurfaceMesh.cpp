@@ -872,6 +872,12 @@ unsigned int ChContactSurfaceMesh::GetNumVertices() const {
 }
 
 void ChContactSurfaceMesh::SurfaceSyncCollisionModels() {
+    if (surface_model) {
+        // the triangle proxies point to the node positions: just refit their bounding boxes
+        surface_model->SyncPosition();
+        surface_model->RefitSubModels();
+        return;
+    }
     for (unsigned int j = 0; j < vfaces.size(); j++) {
         this->vfaces[j]->GetCollisionModel()->SyncPosition();
     }
@@ -882,6 +888,28 @@ void ChContactSurfaceMesh::SurfaceSyncCollisionModels() {
 
 void ChContactSurfaceMesh::SurfaceAddCollisionModelsToSystem(ChSystem* msys) {
     assert(msys);
+    if (single_collision_model && GetNumTriangles() > 0) {
+        // (re)build the surface model, with the collision models of the triangles as sub models;
+        // it refers to the first triangle for the physics item and the (identity) frame.
+        collision::ChCollisionModel* first_model;
+        if (vfaces.size())
+            first_model = vfaces[0]->GetCollisionModel();
+        else
+            first_model = vfaces_rot[0]->GetCollisionModel();
+        if (!surface_model)
+            surface_model.reset(new collision::ChModelBullet);
+        surface_model->SetContactable(first_model->GetContactable());
+        surface_model->ClearModel();
+        surface_model->SetEnvelope(first_model->GetEnvelope());
+        surface_model->SetSafeMargin(first_model->GetSafeMargin());
+        for (unsigned int j = 0; j < vfaces.size(); j++)
+            surface_model->AddSubModel((collision::ChModelBullet*)this->vfaces[j]->GetCollisionModel());
+        for (unsigned int j = 0; j < vfaces_rot.size(); j++)
+            surface_model->AddSubModel((collision::ChModelBullet*)this->vfaces_rot[j]->GetCollisionModel());
+        SurfaceSyncCollisionModels();
+        msys->GetCollisionSystem()->Add(surface_model.get());
+        return;
+    }
     SurfaceSyncCollisionModels();
     for (unsigned int j = 0; j < vfaces.size(); j++) {
         msys->GetCollisionSystem()->Add(this->vfaces[j]->GetCollisionModel());
@@ -893,6 +921,10 @@ void ChContactSurfaceMesh::SurfaceAddCollisionModelsToSystem(ChSystem* msys) {
 
 void ChContactSurfaceMesh::SurfaceRemoveCollisionModelsFromSystem(ChSystem* msys) {
     assert(msys);
+    if (surface_model) {
+        msys->GetCollisionSystem()->Remove(surface_model.get());
+        return;
+    }
     for (unsigned int j = 0; j < vfaces.size(); j++) {
         msys->GetCollisionSystem()->Remove(this->vfaces[j]->GetCollisionModel());
     }
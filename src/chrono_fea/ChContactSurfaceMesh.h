@@ -13,10 +13,13 @@
 #ifndef CHCONTACTSURFACEMESH_H
 #define CHCONTACTSURFACEMESH_H
 
+#include <memory>
+
 #include "chrono_fea/ChContactSurface.h"
 #include "chrono_fea/ChNodeFEAxyz.h"
 #include "chrono_fea/ChNodeFEAxyzrot.h"
 #include "chrono/collision/ChCCollisionModel.h"
+#include "chrono/collision/ChCModelBullet.h"
 #include "chrono/collision/ChCCollisionUtils.h"
 #include "chrono/physics/ChLoaderUV.h"
 
@@ -615,10 +618,15 @@ class ChApiFea ChContactSurfaceMesh : public ChContactSurface {
     CH_RTTI(ChContactSurfaceMesh, ChContactSurface);
 
   public:
-    ChContactSurfaceMesh(ChMesh* parentmesh = 0) : ChContactSurface(parentmesh) {}
+    ChContactSurfaceMesh(ChMesh* parentmesh = 0)
+        : ChContactSurface(parentmesh), single_collision_model(false) {}
 
     virtual ~ChContactSurfaceMesh() {}
 
+    // not copyable: the surface collision model is owned by this object
+    ChContactSurfaceMesh(const ChContactSurfaceMesh&) = delete;
+    ChContactSurfaceMesh& operator=(const ChContactSurfaceMesh&) = delete;
+
     // 
     // FUNCTIONS
     //
@@ -658,6 +666,22 @@ class ChApiFea ChContactSurfaceMesh : public ChContactSurface {
     /// Get the number of vertices.
     unsigned int GetNumVertices() const;
 
+    /// Enable the use of a single collision model for the whole surface (default: false).
+    /// If enabled, the triangles are added as sub shapes of a single Bullet collision object,
+    /// with one broadphase proxy instead of one per triangle, and at each step their bounding
+    /// boxes are refitted in the AABB tree of the surface (the tree is built only once, when
+    /// the mesh is added to the system). The contacts are still reported to the triangles,
+    /// hence with the same node-weighted Jacobians. This is faster for large surfaces, but the
+    /// self collisions of the surface are not detected, and the collision family must be set
+    /// on the surface model (see GetSurfaceCollisionModel()) rather than on the triangles.
+    /// Call this before adding the mesh to the system.
+    void SetSingleCollisionModel(bool mval) { single_collision_model = mval; }
+    bool GetSingleCollisionModel() const { return single_collision_model; }
+
+    /// Get the collision model of the whole surface, if SetSingleCollisionModel() was enabled
+    /// (it is created when the mesh is added to the system; null otherwise).
+    collision::ChCollisionModel* GetSurfaceCollisionModel() const { return surface_model.get(); }
+
     // Functions to interface this with ChPhysicsItem container
     virtual void SurfaceSyncCollisionModels();
     virtual void SurfaceAddCollisionModelsToSystem(ChSystem* msys);
@@ -666,6 +690,11 @@ class ChApiFea ChContactSurfaceMesh : public ChContactSurface {
   private:
     std::vector<std::shared_ptr<ChContactTriangleXYZ> > vfaces;         //  faces that collide
     std::vector<std::shared_ptr<ChContactTriangleXYZROT> > vfaces_rot;  //  faces that collide (for nodes with rotation too)
+
+    bool single_collision_model;  //  use a single collision model for all the faces
+
+    //  collision model with the faces as sub models, if single
+    std::unique_ptr<collision::ChModelBullet> surface_model;
 };
 
 }  // END_OF_NAMESPACE____
@@ -103,6 +103,16 @@ class ChApiFea ChElementBase {
     ///   R += M * v * c
     virtual void EleIntLoadResidual_Mv(ChVectorDynamic<>& R, const ChVectorDynamic<>& w, const double c) {}
 
+    /// Adds the diagonal of the lumped mass matrix of the element (pasted at global nodes offsets)
+    /// into a global vector Md, multiplied by a scaling factor c, as
+    ///   Md += c * diag(M)
+    /// Off-diagonal terms that could not be lumped are added, in absolute value, to 'error'.
+    virtual void EleIntLoadLumpedMass_Md(ChVectorDynamic<>& Md, double& error, const double c) {}
+
+    /// Estimate of the largest time step for which explicit integration of this element is
+    /// stable, in the current configuration (zero if it cannot be estimated).
+    virtual double GetStableTimeStep() { return 0; }
+
     //
     // Functions for interfacing to the solver
     //
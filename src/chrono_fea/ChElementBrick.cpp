@@ -23,7 +23,15 @@ namespace chrono {
 namespace fea {
 
 // -----------------------------------------------------------------------------
-ChElementBrick::ChElementBrick() : m_flag_HE(ANALYTICAL), m_gravity_on(false) {
+ChElementBrick::ChElementBrick()
+    : m_flag_HE(ANALYTICAL),
+      m_gravity_on(false),
+      m_toleranceEAS(1e-5),
+      m_maxIterationsEAS(100),
+      m_freezeToleranceEAS(0),
+      m_convergedEAS(false),
+      m_iterationsEAS(0),
+      m_solvesEAS(0) {
     m_nodes.resize(8);
 }
 // -----------------------------------------------------------------------------
@@ -193,6 +201,16 @@ void ChElementBrick::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
         ResidHE.Reset();
         int count = 0;
         int fail = 1;
+
+        // If the EAS solve converged at the previous call, keep the parameters while the residual
+        // stays below the freeze tolerance.
+        double tolerance = m_toleranceEAS;
+        if (m_flag_HE == ANALYTICAL) {
+            if (m_convergedEAS && m_freezeToleranceEAS > m_toleranceEAS)
+                tolerance = m_freezeToleranceEAS;
+            m_convergedEAS = false;
+            m_solvesEAS++;
+        }
         /// Begin EAS loop
         while (fail == 1) {
             /// Update alpha EAS
@@ -245,9 +263,14 @@ void ChElementBrick::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
             count = count + 1;
             double norm_HE = HE.NormTwo();
 
-            if (norm_HE < 0.00001) {
+            if (norm_HE < tolerance) {
+                m_convergedEAS = true;
+                fail = 0;
+            } else if (count > m_maxIterationsEAS) {
                 fail = 0;
             } else {
+                tolerance = m_toleranceEAS;
+                m_iterationsEAS++;
                 ChMatrixNM<int, 9, 1> INDX;
                 bool pivoting;
                 ResidHE = HE;
@@ -256,9 +279,6 @@ void ChElementBrick::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
                 }
                 LU_solve(KALPHA1, INDX, ResidHE);
             }
-            if (m_flag_HE == ANALYTICAL && count > 2) {
-                GetLog() << i << "  count " << count << "  NormHE " << norm_HE << "\n";
-            }
         }
         Fi = -Finternal;
         //== Stock_Alpha=================//
@@ -274,16 +294,17 @@ void ChElementBrick::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
             ChMatrixNM<double, 9, 9> INV_KALPHA_Temp;
             ChMatrixNM<double, 24, 24> stock_jac_EAS_elem;
 
+            // Factorize KALPHA once, then solve for the columns of its inverse
+            INV_KALPHA_Temp = KALPHA;
+            ChMatrixNM<int, 9, 1> INDX;
+            bool pivoting;
+            if (!LU_factor(INV_KALPHA_Temp, INDX, pivoting)) {
+                throw ChException("Singular matrix.");
+            }
             for (int ii = 0; ii < 9; ii++) {
-                INV_KALPHA_Temp = KALPHA;
-                ChMatrixNM<int, 9, 1> INDX;
                 ChMatrixNM<double, 9, 1> DAMMY_vec;
                 DAMMY_vec.Reset();
                 DAMMY_vec(ii) = 1.0;
-                bool pivoting;
-                if (!LU_factor(INV_KALPHA_Temp, INDX, pivoting)) {
-                    throw ChException("Singular matrix.");
-                }
                 LU_solve(INV_KALPHA_Temp, INDX, DAMMY_vec);
                 INV_KALPHA.PasteClippedMatrix(&DAMMY_vec, 0, 0, 9, 1, 0, ii);  //
             }
@@ -314,6 +335,16 @@ void ChElementBrick::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
         ResidHE.Reset();
         int count = 0;
         int fail = 1;
+
+        // If the EAS solve converged at the previous call, keep the parameters while the residual
+        // stays below the freeze tolerance.
+        double tolerance = m_toleranceEAS;
+        if (m_flag_HE == ANALYTICAL) {
+            if (m_convergedEAS && m_freezeToleranceEAS > m_toleranceEAS)
+                tolerance = m_freezeToleranceEAS;
+            m_convergedEAS = false;
+            m_solvesEAS++;
+        }
         // Loop to obtain convergence in EAS internal parameters alpha
         // This loops call ChQuadrature::Integrate3D on MyAnalyticalForce,
         // which calculates the Jacobian at every iteration of each time step
@@ -390,9 +421,14 @@ void ChElementBrick::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
                 break;  // When numerical jacobian loop, no need to calculate HE
             count = count + 1;
             double norm_HE = HE.NormTwo();
-            if (norm_HE < 0.00001) {
+            if (norm_HE < tolerance) {
+                m_convergedEAS = true;
+                fail = 0;
+            } else if (count > m_maxIterationsEAS) {
                 fail = 0;
             } else {
+                tolerance = m_toleranceEAS;
+                m_iterationsEAS++;
                 ChMatrixNM<int, 9, 1> INDX;
                 ResidHE = HE;
                 bool pivoting;
@@ -416,16 +452,17 @@ void ChElementBrick::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
             ChMatrixNM<double, 9, 9> INV_KALPHA_Temp;
             ChMatrixNM<double, 24, 24> stock_jac_EAS_elem;
 
+            // Factorize KALPHA once, then solve for the columns of its inverse
+            INV_KALPHA_Temp = KALPHA;
+            ChMatrixNM<int, 9, 1> INDX;
+            bool pivoting;
+            if (!LU_factor(INV_KALPHA_Temp, INDX, pivoting)) {
+                throw ChException("Singular matrix.");
+            }
             for (int ii = 0; ii < 9; ii++) {
-                INV_KALPHA_Temp = KALPHA;
-                ChMatrixNM<int, 9, 1> INDX;
                 ChMatrixNM<double, 9, 1> DAMMY_vec;
                 DAMMY_vec.Reset();
                 DAMMY_vec(ii) = 1.0;
-                bool pivoting;
-                if (!LU_factor(INV_KALPHA_Temp, INDX, pivoting)) {
-                    throw ChException("Singular matrix.");
-                }
                 LU_solve(INV_KALPHA_Temp, INDX, DAMMY_vec);
                 INV_KALPHA.PasteClippedMatrix(&DAMMY_vec, 0, 0, 9, 1, 0, ii);  //
             }
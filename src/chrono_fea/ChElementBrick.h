@@ -297,6 +297,33 @@ class ChApiFea ChElementBrick : public ChElementGeneric, public ChLoadableUVW {
     /// Set some element parameters (dimensions).
     void SetInertFlexVec(const ChMatrixNM<double, 3, 1>& a) { m_InertFlexVec = a; }
 
+    /// Set the tolerance (on the residual norm) of the nonlinear EAS solver (default: 1e-5).
+    void SetEASTolerance(double tol) { m_toleranceEAS = tol; }
+
+    /// Set the maximum number of nonlinear EAS iterations (default: 100).
+    void SetEASMaxIterations(int iters) { m_maxIterationsEAS = iters; }
+
+    /// Enable freezing of the EAS parameters (default: 0, disabled).
+    /// If the EAS solve converged at the previous call, the stored parameters are reused without
+    /// Newton iterations as long as the residual stays below the given freeze tolerance (which
+    /// should be larger than the EAS tolerance); once exceeded, the element is solved again down
+    /// to the EAS tolerance.
+    void SetEASFreezeTolerance(double tol) { m_freezeToleranceEAS = tol; }
+
+    /// Number of EAS Newton iterations performed since the last call to ResetEASStatistics().
+    long GetEASIterations() const { return m_iterationsEAS; }
+
+    /// Number of EAS solves (one at each internal force evaluation) since the last call to
+    /// ResetEASStatistics(). GetEASIterations()/GetEASSolves() is the average number of EAS
+    /// iterations per solve.
+    long GetEASSolves() const { return m_solvesEAS; }
+
+    /// Reset the EAS iteration counters.
+    void ResetEASStatistics() {
+        m_iterationsEAS = 0;
+        m_solvesEAS = 0;
+    }
+
     int GetElemNum() const { return m_elementnumber; }
     
     /// Get initial position of the element in matrix form
@@ -464,6 +491,12 @@ class ChApiFea ChElementBrick : public ChElementGeneric, public ChLoadableUVW {
     ChMatrixNM<double, 24, 24> m_stock_jac_EAS;  ///< EAS Jacobian matrix
     ChMatrixNM<double, 9, 1> m_stock_alpha_EAS;  ///< EAS previous step internal parameters
     ChMatrixNM<double, 24, 24> m_stock_KTE;      ///< Analytical Jacobian
+    double m_toleranceEAS;                       ///< tolerance for nonlinear EAS solver (on residual)
+    int m_maxIterationsEAS;                      ///< maximum number of nonlinear EAS iterations
+    double m_freezeToleranceEAS;                 ///< residual below which converged EAS parameters are reused
+    bool m_convergedEAS;                         ///< EAS solve converged at last call
+    long m_iterationsEAS;                        ///< EAS iterations counter
+    long m_solvesEAS;                            ///< EAS solves counter
     ChMatrixNM<double, 8, 3> m_d0;               ///< Initial Coordinate per element
     ChMatrixNM<double, 24, 1> m_GravForce;       ///< Gravity Force
     JacobianType m_flag_HE;
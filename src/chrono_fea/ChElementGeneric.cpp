@@ -11,13 +11,17 @@
 // File author: Alessandro Tasora
 
 
+#include <cmath>
+
 #include "chrono_fea/ChElementGeneric.h"
 
 namespace chrono {
 namespace fea {
 
 void ChElementGeneric::EleIntLoadResidual_F(ChVectorDynamic<>& R, const double c) {
-    ChMatrixDynamic<> mFi(this->GetNdofs(), 1);
+    // Fi_buffer is resized (i.e. allocated) only the first time; later calls only reset it
+    ChMatrixDynamic<>& mFi = Fi_buffer;
+    mFi.Reset(this->GetNdofs(), 1);
     this->ComputeInternalForces(mFi);
     // GetLog() << "EleIntLoadResidual_F , mFi=" << mFi << "  c=" << c << "\n";
     mFi.MatrScale(c);
@@ -62,6 +66,83 @@ void ChElementGeneric::EleIntLoadResidual_Mv(ChVectorDynamic<>& R, const ChVecto
     }
 }
 
+void ChElementGeneric::EleIntLoadLumpedMass_Md(ChVectorDynamic<>& Md, double& error, const double c) {
+    int n = this->GetNdofs();
+    ChMatrixDynamic<> mMi(n, n);
+    this->ComputeMmatrixGlobal(mMi);
+
+    int stride = 0;
+    for (int in = 0; in < this->GetNnodes(); in++) {
+        int nodedofs = GetNodeNdofs(in);
+        for (int i = stride; i < stride + nodedofs; i++) {
+            double rowsum = 0;
+            for (int j = 0; j < n; j++)
+                rowsum += mMi(i, j);
+            double lumped = (rowsum > 0) ? rowsum : mMi(i, i);
+            for (int j = 0; j < n; j++) {
+                if (j != i)
+                    error += std::abs(mMi(i, j));
+            }
+            if (!GetNodeN(in)->GetFixed())
+                Md(GetNodeN(in)->NodeGetOffset_w() + i - stride) += c * lumped;
+        }
+        stride += nodedofs;
+    }
+}
+
+double ChElementGeneric::GetStableTimeStep() {
+    int n = this->GetNdofs();
+    ChMatrixDynamic<> mMi(n, n);
+    this->ComputeMmatrixGlobal(mMi);
+    ChMatrixDynamic<> mK(n, n);
+    this->ComputeKRMmatricesGlobal(mK, 1.0);
+
+    // scaling by the inverse square root of the lumped mass (lumped as in EleIntLoadLumpedMass_Md)
+    ChVectorDynamic<> s(n);
+    for (int i = 0; i < n; i++) {
+        double rowsum = 0;
+        for (int j = 0; j < n; j++)
+            rowsum += mMi(i, j);
+        double lumped = (rowsum > 0) ? rowsum : mMi(i, i);
+        if (lumped <= 0)
+            return 0;
+        s(i) = 1.0 / std::sqrt(lumped);
+    }
+
+    // power iterations on Md^-1/2 * K * Md^-1/2, starting from an oscillating vector
+    // (in the highest frequency modes neighbouring nodes move in opposite directions)
+    ChVectorDynamic<> x(n);
+    ChVectorDynamic<> y(n);
+    for (int i = 0; i < n; i++)
+        x(i) = ((i / 3) % 2 ? -1.0 : 1.0) * (1.0 + 0.01 * i);
+    double lambda = 0;
+    for (int iter = 0; iter < 200; iter++) {
+        double xx = 0;
+        double xy = 0;
+        for (int i = 0; i < n; i++) {
+            double sum = 0;
+            for (int j = 0; j < n; j++)
+                sum += mK(i, j) * s(j) * x(j);
+            y(i) = s(i) * sum;
+            xx += x(i) * x(i);
+            xy += x(i) * y(i);
+        }
+        double ynorm = y.NormTwo();
+        if (ynorm == 0)
+            return 0;
+        for (int i = 0; i < n; i++)
+            x(i) = y(i) / ynorm;
+        double lambda_new = xy / xx;
+        bool converged = std::abs(lambda_new - lambda) <= 1e-8 * std::abs(lambda_new);
+        lambda = lambda_new;
+        if (converged)
+            break;
+    }
+    if (lambda <= 0)
+        return 0;
+    return 2.0 / std::sqrt(lambda);
+}
+
 void ChElementGeneric::VariablesFbLoadInternalForces(double factor) {
     throw(ChException("ChElementGeneric::VariablesFbLoadInternalForces is deprecated"));
     /*
@@ -33,6 +33,7 @@ namespace fea {
 class ChApiFea ChElementGeneric : public ChElementBase {
   protected:
     ChKblockGeneric Kmatr;
+    ChMatrixDynamic<> Fi_buffer;  ///< internal forces, reused by EleIntLoadResidual_F to avoid a reallocation per call
 
   public:
     ChElementGeneric(){};
@@ -53,6 +54,14 @@ class ChApiFea ChElementGeneric : public ChElementBase {
     /// implementing this EleIntLoadResidual_Mv function, unless you need faster code.)
     virtual void EleIntLoadResidual_Mv(ChVectorDynamic<>& R, const ChVectorDynamic<>& w, const double c) override;
 
+    /// Lumps the mass matrix of ComputeMmatrixGlobal() by row sums (or takes its diagonal
+    /// term, for rows whose sum is not positive, as for the slope coordinates of ANCF elements).
+    virtual void EleIntLoadLumpedMass_Md(ChVectorDynamic<>& Md, double& error, const double c) override;
+
+    /// Estimates the stable time step as 2/w_max, where w_max^2 is the largest eigenvalue of the
+    /// element stiffness matrix with respect to the lumped element mass (by power iterations).
+    virtual double GetStableTimeStep() override;
+
     //
     // FEM functions
     //
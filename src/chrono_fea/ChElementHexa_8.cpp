@@ -3,7 +3,7 @@
 namespace chrono {
 namespace fea {
 
-ChElementHexa_8::ChElementHexa_8() {
+ChElementHexa_8::ChElementHexa_8() : corot_valid(false), corot_tolerance(0) {
     nodes.resize(8);
     StiffnessMatrix.Resize(24, 24);
     this->ir = new ChGaussIntegrationRule;
@@ -13,6 +13,9 @@
 #ifndef CHELEMENTHEXA8_H
 #define CHELEMENTHEXA8_H
 
+#include <algorithm>
+#include <cmath>
+
 #include "chrono_fea/ChElementHexahedron.h"
 #include "chrono_fea/ChNodeFEAxyz.h"
 
@@ -35,6 +38,11 @@ class ChApiFea ChElementHexa_8 : public ChElementHexahedron, public ChLoadableUV
 
     ChMatrixDynamic<> StiffnessMatrix;
 
+    ChMatrixNM<double, 24, 24> StiffnessMatrixCorot;  // cached corotated stiffness matrix C*K*C'
+    ChMatrix33<> A_corot;                             // rotation used for StiffnessMatrixCorot
+    bool corot_valid;                                 // false if StiffnessMatrixCorot must be recomputed
+    double corot_tolerance;                           // tolerance on A for reusing StiffnessMatrixCorot
+
   public:
     ChElementHexa_8();
     virtual ~ChElementHexa_8();
@@ -285,11 +293,13 @@ class ChApiFea ChElementHexa_8 : public ChElementHexahedron, public ChLoadableUV
     /// Computes the global STIFFNESS MATRIX of the element:
     /// K = sum (w_i * [B]' * [D] * [B])
     /// The number of Gauss Point is defined by SetIntegrationRule function (default: 8 Gp).
+    /// Invalidates the cached corotated stiffness matrix.
     virtual void ComputeStiffnessMatrix() {
         double Jdet;
         ChMatrixDynamic<>* temp = new ChMatrixDynamic<>;
         ChMatrixDynamic<> BT;
         this->Volume = 0;
+        StiffnessMatrix.Reset();
 
         for (unsigned int i = 0; i < GpVector.size(); i++) {
             ComputeMatrB(GpVector[i], Jdet);
@@ -305,6 +315,7 @@ class ChApiFea ChElementHexa_8 : public ChElementHexahedron, public ChLoadableUV
         }
 
         delete temp;
+        corot_valid = false;
     }
 
     virtual void SetupInitial(ChSystem* system) override { ComputeStiffnessMatrix(); }
@@ -362,25 +373,51 @@ class ChApiFea ChElementHexa_8 : public ChElementHexahedron, public ChLoadableUV
         return mstress;
     }
 
+    /// Set the tolerance for reusing the cached corotated stiffness matrix C*K*C'.
+    /// The cached matrix is recomputed only if some entry of the rotation matrix A changed by more than
+    /// this value since the last computation. With the default value (0), the cached matrix is reused
+    /// only as long as the rotation does not change (e.g. across calls within the same state update).
+    void SetCorotationTolerance(double tol) { corot_tolerance = tol; }
+
+    /// Get the tolerance for reusing the cached corotated stiffness matrix.
+    double GetCorotationTolerance() const { return corot_tolerance; }
+
+    /// Update the cached corotated stiffness matrix C*K*C', unless the rotation A is within the
+    /// corotation tolerance of the one used for the cached matrix.
+    void UpdateCorotatedStiffness() {
+        if (corot_valid) {
+            double max_diff = 0;
+            for (int row = 0; row < 3; ++row)
+                for (int col = 0; col < 3; ++col)
+                    max_diff = std::max(max_diff, std::abs(A(row, col) - A_corot(row, col)));
+            if (max_diff <= corot_tolerance)
+                return;
+        }
+
+        // warp the local stiffness matrix K in order to obtain global
+        // tangent stiffness CKCt:
+        ChMatrixNM<double, 24, 24> CK;
+        ChMatrixCorotation<>::ComputeCK(StiffnessMatrix, this->A, 8, CK);
+        ChMatrixCorotation<>::ComputeKCt(CK, this->A, 8, StiffnessMatrixCorot);
+
+        A_corot = this->A;
+        corot_valid = true;
+    }
+
     /// Sets H as the global stiffness matrix K, scaled  by Kfactor. Optionally, also
     /// superimposes global damping matrix R, scaled by Rfactor, and global mass matrix M multiplied by Mfactor.
     virtual void ComputeKRMmatricesGlobal(ChMatrix<>& H, double Kfactor, double Rfactor = 0, double Mfactor = 0) {
         assert((H.GetRows() == GetNdofs()) && (H.GetColumns() == GetNdofs()));
 
-        // warp the local stiffness matrix K in order to obtain global
-        // tangent stiffness CKCt:
-        ChMatrixDynamic<> CK(GetNdofs(), GetNdofs());
-        ChMatrixDynamic<> CKCt(GetNdofs(), GetNdofs());  // the global, corotated, K matrix, for 8 nodes
-        ChMatrixCorotation<>::ComputeCK(StiffnessMatrix, this->A, 8, CK);
-        ChMatrixCorotation<>::ComputeKCt(CK, this->A, 8, CKCt);
+        // For K stiffness matrix and R damping matrix (corotated stiffness is cached):
 
-        // For K stiffness matrix and R damping matrix:
+        UpdateCorotatedStiffness();
 
         double mkfactor = Kfactor + Rfactor * this->GetMaterial()->Get_RayleighDampingK();
 
-        CKCt.MatrScale(mkfactor);
-
-        H.PasteMatrix(&CKCt, 0, 0);
+        for (int row = 0; row < 24; ++row)
+            for (int col = 0; col < 24; ++col)
+                H(row, col) = mkfactor * StiffnessMatrixCorot(row, col);
 
         // For M mass matrix:
         if (Mfactor) {
@@ -400,17 +437,19 @@ class ChApiFea ChElementHexa_8 : public ChElementHexahedron, public ChLoadableUV
         assert((Fi.GetRows() == GetNdofs()) && (Fi.GetColumns() == 1));
 
         // set up vector of nodal displacements (in local element system) u_l = R*p - p0
-        ChMatrixDynamic<> displ(GetNdofs(), 1);
-        this->GetStateBlock(displ);
+        // (fixed-size temporaries: no heap allocations here)
+        ChMatrixNM<double, 24, 1> displ;
+        for (int in = 0; in < 8; ++in)
+            displ.PasteVector(A.MatrT_x_Vect(nodes[in]->GetPos()) - nodes[in]->GetX0(), in * 3, 0);
 
         // [local Internal Forces] = [Klocal] * displ + [Rlocal] * displ_dt
-        ChMatrixDynamic<> FiK_local(GetNdofs(), 1);
+        ChMatrixNM<double, 24, 1> FiK_local;
         FiK_local.MatrMultiply(StiffnessMatrix, displ);
 
         for (int in = 0; in < 8; ++in) {
             displ.PasteVector(A.MatrT_x_Vect(nodes[in]->pos_dt), in * 3, 0);  // nodal speeds, local
         }
-        ChMatrixDynamic<> FiR_local(GetNdofs(), 1);
+        ChMatrixNM<double, 24, 1> FiR_local;
         FiR_local.MatrMultiply(StiffnessMatrix, displ);
         FiR_local.MatrScale(this->Material->Get_RayleighDampingK());
 
@@ -427,6 +466,19 @@ class ChApiFea ChElementHexa_8 : public ChElementHexahedron, public ChLoadableUV
         ChMatrixCorotation<>::ComputeCK(FiK_local, this->A, 8, Fi);
     }
 
+    /// Adds M*w to R, scaled by c. The mass is lumped (as in ComputeKRMmatricesGlobal), so there
+    /// is no need to build the mass matrix as in the default implementation of ChElementGeneric.
+    virtual void EleIntLoadResidual_Mv(ChVectorDynamic<>& R, const ChVectorDynamic<>& w, const double c) override {
+        double lumped_node_mass = (this->Volume * this->Material->Get_density()) / 8.0;
+        for (int in = 0; in < 8; ++in) {
+            if (nodes[in]->GetFixed())
+                continue;
+            unsigned int offset = nodes[in]->NodeGetOffset_w();
+            for (int i = 0; i < 3; ++i)
+                R(offset + i) += c * lumped_node_mass * w(offset + i);
+        }
+    }
+
     //
     // Custom properties functions
     //
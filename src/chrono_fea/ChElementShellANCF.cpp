@@ -24,18 +24,23 @@
 namespace chrono {
 namespace fea {
 
-// ------------------------------------------------------------------------------
-// Static variables
-// ------------------------------------------------------------------------------
-const double ChElementShellANCF::m_toleranceEAS = 1e-5;
-const int ChElementShellANCF::m_maxIterationsEAS = 100;
-
 // ------------------------------------------------------------------------------
 // Constructor
 // ------------------------------------------------------------------------------
 
 ChElementShellANCF::ChElementShellANCF()
-    : m_gravity_on(false), m_numLayers(0), m_thickness(0), m_lenX(0), m_lenY(0), m_Alpha(0) {
+    : m_gravity_on(false),
+      m_numLayers(0),
+      m_thickness(0),
+      m_lenX(0),
+      m_lenY(0),
+      m_Alpha(0),
+      m_batched(true),
+      m_toleranceEAS(1e-5),
+      m_maxIterationsEAS(100),
+      m_freezeToleranceEAS(0),
+      m_iterationsEAS(0),
+      m_solvesEAS(0) {
     m_nodes.resize(4);
 }
 
@@ -106,10 +111,14 @@ void ChElementShellANCF::SetupInitial(ChSystem* system) {
     // Reserve space for the EAS parameters and Jacobians.
     m_alphaEAS.resize(m_numLayers);
     m_KalphaEAS.resize(m_numLayers);
+    m_convergedEAS.assign(m_numLayers, false);
 
     // Cache the scaling factor (due to change of integration intervals)
     m_GaussScaling = (m_lenX * m_lenY * m_thickness) / 8;
 
+    // Cache the reference-configuration data at the Gauss points of all layers
+    SetupGaussPointBatch();
+
     // Compute mass matrix and gravitational forces (constant)
     ComputeMassMatrix();
     ComputeGravityForce(system->Get_G_acc());
@@ -535,7 +544,7 @@ void MyForce::Evaluate(ChMatrixNM<double, 54, 1>& result, const double x, const
                          strainD_til(5, ii) * (beta(4) * beta(6) + beta(3) * beta(7));
         strainD(3, ii) = strainD_til(0, ii) * beta(2) * beta(2) + strainD_til(1, ii) * beta(5) * beta(5) +
                          strainD_til(2, ii) * beta(2) * beta(5) + strainD_til(3, ii) * beta(8) * beta(8) +
-                         strainD_til(4, ii) * beta(2) * beta(8) + strainD_til(5) * beta(5) * beta(8);
+                         strainD_til(4, ii) * beta(2) * beta(8) + strainD_til(5, ii) * beta(5) * beta(8);
         strainD(4, ii) = strainD_til(0, ii) * 2.0 * beta(0) * beta(2) + strainD_til(1, ii) * 2.0 * beta(3) * beta(5) +
                          strainD_til(2, ii) * (beta(2) * beta(3) + beta(0) * beta(5)) +
                          strainD_til(3, ii) * 2.0 * beta(6) * beta(8) +
@@ -604,27 +613,58 @@ void ChElementShellANCF::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
         // Initial guess for EAS parameters
         ChMatrixNM<double, 5, 1> alphaEAS = m_alphaEAS[kl];
 
+        // With the batched kernel, the Gauss point integrands are evaluated only once per layer.
+        // The internal force and the EAS residual are linear in alphaEAS, so each EAS iteration
+        // below only requires a few small matrix products.
+        ChMatrixNM<double, 24, 1> F0;
+        ChMatrixNM<double, 24, 5> FG;
+        ChMatrixNM<double, 5, 1> HE0;
+        if (m_batched) {
+            ComputeLayerForcesBatched(kl, F0, FG, HE0);
+            KALPHA = m_gaussBatch[kl].KalphaEAS;
+        }
+
+        // A layer that converged at the previous call keeps its parameters while the residual
+        // stays below the freeze tolerance.
+        double tolerance = m_toleranceEAS;
+        if (m_convergedEAS[kl] && m_freezeToleranceEAS > m_toleranceEAS)
+            tolerance = m_freezeToleranceEAS;
+        m_convergedEAS[kl] = false;
+        m_solvesEAS++;
+
         // Newton loop for EAS
-        for (int count = 0; count < m_maxIterationsEAS; count++) {
-            ChMatrixNM<double, 54, 1> result;
-            MyForce formula(this, kl, &alphaEAS);
-            ChQuadrature::Integrate3D<ChMatrixNM<double, 54, 1> >(result,   // result of integration
-                                                                  formula,  // integrand formula
-                                                                  -1, 1,    // x limits
-                                                                  -1, 1,    // y limits
-                                                                  m_GaussZ[kl], m_GaussZ[kl + 1],  // z limits
-                                                                  2  // order of integration
-                                                                  );
-
-            // Extract vectors and matrices from result of integration
-            Finternal.PasteClippedMatrix(&result, 0, 0, 24, 1, 0, 0);
-            HE.PasteClippedMatrix(&result, 24, 0, 5, 1, 0, 0);
-            KALPHA.PasteClippedVectorToMatrix(&result, 0, 0, 5, 5, 29);
+        for (int count = 0; count <= m_maxIterationsEAS; count++) {
+            if (m_batched) {
+                Finternal.MatrMultiply(FG, alphaEAS);
+                Finternal += F0;
+                HE.MatrMultiply(KALPHA, alphaEAS);
+                HE += HE0;
+            } else {
+                ChMatrixNM<double, 54, 1> result;
+                MyForce formula(this, kl, &alphaEAS);
+                ChQuadrature::Integrate3D<ChMatrixNM<double, 54, 1> >(result,   // result of integration
+                                                                      formula,  // integrand formula
+                                                                      -1, 1,    // x limits
+                                                                      -1, 1,    // y limits
+                                                                      m_GaussZ[kl], m_GaussZ[kl + 1],  // z limits
+                                                                      2  // order of integration
+                                                                      );
+
+                // Extract vectors and matrices from result of integration
+                Finternal.PasteClippedMatrix(&result, 0, 0, 24, 1, 0, 0);
+                HE.PasteClippedMatrix(&result, 24, 0, 5, 1, 0, 0);
+                KALPHA.PasteClippedVectorToMatrix(&result, 0, 0, 5, 5, 29);
+            }
 
             // Check convergence (residual check)
             double norm_HE = HE.NormTwo();
-            if (norm_HE < m_toleranceEAS)
+            if (norm_HE < tolerance) {
+                m_convergedEAS[kl] = true;
+                break;
+            }
+            if (count == m_maxIterationsEAS)
                 break;
+            tolerance = m_toleranceEAS;
 
             // Calculate increment (in place) and update EAS parameters
             ChMatrixNM<int, 5, 1> INDX;
@@ -634,9 +674,7 @@ void ChElementShellANCF::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
                 throw ChException("Singular matrix in LU factorization");
             LU_solve(KALPHA1, INDX, HE);
             alphaEAS = alphaEAS - HE;
-
-            if (count >= 2)
-                GetLog() << "  count " << count << "  NormHE " << norm_HE << "\n";
+            m_iterationsEAS++;
         }
 
         // Accumulate internal force
@@ -653,6 +691,254 @@ void ChElementShellANCF::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
     }
 }
 
+// -----------------------------------------------------------------------------
+// Batched Gauss point kernel for the internal forces
+// -----------------------------------------------------------------------------
+
+void ChElementShellANCF::SetupGaussPointBatch() {
+    // Same 2x2x2 Gauss points and ordering as ChQuadrature::Integrate3D with order 2
+    const std::vector<double>& roots = ChQuadrature::GetStaticTables()->Lroots[1];
+    const std::vector<double>& weights = ChQuadrature::GetStaticTables()->Weight[1];
+
+    m_gaussBatch.resize(m_numLayers);
+
+    for (size_t kl = 0; kl < m_numLayers; kl++) {
+        GaussPointBatch& batch = m_gaussBatch[kl];
+        const ChMatrixNM<double, 6, 6>& T0 = m_layers[kl].Get_T0();
+        const ChMatrixNM<double, 6, 6>& E_eps = m_layers[kl].GetMaterial()->Get_E_eps();
+        double detJ0C = m_layers[kl].Get_detJ0C();
+        double theta = m_layers[kl].Get_theta();
+        double Zc1 = (m_GaussZ[kl + 1] - m_GaussZ[kl]) / 2;
+        double Zc2 = (m_GaussZ[kl + 1] + m_GaussZ[kl]) / 2;
+
+        batch.KalphaEAS.Reset();
+
+        int g = 0;
+        for (int ix = 0; ix < 2; ix++) {
+            for (int iy = 0; iy < 2; iy++) {
+                for (int iz = 0; iz < 2; iz++, g++) {
+                    double x = roots[ix];
+                    double y = roots[iy];
+                    double z = Zc1 * roots[iz] + Zc2;
+
+                    ChMatrixNM<double, 1, 8> N;
+                    ChMatrixNM<double, 1, 8> Nx;
+                    ChMatrixNM<double, 1, 8> Ny;
+                    ChMatrixNM<double, 1, 8> Nz;
+                    ChMatrixNM<double, 1, 3> Nx_d0;
+                    ChMatrixNM<double, 1, 3> Ny_d0;
+                    ChMatrixNM<double, 1, 3> Nz_d0;
+                    ChMatrixNM<double, 1, 4> S_ANS;
+                    ChMatrixNM<double, 6, 5> M;
+                    ShapeFunctions(N, x, y, z);
+                    double detJ0 = Calc_detJ0(x, y, z, Nx, Ny, Nz, Nx_d0, Ny_d0, Nz_d0);
+                    ShapeFunctionANSbilinearShell(S_ANS, x, y);
+                    Basis_M(M, x, y, z);
+
+                    batch.w[g] = weights[ix] * weights[iy] * weights[iz] * Zc1 * detJ0 * m_GaussScaling;
+
+                    for (int i = 0; i < 8; i++) {
+                        batch.N[i][g] = N(0, i);
+                        batch.Nx[i][g] = Nx(0, i);
+                        batch.Ny[i][g] = Ny(0, i);
+                    }
+                    for (int i = 0; i < 4; i++)
+                        batch.S_ANS[i][g] = S_ANS(0, i);
+
+                    // In-plane strain terms of the initial configuration (Nx*d0*d0'*Nx', etc.)
+                    ChVector<> rx0(Nx_d0(0, 0), Nx_d0(0, 1), Nx_d0(0, 2));
+                    ChVector<> ry0(Ny_d0(0, 0), Ny_d0(0, 1), Ny_d0(0, 2));
+                    ChVector<> rz0(Nz_d0(0, 0), Nz_d0(0, 1), Nz_d0(0, 2));
+                    batch.strain0[0][g] = 0.5 * Vdot(rx0, rx0);
+                    batch.strain0[1][g] = 0.5 * Vdot(ry0, ry0);
+                    batch.strain0[2][g] = Vdot(rx0, ry0);
+
+                    // Tangent frame, rotated by the fiber angle, and rows of the inverse of the
+                    // initial position vector gradient (see MyForce::Evaluate)
+                    ChVector<> A1 = rx0.GetNormalized();
+                    ChVector<> A3 = Vcross(rx0, ry0).GetNormalized();
+                    ChVector<> A2 = Vcross(A3, A1);
+                    ChVector<> AA1 = A1 * cos(theta) + A2 * sin(theta);
+                    ChVector<> AA2 = -A1 * sin(theta) + A2 * cos(theta);
+                    ChVector<> AA3 = A3;
+                    ChVector<> j01 = Vcross(ry0, rz0) / detJ0;
+                    ChVector<> j02 = Vcross(rz0, rx0) / detJ0;
+                    ChVector<> j03 = Vcross(rx0, ry0) / detJ0;
+
+                    double b[9] = {Vdot(AA1, j01), Vdot(AA2, j01), Vdot(AA3, j01),
+                                   Vdot(AA1, j02), Vdot(AA2, j02), Vdot(AA3, j02),
+                                   Vdot(AA1, j03), Vdot(AA2, j03), Vdot(AA3, j03)};
+
+                    // Orthotropic transformation: strain = T * strain_til
+                    for (int r = 0; r < 3; r++) {
+                        // Normal components (xx, yy, zz in the fiber frame)
+                        int row = (r == 0) ? 0 : ((r == 1) ? 1 : 3);
+                        batch.T[row][0][g] = b[r] * b[r];
+                        batch.T[row][1][g] = b[3 + r] * b[3 + r];
+                        batch.T[row][2][g] = b[r] * b[3 + r];
+                        batch.T[row][3][g] = b[6 + r] * b[6 + r];
+                        batch.T[row][4][g] = b[r] * b[6 + r];
+                        batch.T[row][5][g] = b[3 + r] * b[6 + r];
+                    }
+                    const int shear[3][3] = {{2, 0, 1}, {4, 0, 2}, {5, 1, 2}};
+                    for (int s = 0; s < 3; s++) {
+                        // Shear components (xy, xz, yz in the fiber frame)
+                        int row = shear[s][0];
+                        int p = shear[s][1];
+                        int q = shear[s][2];
+                        batch.T[row][0][g] = 2 * b[p] * b[q];
+                        batch.T[row][1][g] = 2 * b[3 + p] * b[3 + q];
+                        batch.T[row][2][g] = b[q] * b[3 + p] + b[p] * b[3 + q];
+                        batch.T[row][3][g] = 2 * b[6 + p] * b[6 + q];
+                        batch.T[row][4][g] = b[q] * b[6 + p] + b[p] * b[6 + q];
+                        batch.T[row][5][g] = b[3 + q] * b[6 + p] + b[3 + p] * b[6 + q];
+                    }
+
+                    // Enhanced Assumed Strain interpolation and its (constant) contribution to the EAS Jacobian
+                    ChMatrixNM<double, 6, 5> G = T0 * M * (detJ0C / detJ0);
+                    ChMatrixNM<double, 6, 5> EG = E_eps * G;
+                    ChMatrixNM<double, 5, 5> GtEG;
+                    GtEG.MatrTMultiply(G, EG);
+                    GtEG *= batch.w[g];
+                    batch.KalphaEAS += GtEG;
+
+                    for (int r = 0; r < 6; r++) {
+                        for (int a = 0; a < 5; a++) {
+                            batch.G[r][a][g] = G(r, a);
+                            batch.EGw[r][a][g] = EG(r, a) * batch.w[g];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Evaluate the integrand of MyForce at all 8 Gauss points of a layer at once. Reference-configuration
+// quantities come from the cached GaussPointBatch; all per-point loops run over the innermost (point)
+// index of fixed length 8, which the compiler maps onto SIMD registers.
+void ChElementShellANCF::ComputeLayerForcesBatched(size_t kl,
+                                                   ChMatrixNM<double, 24, 1>& F0,
+                                                   ChMatrixNM<double, 24, 5>& FG,
+                                                   ChMatrixNM<double, 5, 1>& HE0) {
+    const int NP = 8;
+    const GaussPointBatch& b = m_gaussBatch[kl];
+    const ChMatrixNM<double, 6, 6>& E_eps = m_layers[kl].GetMaterial()->Get_E_eps();
+
+    // Current position vector gradients: rx = Nx * d, ry = Ny * d
+    double rx[3][NP];
+    double ry[3][NP];
+    for (int k = 0; k < 3; k++) {
+        for (int g = 0; g < NP; g++) {
+            rx[k][g] = 0;
+            ry[k][g] = 0;
+        }
+        for (int i = 0; i < 8; i++) {
+            double dik = m_d(i, k);
+            for (int g = 0; g < NP; g++) {
+                rx[k][g] += b.Nx[i][g] * dik;
+                ry[k][g] += b.Ny[i][g] * dik;
+            }
+        }
+    }
+
+    // Strain components (before orthotropic transformation), including ANS
+    double strain_til[6][NP];
+    for (int g = 0; g < NP; g++) {
+        strain_til[0][g] = 0.5 * (rx[0][g] * rx[0][g] + rx[1][g] * rx[1][g] + rx[2][g] * rx[2][g]) - b.strain0[0][g];
+        strain_til[1][g] = 0.5 * (ry[0][g] * ry[0][g] + ry[1][g] * ry[1][g] + ry[2][g] * ry[2][g]) - b.strain0[1][g];
+        strain_til[2][g] = (rx[0][g] * ry[0][g] + rx[1][g] * ry[1][g] + rx[2][g] * ry[2][g]) - b.strain0[2][g];
+        strain_til[3][g] = b.N[0][g] * m_strainANS(0, 0) + b.N[2][g] * m_strainANS(1, 0) +
+                           b.N[4][g] * m_strainANS(2, 0) + b.N[6][g] * m_strainANS(3, 0);
+        strain_til[4][g] = b.S_ANS[2][g] * m_strainANS(6, 0) + b.S_ANS[3][g] * m_strainANS(7, 0);
+        strain_til[5][g] = b.S_ANS[0][g] * m_strainANS(4, 0) + b.S_ANS[1][g] * m_strainANS(5, 0);
+    }
+
+    // For orthotropic material
+    double strain[6][NP];
+    for (int r = 0; r < 6; r++) {
+        for (int g = 0; g < NP; g++)
+            strain[r][g] = 0;
+        for (int c = 0; c < 6; c++)
+            for (int g = 0; g < NP; g++)
+                strain[r][g] += b.T[r][c][g] * strain_til[c][g];
+    }
+
+    // Strain derivatives (one column at a time), with orthotropic transformation
+    double strainD[6][24][NP];
+    for (int col = 0; col < 24; col++) {
+        int i = col / 3;
+        int k = col % 3;
+        double strainD_til[6][NP];
+        for (int g = 0; g < NP; g++) {
+            strainD_til[0][g] = rx[k][g] * b.Nx[i][g];
+            strainD_til[1][g] = ry[k][g] * b.Ny[i][g];
+            strainD_til[2][g] = ry[k][g] * b.Nx[i][g] + rx[k][g] * b.Ny[i][g];
+            strainD_til[3][g] = b.N[0][g] * m_strainANS_D(0, col) + b.N[2][g] * m_strainANS_D(1, col) +
+                                b.N[4][g] * m_strainANS_D(2, col) + b.N[6][g] * m_strainANS_D(3, col);
+            strainD_til[4][g] = b.S_ANS[2][g] * m_strainANS_D(6, col) + b.S_ANS[3][g] * m_strainANS_D(7, col);
+            strainD_til[5][g] = b.S_ANS[0][g] * m_strainANS_D(4, col) + b.S_ANS[1][g] * m_strainANS_D(5, col);
+        }
+        for (int r = 0; r < 6; r++) {
+            for (int g = 0; g < NP; g++)
+                strainD[r][col][g] = 0;
+            for (int c = 0; c < 6; c++)
+                for (int g = 0; g < NP; g++)
+                    strainD[r][col][g] += b.T[r][c][g] * strainD_til[c][g];
+        }
+    }
+
+    // Add structural damping (strain time derivative)
+    if (m_Alpha != 0) {
+        for (int col = 0; col < 24; col++) {
+            double vel = m_Alpha * m_d_dt(col, 0);
+            for (int r = 0; r < 6; r++)
+                for (int g = 0; g < NP; g++)
+                    strain[r][g] += strainD[r][col][g] * vel;
+        }
+    }
+
+    // Weighted stresses
+    double stress[6][NP];
+    for (int r = 0; r < 6; r++) {
+        for (int g = 0; g < NP; g++)
+            stress[r][g] = 0;
+        for (int c = 0; c < 6; c++) {
+            double E_rc = E_eps(r, c);
+            for (int g = 0; g < NP; g++)
+                stress[r][g] += E_rc * strain[c][g];
+        }
+        for (int g = 0; g < NP; g++)
+            stress[r][g] *= b.w[g];
+    }
+
+    // Reduce over the Gauss points: F0 = sum(strainD' * stress), FG = sum(strainD' * E * G),
+    // HE0 = sum(G' * stress)
+    for (int col = 0; col < 24; col++) {
+        double f = 0;
+        for (int r = 0; r < 6; r++)
+            for (int g = 0; g < NP; g++)
+                f += strainD[r][col][g] * stress[r][g];
+        F0(col, 0) = f;
+
+        for (int a = 0; a < 5; a++) {
+            double fg = 0;
+            for (int r = 0; r < 6; r++)
+                for (int g = 0; g < NP; g++)
+                    fg += strainD[r][col][g] * b.EGw[r][a][g];
+            FG(col, a) = fg;
+        }
+    }
+
+    for (int a = 0; a < 5; a++) {
+        double he = 0;
+        for (int r = 0; r < 6; r++)
+            for (int g = 0; g < NP; g++)
+                he += b.G[r][a][g] * stress[r][g];
+        HE0(a, 0) = he;
+    }
+}
+
 // -----------------------------------------------------------------------------
 // Jacobians of internal forces
 // -----------------------------------------------------------------------------
@@ -915,7 +1201,7 @@ void MyJacobian::Evaluate(ChMatrixNM<double, 696, 1>& result, const double x, co
                          strainD_til(5, ii) * (beta(4) * beta(6) + beta(3) * beta(7));
         strainD(3, ii) = strainD_til(0, ii) * beta(2) * beta(2) + strainD_til(1, ii) * beta(5) * beta(5) +
                          strainD_til(2, ii) * beta(2) * beta(5) + strainD_til(3, ii) * beta(8) * beta(8) +
-                         strainD_til(4, ii) * beta(2) * beta(8) + strainD_til(5) * beta(5) * beta(8);
+                         strainD_til(4, ii) * beta(2) * beta(8) + strainD_til(5, ii) * beta(5) * beta(8);
         strainD(4, ii) = strainD_til(0, ii) * 2.0 * beta(0) * beta(2) + strainD_til(1, ii) * 2.0 * beta(3) * beta(5) +
                          strainD_til(2, ii) * (beta(2) * beta(3) + beta(0) * beta(5)) +
                          strainD_til(3, ii) * 2.0 * beta(6) * beta(8) +
@@ -181,6 +181,41 @@ class ChApiFea ChElementShellANCF : public ChElementShell, public ChLoadableUV,
     /// Get the total thickness of the shell element.
     double GetThickness() { return m_thickness; }
 
+    /// Enable/disable the batched Gauss point kernel for the internal forces (default: true).
+    /// If disabled, the internal forces are integrated with the generic ChQuadrature functor
+    /// (re-evaluated at each EAS iteration); this is mostly useful for benchmarking and debugging.
+    void SetBatchedGaussPoints(bool val) { m_batched = val; }
+
+    /// Return true if the batched Gauss point kernel is used for the internal forces.
+    bool GetBatchedGaussPoints() const { return m_batched; }
+
+    /// Set the tolerance (on the residual norm) of the nonlinear EAS solver (default: 1e-5).
+    void SetEASTolerance(double tol) { m_toleranceEAS = tol; }
+
+    /// Set the maximum number of nonlinear EAS iterations (default: 100).
+    void SetEASMaxIterations(int iters) { m_maxIterationsEAS = iters; }
+
+    /// Enable freezing of the EAS parameters (default: 0, disabled).
+    /// If the EAS solve of a layer converged at the previous call, its parameters are reused
+    /// without Newton iterations as long as the residual stays below the given freeze tolerance
+    /// (which should be larger than the EAS tolerance); once exceeded, the layer is solved again
+    /// down to the EAS tolerance.
+    void SetEASFreezeTolerance(double tol) { m_freezeToleranceEAS = tol; }
+
+    /// Number of EAS Newton iterations performed since the last call to ResetEASStatistics().
+    long GetEASIterations() const { return m_iterationsEAS; }
+
+    /// Number of EAS solves (one per layer at each internal force evaluation) since the last
+    /// call to ResetEASStatistics(). GetEASIterations()/GetEASSolves() is the average number
+    /// of EAS iterations per solve.
+    long GetEASSolves() const { return m_solvesEAS; }
+
+    /// Reset the EAS iteration counters.
+    void ResetEASStatistics() {
+        m_iterationsEAS = 0;
+        m_solvesEAS = 0;
+    }
+
     // Shape functions
     // ---------------
 
@@ -232,8 +267,43 @@ class ChApiFea ChElementShellANCF : public ChElementShell, public ChLoadableUV,
     std::vector<ChMatrixNM<double, 5, 1> > m_alphaEAS;     ///< EAS parameters (5 per layer)
     std::vector<ChMatrixNM<double, 5, 5> > m_KalphaEAS;    ///< EAS Jacobians (a 5x5 matrix per layer)
 
-    static const double m_toleranceEAS;   ///< tolerance for nonlinear EAS solver (on residual)
-    static const int m_maxIterationsEAS;  ///< maximum number of nonlinear EAS iterations
+    std::vector<char> m_convergedEAS;                      ///< EAS solve of each layer converged at last call
+
+    double m_toleranceEAS;        ///< tolerance for nonlinear EAS solver (on residual)
+    int m_maxIterationsEAS;       ///< maximum number of nonlinear EAS iterations
+    double m_freezeToleranceEAS;  ///< residual below which converged EAS parameters are reused
+    long m_iterationsEAS;         ///< EAS iterations counter
+    long m_solvesEAS;             ///< EAS solves counter
+
+    /// Reference-configuration quantities at the 2x2x2 Gauss points of one layer.
+    /// Per-point values are stored with the Gauss point index last (structure of arrays), so that
+    /// the batched internal force kernel works on contiguous data and its inner loops vectorize.
+    struct GaussPointBatch {
+        double w[8];                          ///< quadrature weight times detJ0 and interval scaling
+        double N[8][8];                       ///< shape functions
+        double Nx[8][8];                      ///< shape function derivatives with respect to X
+        double Ny[8][8];                      ///< shape function derivatives with respect to Y
+        double S_ANS[4][8];                   ///< ANS interpolation functions
+        double strain0[3][8];                 ///< in-plane strain terms of the initial configuration
+        double T[6][6][8];                    ///< orthotropic strain transformation (from beta)
+        double G[6][5][8];                    ///< EAS interpolation matrix
+        double EGw[6][5][8];                  ///< E_eps * G, scaled by the point weight
+        ChMatrixNM<double, 5, 5> KalphaEAS;  ///< EAS Jacobian (constant, integrated over the layer)
+    };
+
+    bool m_batched;                              ///< use the batched Gauss point kernel?
+    std::vector<GaussPointBatch> m_gaussBatch;  ///< cached Gauss point data (one set per layer)
+
+    /// Precompute the Gauss point data used by the batched internal force kernel.
+    void SetupGaussPointBatch();
+
+    /// Batched evaluation of the internal force integrands of the specified layer at all its Gauss points.
+    /// The integrals are split in the parts that do not depend on the EAS parameters alpha, such that
+    ///   Fint = F0 + FG * alpha,  HE = HE0 + KalphaEAS * alpha.
+    void ComputeLayerForcesBatched(size_t kl,
+                                   ChMatrixNM<double, 24, 1>& F0,
+                                   ChMatrixNM<double, 24, 5>& FG,
+                                   ChMatrixNM<double, 5, 1>& HE0);
 
 public:
     // Interface to ChElementBase base class
@@ -15,7 +15,7 @@
 namespace chrono {
 namespace fea {
 
-ChElementTetra_4::ChElementTetra_4() {
+ChElementTetra_4::ChElementTetra_4() : corot_valid(false), corot_tolerance(0) {
     nodes.resize(4);
     this->MatrB.Resize(6, 12);
     this->StiffnessMatrix.Resize(12, 12);
@@ -13,6 +13,7 @@
 #ifndef CHELEMENTTETRA4_H
 #define CHELEMENTTETRA4_H
 
+#include <algorithm>
 #include <cmath>
 
 #include "chrono/physics/ChTensors.h"
@@ -39,6 +40,11 @@ class ChApiFea ChElementTetra_4 : public ChElementTetrahedron, public ChLoadable
 
     ChMatrixNM<double, 4, 4> mM;  // for speeding up corotational approach
 
+    ChMatrixNM<double, 12, 12> StiffnessMatrixCorot;  // cached corotated stiffness matrix C*K*C'
+    ChMatrix33<> A_corot;                             // rotation used for StiffnessMatrixCorot
+    bool corot_valid;                                 // false if StiffnessMatrixCorot must be recomputed
+    double corot_tolerance;                           // tolerance on A for reusing StiffnessMatrixCorot
+
   public:
     ChElementTetra_4();
     virtual ~ChElementTetra_4();
@@ -114,6 +120,7 @@ class ChApiFea ChElementTetra_4 : public ChElementTetrahedron, public ChLoadable
 
     /// Computes the local STIFFNESS MATRIX of the element:
     /// K = Volume * [B]' * [D] * [B]
+    /// Invalidates the cached corotated stiffness matrix.
     virtual void ComputeStiffnessMatrix() {
         // M = [ X0_0 X0_1 X0_2 X0_3 ] ^-1
         //     [ 1    1    1    1    ]
@@ -192,6 +199,8 @@ class ChApiFea ChElementTetra_4 : public ChElementTetrahedron, public ChLoadable
         if (max_err > 1e-10)
             GetLog() << "NONSYMMETRIC local stiffness matrix! err " << max_err << " at " << err_r << "," << err_c
                      << "\n";
+
+        corot_valid = false;
     }
 
     /// set up the element's parameters and matrices
@@ -232,97 +241,56 @@ class ChApiFea ChElementTetra_4 : public ChElementTetrahedron, public ChLoadable
         // GetLog() << "FEM rotation: \n" << A << "\n" ;
     }
 
-    /// Sets H as the global stiffness matrix K, scaled  by Kfactor. Optionally, also
-    /// superimposes global damping matrix R, scaled by Rfactor, and global mass matrix M multiplied by Mfactor.
-    virtual void ComputeKRMmatricesGlobal(ChMatrix<>& H, double Kfactor, double Rfactor = 0, double Mfactor = 0) {
-        assert((H.GetRows() == 12) && (H.GetColumns() == 12));
+    /// Set the tolerance for reusing the cached corotated stiffness matrix C*K*C'.
+    /// The cached matrix is recomputed only if some entry of the rotation matrix A changed by more than
+    /// this value since the last computation. With the default value (0), the cached matrix is reused
+    /// only as long as the rotation does not change (e.g. across calls within the same state update).
+    void SetCorotationTolerance(double tol) { corot_tolerance = tol; }
+
+    /// Get the tolerance for reusing the cached corotated stiffness matrix.
+    double GetCorotationTolerance() const { return corot_tolerance; }
+
+    /// Update the cached corotated stiffness matrix C*K*C', unless the rotation A is within the
+    /// corotation tolerance of the one used for the cached matrix.
+    void UpdateCorotatedStiffness() {
+        if (corot_valid) {
+            double max_diff = 0;
+            for (int row = 0; row < 3; ++row)
+                for (int col = 0; col < 3; ++col)
+                    max_diff = std::max(max_diff, std::abs(A(row, col) - A_corot(row, col)));
+            if (max_diff <= corot_tolerance)
+                return;
+        }
 
         // warp the local stiffness matrix K in order to obtain global
         // tangent stiffness CKCt:
-        ChMatrixDynamic<> CK(12, 12);
-        ChMatrixDynamic<> CKCt(12, 12);  // the global, corotated, K matrix
+        ChMatrixNM<double, 12, 12> CK;
         ChMatrixCorotation<>::ComputeCK(StiffnessMatrix, this->A, 4, CK);
-        ChMatrixCorotation<>::ComputeKCt(CK, this->A, 4, CKCt);
-        /*
-        // ***TEST***
-        ChMatrixDynamic<> testCKCt(12,12);
-        ChMatrixDynamic<> mC(12,12);
-        mC.PasteMatrix(&this->A,0,0);
-        mC.PasteMatrix(&this->A,3,3);
-        mC.PasteMatrix(&this->A,6,6);
-        mC.PasteMatrix(&this->A,9,9);
-        CK.MatrMultiply(mC,StiffnessMatrix);
-        testCKCt.MatrMultiplyT(CK,mC);
-        ChMatrixDynamic<> mdiff = testCKCt - CKCt;
-        double maxerr=0;
-        for (int row = 0; row < mdiff.GetRows()-1; ++row)
-            for (int col = 0; col < mdiff.GetColumns(); ++col)
-                if (fabs(mdiff(col,row)) > maxerr ) maxerr =  fabs(mdiff(col,row));
-        if (maxerr > 0)
-            GetLog() << " !!!corotation symmetry error!!!! "  << maxerr << "\n";
-        */
+        ChMatrixCorotation<>::ComputeKCt(CK, this->A, 4, StiffnessMatrixCorot);
 
         // ***TEST*** SYMMETRIZE TO AVOID ROUNDOFF ASYMMETRY
-        for (int row = 0; row < CKCt.GetRows() - 1; ++row)
-            for (int col = row + 1; col < CKCt.GetColumns(); ++col)
-                CKCt(row, col) = CKCt(col, row);
+        for (int row = 0; row < 11; ++row)
+            for (int col = row + 1; col < 12; ++col)
+                StiffnessMatrixCorot(row, col) = StiffnessMatrixCorot(col, row);
 
-        //***DEBUG***
-        double max_err = 0;
-        int err_r = -1;
-        int err_c = -1;
-        for (int row = 0; row < StiffnessMatrix.GetRows(); ++row)
-            for (int col = 0; col < StiffnessMatrix.GetColumns(); ++col) {
-                double diff = fabs(StiffnessMatrix.GetElement(row, col) - StiffnessMatrix.GetElement(col, row));
-                if (diff > max_err) {
-                    max_err = diff;
-                    err_r = row;
-                    err_c = col;
-                }
-            }
-        if (max_err > 1e-10)
-            GetLog() << "NONSYMMETRIC local stiffness matrix! err " << max_err << " at " << err_r << "," << err_c
-                     << "\n";
-        max_err = 0;
-        err_r = -1;
-        err_c = -1;
-        double maxval = 0;
-        for (int row = 0; row < CKCt.GetRows(); ++row)
-            for (int col = 0; col < CKCt.GetColumns(); ++col) {
-                double diff = fabs(CKCt.GetElement(row, col) - CKCt.GetElement(col, row));
-                if (diff > max_err) {
-                    max_err = diff;
-                    err_r = row;
-                    err_c = col;
-                }
-                if (CKCt.GetElement(row, col) > maxval)
-                    maxval = CKCt.GetElement(row, col);
-            }
-        if (max_err > 1e-10)
-            GetLog() << "NONSYMMETRIC corotated matrix! err " << max_err << " at " << err_r << "," << err_c
-                     << ",   maxval=" << maxval << "\n";
-
-        // DEBUG
-        /*
-        ChMatrixDynamic<> Ctest(12,12);
-        Ctest.PasteMatrix(&A,0,0);
-        Ctest.PasteMatrix(&A,3,3);
-        Ctest.PasteMatrix(&A,6,6);
-        Ctest.PasteMatrix(&A,9,9);
-        ChMatrixDynamic<> CKtest(12,12);
-        CKtest.MatrMultiply(Ctest,StiffnessMatrix);
-        ChMatrixDynamic<> CKCttest(12,12);
-        CKCttest.MatrMultiplyT(CKtest,Ctest);
-        GetLog() << "CKCt difference \n" << CKCt-CKCttest << "\n";
-        */
-
-        // For K stiffness matrix and R damping matrix:
+        A_corot = this->A;
+        corot_valid = true;
+    }
 
-        double mkfactor = Kfactor + Rfactor * this->GetMaterial()->Get_RayleighDampingK();
+    /// Sets H as the global stiffness matrix K, scaled  by Kfactor. Optionally, also
+    /// superimposes global damping matrix R, scaled by Rfactor, and global mass matrix M multiplied by Mfactor.
+    virtual void ComputeKRMmatricesGlobal(ChMatrix<>& H, double Kfactor, double Rfactor = 0, double Mfactor = 0) {
+        assert((H.GetRows() == 12) && (H.GetColumns() == 12));
+
+        // For K stiffness matrix and R damping matrix (corotated stiffness is cached):
 
-        CKCt.MatrScale(mkfactor);
+        UpdateCorotatedStiffness();
 
-        H.PasteMatrix(&CKCt, 0, 0);
+        double mkfactor = Kfactor + Rfactor * this->GetMaterial()->Get_RayleighDampingK();
+
+        for (int row = 0; row < 12; ++row)
+            for (int col = 0; col < 12; ++col)
+                H(row, col) = mkfactor * StiffnessMatrixCorot(row, col);
 
         // For M mass matrix:
         if (Mfactor) {
@@ -342,18 +310,20 @@ class ChApiFea ChElementTetra_4 : public ChElementTetrahedron, public ChLoadable
         assert((Fi.GetRows() == 12) && (Fi.GetColumns() == 1));
 
         // set up vector of nodal displacements (in local element system) u_l = R*p - p0
-        ChMatrixDynamic<> displ(12, 1);
-        this->GetStateBlock(displ);  // nodal displacements, local
+        // (fixed-size temporaries: no heap allocations here)
+        ChMatrixNM<double, 12, 1> displ;
+        for (int in = 0; in < 4; ++in)
+            displ.PasteVector(A.MatrT_x_Vect(nodes[in]->pos) - nodes[in]->GetX0(), in * 3, 0);
 
         // [local Internal Forces] = [Klocal] * displ + [Rlocal] * displ_dt
-        ChMatrixDynamic<> FiK_local(12, 1);
+        ChMatrixNM<double, 12, 1> FiK_local;
         FiK_local.MatrMultiply(StiffnessMatrix, displ);
 
         displ.PasteVector(A.MatrT_x_Vect(nodes[0]->pos_dt), 0, 0);  // nodal speeds, local
         displ.PasteVector(A.MatrT_x_Vect(nodes[1]->pos_dt), 3, 0);
         displ.PasteVector(A.MatrT_x_Vect(nodes[2]->pos_dt), 6, 0);
         displ.PasteVector(A.MatrT_x_Vect(nodes[3]->pos_dt), 9, 0);
-        ChMatrixDynamic<> FiR_local(12, 1);
+        ChMatrixNM<double, 12, 1> FiR_local;
         FiR_local.MatrMultiply(StiffnessMatrix, displ);
         FiR_local.MatrScale(this->Material->Get_RayleighDampingK());
 
@@ -370,6 +340,19 @@ class ChApiFea ChElementTetra_4 : public ChElementTetrahedron, public ChLoadable
         ChMatrixCorotation<>::ComputeCK(FiK_local, this->A, 4, Fi);
     }
 
+    /// Adds M*w to R, scaled by c. The mass is lumped (as in ComputeKRMmatricesGlobal), so there
+    /// is no need to build the mass matrix as in the default implementation of ChElementGeneric.
+    virtual void EleIntLoadResidual_Mv(ChVectorDynamic<>& R, const ChVectorDynamic<>& w, const double c) override {
+        double lumped_node_mass = (this->GetVolume() * this->Material->Get_density()) / 4.0;
+        for (int in = 0; in < 4; ++in) {
+            if (nodes[in]->GetFixed())
+                continue;
+            unsigned int offset = nodes[in]->NodeGetOffset_w();
+            for (int i = 0; i < 3; ++i)
+                R(offset + i) += c * lumped_node_mass * w(offset + i);
+        }
+    }
+
     //
     // Custom properties functions
     //
@@ -13,11 +13,13 @@
 // =============================================================================
 
 #include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <functional>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 
 #include "chrono/core/ChMath.h"
 #include "chrono/physics/ChLoad.h"
@@ -45,6 +47,10 @@ ChMesh::ChMesh(const ChMesh& other) : ChIndexedNodes(other) {
 
     automatic_gravity_load = other.automatic_gravity_load;
     num_points_gravity = other.num_points_gravity;
+    gravity_num_points = 0;  // the cached gravity loads are not copied
+
+    element_colors = other.element_colors;
+    element_colors_valid = other.element_colors_valid;
 
     ncalls_internal_forces = 0;
     ncalls_KRMload = 0;
@@ -66,6 +72,155 @@ void ChMesh::SetupInitial() {
         //    - precompute matrices, such as the [Kl] local stiffness of each element, if needed, etc.
         velements[i]->SetupInitial(GetSystem());
     }
+
+    //    - group elements in colours for the parallel assembly of nodal terms
+    ComputeElementColors();
+}
+
+void ChMesh::ComputeElementColors() {
+    // For each node, the colours of the elements already coloured that use it.
+    std::unordered_map<ChNodeFEAbase*, std::vector<unsigned int> > node_colors;
+    node_colors.reserve(vnodes.size());
+
+    std::vector<char> taken;
+    element_colors.clear();
+
+    for (unsigned int ie = 0; ie < velements.size(); ie++) {
+        // Mark the colours used by neighbouring elements...
+        taken.assign(element_colors.size() + 1, false);
+        for (int in = 0; in < velements[ie]->GetNnodes(); in++) {
+            const std::vector<unsigned int>& used = node_colors[velements[ie]->GetNodeN(in).get()];
+            for (unsigned int k = 0; k < used.size(); k++)
+                taken[used[k]] = true;
+        }
+
+        // ...and pick the first free one.
+        unsigned int color = 0;
+        while (taken[color])
+            color++;
+        if (color == element_colors.size())
+            element_colors.push_back(std::vector<unsigned int>());
+        element_colors[color].push_back(ie);
+
+        for (int in = 0; in < velements[ie]->GetNnodes(); in++) {
+            node_colors[velements[ie]->GetNodeN(in).get()].push_back(color);
+        }
+    }
+
+    element_colors_valid = true;
+}
+
+void ChMesh::RenumberNodes() {
+    unsigned int nnodes = (unsigned int)vnodes.size();
+    std::unordered_map<ChNodeFEAbase*, unsigned int> node_index;
+    node_index.reserve(nnodes);
+    for (unsigned int i = 0; i < nnodes; i++)
+        node_index[vnodes[i].get()] = i;
+
+    // Node adjacency graph, in compressed row format: two nodes are adjacent if they share an element.
+    std::vector<std::vector<unsigned int> > element_nodes(velements.size());
+    std::vector<unsigned int> degree(nnodes, 0);
+    for (unsigned int ie = 0; ie < velements.size(); ie++) {
+        for (int in = 0; in < velements[ie]->GetNnodes(); in++) {
+            auto it = node_index.find(velements[ie]->GetNodeN(in).get());
+            if (it != node_index.end())
+                element_nodes[ie].push_back(it->second);
+        }
+        for (unsigned int k = 0; k < element_nodes[ie].size(); k++)
+            degree[element_nodes[ie][k]] += (unsigned int)element_nodes[ie].size() - 1;
+    }
+    std::vector<unsigned int> adj_start(nnodes + 1, 0);
+    for (unsigned int i = 0; i < nnodes; i++)
+        adj_start[i + 1] = adj_start[i] + degree[i];
+    std::vector<unsigned int> adj(adj_start[nnodes]);
+    std::vector<unsigned int> fill(adj_start.begin(), adj_start.end() - 1);
+    for (unsigned int ie = 0; ie < velements.size(); ie++)
+        for (unsigned int a = 0; a < element_nodes[ie].size(); a++)
+            for (unsigned int b = 0; b < element_nodes[ie].size(); b++)
+                if (a != b)
+                    adj[fill[element_nodes[ie][a]]++] = element_nodes[ie][b];
+    // remove the duplicates (nodes shared by more elements), and compute the true degrees
+    for (unsigned int i = 0; i < nnodes; i++) {
+        std::sort(adj.begin() + adj_start[i], adj.begin() + adj_start[i + 1]);
+        degree[i] = (unsigned int)(std::unique(adj.begin() + adj_start[i], adj.begin() + adj_start[i + 1]) -
+                                   (adj.begin() + adj_start[i]));
+    }
+
+    // Breadth first visit from 'root', with neighbours in increasing degree order (Cuthill-McKee).
+    // Appends the visited nodes to 'order'; returns the number of levels and the index in 'order'
+    // of the first node of the last level.
+    std::vector<char> visited(nnodes, false);
+    std::vector<unsigned int> order;
+    order.reserve(nnodes);
+    auto visit = [&](unsigned int root, size_t& last_level) {
+        size_t depth = 1;
+        last_level = order.size();
+        order.push_back(root);
+        visited[root] = true;
+        size_t level_end = order.size();
+        for (size_t head = last_level; head < order.size(); head++) {
+            if (head == level_end) {
+                depth++;
+                last_level = head;
+                level_end = order.size();
+            }
+            unsigned int node = order[head];
+            size_t children = order.size();
+            for (unsigned int k = adj_start[node]; k < adj_start[node] + degree[node]; k++)
+                if (!visited[adj[k]]) {
+                    visited[adj[k]] = true;
+                    order.push_back(adj[k]);
+                }
+            std::stable_sort(order.begin() + children, order.end(),
+                             [&](unsigned int n1, unsigned int n2) { return degree[n1] < degree[n2]; });
+        }
+        return depth;
+    };
+
+    std::vector<unsigned int> permutation;
+    permutation.reserve(nnodes);
+    std::vector<unsigned int> isolated;
+    for (unsigned int start = 0; start < nnodes; start++) {
+        if (visited[start])
+            continue;
+        if (degree[start] == 0) {
+            visited[start] = true;
+            isolated.push_back(start);
+            continue;
+        }
+        // Find a pseudo-peripheral root of this connected component: restart from the node of
+        // minimum degree in the last level of the visit, as long as the visit gets deeper.
+        unsigned int root = start;
+        size_t depth = 0;
+        for (int iter = 0; iter < 5; iter++) {
+            order.clear();
+            size_t last_level;
+            size_t new_depth = visit(root, last_level);
+            for (size_t k = 0; k < order.size(); k++)
+                visited[order[k]] = false;
+            if (new_depth <= depth)
+                break;
+            depth = new_depth;
+            unsigned int candidate = order[last_level];
+            for (size_t k = last_level; k < order.size(); k++)
+                if (degree[order[k]] < degree[candidate])
+                    candidate = order[k];
+            if (candidate == root)
+                break;
+            root = candidate;
+        }
+        order.clear();
+        size_t last_level;
+        visit(root, last_level);
+        // reversed Cuthill-McKee ordering of the component
+        permutation.insert(permutation.end(), order.rbegin(), order.rend());
+    }
+    permutation.insert(permutation.end(), isolated.begin(), isolated.end());
+
+    std::vector<std::shared_ptr<ChNodeFEAbase> > renumbered(nnodes);
+    for (unsigned int i = 0; i < nnodes; i++)
+        renumbered[i] = vnodes[permutation[i]];
+    vnodes.swap(renumbered);
 }
 
 void ChMesh::Relax() {
@@ -88,17 +243,25 @@ void ChMesh::AddNode(std::shared_ptr<ChNodeFEAbase> m_node) {
 
 void ChMesh::AddElement(std::shared_ptr<ChElementBase> m_elem) {
     velements.push_back(m_elem);
+    ResetColoring();
+    ResetGravityLoads();
 }
 
 void ChMesh::ClearElements() {
     velements.clear();
     vcontactsurfaces.clear();
+    element_colors.clear();
+    ResetColoring();
+    ResetGravityLoads();
 }
 
 void ChMesh::ClearNodes() {
     velements.clear();
     vnodes.clear();
     vcontactsurfaces.clear();
+    element_colors.clear();
+    ResetColoring();
+    ResetGravityLoads();
 }
 
 void ChMesh::AddContactSurface(std::shared_ptr<ChContactSurface> m_surf) {
@@ -247,6 +410,18 @@ void ChMesh::IntLoadResidual_F(const unsigned int off,  // offset in R residual
                                ChVectorDynamic<>& R,    // result: the R residual, R += c*F
                                const double c           // a scaling factor
                                ) {
+    LoadForces(off, R, nullptr, c);
+}
+
+void ChMesh::IntLoadResidual_F_Masked(const unsigned int off,         // offset in R residual
+                                      ChVectorDynamic<>& R,           // result: the R residual, R += c*F
+                                      const ChVectorDynamic<>& mask,  // coordinates that need the forces
+                                      const double c                  // a scaling factor
+                                      ) {
+    LoadForces(off, R, &mask, c);
+}
+
+void ChMesh::LoadForces(const unsigned int off, ChVectorDynamic<>& R, const ChVectorDynamic<>* mask, const double c) {
     // applied nodal forces
     unsigned int local_off_v = 0;
     for (unsigned int j = 0; j < vnodes.size(); j++) {
@@ -257,31 +432,93 @@ void ChMesh::IntLoadResidual_F(const unsigned int off,  // offset in R residual
     }
 
     // internal forces
+    // Elements of the same colour do not share nodes, so they can add their contributions
+    // to R concurrently; the colours are processed in sequence, which also makes the
+    // summation order (and the result) independent of the number of threads.
     timer_internal_forces.start();
+    CheckElementColors();
+    for (unsigned int ic = 0; ic < element_colors.size(); ic++) {
+        const std::vector<unsigned int>& color = element_colors[ic];
 #pragma omp parallel for schedule(dynamic, 4)
-    for (int ie = 0; ie < velements.size(); ie++) {
-        velements[ie]->EleIntLoadResidual_F(R, c);
+        for (int k = 0; k < color.size(); k++) {
+            ChElementBase* element = velements[color[k]].get();
+            if (mask) {
+                // skip the elements whose nodes do not need the forces
+                bool needed = false;
+                for (int in = 0; in < element->GetNnodes() && !needed; in++) {
+                    std::shared_ptr<ChNodeFEAbase> node = element->GetNodeN(in);
+                    needed = !node->GetFixed() && (*mask)(node->NodeGetOffset_w()) != 0;
+                }
+                if (!needed)
+                    continue;
+            }
+            element->EleIntLoadResidual_F(R, c);
+        }
     }
     timer_internal_forces.stop();
     ncalls_internal_forces++;
 
     // Apply gravity loads without the need of adding
-    // a ChLoad object to each element: just instance here a single ChLoad and reuse
-    // it for all 'volume' objects.
+    // a ChLoad object to each element.
     if (automatic_gravity_load) {
-        std::shared_ptr<ChLoadableUVW> mloadable;  // still null
-        auto common_gravity_loader = std::make_shared<ChLoad<ChLoaderGravity>>(mloadable);
-        common_gravity_loader->loader.Set_G_acc(GetSystem()->Get_G_acc());
-        common_gravity_loader->loader.SetNumIntPoints(num_points_gravity);
+        LoadGravity(R, c);
+    }
+}
+
+void ChMesh::LoadGravity(ChVectorDynamic<>& R, const double c) {
+    const ChVector<>& G_acc = GetSystem()->Get_G_acc();
 
+    // Invalidate all cached loads if the elements or the gravity settings changed
+    if (gravity_loads.size() != velements.size() || !(gravity_G_acc == G_acc) ||
+        gravity_num_points != num_points_gravity) {
+        gravity_loadables.resize(velements.size());
         for (unsigned int ie = 0; ie < velements.size(); ie++) {
-            if (mloadable = std::dynamic_pointer_cast<ChLoadableUVW>(velements[ie])) {
-                if (mloadable->GetDensity()) {
-                    // temporary set loader target and compute generalized forces term
-                    common_gravity_loader->loader.loadable = mloadable;
-                    common_gravity_loader->ComputeQ(0, 0);
-                    common_gravity_loader->LoadIntLoadResidual_F(R, c);
-                }
+            gravity_loadables[ie] = dynamic_cast<ChLoadableUVW*>(velements[ie].get());
+        }
+        gravity_loads.assign(velements.size(), ChVectorDynamic<>());
+        gravity_densities.assign(velements.size(), 0);
+        gravity_G_acc = G_acc;
+        gravity_num_points = num_points_gravity;
+    }
+
+    // Instance a single ChLoad, only if some loads must be (re)integrated, and reuse it for all elements
+    std::shared_ptr<ChLoad<ChLoaderGravity> > common_gravity_loader;
+
+    for (unsigned int ie = 0; ie < velements.size(); ie++) {
+        ChLoadableUVW* loadable = gravity_loadables[ie];
+        if (!loadable)
+            continue;
+        double density = loadable->GetDensity();
+        if (!density)
+            continue;
+
+        bool constant = loadable->IsGravityLoadConstant();
+        if (!constant || density != gravity_densities[ie]) {
+            if (!common_gravity_loader) {
+                std::shared_ptr<ChLoadableUVW> mloadable;  // still null
+                common_gravity_loader = std::make_shared<ChLoad<ChLoaderGravity> >(mloadable);
+                common_gravity_loader->loader.Set_G_acc(G_acc);
+                common_gravity_loader->loader.SetNumIntPoints(num_points_gravity);
+            }
+            // temporary set loader target and compute generalized forces term
+            common_gravity_loader->loader.loadable = std::dynamic_pointer_cast<ChLoadableUVW>(velements[ie]);
+            common_gravity_loader->ComputeQ(0, 0);
+            if (!constant) {
+                common_gravity_loader->LoadIntLoadResidual_F(R, c);
+                continue;
+            }
+            gravity_loads[ie] = common_gravity_loader->loader.Q;
+            gravity_densities[ie] = density;
+        }
+
+        // Add the cached load, scattered to the element sub-blocks as in ChLoad::LoadIntLoadResidual_F
+        const ChVectorDynamic<>& Q = gravity_loads[ie];
+        unsigned int rowQ = 0;
+        for (int i = 0; i < loadable->GetSubBlocks(); ++i) {
+            unsigned int moffset = loadable->GetSubBlockOffset(i);
+            for (unsigned int row = 0; row < loadable->GetSubBlockSize(i); ++row) {
+                R(row + moffset) += Q(rowQ) * c;
+                ++rowQ;
             }
         }
     }
@@ -322,10 +559,92 @@ void ChMesh::IntLoadResidual_Mv(const unsigned int off,      ///< offset in R re
         }
     }
 
-    // internal masses
+    // internal masses (same colour-by-colour scheme as for the internal forces)
+    CheckElementColors();
+    for (unsigned int ic = 0; ic < element_colors.size(); ic++) {
+        const std::vector<unsigned int>& color = element_colors[ic];
+#pragma omp parallel for schedule(dynamic, 4)
+        for (int k = 0; k < color.size(); k++) {
+            velements[color[k]]->EleIntLoadResidual_Mv(R, w, c);
+        }
+    }
+}
+
+void ChMesh::IntLoadLumpedMass_Md(const unsigned int off,  ///< offset in Md vector
+                                  ChVectorDynamic<>& Md,   ///< result: Md vector, diagonal of the lumped mass matrix
+                                  double& err,             ///< result: not touched if lumping does not introduce errors
+                                  const double c           ///< a scaling factor
+                                  ) {
+    // nodal masses (diagonal)
+    ChVectorDynamic<> ones(Md.GetRows());
+    ones.FillElem(1.0);
+    unsigned int local_off_v = 0;
+    for (unsigned int j = 0; j < vnodes.size(); j++) {
+        if (!vnodes[j]->GetFixed()) {
+            vnodes[j]->NodeIntLoadResidual_Mv(off + local_off_v, Md, ones, c);
+            local_off_v += vnodes[j]->Get_ndof_w();
+        }
+    }
+
+    // lumped element masses (same colour-by-colour scheme as for the internal forces)
+    CheckElementColors();
+    double error = 0;
+    for (unsigned int ic = 0; ic < element_colors.size(); ic++) {
+        const std::vector<unsigned int>& color = element_colors[ic];
+#pragma omp parallel for schedule(dynamic, 4) reduction(+ : error)
+        for (int k = 0; k < color.size(); k++) {
+            velements[color[k]]->EleIntLoadLumpedMass_Md(Md, error, c);
+        }
+    }
+    err += error;
+}
+
+void ChMesh::ComputeElementStableTimeSteps(std::vector<double>& steps) {
+    steps.resize(velements.size());
+#pragma omp parallel for schedule(dynamic, 4)
+    for (int ie = 0; ie < velements.size(); ie++) {
+        steps[ie] = velements[ie]->GetStableTimeStep();
+    }
+}
+
+void ChMesh::IntLoadStableTimeSteps(const unsigned int off, ChVectorDynamic<>& steps) {
+    unsigned int local_off_v = 0;
+    for (unsigned int j = 0; j < vnodes.size(); j++) {
+        if (!vnodes[j]->GetFixed()) {
+            for (int i = 0; i < vnodes[j]->Get_ndof_w(); i++)
+                steps(off + local_off_v + i) = 0;
+            local_off_v += vnodes[j]->Get_ndof_w();
+        }
+    }
+
+    // each node gets the smallest stable step of the elements that share it
+    std::vector<double> element_steps;
+    ComputeElementStableTimeSteps(element_steps);
     for (unsigned int ie = 0; ie < velements.size(); ie++) {
-        velements[ie]->EleIntLoadResidual_Mv(R, w, c);
+        if (element_steps[ie] <= 0)
+            continue;
+        for (int in = 0; in < velements[ie]->GetNnodes(); in++) {
+            std::shared_ptr<ChNodeFEAbase> node = velements[ie]->GetNodeN(in);
+            if (node->GetFixed())
+                continue;
+            for (int i = 0; i < node->Get_ndof_w(); i++) {
+                double& step = steps(node->NodeGetOffset_w() + i);
+                if (step == 0 || element_steps[ie] < step)
+                    step = element_steps[ie];
+            }
+        }
+    }
+}
+
+double ChMesh::GetStableTimeStep() {
+    std::vector<double> steps;
+    ComputeElementStableTimeSteps(steps);
+    double step = 0;
+    for (unsigned int ie = 0; ie < steps.size(); ie++) {
+        if (steps[ie] > 0 && (step == 0 || steps[ie] < step))
+            step = steps[ie];
     }
+    return step;
 }
 
 void ChMesh::IntToDescriptor(const unsigned int off_v,  ///< offset in v, R
@@ -364,6 +683,7 @@ void ChMesh::InjectKRMmatrices(ChSystemDescriptor& mdescriptor) {
 }
 
 void ChMesh::KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) {
+    // Each element only writes its own ChKblock here, so no colouring is needed.
     timer_KRMload.start();
 #pragma omp parallel for
     for (int ie = 0; ie < velements.size(); ie++)
@@ -21,6 +21,7 @@
 #include "chrono/core/ChTimer.h"
 #include "chrono/physics/ChContinuumMaterial.h"
 #include "chrono/physics/ChIndexedNodes.h"
+#include "chrono/physics/ChLoadable.h"
 #include "chrono/physics/ChMaterialSurface.h"
 #include "chrono_fea/ChContactSurface.h"
 #include "chrono_fea/ChElementBase.h"
@@ -53,6 +54,19 @@ class ChApiFea ChMesh : public ChIndexedNodes {
     bool automatic_gravity_load;
     int num_points_gravity;
 
+    /// Cached generalized gravity loads of the elements, used by the automatic gravity.
+    /// Recomputed if the element list, G, the number of integration points or the density of an element change.
+    std::vector<ChLoadableUVW*> gravity_loadables;       ///< elements that support gravity (null otherwise)
+    std::vector<ChVectorDynamic<> > gravity_loads;       ///< cached gravity load of each element
+    std::vector<double> gravity_densities;               ///< element density used for the cached load
+    ChVector<> gravity_G_acc;                            ///< gravity used for the cached loads
+    int gravity_num_points;                              ///< integration points used for the cached loads
+
+    /// Element indices grouped by colour: no two elements of the same colour share a node,
+    /// so the elements of one colour can load their nodal terms into R concurrently.
+    std::vector<std::vector<unsigned int> > element_colors;
+    bool element_colors_valid;  ///< false if the element topology changed since the colouring was computed
+
     ChTimer<> timer_internal_forces;
     ChTimer<> timer_KRMload;
     int ncalls_internal_forces;
@@ -64,6 +78,8 @@ class ChApiFea ChMesh : public ChIndexedNodes {
           n_dofs_w(0),
           automatic_gravity_load(true),
           num_points_gravity(1),
+          gravity_num_points(0),
+          element_colors_valid(false),
           ncalls_internal_forces(0),
           ncalls_KRMload(0) {}
     ChMesh(const ChMesh& other);
@@ -77,6 +93,15 @@ class ChApiFea ChMesh : public ChIndexedNodes {
     void ClearNodes();
     void ClearElements();
 
+    /// Renumber the nodes of the mesh with the reverse Cuthill-McKee algorithm, that is, reorder
+    /// the array of nodes so that nodes connected by an element get close indexes. Since the
+    /// degrees of freedom of the mesh follow the order of the nodes, this reduces the bandwidth of
+    /// the stiffness matrix, and the fill-in of direct sparse solvers, when the node order of
+    /// the input (ex. a mesh file) is scattered. Nodes not used by any element are put at the end.
+    /// Call this after adding all nodes and elements, before the simulation starts; note that
+    /// indexes previously obtained from GetNode() are not valid anymore.
+    void RenumberNodes();
+
     /// Get the array of nodes of this mesh.
     const std::vector<std::shared_ptr<ChNodeFEAbase>>& GetNodes() const { return vnodes; }
 
@@ -101,6 +126,16 @@ class ChApiFea ChMesh : public ChIndexedNodes {
     /// Override default in ChPhysicsItem
     virtual bool GetCollide() override { return true; }
 
+    /// Get the number of element colours used for the parallel assembly of internal forces.
+    /// Elements of the same colour do not share nodes. The colouring is computed in SetupInitial
+    /// and recomputed automatically if elements are added or removed afterwards.
+    unsigned int GetNumElementColors() const { return (unsigned int)element_colors.size(); }
+
+    /// Discard the element colouring, so that it is recomputed before the next assembly.
+    /// Call this after changing the nodes of elements already in the mesh (ex. with SetNodes()),
+    /// otherwise two elements of the same colour could write the same node concurrently.
+    void ResetColoring() { element_colors_valid = false; }
+
     /// Reset counters for internal force and Jacobian evaluations.
     void ResetCounters() {
         ncalls_internal_forces = 0;
@@ -173,6 +208,13 @@ class ChApiFea ChMesh : public ChIndexedNodes {
     }
     /// Tell if this mesh will add automatically a gravity load to all contained elements
     bool GetAutomaticGravity() { return automatic_gravity_load; }
+    /// Force the recomputation of the cached gravity loads, for example if element geometry was changed.
+    /// Changes of G or of element densities are detected automatically, and the cache is reset when
+    /// elements are added or removed.
+    void ResetGravityLoads() {
+        gravity_loadables.clear();
+        gravity_loads.clear();
+    }
 
     /// Get ChMesh mass properties
     void ComputeMassProperties(double& mass,          ///< ChMesh object mass
@@ -203,16 +245,30 @@ class ChApiFea ChMesh : public ChIndexedNodes {
                                    const unsigned int off_v,
                                    const ChStateDelta& Dv) override;
     virtual void IntLoadResidual_F(const unsigned int off, ChVectorDynamic<>& R, const double c) override;
+    virtual void IntLoadResidual_F_Masked(const unsigned int off,
+                                          ChVectorDynamic<>& R,
+                                          const ChVectorDynamic<>& mask,
+                                          const double c) override;
     virtual void IntLoadResidual_Mv(const unsigned int off,
                                     ChVectorDynamic<>& R,
                                     const ChVectorDynamic<>& w,
                                     const double c) override;
+    virtual void IntLoadLumpedMass_Md(const unsigned int off,
+                                      ChVectorDynamic<>& Md,
+                                      double& err,
+                                      const double c) override;
     virtual void IntToDescriptor(const unsigned int off_v,
                                  const ChStateDelta& v,
                                  const ChVectorDynamic<>& R,
                                  const unsigned int off_L,
                                  const ChVectorDynamic<>& L,
                                  const ChVectorDynamic<>& Qc) override;
+
+    /// Smallest stable time step of the elements, for explicit integration.
+    virtual double GetStableTimeStep() override;
+
+    /// Stable time step of the nodes, that is, the smallest stable step of their elements.
+    virtual void IntLoadStableTimeSteps(const unsigned int off, ChVectorDynamic<>& steps) override;
     virtual void IntFromDescriptor(const unsigned int off_v,
                                    ChStateDelta& v,
                                    const unsigned int off_L,
@@ -275,6 +331,25 @@ class ChApiFea ChMesh : public ChIndexedNodes {
     /// - Computes the total number of degrees of freedom
     /// - Precompute auxiliary data, such as (local) stiffness matrices Kl, if any, for each element.
     virtual void SetupInitial() override;
+
+    /// Applied, internal and gravity forces, R += c*F. If a mask is given, the internal forces are
+    /// computed only for the elements with at least one node flagged in the mask.
+    void LoadForces(const unsigned int off, ChVectorDynamic<>& R, const ChVectorDynamic<>* mask, const double c);
+
+    /// Add the automatic gravity load of all elements to R, R += c*F_gravity.
+    void LoadGravity(ChVectorDynamic<>& R, const double c);
+
+    /// Stable time step of each element (in parallel).
+    void ComputeElementStableTimeSteps(std::vector<double>& steps);
+
+    /// Greedy colouring of the elements, such that elements sharing a node get different colours.
+    void ComputeElementColors();
+
+    /// Recompute the element colouring if the topology changed since it was last computed.
+    void CheckElementColors() {
+        if (!element_colors_valid)
+            ComputeElementColors();
+    }
 };
 
 /// @} fea_module
@@ -36,6 +36,73 @@ using namespace std;
 namespace chrono {
 namespace fea {
 
+// Read a whole text file with a single read, and split it in lines: the line terminators
+// are replaced by '\0', and each line pointer skips the leading white space.
+// Returns false if the file cannot be opened.
+static bool ReadFileLines(const char* filename, std::vector<char>& buffer, std::vector<const char*>& lines) {
+    ifstream fin(filename, ios::in | ios::binary);
+    if (!fin.good())
+        return false;
+    fin.seekg(0, ios::end);
+    std::streamoff size = fin.tellg();
+    fin.seekg(0, ios::beg);
+    buffer.resize((size_t)size + 1);
+    if (size > 0)
+        fin.read(&buffer[0], size);
+    buffer[(size_t)size] = 0;
+
+    lines.clear();
+    size_t i = 0;
+    while (i < (size_t)size) {
+        while (i < (size_t)size && isspace((unsigned char)buffer[i]) && buffer[i] != '\n')
+            ++i;
+        lines.push_back(&buffer[i]);
+        while (i < (size_t)size && buffer[i] != '\n')
+            ++i;
+        if (i > 0 && buffer[i - 1] == '\r')
+            buffer[i - 1] = 0;
+        buffer[i] = 0;
+        ++i;
+    }
+    return true;
+}
+
+// Parse the numbers of a line separated by white space, or by commas if 'csv' is true, up to
+// 'maxvals' numbers. An unreadable token counts as a 0 value. Returns the number of tokens.
+static int ParseLineNumbers(const char* str, double* vals, int maxvals, bool csv = false) {
+    int ntoken = 0;
+    const char* s = str;
+    while (ntoken < maxvals) {
+        while (isspace((unsigned char)*s))
+            ++s;
+        if (*s == 0)
+            break;
+        char* end;
+        double val = strtod(s, &end);
+        if (end == s) {
+            val = 0;
+            while (*end != 0 && (csv ? *end != ',' : !isspace((unsigned char)*end)))
+                ++end;
+        }
+        vals[ntoken++] = val;
+        s = end;
+        while (isspace((unsigned char)*s))
+            ++s;
+        if (csv && *s == ',')
+            ++s;
+    }
+    return ntoken;
+}
+
+// Remove the empty lines and the comments (starting with '#') from a list of lines.
+static void SkipTetGenComments(std::vector<const char*>& lines) {
+    size_t n = 0;
+    for (size_t i = 0; i < lines.size(); ++i)
+        if (lines[i][0] != 0 && lines[i][0] != '#')
+            lines[n++] = lines[i];
+    lines.resize(n);
+}
+
 void ChMeshFileLoader::FromTetGenFile(std::shared_ptr<ChMesh> mesh,
                                       const char* filename_node,
                                       const char* filename_ele,
@@ -44,149 +111,174 @@ void ChMeshFileLoader::FromTetGenFile(std::shared_ptr<ChMesh> mesh,
                                       ChMatrix33<> rot_transform) {
     int totnodes = 0;
     int nodes_offset = mesh->GetNnodes();
-    int added_nodes = 0;
+
+    bool elastic = (std::dynamic_pointer_cast<ChContinuumElastic>(my_material) != nullptr);
+    bool poisson = (std::dynamic_pointer_cast<ChContinuumPoisson3D>(my_material) != nullptr);
+
+    // The files are read with a single read each; then the lines, that are independent, are
+    // parsed and the nodes and elements are created in parallel. Errors are collected and the
+    // one of the first offending line is thrown, as in a sequential parsing.
+    std::vector<char> buffer;
+    std::vector<const char*> lines;
 
     // Load .node TetGen file
     {
-        bool parse_header = true;
-        bool parse_nodes = false;
-
-        fstream fin(filename_node);
-        if (!fin.good())
+        if (!ReadFileLines(filename_node, buffer, lines))
             throw ChException("ERROR opening TetGen .node file: " + std::string(filename_node) + "\n");
+        SkipTetGenComments(lines);
+
+        if (lines.size() > 0) {
+            double header[4] = {0, 0, 0, 0};
+            ParseLineNumbers(lines[0], header, 4);
+            int nnodes = (int)header[0];
+            std::string line(lines[0]);
+            if ((int)header[1] != 3)
+                throw ChException("ERROR in TetGen .node file. Only 3 dimensional nodes supported: \n" + line);
+            if ((int)header[2] != 0)
+                throw ChException("ERROR in TetGen .node file. Only nodes with 0 attrs supported: \n" + line);
+            if ((int)header[3] != 0)
+                throw ChException("ERROR in TetGen .node file. Only nodes with 0 markers supported: \n" + line);
+            totnodes = nnodes;
+        }
 
-        int nnodes = 0;
-        int ndims = 0;
-        int nattrs = 0;
-        int nboundarymark = 0;
-
-        string line;
-        while (getline(fin, line)) {
-            // trims white space from the beginning of the string
-            line.erase(line.begin(), find_if(line.begin(), line.end(), not1(ptr_fun<int, int>(isspace))));
-
-            if (line[0] == '#')
-                continue;  // skip comment
-            if (line[0] == 0)
-                continue;  // skip empty lines
-
-            if (parse_header) {
-                stringstream(line) >> nnodes >> ndims >> nattrs >> nboundarymark;
-                if (ndims != 3)
-                    throw ChException("ERROR in TetGen .node file. Only 3 dimensional nodes supported: \n" + line);
-                if (nattrs != 0)
-                    throw ChException("ERROR in TetGen .node file. Only nodes with 0 attrs supported: \n" + line);
-                if (nboundarymark != 0)
-                    throw ChException("ERROR in TetGen .node file. Only nodes with 0 markers supported: \n" + line);
-                parse_header = false;
-                parse_nodes = true;
-                totnodes = nnodes;
+        int nlines = (int)lines.size() - 1;
+        if (nlines > 0 && !elastic && !poisson)
+            throw ChException("ERROR in TetGen generation. Material type not supported. \n");
+
+        std::vector<std::shared_ptr<ChNodeFEAbase>> new_nodes(std::max(nlines, 0));
+        int error_line = nlines;
+        int error_code = 0;
+
+#pragma omp parallel for schedule(static)
+        for (int i = 0; i < nlines; ++i) {
+            double vals[4] = {0, -10e30, -10e30, -10e30};
+            ParseLineNumbers(lines[i + 1], vals, 4);
+            int idnode = (int)vals[0];
+            int code = 0;
+            if (idnode <= 0 || idnode > totnodes)
+                code = 1;
+            else if (idnode != i + 1)
+                code = 2;
+            else if (vals[1] == -10e30 || vals[2] == -10e30 || vals[3] == -10e30)
+                code = 3;
+            if (code) {
+#pragma omp critical
+                {
+                    if (i < error_line) {
+                        error_line = i;
+                        error_code = code;
+                    }
+                }
                 continue;
             }
 
-            int idnode = 0;
-            double x = -10e30;
-            double y = -10e30;
-            double z = -10e30;
-
-            if (parse_nodes) {
-                stringstream(line) >> idnode >> x >> y >> z;
-                ++added_nodes;
-                if (idnode <= 0 || idnode > nnodes)
-                    throw ChException("ERROR in TetGen .node file. Node ID not in range: \n" + line + "\n");
-                if (idnode != added_nodes)
-                    throw ChException("ERROR in TetGen .node file. Nodes IDs must be sequential (1 2 3 ..): \n" + line +
-                                      "\n");
-                if (x == -10e30 || y == -10e30 || z == -10e30)
-                    throw ChException("ERROR in TetGen .node file, in parsing x,y,z coordinates of node: \n" + line +
-                                      "\n");
+            ChVector<> node_position(vals[1], vals[2], vals[3]);
+            node_position = rot_transform * node_position;  // rotate/scale, if needed
+            node_position = pos_transform + node_position;  // move, if needed
 
-                ChVector<> node_position(x, y, z);
-                node_position = rot_transform * node_position;  // rotate/scale, if needed
-                node_position = pos_transform + node_position;  // move, if needed
+            if (elastic)
+                new_nodes[i] = std::make_shared<ChNodeFEAxyz>(node_position);
+            else
+                new_nodes[i] = std::make_shared<ChNodeFEAxyzP>(node_position);
+        }
 
-                if (std::dynamic_pointer_cast<ChContinuumElastic>(my_material)) {
-                    auto mnode = std::make_shared<ChNodeFEAxyz>(node_position);
-                    mesh->AddNode(mnode);
-                } else if (std::dynamic_pointer_cast<ChContinuumPoisson3D>(my_material)) {
-                    auto mnode = std::make_shared<ChNodeFEAxyzP>(node_position);
-                    mesh->AddNode(mnode);
-                } else
-                    throw ChException("ERROR in TetGen generation. Material type not supported. \n");
-            }
+        if (error_code) {
+            std::string line(lines[error_line + 1]);
+            if (error_code == 1)
+                throw ChException("ERROR in TetGen .node file. Node ID not in range: \n" + line + "\n");
+            if (error_code == 2)
+                throw ChException("ERROR in TetGen .node file. Nodes IDs must be sequential (1 2 3 ..): \n" + line +
+                                  "\n");
+            throw ChException("ERROR in TetGen .node file, in parsing x,y,z coordinates of node: \n" + line + "\n");
+        }
 
-        }  // end while
+        for (int i = 0; i < nlines; ++i)
+            mesh->AddNode(new_nodes[i]);
 
     }  // end .node file
 
     // Load .ele TetGen file
     {
-        bool parse_header = true;
-        bool parse_tet = false;
-
-        fstream fin(filename_ele);
-        if (!fin.good())
+        if (!ReadFileLines(filename_ele, buffer, lines))
             throw ChException("ERROR opening TetGen .node file: " + std::string(filename_node) + "\n");
+        SkipTetGenComments(lines);
+
+        int ntets = 0;
+        if (lines.size() > 0) {
+            double header[3] = {0, 0, 0};
+            ParseLineNumbers(lines[0], header, 3);
+            ntets = (int)header[0];
+            std::string line(lines[0]);
+            if ((int)header[1] != 4)
+                throw ChException("ERROR in TetGen .ele file. Only 4 -nodes per tes supported: \n" + line + "\n");
+            if ((int)header[2] != 0)
+                throw ChException("ERROR in TetGen .ele file. Only tets with 0 attrs supported: \n" + line + "\n");
+        }
 
-        int ntets, nnodespertet, nattrs = 0;
-
-        string line;
-        while (getline(fin, line)) {
-            // trims white space from the beginning of the string
-            line.erase(line.begin(), find_if(line.begin(), line.end(), not1(ptr_fun<int, int>(isspace))));
-
-            if (line[0] == '#')
-                continue;  // skip comment
-            if (line[0] == 0)
-                continue;  // skip empty lines
-
-            if (parse_header) {
-                stringstream(line) >> ntets >> nnodespertet >> nattrs;
-                if (nnodespertet != 4)
-                    throw ChException("ERROR in TetGen .ele file. Only 4 -nodes per tes supported: \n" + line + "\n");
-                if (nattrs != 0)
-                    throw ChException("ERROR in TetGen .ele file. Only tets with 0 attrs supported: \n" + line + "\n");
-                parse_header = false;
-                parse_tet = true;
+        int nlines = (int)lines.size() - 1;
+        if (nlines > 0 && !elastic && !poisson)
+            throw ChException("ERROR in TetGen generation. Material type not supported. \n");
+
+        const std::vector<std::shared_ptr<ChNodeFEAbase>>& nodes = mesh->GetNodes();
+        std::vector<std::shared_ptr<ChElementBase>> new_elements(std::max(nlines, 0));
+        int error_line = nlines;
+        int error_code = 0;
+
+#pragma omp parallel for schedule(static)
+        for (int i = 0; i < nlines; ++i) {
+            double vals[5] = {0, 0, 0, 0, 0};
+            ParseLineNumbers(lines[i + 1], vals, 5);
+            int idtet = (int)vals[0];
+            int n[4];
+            int code = 0;
+            if (idtet <= 0 || idtet > ntets)
+                code = 1;
+            for (int k = 0; k < 4 && !code; ++k) {
+                n[k] = (int)vals[k + 1];
+                if (n[k] <= 0 || n[k] > totnodes)
+                    code = 2 + k;
+            }
+            if (code) {
+#pragma omp critical
+                {
+                    if (i < error_line) {
+                        error_line = i;
+                        error_code = code;
+                    }
+                }
                 continue;
             }
 
-            int idtet = 0;
-            int n1, n2, n3, n4;
-
-            if (parse_tet) {
-                stringstream(line) >> idtet >> n1 >> n2 >> n3 >> n4;
-                if (idtet <= 0 || idtet > ntets)
-                    throw ChException("ERROR in TetGen .node file. Tetahedron ID not in range: \n" + line + "\n");
-                if (n1 > totnodes)
-                    throw ChException("ERROR in TetGen .node file, ID of 1st node is out of range: \n" + line + "\n");
-                if (n2 > totnodes)
-                    throw ChException("ERROR in TetGen .node file, ID of 2nd node is out of range: \n" + line + "\n");
-                if (n3 > totnodes)
-                    throw ChException("ERROR in TetGen .node file, ID of 3rd node is out of range: \n" + line + "\n");
-                if (n4 > totnodes)
-                    throw ChException("ERROR in TetGen .node file, ID of 4th node is out of range: \n" + line + "\n");
-                if (std::dynamic_pointer_cast<ChContinuumElastic>(my_material)) {
-                    auto mel = std::make_shared<ChElementTetra_4>();
-                    mel->SetNodes(std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(nodes_offset + n1 - 1)),
-                                  std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(nodes_offset + n3 - 1)),
-                                  std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(nodes_offset + n2 - 1)),
-                                  std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(nodes_offset + n4 - 1)));
-                    mel->SetMaterial(std::static_pointer_cast<ChContinuumElastic>(my_material));
-                    mesh->AddElement(mel);
-                } else if (std::dynamic_pointer_cast<ChContinuumPoisson3D>(my_material)) {
-                    auto mel = std::make_shared<ChElementTetra_4_P>();
-                    mel->SetNodes(std::dynamic_pointer_cast<ChNodeFEAxyzP>(mesh->GetNode(nodes_offset + n1 - 1)),
-                                  std::dynamic_pointer_cast<ChNodeFEAxyzP>(mesh->GetNode(nodes_offset + n3 - 1)),
-                                  std::dynamic_pointer_cast<ChNodeFEAxyzP>(mesh->GetNode(nodes_offset + n2 - 1)),
-                                  std::dynamic_pointer_cast<ChNodeFEAxyzP>(mesh->GetNode(nodes_offset + n4 - 1)));
-                    mel->SetMaterial(std::static_pointer_cast<ChContinuumPoisson3D>(my_material));
-                    mesh->AddElement(mel);
-                } else
-                    throw ChException("ERROR in TetGen generation. Material type not supported. \n");
+            if (elastic) {
+                auto mel = std::make_shared<ChElementTetra_4>();
+                mel->SetNodes(std::static_pointer_cast<ChNodeFEAxyz>(nodes[nodes_offset + n[0] - 1]),
+                              std::static_pointer_cast<ChNodeFEAxyz>(nodes[nodes_offset + n[2] - 1]),
+                              std::static_pointer_cast<ChNodeFEAxyz>(nodes[nodes_offset + n[1] - 1]),
+                              std::static_pointer_cast<ChNodeFEAxyz>(nodes[nodes_offset + n[3] - 1]));
+                mel->SetMaterial(std::static_pointer_cast<ChContinuumElastic>(my_material));
+                new_elements[i] = mel;
+            } else {
+                auto mel = std::make_shared<ChElementTetra_4_P>();
+                mel->SetNodes(std::static_pointer_cast<ChNodeFEAxyzP>(nodes[nodes_offset + n[0] - 1]),
+                              std::static_pointer_cast<ChNodeFEAxyzP>(nodes[nodes_offset + n[2] - 1]),
+                              std::static_pointer_cast<ChNodeFEAxyzP>(nodes[nodes_offset + n[1] - 1]),
+                              std::static_pointer_cast<ChNodeFEAxyzP>(nodes[nodes_offset + n[3] - 1]));
+                mel->SetMaterial(std::static_pointer_cast<ChContinuumPoisson3D>(my_material));
+                new_elements[i] = mel;
             }
+        }
 
-        }  // end while
+        if (error_code) {
+            std::string line(lines[error_line + 1]);
+            const char* which[4] = {"1st", "2nd", "3rd", "4th"};
+            if (error_code == 1)
+                throw ChException("ERROR in TetGen .node file. Tetahedron ID not in range: \n" + line + "\n");
+            throw ChException("ERROR in TetGen .node file, ID of " + std::string(which[error_code - 2]) +
+                              " node is out of range: \n" + line + "\n");
+        }
+
+        for (int i = 0; i < nlines; ++i)
+            mesh->AddElement(new_elements[i]);
 
     }  // end .ele file
 }
@@ -216,23 +308,20 @@ void ChMeshFileLoader::FromAbaqusFile(std::shared_ptr<ChMesh> mesh,
         E_PARSE_NODESET
     } e_parse_section = E_PARSE_UNKNOWN;
 
-    fstream fin(filename);
-    if (!fin.good())
+    // read the file with a single read, then parse its lines
+    std::vector<char> buffer;
+    std::vector<const char*> lines;
+    if (!ReadFileLines(filename, buffer, lines))
         throw ChException("ERROR opening Abaqus .inp file: " + std::string(filename) + "\n");
 
-    int nnodes = 0;
-    int ndims = 0;
-    int nattrs = 0;
+    for (size_t il = 0; il < lines.size(); ++il) {
+        const char* cline = lines[il];
 
-    string line;
-    while (getline(fin, line)) {
-        // trims white space from the beginning of the string
-        line.erase(line.begin(), find_if(line.begin(), line.end(), not1(ptr_fun<int, int>(isspace))));
-
-        if (line[0] == 0)
+        if (cline[0] == 0)
             continue;  // skip empty lines
 
-        if (line[0] == '*') {
+        if (cline[0] == '*') {
+            string line(cline);
             e_parse_section = E_PARSE_UNKNOWN;
 
             if (line.find("*NODE") == 0) {
@@ -287,28 +376,22 @@ void ChMeshFileLoader::FromAbaqusFile(std::shared_ptr<ChMesh> mesh,
             double y = -10e30;
             double z = -10e30;
             double tokenvals[20];
-            int ntoken = 0;
-
-            string token;
-            std::istringstream ss(line);
-            while (getline(ss, token, ',') && ntoken < 20) {
-                std::istringstream stoken(token);
-                stoken >> tokenvals[ntoken];
-                ++ntoken;
-            }
+            int ntoken = ParseLineNumbers(cline, tokenvals, 20, true);
             ++added_nodes;
 
             if (ntoken != 4)
-                throw ChException("ERROR in .inp file, nodes require ID and three x y z coords, see line:\n" + line +
-                                  "\n");
+                throw ChException("ERROR in .inp file, nodes require ID and three x y z coords, see line:\n" +
+                                  string(cline) + "\n");
             idnode = (int)tokenvals[0];
             if (idnode != added_nodes)
-                throw ChException("ERROR in .inp file. Nodes IDs must be sequential (1 2 3 ..): \n" + line + "\n");
+                throw ChException("ERROR in .inp file. Nodes IDs must be sequential (1 2 3 ..): \n" + string(cline) +
+                                  "\n");
             x = tokenvals[1];
             y = tokenvals[2];
             z = tokenvals[3];
             if (x == -10e30 || y == -10e30 || z == -10e30)
-                throw ChException("ERROR in in .inp file, in parsing x,y,z coordinates of node: \n" + line + "\n");
+                throw ChException("ERROR in in .inp file, in parsing x,y,z coordinates of node: \n" + string(cline) +
+                                  "\n");
 
             ChVector<> node_position(x, y, z);
             node_position = rot_transform * node_position;  // rotate/scale, if needed
@@ -328,39 +411,36 @@ void ChMeshFileLoader::FromAbaqusFile(std::shared_ptr<ChMesh> mesh,
 
         if (e_parse_section == E_PARSE_TETS_10 || e_parse_section == E_PARSE_TETS_4) {
             int idelem = 0;
+            double tokenreals[20];
             unsigned int tokenvals[20];
-            int ntoken = 0;
-
-            string token;
-            std::istringstream ss(line);
-            while (std::getline(ss, token, ',') && ntoken < 20) {
-                std::istringstream stoken(token);
-                stoken >> tokenvals[ntoken];
-                ++ntoken;
-            }
+            int ntoken = ParseLineNumbers(cline, tokenreals, 20, true);
+            for (int nt = 0; nt < ntoken; ++nt)
+                tokenvals[nt] = (unsigned int)tokenreals[nt];
             ++added_elements;
             if (e_parse_section == E_PARSE_TETS_10) {
                 if (ntoken != 11)
-                    throw ChException("ERROR in .inp file, tetahedrons require ID and 10 node IDs, see line:\n" + line +
-                                      "\n");
+                    throw ChException("ERROR in .inp file, tetahedrons require ID and 10 node IDs, see line:\n" +
+                                      string(cline) + "\n");
                 idelem = (int)tokenvals[0];
                 if (idelem != added_elements)
-                    throw ChException("ERROR in .inp file. Element IDs must be sequential (1 2 3 ..): \n" + line +
-                                      "\n");
+                    throw ChException("ERROR in .inp file. Element IDs must be sequential (1 2 3 ..): \n" +
+                                      string(cline) + "\n");
                 for (int in = 0; in < 10; ++in)
                     if (tokenvals[in + 1] == -10e30)
-                        throw ChException("ERROR in in .inp file, in parsing IDs of tetahedron: \n" + line + "\n");
+                        throw ChException("ERROR in in .inp file, in parsing IDs of tetahedron: \n" +
+                                          string(cline) + "\n");
             } else if (e_parse_section == E_PARSE_TETS_4) {
                 if (ntoken != 5)
-                    throw ChException("ERROR in .inp file, tetahedrons require ID and 10 node IDs, see line:\n" + line +
-                                      "\n");
+                    throw ChException("ERROR in .inp file, tetahedrons require ID and 10 node IDs, see line:\n" +
+                                      string(cline) + "\n");
                 idelem = (int)tokenvals[0];
                 if (idelem != added_elements)
-                    throw ChException("ERROR in .inp file. Element IDs must be sequential (1 2 3 ..): \n" + line +
-                                      "\n");
+                    throw ChException("ERROR in .inp file. Element IDs must be sequential (1 2 3 ..): \n" +
+                                      string(cline) + "\n");
                 for (int in = 0; in < 4; ++in)
                     if (tokenvals[in + 1] == -10e30)
-                        throw ChException("ERROR in in .inp file, in parsing IDs of tetahedron: \n" + line + "\n");
+                        throw ChException("ERROR in in .inp file, in parsing IDs of tetahedron: \n" +
+                                          string(cline) + "\n");
             }
             if (std::dynamic_pointer_cast<ChContinuumElastic>(my_material)) {
                 auto mel = std::make_shared<ChElementTetra_4>();
@@ -393,16 +473,8 @@ void ChMeshFileLoader::FromAbaqusFile(std::shared_ptr<ChMesh> mesh,
         if (e_parse_section == E_PARSE_NODESET) {
             int idelem = 0;
 
-            unsigned int tokenvals[100];
-            int ntoken = 0;
-
-            string token;
-            std::istringstream ss(line);
-            while (std::getline(ss, token, ',') && ntoken < 100) {
-                std::istringstream stoken(token);
-                stoken >> tokenvals[ntoken];
-                ++ntoken;
-            }
+            double tokenvals[100];
+            int ntoken = ParseLineNumbers(cline, tokenvals, 100, true);
 
             for (int nt = 0; nt < ntoken; ++nt) {
                 int idnode = (int)tokenvals[nt];
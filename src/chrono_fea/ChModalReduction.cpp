@@ -0,0 +1,550 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Component mode synthesis (Craig-Bampton) reduction of a ChMesh
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <unordered_map>
+
+#include "chrono/core/ChException.h"
+#include "chrono/core/ChStream.h"
+#include "chrono_fea/ChModalReduction.h"
+
+namespace chrono {
+namespace fea {
+
+namespace {
+
+// Sparse symmetric matrix in compressed row format, used for the large (full mesh) operators.
+struct CSRMatrix {
+    int n;
+    std::vector<int> rowptr;
+    std::vector<int> col;
+    std::vector<double> val;
+
+    // Build the block [lo,hi)x[lo,hi) of the matrix stored row by row in 'rows'.
+    CSRMatrix(const std::vector<std::map<int, double> >& rows, int lo, int hi) : n(hi - lo) {
+        rowptr.reserve(n + 1);
+        rowptr.push_back(0);
+        for (int i = lo; i < hi; i++) {
+            for (auto it = rows[i].lower_bound(lo); it != rows[i].end() && it->first < hi; ++it) {
+                col.push_back(it->first - lo);
+                val.push_back(it->second);
+            }
+            rowptr.push_back((int)col.size());
+        }
+    }
+
+    // y = A*x
+    void Multiply(const std::vector<double>& x, std::vector<double>& y) const {
+        y.resize(n);
+        for (int i = 0; i < n; i++) {
+            double sum = 0;
+            for (int k = rowptr[i]; k < rowptr[i + 1]; k++)
+                sum += val[k] * x[col[k]];
+            y[i] = sum;
+        }
+    }
+
+    // x'*A*y
+    double Product(const std::vector<double>& x, const std::vector<double>& y) const {
+        double sum = 0;
+        for (int i = 0; i < n; i++)
+            for (int k = rowptr[i]; k < rowptr[i + 1]; k++)
+                sum += x[i] * val[k] * y[col[k]];
+        return sum;
+    }
+
+    std::vector<double> Diagonal() const {
+        std::vector<double> d(n, 0.0);
+        for (int i = 0; i < n; i++)
+            for (int k = rowptr[i]; k < rowptr[i + 1]; k++)
+                if (col[k] == i)
+                    d[i] = val[k];
+        return d;
+    }
+};
+
+double Dot(const std::vector<double>& a, const std::vector<double>& b) {
+    double sum = 0;
+    for (size_t i = 0; i < a.size(); i++)
+        sum += a[i] * b[i];
+    return sum;
+}
+
+// Solve A*x=b with the Jacobi-preconditioned conjugate gradient method; x is the initial guess on entry.
+bool SolvePCG(const CSRMatrix& A,
+              const std::vector<double>& diag,
+              const std::vector<double>& b,
+              std::vector<double>& x,
+              double tol) {
+    int n = A.n;
+    x.resize(n, 0.0);
+    std::vector<double> r(n), z(n), p(n), Ap(n);
+    A.Multiply(x, Ap);
+    for (int i = 0; i < n; i++)
+        r[i] = b[i] - Ap[i];
+    double bnorm = std::sqrt(Dot(b, b));
+    if (bnorm == 0) {
+        std::fill(x.begin(), x.end(), 0.0);
+        return true;
+    }
+    for (int i = 0; i < n; i++)
+        z[i] = r[i] / diag[i];
+    p = z;
+    double rz = Dot(r, z);
+    int max_iterations = std::max(1000, 10 * n);
+    for (int iter = 0; iter < max_iterations; iter++) {
+        if (std::sqrt(Dot(r, r)) <= tol * bnorm)
+            return true;
+        A.Multiply(p, Ap);
+        double pAp = Dot(p, Ap);
+        if (pAp <= 0)
+            return false;
+        double alpha = rz / pAp;
+        for (int i = 0; i < n; i++) {
+            x[i] += alpha * p[i];
+            r[i] -= alpha * Ap[i];
+            z[i] = r[i] / diag[i];
+        }
+        double rz_new = Dot(r, z);
+        double beta = rz_new / rz;
+        rz = rz_new;
+        for (int i = 0; i < n; i++)
+            p[i] = z[i] + beta * p[i];
+    }
+    return std::sqrt(Dot(r, r)) <= tol * bnorm;
+}
+
+// Eigenvalues and eigenvectors of the dense symmetric matrix A, with the cyclic Jacobi method.
+// On exit the columns of V are the eigenvectors; A is overwritten.
+void SymmetricEigen(ChMatrixDynamic<>& A, ChVectorDynamic<>& lambda, ChMatrixDynamic<>& V) {
+    int n = A.GetRows();
+    V.Reset(n, n);
+    V.FillDiag(1.0);
+    for (int sweep = 0; sweep < 100; sweep++) {
+        double off = 0;
+        double norm = 0;
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++) {
+                norm += A(i, j) * A(i, j);
+                if (i != j)
+                    off += A(i, j) * A(i, j);
+            }
+        if (off <= 1e-30 * norm)
+            break;
+        for (int p = 0; p < n - 1; p++) {
+            for (int q = p + 1; q < n; q++) {
+                double apq = A(p, q);
+                if (std::abs(apq) <= 1e-300)
+                    continue;
+                double theta = (A(q, q) - A(p, p)) / (2 * apq);
+                double t = (theta >= 0 ? 1.0 : -1.0) / (std::abs(theta) + std::sqrt(theta * theta + 1));
+                double c = 1 / std::sqrt(t * t + 1);
+                double s = t * c;
+                for (int k = 0; k < n; k++) {
+                    double akp = A(k, p);
+                    double akq = A(k, q);
+                    A(k, p) = c * akp - s * akq;
+                    A(k, q) = s * akp + c * akq;
+                }
+                for (int k = 0; k < n; k++) {
+                    double apk = A(p, k);
+                    double aqk = A(q, k);
+                    A(p, k) = c * apk - s * aqk;
+                    A(q, k) = s * apk + c * aqk;
+                }
+                for (int k = 0; k < n; k++) {
+                    double vkp = V(k, p);
+                    double vkq = V(k, q);
+                    V(k, p) = c * vkp - s * vkq;
+                    V(k, q) = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+    lambda.Reset(n);
+    for (int i = 0; i < n; i++)
+        lambda(i) = A(i, i);
+}
+
+// Generalized symmetric eigenproblem K*x = lambda*M*x, with M positive definite.
+// Eigenvalues are sorted in ascending order, eigenvectors (columns of X) are M-normalized.
+void GeneralizedEigen(const ChMatrixDynamic<>& K,
+                      const ChMatrixDynamic<>& M,
+                      ChVectorDynamic<>& lambda,
+                      ChMatrixDynamic<>& X) {
+    int n = K.GetRows();
+
+    // Cholesky factorization M = L*L'
+    ChMatrixDynamic<> L(n, n);
+    for (int j = 0; j < n; j++) {
+        double d = M(j, j);
+        for (int k = 0; k < j; k++)
+            d -= L(j, k) * L(j, k);
+        if (d <= 0)
+            throw ChException("ChModalReduction: mass matrix is not positive definite.");
+        L(j, j) = std::sqrt(d);
+        for (int i = j + 1; i < n; i++) {
+            double s = M(i, j);
+            for (int k = 0; k < j; k++)
+                s -= L(i, k) * L(j, k);
+            L(i, j) = s / L(j, j);
+        }
+    }
+
+    // C = inv(L)*K*inv(L)'
+    ChMatrixDynamic<> Z(n, n);
+    for (int c = 0; c < n; c++)
+        for (int i = 0; i < n; i++) {
+            double s = K(i, c);
+            for (int k = 0; k < i; k++)
+                s -= L(i, k) * Z(k, c);
+            Z(i, c) = s / L(i, i);
+        }
+    ChMatrixDynamic<> C(n, n);
+    for (int c = 0; c < n; c++)
+        for (int i = 0; i < n; i++) {
+            double s = Z(c, i);
+            for (int k = 0; k < i; k++)
+                s -= L(i, k) * C(k, c);
+            C(i, c) = s / L(i, i);
+        }
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < i; j++)
+            C(i, j) = C(j, i) = 0.5 * (C(i, j) + C(j, i));
+
+    ChVectorDynamic<> lam;
+    ChMatrixDynamic<> Y;
+    SymmetricEigen(C, lam, Y);
+
+    // sort, then back-substitute x = inv(L')*y
+    std::vector<int> order(n);
+    for (int i = 0; i < n; i++)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), [&lam](int a, int b) { return lam(a) < lam(b); });
+    lambda.Reset(n);
+    X.Reset(n, n);
+    for (int c = 0; c < n; c++) {
+        lambda(c) = lam(order[c]);
+        for (int i = n - 1; i >= 0; i--) {
+            double s = Y(i, order[c]);
+            for (int k = i + 1; k < n; k++)
+                s -= L(k, i) * X(k, c);
+            X(i, c) = s / L(i, i);
+        }
+    }
+}
+
+// Lowest eigenpairs of K*x = lambda*M*x (K, M positive definite) by subspace iteration.
+void SubspaceIteration(const CSRMatrix& K,
+                       const CSRMatrix& M,
+                       int nmodes,
+                       double tol,
+                       std::vector<std::vector<double> >& modes,
+                       std::vector<double>& lambda) {
+    int n = K.n;
+    int p = std::min(n, std::max(2 * nmodes, nmodes + 8));
+    std::vector<double> diagK = K.Diagonal();
+    std::vector<double> diagM = M.Diagonal();
+
+    // starting subspace: mass diagonal, plus pseudo-random vectors
+    std::vector<std::vector<double> > X(p, std::vector<double>(n));
+    unsigned int seed = 12345;
+    for (int c = 0; c < p; c++)
+        for (int i = 0; i < n; i++) {
+            seed = seed * 1103515245 + 12345;
+            X[c][i] = (c == 0) ? diagM[i] : ((seed >> 8) & 0xFFFF) / 32768.0 - 1.0;
+        }
+
+    std::vector<std::vector<double> > Y(p, std::vector<double>(n, 0.0));
+    std::vector<std::vector<double> > KY(p), MY(p);
+    std::vector<double> rhs;
+    ChVectorDynamic<> lam_old(p);
+    ChVectorDynamic<> lam;
+    ChMatrixDynamic<> Q;
+    ChMatrixDynamic<> Kr(p, p);
+    ChMatrixDynamic<> Mr(p, p);
+
+    for (int iter = 0; iter < 200; iter++) {
+        for (int c = 0; c < p; c++) {
+            M.Multiply(X[c], rhs);
+            if (iter > 0)
+                for (int i = 0; i < n; i++)
+                    Y[c][i] = X[c][i] / lam_old(c);
+            if (!SolvePCG(K, diagK, rhs, Y[c], tol))
+                throw ChException("ChModalReduction: iterative solver failed, interior stiffness is singular.");
+            K.Multiply(Y[c], KY[c]);
+            M.Multiply(Y[c], MY[c]);
+        }
+        for (int a = 0; a < p; a++)
+            for (int b = a; b < p; b++) {
+                Kr(a, b) = Kr(b, a) = Dot(Y[a], KY[b]);
+                Mr(a, b) = Mr(b, a) = Dot(Y[a], MY[b]);
+            }
+        GeneralizedEigen(Kr, Mr, lam, Q);
+
+        for (int c = 0; c < p; c++) {
+            std::fill(X[c].begin(), X[c].end(), 0.0);
+            for (int a = 0; a < p; a++)
+                for (int i = 0; i < n; i++)
+                    X[c][i] += Y[a][i] * Q(a, c);
+        }
+
+        bool converged = (iter > 0);
+        for (int c = 0; c < nmodes; c++)
+            if (std::abs(lam(c) - lam_old(c)) > tol * std::abs(lam(c)))
+                converged = false;
+        lam_old = lam;
+        if (converged)
+            break;
+    }
+
+    modes.assign(X.begin(), X.begin() + nmodes);
+    lambda.resize(nmodes);
+    for (int c = 0; c < nmodes; c++)
+        lambda[c] = lam_old(c);
+}
+
+}  // end anonymous namespace
+
+// -----------------------------------------------------------------------------
+
+ChModalReduction::ChModalReduction() : mass(0), cog(VNULL), inertia(1), tolerance(1e-9) {
+    eigenvalues.Reset(0);
+}
+
+double ChModalReduction::GetFrequency(int j) const {
+    return std::sqrt(std::max(0.0, eigenvalues(j))) / CH_C_2PI;
+}
+
+ChVector<> ChModalReduction::GetNodeDisplacement(int k, const ChVectorDynamic<>& q) const {
+    ChVector<> u(VNULL);
+    for (int j = 0; j < GetNmodes(); j++)
+        u += GetNodeModeShape(k, j) * q(j);
+    return u;
+}
+
+void ChModalReduction::AddNodeForce(int k, const ChVector<>& F, ChVectorDynamic<>& Q, double c) const {
+    for (int j = 0; j < GetNmodes(); j++)
+        Q(j) += c * (modes(3 * k, j) * F.x + modes(3 * k + 1, j) * F.y + modes(3 * k + 2, j) * F.z);
+}
+
+void ChModalReduction::Compute(std::shared_ptr<ChMesh> mesh,
+                               const std::vector<std::shared_ptr<ChNodeFEAxyz> >& interface,
+                               int n_fixed_modes) {
+    // Number the nodes, and permute the coordinates so that the interface ones come first.
+    int nnodes = mesh->GetNnodes();
+    std::unordered_map<ChNodeFEAbase*, int> node_index;
+    ref_pos.resize(nnodes);
+    for (int k = 0; k < nnodes; k++) {
+        auto node = std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNodes()[k]);
+        if (!node)
+            throw ChException("ChModalReduction: only meshes of ChNodeFEAxyz nodes are supported.");
+        node_index[node.get()] = k;
+        ref_pos[k] = node->GetX0();
+    }
+
+    int N = 3 * nnodes;
+    int nb = 3 * (int)interface.size();
+    std::vector<int> perm(N, -1);
+    interface_nodes.clear();
+    for (size_t i = 0; i < interface.size(); i++) {
+        auto it = node_index.find(interface[i].get());
+        if (it == node_index.end() || perm[3 * it->second] >= 0)
+            throw ChException("ChModalReduction: interface nodes must be distinct nodes of the mesh.");
+        interface_nodes.push_back(it->second);
+        for (int d = 0; d < 3; d++)
+            perm[3 * it->second + d] = 3 * (int)i + d;
+    }
+    int next = nb;
+    for (int r = 0; r < N; r++)
+        if (perm[r] < 0)
+            perm[r] = next++;
+
+    // Assemble the stiffness and mass matrices at the reference configuration.
+    std::vector<std::map<int, double> > rowsK(N), rowsM(N);
+    ChMatrixDynamic<> H;
+    for (unsigned int ie = 0; ie < mesh->GetNelements(); ie++) {
+        auto element = mesh->GetElement(ie);
+        int nn = element->GetNnodes();
+        if (element->GetNdofs() != 3 * nn)
+            throw ChException("ChModalReduction: only elements with 3 coordinates per node are supported.");
+        std::vector<int> dofs(3 * nn);
+        for (int in = 0; in < nn; in++)
+            for (int d = 0; d < 3; d++)
+                dofs[3 * in + d] = perm[3 * node_index[element->GetNodeN(in).get()] + d];
+        element->Update();
+        H.Reset(3 * nn, 3 * nn);
+        element->ComputeKRMmatricesGlobal(H, 1.0, 0, 0);
+        for (int i = 0; i < 3 * nn; i++)
+            for (int j = 0; j < 3 * nn; j++)
+                if (H(i, j) != 0)
+                    rowsK[dofs[i]][dofs[j]] += H(i, j);
+        H.Reset(3 * nn, 3 * nn);
+        element->ComputeKRMmatricesGlobal(H, 0, 0, 1.0);
+        for (int i = 0; i < 3 * nn; i++)
+            for (int j = 0; j < 3 * nn; j++)
+                if (H(i, j) != 0)
+                    rowsM[dofs[i]][dofs[j]] += H(i, j);
+    }
+    CSRMatrix K(rowsK, 0, N);
+    CSRMatrix M(rowsM, 0, N);
+    CSRMatrix Kii(rowsK, nb, N);
+    CSRMatrix Mii(rowsM, nb, N);
+    std::vector<double> diagKii = Kii.Diagonal();
+    int ni = N - nb;
+
+    // Craig-Bampton basis T = [I 0; Psi Phi], stored column by column (permuted coordinates).
+    // Static constraint modes: Kii*Psi = -Kib
+    std::vector<std::vector<double> > T;
+    std::vector<double> rhs(ni), psi;
+    for (int j = 0; j < nb; j++) {
+        std::fill(rhs.begin(), rhs.end(), 0.0);
+        for (auto it = rowsK[j].lower_bound(nb); it != rowsK[j].end(); ++it)
+            rhs[it->first - nb] = -it->second;
+        psi.assign(ni, 0.0);
+        if (ni > 0 && !SolvePCG(Kii, diagKii, rhs, psi, tolerance))
+            throw ChException("ChModalReduction: iterative solver failed, interface nodes do not restrain the mesh.");
+        std::vector<double> t(N, 0.0);
+        t[j] = 1;
+        std::copy(psi.begin(), psi.end(), t.begin() + nb);
+        T.push_back(t);
+    }
+
+    // Fixed-interface normal modes: Kii*Phi = Mii*Phi*Lambda
+    int nm = std::min(std::max(n_fixed_modes, 0), ni);
+    if (nm > 0) {
+        std::vector<std::vector<double> > phi;
+        std::vector<double> lambda;
+        SubspaceIteration(Kii, Mii, nm, tolerance, phi, lambda);
+        for (int j = 0; j < nm; j++) {
+            std::vector<double> t(N, 0.0);
+            std::copy(phi[j].begin(), phi[j].end(), t.begin() + nb);
+            T.push_back(t);
+        }
+    }
+
+    // Reduced matrices T'*K*T and T'*M*T, and their eigen-decomposition.
+    int r = (int)T.size();
+    ChMatrixDynamic<> Kr(r, r);
+    ChMatrixDynamic<> Mr(r, r);
+    std::vector<double> KT, MT;
+    for (int b = 0; b < r; b++) {
+        K.Multiply(T[b], KT);
+        M.Multiply(T[b], MT);
+        for (int a = 0; a <= b; a++) {
+            Kr(a, b) = Kr(b, a) = Dot(T[a], KT);
+            Mr(a, b) = Mr(b, a) = Dot(T[a], MT);
+        }
+    }
+    ChVectorDynamic<> lambda;
+    ChMatrixDynamic<> Q;
+    GeneralizedEigen(Kr, Mr, lambda, Q);
+
+    // Drop the six rigid body modes; store the elastic ones as nodal fields.
+    const int nrigid = 6;
+    int ne = std::max(r - nrigid, 0);
+    eigenvalues.Reset(ne);
+    modes.Reset(N, std::max(ne, 1));
+    for (int j = 0; j < ne; j++) {
+        eigenvalues(j) = lambda(nrigid + j);
+        for (int row = 0; row < N; row++) {
+            double u = 0;
+            for (int a = 0; a < r; a++)
+                u += T[a][perm[row]] * Q(a, nrigid + j);
+            modes(row, j) = u;
+        }
+    }
+
+    // Rigid body mass properties, from the mass matrix and the rigid displacement fields.
+    std::vector<std::vector<double> > trasl(3, std::vector<double>(N, 0.0));
+    std::vector<std::vector<double> > coord(3, std::vector<double>(N, 0.0));
+    std::vector<std::vector<double> > rot(3, std::vector<double>(N, 0.0));
+    for (int k = 0; k < nnodes; k++) {
+        ChVector<> axes[3] = {VECT_X, VECT_Y, VECT_Z};
+        double X[3] = {ref_pos[k].x, ref_pos[k].y, ref_pos[k].z};
+        for (int d = 0; d < 3; d++) {
+            trasl[d][perm[3 * k + d]] = 1;
+            coord[d][perm[3 * k + d]] = X[d];
+            ChVector<> u = Vcross(axes[d], ref_pos[k]);
+            rot[d][perm[3 * k + 0]] = u.x;
+            rot[d][perm[3 * k + 1]] = u.y;
+            rot[d][perm[3 * k + 2]] = u.z;
+        }
+    }
+    mass = M.Product(trasl[0], trasl[0]);
+    double c[3];
+    for (int d = 0; d < 3; d++)
+        c[d] = M.Product(trasl[d], coord[d]) / mass;
+    cog = ChVector<>(c[0], c[1], c[2]);
+    for (int a = 0; a < 3; a++)
+        for (int b = 0; b < 3; b++)
+            inertia(a, b) = M.Product(rot[a], rot[b]) - mass * ((a == b ? cog.Length2() : 0) - c[a] * c[b]);
+}
+
+void ChModalReduction::Save(const char* filename) const {
+    ChStreamOutBinaryFile mfile(filename);
+
+    std::string tag("ChModalReduction");
+    mfile << tag;
+    mfile << 1;  // version
+    mfile << GetNnodes() << GetNmodes() << GetNinterfaceNodes();
+    for (int k = 0; k < GetNnodes(); k++)
+        mfile << ref_pos[k].x << ref_pos[k].y << ref_pos[k].z;
+    for (int i = 0; i < GetNinterfaceNodes(); i++)
+        mfile << interface_nodes[i];
+    for (int j = 0; j < GetNmodes(); j++)
+        mfile << eigenvalues(j);
+    for (int row = 0; row < 3 * GetNnodes(); row++)
+        for (int j = 0; j < GetNmodes(); j++)
+            mfile << modes(row, j);
+    mfile << mass << cog.x << cog.y << cog.z;
+    for (int a = 0; a < 3; a++)
+        for (int b = 0; b < 3; b++)
+            mfile << inertia(a, b);
+}
+
+void ChModalReduction::Load(const char* filename) {
+    ChStreamInBinaryFile mfile(filename);
+
+    std::string tag;
+    int version;
+    mfile >> tag >> version;
+    if (tag != "ChModalReduction" || version != 1)
+        throw ChException("ChModalReduction: not a reduced model file.");
+
+    int nnodes, nmodes, niface;
+    mfile >> nnodes >> nmodes >> niface;
+    ref_pos.resize(nnodes);
+    for (int k = 0; k < nnodes; k++)
+        mfile >> ref_pos[k].x >> ref_pos[k].y >> ref_pos[k].z;
+    interface_nodes.resize(niface);
+    for (int i = 0; i < niface; i++)
+        mfile >> interface_nodes[i];
+    eigenvalues.Reset(nmodes);
+    for (int j = 0; j < nmodes; j++)
+        mfile >> eigenvalues(j);
+    modes.Reset(3 * nnodes, std::max(nmodes, 1));
+    for (int row = 0; row < 3 * nnodes; row++)
+        for (int j = 0; j < nmodes; j++)
+            mfile >> modes(row, j);
+    mfile >> mass >> cog.x >> cog.y >> cog.z;
+    for (int a = 0; a < 3; a++)
+        for (int b = 0; b < 3; b++)
+            mfile >> inertia(a, b);
+}
+
+}  // end namespace fea
+}  // end namespace chrono
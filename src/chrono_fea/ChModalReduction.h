@@ -0,0 +1,126 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Component mode synthesis (Craig-Bampton) reduction of a ChMesh
+// =============================================================================
+
+#ifndef CHMODALREDUCTION_H
+#define CHMODALREDUCTION_H
+
+#include <vector>
+
+#include "chrono/core/ChMatrixDynamic.h"
+#include "chrono/core/ChMatrix33.h"
+#include "chrono_fea/ChMesh.h"
+#include "chrono_fea/ChNodeFEAxyz.h"
+
+namespace chrono {
+namespace fea {
+
+/// @addtogroup fea_module
+/// @{
+
+/// Reduced order model of a linear elastic ChMesh, obtained with the Craig-Bampton
+/// component mode synthesis method.
+/// The reduction basis is made of the static constraint modes of the interface nodes
+/// plus a number of fixed-interface normal modes. The reduced stiffness and mass
+/// matrices are then diagonalized: the six rigid body modes are removed and the
+/// remaining elastic modes (mass normalized, hence orthogonal to the rigid body motion,
+/// i.e. satisfying the mean axis conditions) are stored as nodal displacement fields,
+/// together with the rigid body mass properties of the mesh.
+/// The result is meant to be used by a ChReducedFlexibleBody, and it can be saved to
+/// and loaded from a binary file, so that the eigen-analysis is done only once.
+/// Only meshes whose nodes are all ChNodeFEAxyz (ex. tetrahedrons, hexahedrons) are
+/// supported; the mesh must be in its undeformed configuration, and its elements must
+/// have been initialized (ex. by ChSystem::SetupInitial()).
+class ChApiFea ChModalReduction {
+  public:
+    ChModalReduction();
+    ~ChModalReduction() {}
+
+    /// Compute the reduced model of the mesh.
+    /// The interface nodes should restrain the rigid body motion of the mesh (for example,
+    /// at least three non aligned nodes), otherwise the interior stiffness is singular.
+    /// Throws a ChException if the mesh is not supported or the iterative solver fails.
+    void Compute(std::shared_ptr<ChMesh> mesh,                                      ///< mesh to reduce
+                 const std::vector<std::shared_ptr<ChNodeFEAxyz> >& interface_nodes,  ///< interface nodes
+                 int n_fixed_modes                                                   ///< fixed-interface modes
+                 );
+
+    /// Save the reduced model to a binary file.
+    void Save(const char* filename) const;
+
+    /// Load a reduced model previously saved with Save().
+    /// Throws a ChException if the file cannot be read.
+    void Load(const char* filename);
+
+    /// Set the tolerance of the iterative solvers and of the subspace iteration.
+    void SetTolerance(double tol) { tolerance = tol; }
+    double GetTolerance() const { return tolerance; }
+
+    /// Number of nodes of the reduced mesh.
+    int GetNnodes() const { return (int)ref_pos.size(); }
+
+    /// Number of elastic modes, i.e. the number of coordinates of the reduced model.
+    int GetNmodes() const { return eigenvalues.GetRows(); }
+
+    /// Number of interface nodes.
+    int GetNinterfaceNodes() const { return (int)interface_nodes.size(); }
+
+    /// Index (in the mesh node list) of the i-th interface node.
+    int GetInterfaceNodeIndex(int i) const { return interface_nodes[i]; }
+
+    /// Squared circular frequencies of the elastic modes, in ascending order.
+    const ChVectorDynamic<>& GetEigenvalues() const { return eigenvalues; }
+
+    /// Frequency, in Hz, of the j-th elastic mode.
+    double GetFrequency(int j) const;
+
+    /// Total mass of the mesh.
+    double GetMass() const { return mass; }
+
+    /// Center of mass of the mesh, in mesh coordinates.
+    const ChVector<>& GetCOG() const { return cog; }
+
+    /// Inertia tensor of the mesh about its center of mass.
+    const ChMatrix33<>& GetInertia() const { return inertia; }
+
+    /// Reference position of the k-th node, in mesh coordinates.
+    const ChVector<>& GetNodeRefPos(int k) const { return ref_pos[k]; }
+
+    /// Displacement of the k-th node in the j-th elastic mode.
+    ChVector<> GetNodeModeShape(int k, int j) const {
+        return ChVector<>(modes(3 * k, j), modes(3 * k + 1, j), modes(3 * k + 2, j));
+    }
+
+    /// Displacement of the k-th node for the given modal coordinates.
+    ChVector<> GetNodeDisplacement(int k, const ChVectorDynamic<>& q) const;
+
+    /// Project a force applied to the k-th node onto the elastic modes, adding c*U_k'*F to Q.
+    void AddNodeForce(int k, const ChVector<>& F, ChVectorDynamic<>& Q, double c = 1) const;
+
+  private:
+    ChMatrixDynamic<> modes;            ///< elastic mode shapes, 3 rows per node
+    ChVectorDynamic<> eigenvalues;      ///< squared circular frequencies of the elastic modes
+    std::vector<ChVector<> > ref_pos;   ///< node reference positions
+    std::vector<int> interface_nodes;  ///< interface node indexes
+    double mass;
+    ChVector<> cog;
+    ChMatrix33<> inertia;
+    double tolerance;
+};
+
+/// @} fea_module
+
+}  // end namespace fea
+}  // end namespace chrono
+
+#endif
@@ -0,0 +1,251 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Floating frame flexible body, using a reduced (modal) model of a ChMesh
+// =============================================================================
+
+#include <cmath>
+
+#include "chrono/physics/ChSystem.h"
+#include "chrono_fea/ChReducedFlexibleBody.h"
+
+namespace chrono {
+namespace fea {
+
+ChReducedFlexibleBody::ChReducedFlexibleBody(std::shared_ptr<ChModalReduction> model)
+    : model(model),
+      q(model->GetNmodes()),
+      q_dt(model->GetNmodes()),
+      q_dtdt(model->GetNmodes()),
+      Qbuffer(model->GetNmodes()),
+      interface_forces(model->GetNinterfaceNodes(), VNULL),
+      damping_ratio(0),
+      variables(model->GetNmodes()) {
+    std::vector<ChVariables*> mvars;
+    mvars.push_back(&variables);
+    KRM.SetVariables(mvars);
+}
+
+ChReducedFlexibleBody::ChReducedFlexibleBody(const ChReducedFlexibleBody& other)
+    : ChPhysicsItem(other),
+      model(other.model),
+      frame(other.frame),
+      q(other.q),
+      q_dt(other.q_dt),
+      q_dtdt(other.q_dtdt),
+      Qbuffer(other.Qbuffer),
+      interface_forces(other.interface_forces),
+      damping_ratio(other.damping_ratio),
+      variables(other.GetNmodes()) {
+    variables = other.variables;
+    std::vector<ChVariables*> mvars;
+    mvars.push_back(&variables);
+    KRM.SetVariables(mvars);
+}
+
+void ChReducedFlexibleBody::Initialize(std::shared_ptr<ChBody> body, const ChFrame<>& mesh_frame) {
+    frame = body;
+    frame->SetMass(model->GetMass());
+    frame->SetInertia(model->GetInertia());
+    frame->SetPos(mesh_frame.TransformPointLocalToParent(model->GetCOG()));
+    frame->SetRot(mesh_frame.GetRot());
+}
+
+ChVector<> ChReducedFlexibleBody::GetNodePosLocal(int k) const {
+    return model->GetNodeRefPos(k) - model->GetCOG() + model->GetNodeDisplacement(k, q);
+}
+
+ChVector<> ChReducedFlexibleBody::GetNodePos(int k) const {
+    return frame->TransformPointLocalToParent(GetNodePosLocal(k));
+}
+
+ChVector<> ChReducedFlexibleBody::GetNodeVel(int k) const {
+    ChVector<> vel_loc = Vcross(frame->GetWvel_loc(), GetNodePosLocal(k)) + model->GetNodeDisplacement(k, q_dt);
+    return frame->GetPos_dt() + frame->TransformDirectionLocalToParent(vel_loc);
+}
+
+void ChReducedFlexibleBody::UpdateMesh(std::shared_ptr<ChMesh> mesh) const {
+    for (int k = 0; k < model->GetNnodes(); k++) {
+        auto node = std::static_pointer_cast<ChNodeFEAxyz>(mesh->GetNodes()[k]);
+        node->SetPos(GetNodePos(k));
+        node->SetPos_dt(GetNodeVel(k));
+    }
+}
+
+void ChReducedFlexibleBody::ComputeForces(ChVectorDynamic<>& Qmodes,
+                                          ChVector<>& force,
+                                          ChVector<>& torque_loc) const {
+    const ChVectorDynamic<>& lambda = model->GetEigenvalues();
+
+    // elastic and damping forces on the modes
+    for (int j = 0; j < GetNmodes(); j++) {
+        double omega = std::sqrt(std::max(0.0, lambda(j)));
+        Qmodes(j) = -lambda(j) * q(j) - 2 * damping_ratio * omega * q_dt(j);
+    }
+
+    // interface forces: rigid part on the frame, elastic part on the modes
+    force = VNULL;
+    torque_loc = VNULL;
+    for (int i = 0; i < model->GetNinterfaceNodes(); i++) {
+        if (interface_forces[i].IsNull())
+            continue;
+        int k = model->GetInterfaceNodeIndex(i);
+        ChVector<> F_loc = frame->TransformDirectionParentToLocal(interface_forces[i]);
+        force += interface_forces[i];
+        torque_loc += Vcross(GetNodePosLocal(k), F_loc);
+        model->AddNodeForce(k, F_loc, Qmodes);
+    }
+}
+
+//// STATE BOOKKEEPING FUNCTIONS
+
+void ChReducedFlexibleBody::IntStateGather(const unsigned int off_x,  // offset in x state vector
+                                           ChState& x,                // state vector, position part
+                                           const unsigned int off_v,  // offset in v state vector
+                                           ChStateDelta& v,           // state vector, speed part
+                                           double& T                  // time
+                                           ) {
+    x.PasteMatrix(&q, off_x, 0);
+    v.PasteMatrix(&q_dt, off_v, 0);
+    T = GetChTime();
+}
+
+void ChReducedFlexibleBody::IntStateScatter(const unsigned int off_x,  // offset in x state vector
+                                            const ChState& x,          // state vector, position part
+                                            const unsigned int off_v,  // offset in v state vector
+                                            const ChStateDelta& v,     // state vector, speed part
+                                            const double T             // time
+                                            ) {
+    q.PasteClippedMatrix(&x, off_x, 0, GetNmodes(), 1, 0, 0);
+    q_dt.PasteClippedMatrix(&v, off_v, 0, GetNmodes(), 1, 0, 0);
+    Update(T);
+}
+
+void ChReducedFlexibleBody::IntStateGatherAcceleration(const unsigned int off_a, ChStateDelta& a) {
+    a.PasteMatrix(&q_dtdt, off_a, 0);
+}
+
+void ChReducedFlexibleBody::IntStateScatterAcceleration(const unsigned int off_a, const ChStateDelta& a) {
+    q_dtdt.PasteClippedMatrix(&a, off_a, 0, GetNmodes(), 1, 0, 0);
+}
+
+void ChReducedFlexibleBody::IntLoadResidual_F(const unsigned int off,  // offset in R residual
+                                              ChVectorDynamic<>& R,    // result: the R residual, R += c*F
+                                              const double c           // a scaling factor
+                                              ) {
+    ChVector<> force;
+    ChVector<> torque_loc;
+    ComputeForces(Qbuffer, force, torque_loc);
+    for (int j = 0; j < GetNmodes(); j++)
+        R(off + j) += c * Qbuffer(j);
+
+    if (frame && frame->Variables().IsActive()) {
+        R.PasteSumVector(force * c, frame->Variables().GetOffset(), 0);
+        R.PasteSumVector(torque_loc * c, frame->Variables().GetOffset() + 3, 0);
+    }
+}
+
+void ChReducedFlexibleBody::IntLoadResidual_Mv(const unsigned int off,      // offset in R residual
+                                               ChVectorDynamic<>& R,        // result: the R residual, R += c*M*v
+                                               const ChVectorDynamic<>& w,  // the w vector
+                                               const double c               // a scaling factor
+                                               ) {
+    // unit modal masses
+    for (int j = 0; j < GetNmodes(); j++)
+        R(off + j) += c * w(off + j);
+}
+
+void ChReducedFlexibleBody::IntToDescriptor(const unsigned int off_v,  // offset in v, R
+                                            const ChStateDelta& v,
+                                            const ChVectorDynamic<>& R,
+                                            const unsigned int off_L,  // offset in L, Qc
+                                            const ChVectorDynamic<>& L,
+                                            const ChVectorDynamic<>& Qc) {
+    variables.Get_qb().PasteClippedMatrix(&v, off_v, 0, GetNmodes(), 1, 0, 0);
+    variables.Get_fb().PasteClippedMatrix(&R, off_v, 0, GetNmodes(), 1, 0, 0);
+}
+
+void ChReducedFlexibleBody::IntFromDescriptor(const unsigned int off_v,  // offset in v
+                                              ChStateDelta& v,
+                                              const unsigned int off_L,  // offset in L
+                                              ChVectorDynamic<>& L) {
+    v.PasteMatrix(&variables.Get_qb(), off_v, 0);
+}
+
+//// SOLVER FUNCTIONS
+
+void ChReducedFlexibleBody::InjectVariables(ChSystemDescriptor& mdescriptor) {
+    mdescriptor.InsertVariables(&variables);
+}
+
+void ChReducedFlexibleBody::VariablesFbReset() {
+    variables.Get_fb().FillElem(0.0);
+}
+
+void ChReducedFlexibleBody::VariablesFbLoadForces(double factor) {
+    ChVector<> force;
+    ChVector<> torque_loc;
+    ComputeForces(Qbuffer, force, torque_loc);
+    for (int j = 0; j < GetNmodes(); j++)
+        variables.Get_fb().ElementN(j) += factor * Qbuffer(j);
+
+    if (frame && frame->Variables().IsActive()) {
+        frame->Variables().Get_fb().PasteSumVector(force * factor, 0, 0);
+        frame->Variables().Get_fb().PasteSumVector(torque_loc * factor, 3, 0);
+    }
+}
+
+void ChReducedFlexibleBody::VariablesFbIncrementMq() {
+    variables.Compute_inc_Mb_v(variables.Get_fb(), variables.Get_qb());
+}
+
+void ChReducedFlexibleBody::VariablesQbLoadSpeed() {
+    // set current speed in 'qb', it can be used by the solver when working in incremental mode
+    variables.Get_qb().CopyFromMatrix(q_dt);
+}
+
+void ChReducedFlexibleBody::VariablesQbSetSpeed(double step) {
+    for (int j = 0; j < GetNmodes(); j++) {
+        double old_dt = q_dt(j);
+        q_dt(j) = variables.Get_qb().ElementN(j);
+
+        // Compute accel. by BDF (approximate by differentiation);
+        if (step)
+            q_dtdt(j) = (q_dt(j) - old_dt) / step;
+    }
+}
+
+void ChReducedFlexibleBody::VariablesQbIncrementPosition(double step) {
+    // ADVANCE POSITION: q' = q + dt * q_dt
+    for (int j = 0; j < GetNmodes(); j++)
+        q(j) += variables.Get_qb().ElementN(j) * step;
+}
+
+void ChReducedFlexibleBody::InjectKRMmatrices(ChSystemDescriptor& mdescriptor) {
+    mdescriptor.InsertKblock(&KRM);
+}
+
+void ChReducedFlexibleBody::KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) {
+    const ChVectorDynamic<>& lambda = model->GetEigenvalues();
+    ChMatrix<>& H = *KRM.Get_K();
+    for (int j = 0; j < GetNmodes(); j++) {
+        double omega = std::sqrt(std::max(0.0, lambda(j)));
+        H(j, j) = Kfactor * lambda(j) + Rfactor * 2 * damping_ratio * omega;
+    }
+}
+
+void ChReducedFlexibleBody::SetNoSpeedNoAcceleration() {
+    q_dt.FillElem(0.0);
+    q_dtdt.FillElem(0.0);
+}
+
+}  // end namespace fea
+}  // end namespace chrono
@@ -0,0 +1,188 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Floating frame flexible body, using a reduced (modal) model of a ChMesh
+// =============================================================================
+
+#ifndef CHREDUCEDFLEXIBLEBODY_H
+#define CHREDUCEDFLEXIBLEBODY_H
+
+#include "chrono/physics/ChBody.h"
+#include "chrono/solver/ChKblockGeneric.h"
+#include "chrono/solver/ChVariablesGenericDiagonalMass.h"
+#include "chrono_fea/ChModalReduction.h"
+
+namespace chrono {
+namespace fea {
+
+/// @addtogroup fea_module
+/// @{
+
+/// Flexible body with small deformations, described by a floating reference frame
+/// plus the elastic modes of a ChModalReduction.
+/// The floating frame is a ChBody (placed at the center of mass of the mesh, and
+/// carrying its rigid body mass properties) that must be added to the system
+/// separately; joints, motors and forces can be attached to it as usual. This item
+/// adds the modal coordinates q, with unit modal masses, stiffness w_j^2 and
+/// optional modal damping.
+/// Since the elastic modes satisfy the mean axis conditions, the inertial coupling
+/// between the rigid and elastic motion vanishes at first order and is neglected
+/// (no centrifugal stiffening or gyroscopic terms on the modes).
+/// External forces can be applied at the interface nodes: they act on both the
+/// floating frame and the elastic modes.
+class ChApiFea ChReducedFlexibleBody : public ChPhysicsItem {
+    // Chrono simulation of RTTI, needed for serialization
+    CH_RTTI(ChReducedFlexibleBody, ChPhysicsItem);
+
+  public:
+    ChReducedFlexibleBody(std::shared_ptr<ChModalReduction> model);
+    ChReducedFlexibleBody(const ChReducedFlexibleBody& other);
+    ~ChReducedFlexibleBody() {}
+
+    /// "Virtual" copy constructor (covariant return type).
+    virtual ChReducedFlexibleBody* Clone() const override { return new ChReducedFlexibleBody(*this); }
+
+    /// Use the given body as the floating frame: its mass and inertia are set from the
+    /// reduced model, and it is placed at the center of mass of the mesh, with the mesh
+    /// reference frame at the given absolute position.
+    void Initialize(std::shared_ptr<ChBody> body, const ChFrame<>& mesh_frame = ChFrame<>());
+
+    /// Access the reduced model.
+    std::shared_ptr<ChModalReduction> GetModel() const { return model; }
+
+    /// Access the floating frame body.
+    std::shared_ptr<ChBody> GetFrameBody() const { return frame; }
+
+    /// Set the damping ratio of all the elastic modes.
+    void SetModalDamping(double zeta) { damping_ratio = zeta; }
+    double GetModalDamping() const { return damping_ratio; }
+
+    /// Number of elastic modes.
+    int GetNmodes() const { return model->GetNmodes(); }
+
+    /// Modal coordinates and their time derivatives.
+    const ChVectorDynamic<>& GetModalCoordinates() const { return q; }
+    const ChVectorDynamic<>& GetModalCoordinates_dt() const { return q_dt; }
+    const ChVectorDynamic<>& GetModalCoordinates_dtdt() const { return q_dtdt; }
+    void SetModalCoordinates(const ChVectorDynamic<>& mq) { q = mq; }
+    void SetModalCoordinates_dt(const ChVectorDynamic<>& mq_dt) { q_dt = mq_dt; }
+
+    /// Position of the k-th mesh node, relative to the center of mass, in the floating frame.
+    ChVector<> GetNodePosLocal(int k) const;
+
+    /// Absolute position of the k-th mesh node.
+    ChVector<> GetNodePos(int k) const;
+
+    /// Absolute velocity of the k-th mesh node.
+    ChVector<> GetNodeVel(int k) const;
+
+    /// Absolute position of the i-th interface node.
+    ChVector<> GetInterfaceNodePos(int i) const { return GetNodePos(model->GetInterfaceNodeIndex(i)); }
+
+    /// Absolute velocity of the i-th interface node.
+    ChVector<> GetInterfaceNodeVel(int i) const { return GetNodeVel(model->GetInterfaceNodeIndex(i)); }
+
+    /// Set the force applied to the i-th interface node, in absolute coordinates.
+    void SetInterfaceForce(int i, const ChVector<>& force) { interface_forces[i] = force; }
+    const ChVector<>& GetInterfaceForce(int i) const { return interface_forces[i]; }
+
+    /// Copy the current (deformed) node positions and velocities into the nodes of the
+    /// original mesh, for example for visualization or postprocessing.
+    /// The mesh must be the one that was reduced, and it should not be part of the system.
+    void UpdateMesh(std::shared_ptr<ChMesh> mesh) const;
+
+    //
+    // STATE FUNCTIONS
+    //
+
+    /// Number of coordinates: the elastic modes.
+    virtual int GetDOF() override { return GetNmodes(); }
+
+    /// Returns reference to the encapsulated ChVariables (the modal coordinates).
+    ChVariablesGenericDiagonalMass& Variables() { return variables; }
+
+    // (override/implement interfaces for global state vectors, see ChPhysicsItem for comments.)
+    virtual void IntStateGather(const unsigned int off_x,
+                                ChState& x,
+                                const unsigned int off_v,
+                                ChStateDelta& v,
+                                double& T) override;
+    virtual void IntStateScatter(const unsigned int off_x,
+                                 const ChState& x,
+                                 const unsigned int off_v,
+                                 const ChStateDelta& v,
+                                 const double T) override;
+    virtual void IntStateGatherAcceleration(const unsigned int off_a, ChStateDelta& a) override;
+    virtual void IntStateScatterAcceleration(const unsigned int off_a, const ChStateDelta& a) override;
+    virtual void IntLoadResidual_F(const unsigned int off, ChVectorDynamic<>& R, const double c) override;
+    virtual void IntLoadResidual_Mv(const unsigned int off,
+                                    ChVectorDynamic<>& R,
+                                    const ChVectorDynamic<>& w,
+                                    const double c) override;
+    virtual void IntToDescriptor(const unsigned int off_v,
+                                 const ChStateDelta& v,
+                                 const ChVectorDynamic<>& R,
+                                 const unsigned int off_L,
+                                 const ChVectorDynamic<>& L,
+                                 const ChVectorDynamic<>& Qc) override;
+    virtual void IntFromDescriptor(const unsigned int off_v,
+                                   ChStateDelta& v,
+                                   const unsigned int off_L,
+                                   ChVectorDynamic<>& L) override;
+
+    //
+    // SOLVER FUNCTIONS
+    //
+
+    virtual void InjectVariables(ChSystemDescriptor& mdescriptor) override;
+    virtual void VariablesFbReset() override;
+    virtual void VariablesFbLoadForces(double factor = 1) override;
+    virtual void VariablesQbLoadSpeed() override;
+    virtual void VariablesFbIncrementMq() override;
+    virtual void VariablesQbSetSpeed(double step = 0) override;
+    virtual void VariablesQbIncrementPosition(double step) override;
+
+    /// Tell to a system descriptor that there is a ChKblock with the modal stiffness and damping.
+    virtual void InjectKRMmatrices(ChSystemDescriptor& mdescriptor) override;
+
+    /// Load the modal stiffness and damping, scaled by Kfactor and Rfactor (the modal
+    /// mass is handled by the ChVariables).
+    virtual void KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) override;
+
+    /// Set no speed and no accelerations of the modal coordinates.
+    virtual void SetNoSpeedNoAcceleration() override;
+
+  private:
+    /// Compute the generalized forces on the modes (Qmodes), and the force and torque (in
+    /// frame coordinates, about the center of mass) on the floating frame.
+    void ComputeForces(ChVectorDynamic<>& Qmodes, ChVector<>& force, ChVector<>& torque_loc) const;
+
+    std::shared_ptr<ChModalReduction> model;
+    std::shared_ptr<ChBody> frame;
+
+    ChVectorDynamic<> q;       ///< modal coordinates
+    ChVectorDynamic<> q_dt;    ///< modal velocities
+    ChVectorDynamic<> q_dtdt;  ///< modal accelerations
+    ChVectorDynamic<> Qbuffer;  ///< work vector for the modal forces
+
+    std::vector<ChVector<> > interface_forces;  ///< forces at interface nodes (absolute)
+    double damping_ratio;
+
+    ChVariablesGenericDiagonalMass variables;
+    ChKblockGeneric KRM;
+};
+
+/// @} fea_module
+
+}  // end namespace fea
+}  // end namespace chrono
+
+#endif
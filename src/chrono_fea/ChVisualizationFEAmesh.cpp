@@ -59,6 +59,12 @@ ChVisualizationFEAmesh::ChVisualizationFEAmesh(ChMesh& mymesh) {
 
 	undeformed_reference = false;
 
+    cached_topology = false;
+    update_interval = 0;
+    last_update_time = 0;
+    last_update_valid = false;
+    cache_valid = false;
+
     auto new_mesh_asset = std::make_shared<ChTriangleMeshShape>();
 	this->AddAsset(new_mesh_asset);
 
@@ -280,33 +286,7 @@ void ChVisualizationFEAmesh::UpdateBuffers_Hex(std::shared_ptr<ChElementBase> el
     }
 }
 
-void ChVisualizationFEAmesh::Update(ChPhysicsItem* updater, const ChCoordsys<>& coords) {
-	if (!this->FEMmesh) 
-		return;
-
-	std::shared_ptr<ChTriangleMeshShape> mesh_asset;
-	std::shared_ptr<ChGlyphs>			 glyphs_asset;
-
-	// try to retrieve previously added mesh asset and glyhs asset in sublevel..
-    if (this->GetAssets().size() == 2) {
-        mesh_asset = std::dynamic_pointer_cast<ChTriangleMeshShape>(GetAssets()[0]);
-        glyphs_asset = std::dynamic_pointer_cast<ChGlyphs>(GetAssets()[1]);
-    }
-
-	// if not available, create ...
-    if (!mesh_asset) {
-		this->GetAssets().resize(0); // this to delete other sub assets that are not in mesh & glyphs, if any
-
-        auto new_mesh_asset = std::make_shared<ChTriangleMeshShape>();
-		this->AddAsset(new_mesh_asset);
-		mesh_asset = new_mesh_asset;
-
-        auto new_glyphs_asset = std::make_shared<ChGlyphs>();
-		this->AddAsset(new_glyphs_asset);
-		glyphs_asset = new_glyphs_asset;
-	}
-	geometry::ChTriangleMeshConnected& trianglemesh = mesh_asset->GetMesh();
-
+void ChVisualizationFEAmesh::UpdateBuffers_Full(geometry::ChTriangleMeshConnected& trianglemesh) {
 	size_t n_verts = 0;
 	size_t n_vcols = 0;
 	size_t n_vnorms = 0;
@@ -1000,6 +980,207 @@ void ChVisualizationFEAmesh::Update(ChPhysicsItem* updater, const ChCoordsys<>&
 
 		TriangleNormalsSmooth( trianglemesh.getCoordsNormals(), normal_accumulators);
 	}
+}
+
+// Quantities that, if unchanged, guarantee that the triangle mesh keeps the same connectivity.
+std::vector<size_t> ChVisualizationFEAmesh::ComputeTopologySignature() {
+    size_t n_loadfaces = 0;
+    for (unsigned int isu = 0; isu < this->FEMmesh->GetNmeshSurfaces(); ++isu)
+        n_loadfaces += this->FEMmesh->GetMeshSurface(isu)->GetFacesList().size();
+    size_t n_contactfaces = 0;
+    for (unsigned int isu = 0; isu < this->FEMmesh->GetNcontactSurfaces(); ++isu)
+        if (auto msurface = std::dynamic_pointer_cast<ChContactSurfaceMesh>(this->FEMmesh->GetContactSurface(isu)))
+            n_contactfaces += msurface->GetTriangleList().size();
+
+    std::vector<size_t> signature;
+    signature.push_back((size_t)this->fem_data_type);
+    signature.push_back((size_t)this->smooth_faces);
+    signature.push_back((size_t)this->FEMmesh->GetNelements());
+    signature.push_back((size_t)this->FEMmesh->GetNnodes());
+    signature.push_back(n_loadfaces);
+    signature.push_back(n_contactfaces);
+    return signature;
+}
+
+// Record the node (and element) each vertex was computed from by UpdateBuffers_Full(), in the
+// same order. Return false if some vertexes cannot be updated this way (beams, shells).
+bool ChVisualizationFEAmesh::BuildVertexSources(geometry::ChTriangleMeshConnected& trianglemesh) {
+    vertex_sources.clear();
+    vertex_groups.clear();
+
+    if (this->fem_data_type != E_PLOT_NONE &&
+        this->fem_data_type != E_PLOT_LOADSURFACES &&
+        this->fem_data_type != E_PLOT_CONTACTSURFACES) {
+        for (unsigned int iel = 0; iel < this->FEMmesh->GetNelements(); ++iel) {
+            std::shared_ptr<ChElementBase> element = this->FEMmesh->GetElement(iel);
+            VertexGroup group = {(unsigned int)vertex_sources.size(), 0, true};
+            if (std::dynamic_pointer_cast<ChElementTetra_4>(element)) {
+                group.count = 4;
+            } else if (std::dynamic_pointer_cast<ChElementTetra_4_P>(element)) {
+                group.count = 4;
+            } else if (std::dynamic_pointer_cast<ChElementHexa_8>(element) ||
+                       std::dynamic_pointer_cast<ChElementBrick>(element) ||
+                       std::dynamic_pointer_cast<ChElementBrick_9>(element)) {
+                group.count = 8;
+            } else if (std::dynamic_pointer_cast<ChElementBeam>(element) ||
+                       std::dynamic_pointer_cast<ChElementShell>(element)) {
+                return false;
+            }
+            for (unsigned int in = 0; in < group.count; ++in) {
+                VertexSource source;
+                source.node = std::dynamic_pointer_cast<ChNodeFEAxyz>(element->GetNodeN(in));
+                source.nodeP = std::dynamic_pointer_cast<ChNodeFEAxyzP>(element->GetNodeN(in));
+                source.element = (int)iel;
+                source.node_index = (int)in;
+                vertex_sources.push_back(source);
+            }
+            if (group.count)
+                vertex_groups.push_back(group);
+        }
+    }
+
+    if (this->fem_data_type == E_PLOT_LOADSURFACES) {
+        for (unsigned int isu = 0; isu < this->FEMmesh->GetNmeshSurfaces(); ++isu) {
+            std::shared_ptr<ChMeshSurface> msurface = this->FEMmesh->GetMeshSurface(isu);
+            for (unsigned int ifa = 0; ifa < msurface->GetFacesList().size(); ++ifa) {
+                auto mfacetetra = std::dynamic_pointer_cast<ChFaceTetra_4>(msurface->GetFacesList()[ifa]);
+                if (!mfacetetra)
+                    return false;
+                VertexGroup group = {(unsigned int)vertex_sources.size(), 3, false};
+                for (int in = 0; in < 3; ++in) {
+                    VertexSource source;
+                    source.node = mfacetetra->GetNodeN(in);
+                    source.element = -1;
+                    source.node_index = in;
+                    vertex_sources.push_back(source);
+                }
+                vertex_groups.push_back(group);
+            }
+        }
+    }
+
+    if (this->fem_data_type == E_PLOT_CONTACTSURFACES) {
+        for (unsigned int isu = 0; isu < this->FEMmesh->GetNcontactSurfaces(); ++isu) {
+            if (auto msurface = std::dynamic_pointer_cast<ChContactSurfaceMesh>(this->FEMmesh->GetContactSurface(isu))) {
+                for (unsigned int ifa = 0; ifa < msurface->GetTriangleList().size(); ++ifa) {
+                    std::shared_ptr<ChContactTriangleXYZ> mface = msurface->GetTriangleList()[ifa];
+                    VertexGroup group = {(unsigned int)vertex_sources.size(), 3, false};
+                    std::shared_ptr<ChNodeFEAxyz> fnodes[3] = {mface->GetNode1(), mface->GetNode2(), mface->GetNode3()};
+                    for (int in = 0; in < 3; ++in) {
+                        VertexSource source;
+                        source.node = fnodes[in];
+                        source.element = -1;
+                        source.node_index = in;
+                        vertex_sources.push_back(source);
+                    }
+                    vertex_groups.push_back(group);
+                }
+            }
+        }
+    }
+
+    for (size_t iv = 0; iv < vertex_sources.size(); ++iv) {
+        if (!vertex_sources[iv].node && !vertex_sources[iv].nodeP)
+            return false;
+    }
+
+    return vertex_sources.size() == trianglemesh.getCoordsVertices().size() &&
+           vertex_sources.size() == trianglemesh.getCoordsColors().size();
+}
+
+// Update positions, colours and normals of the vertexes, keeping the connectivity of the
+// triangles built by the last UpdateBuffers_Full().
+void ChVisualizationFEAmesh::UpdateBuffers_Cached(geometry::ChTriangleMeshConnected& trianglemesh) {
+    std::vector<ChVector<> >& vertexes = trianglemesh.getCoordsVertices();
+    std::vector<ChVector<float> >& colors = trianglemesh.getCoordsColors();
+    ChVector<float> surface_color(meshcolor.R, meshcolor.G, meshcolor.B);
+
+#pragma omp parallel for schedule(dynamic, 64)
+    for (int ig = 0; ig < (int)vertex_groups.size(); ++ig) {
+        const VertexGroup& group = vertex_groups[ig];
+        ChVector<> vc(0, 0, 0);
+        for (unsigned int iv = group.first; iv < group.first + group.count; ++iv) {
+            const VertexSource& source = vertex_sources[iv];
+            if (source.node) {
+                if (undeformed_reference && source.element >= 0)
+                    vertexes[iv] = source.node->GetX0();
+                else
+                    vertexes[iv] = source.node->GetPos();
+                colors[iv] = (source.element >= 0)
+                                 ? ComputeFalseColor(ComputeScalarOutput(source.node, source.node_index,
+                                                                         FEMmesh->GetElement(source.element)))
+                                 : surface_color;
+            } else {
+                vertexes[iv] = source.nodeP->GetPos();
+                colors[iv] = ComputeFalseColor(
+                    ComputeScalarOutput(source.nodeP, source.node_index, FEMmesh->GetElement(source.element)));
+            }
+            vc += vertexes[iv];
+        }
+        if (this->shrink_elements && group.shrinkable) {
+            vc = vc * (1.0 / group.count);  // average, center of element
+            for (unsigned int iv = group.first; iv < group.first + group.count; ++iv)
+                vertexes[iv] = vc + this->shrink_factor * (vertexes[iv] - vc);
+        }
+    }
+
+    if (this->smooth_faces) {
+        TriangleNormalsReset(trianglemesh.getCoordsNormals(), normal_accumulators);
+        for (unsigned int itri = 0; itri < trianglemesh.getIndicesVertexes().size(); ++itri)
+            TriangleNormalsCompute(trianglemesh.getIndicesNormals()[itri], trianglemesh.getIndicesVertexes()[itri],
+                                   trianglemesh.getCoordsVertices(), trianglemesh.getCoordsNormals(),
+                                   normal_accumulators);
+        TriangleNormalsSmooth(trianglemesh.getCoordsNormals(), normal_accumulators);
+    }
+}
+
+void ChVisualizationFEAmesh::Update(ChPhysicsItem* updater, const ChCoordsys<>& coords) {
+	if (!this->FEMmesh) 
+		return;
+
+    // throttle the updates to the requested interval of simulated time
+    if (this->update_interval > 0 && updater) {
+        double mtime = updater->GetChTime();
+        if (this->last_update_valid && mtime >= this->last_update_time &&
+            mtime < this->last_update_time + this->update_interval * (1 - 1e-9))
+            return;
+        this->last_update_time = mtime;
+        this->last_update_valid = true;
+    }
+
+	std::shared_ptr<ChTriangleMeshShape> mesh_asset;
+	std::shared_ptr<ChGlyphs>			 glyphs_asset;
+
+	// try to retrieve previously added mesh asset and glyhs asset in sublevel..
+    if (this->GetAssets().size() == 2) {
+        mesh_asset = std::dynamic_pointer_cast<ChTriangleMeshShape>(GetAssets()[0]);
+        glyphs_asset = std::dynamic_pointer_cast<ChGlyphs>(GetAssets()[1]);
+    }
+
+	// if not available, create ...
+    if (!mesh_asset) {
+		this->GetAssets().resize(0); // this to delete other sub assets that are not in mesh & glyphs, if any
+
+        auto new_mesh_asset = std::make_shared<ChTriangleMeshShape>();
+		this->AddAsset(new_mesh_asset);
+		mesh_asset = new_mesh_asset;
+
+        auto new_glyphs_asset = std::make_shared<ChGlyphs>();
+		this->AddAsset(new_glyphs_asset);
+		glyphs_asset = new_glyphs_asset;
+	}
+	geometry::ChTriangleMeshConnected& trianglemesh = mesh_asset->GetMesh();
+
+    if (this->cached_topology && this->cache_valid && ComputeTopologySignature() == this->cached_signature &&
+        trianglemesh.getCoordsVertices().size() == this->vertex_sources.size()) {
+        UpdateBuffers_Cached(trianglemesh);
+    } else {
+        UpdateBuffers_Full(trianglemesh);
+        if (this->cached_topology) {
+            this->cache_valid = BuildVertexSources(trianglemesh);
+            this->cached_signature = ComputeTopologySignature();
+        }
+    }
 
 	// other flags
 	mesh_asset->SetWireframe( this->wireframe );
@@ -110,6 +110,31 @@ class ChApiFea ChVisualizationFEAmesh : public ChAssetLevel {
 
     std::vector<int> normal_accumulators;
 
+    bool cached_topology;
+    double update_interval;
+    double last_update_time;
+    bool last_update_valid;
+
+    // Where each vertex of the triangle mesh takes its position and colour from, for the
+    // cached update: a node of an element (with the index of the element in the mesh), or a
+    // node of a surface (element = -1, drawn with the mesh colour).
+    struct VertexSource {
+        std::shared_ptr<ChNodeFEAxyz> node;
+        std::shared_ptr<ChNodeFEAxyzP> nodeP;
+        int element;
+        int node_index;
+    };
+    // Vertexes of the same element or face are consecutive; the groups are shrunk together.
+    struct VertexGroup {
+        unsigned int first;
+        unsigned int count;
+        bool shrinkable;
+    };
+    std::vector<VertexSource> vertex_sources;
+    std::vector<VertexGroup> vertex_groups;
+    std::vector<size_t> cached_signature;
+    bool cache_valid;
+
   public:
     //
     // CONSTRUCTORS
@@ -192,6 +217,28 @@ class ChApiFea ChVisualizationFEAmesh : public ChAssetLevel {
     // undeformed (the reference position).
     void SetDrawInUndeformedReference(bool mdu) { this->undeformed_reference = mdu; }
 
+    /// Enable the cached update of the triangle mesh (default: false). The connectivity of the
+    /// triangles is built once, and later updates only recompute vertex positions, colours and
+    /// normals, in parallel. The cache is rebuilt automatically if the number of elements, nodes
+    /// or faces changes, or if the plotted data type changes; call ResetCachedTopology() after
+    /// other changes to the mesh. Meshes with beams or shells always use the full update.
+    void SetCachedTopology(bool mcached) {
+        this->cached_topology = mcached;
+        ResetCachedTopology();
+    }
+    bool GetCachedTopology() const { return this->cached_topology; }
+
+    /// Force a full rebuild of the triangle mesh at the next update.
+    void ResetCachedTopology() { this->cache_valid = false; }
+
+    /// Update the triangle mesh at most once every mint seconds of simulated time, for example
+    /// at the output frame rate, whatever the time step (default: 0, at each update).
+    void SetUpdateInterval(double mint) {
+        this->update_interval = mint;
+        this->last_update_valid = false;
+    }
+    double GetUpdateInterval() const { return this->update_interval; }
+
     // Updates the triangle visualization mesh so that it matches with the
     // FEM mesh (ex. tetrahedrons are converted in 4 surfaces, etc.
     virtual void Update(ChPhysicsItem* updater, const ChCoordsys<>& coords);
@@ -209,6 +256,10 @@ class ChApiFea ChVisualizationFEAmesh : public ChAssetLevel {
                            unsigned int& i_vnorms,
                            unsigned int& i_vcols,
                            unsigned int& i_triindex);
+    void UpdateBuffers_Full(geometry::ChTriangleMeshConnected& trianglemesh);
+    void UpdateBuffers_Cached(geometry::ChTriangleMeshConnected& trianglemesh);
+    bool BuildVertexSources(geometry::ChTriangleMeshConnected& trianglemesh);
+    std::vector<size_t> ComputeTopologySignature();
 };
 
 }  // END_OF_NAMESPACE____
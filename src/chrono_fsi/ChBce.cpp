@@ -0,0 +1,443 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Author: Arman Pazouki
+// =============================================================================
+//
+// Base class for processing boundary condition enforcing (bce) markers forces
+// in fsi system.//
+// OpenMP (CPU) implementation, compiled instead of ChBce.cu when
+// CHRONO_FSI_USE_CUDA is not defined.
+// =============================================================================
+
+#include "chrono_fsi/ChBce.cuh" //for FsiGeneralData
+#include "chrono_fsi/ChDeviceUtils.cuh"
+#include "chrono_fsi/ChSphGeneral.cuh"
+#include <stdexcept>
+#include <thrust/reduce.h>
+
+namespace chrono {
+namespace fsi {
+
+//--------------------------------------------------------------------------------------------------------------------------------
+// collide a particle against all other particles in a given cell
+static inline void BCE_modification_Share(
+    Real3 &sumVW, Real &sumWAll, Real3 &sumRhoRW, Real &sumPW, Real &sumWFluid,
+    int &isAffectedV, int &isAffectedP, int3 gridPos, Real3 posRadA,
+    const Real3 *sortedPosRad, const Real3 *sortedVelMas,
+    const Real4 *sortedRhoPreMu, const uint *cellStart, const uint *cellEnd) {
+  uint gridHash = calcGridHash(gridPos);
+  // empty cells have cellStart == cellEnd
+  uint startIndex = cellStart[gridHash];
+  uint endIndex = cellEnd[gridHash];
+  for (uint j = startIndex; j < endIndex; j++) {
+    Real3 posRadB = sortedPosRad[j];
+    Real3 dist3 = Distance(posRadA, posRadB);
+    Real d = length(dist3);
+    Real4 rhoPresMuB = sortedRhoPreMu[j];
+    if (d > RESOLUTION_LENGTH_MULT * paramsD.HSML || rhoPresMuB.w > -.1)
+      continue;
+
+    Real Wd = W3(d);
+    Real WdOvRho = Wd / rhoPresMuB.x;
+    isAffectedV = 1;
+    Real3 velMasB = sortedVelMas[j];
+    sumVW += velMasB * WdOvRho;
+    sumWAll += WdOvRho;
+
+    isAffectedP = 1;
+    sumRhoRW += rhoPresMuB.x * dist3 * WdOvRho;
+    sumPW += rhoPresMuB.y * WdOvRho;
+    sumWFluid += WdOvRho;
+  }
+}
+//--------------------------------------------------------------------------------------------------------------------------------
+ChBce::ChBce(SphMarkerDataD *otherSortedSphMarkersD,
+             ProximityDataD *otherMarkersProximityD,
+             FsiGeneralData *otherFsiGeneralData, SimParams *otherParamsH,
+             NumberOfObjects *otherNumObjects)
+    : sortedSphMarkersD(otherSortedSphMarkersD),
+      markersProximityD(otherMarkersProximityD),
+      fsiGeneralData(otherFsiGeneralData), paramsH(otherParamsH),
+      numObjectsH(otherNumObjects) {}
+//--------------------------------------------------------------------------------------------------------------------------------
+void ChBce::Finalize(SphMarkerDataD *sphMarkersD, FsiBodiesDataD *fsiBodiesD) {
+  paramsD = *paramsH;
+  numObjectsD = *numObjectsH;
+
+  totalSurfaceInteractionRigid4.resize(numObjectsH->numRigidBodies);
+  dummyIdentify.resize(numObjectsH->numRigidBodies);
+  torqueMarkersD.resize(numObjectsH->numRigid_SphMarkers);
+
+  // Resizing the arrays used to modify the BCE velocity and pressure according
+  // to ADAMI
+  int numRigidAndBoundaryMarkers =
+      fsiGeneralData->referenceArray[2 + numObjectsH->numRigidBodies - 1].y -
+      fsiGeneralData->referenceArray[0].y;
+  if ((numObjectsH->numBoundaryMarkers + numObjectsH->numRigid_SphMarkers) !=
+      numRigidAndBoundaryMarkers) {
+    throw std::runtime_error(
+        "Error! number of rigid and boundary markers are saved incorrectly!\n");
+  }
+  velMas_ModifiedBCE.resize(numRigidAndBoundaryMarkers);
+  rhoPreMu_ModifiedBCE.resize(numRigidAndBoundaryMarkers);
+
+  // Populate local position of BCE markers
+  Populate_RigidSPH_MeshPos_LRF(sphMarkersD, fsiBodiesD);
+}
+//--------------------------------------------------------------------------------------------------------------------------------
+ChBce::~ChBce() {}
+
+////--------------------------------------------------------------------------------------------------------------------------------
+void ChBce::MakeRigidIdentifier() {
+  if (numObjectsH->numRigidBodies > 0) {
+    for (int rigidSphereA = 0; rigidSphereA < numObjectsH->numRigidBodies;
+         rigidSphereA++) {
+      int4 referencePart = fsiGeneralData->referenceArray[2 + rigidSphereA];
+      if (referencePart.z != 1) {
+        throw std::runtime_error("Error! in accessing rigid bodies. Reference "
+                                 "array indexing is wrong, MakeRigidIdentifier!\n");
+      }
+      int2 updatePortion = mI2(referencePart); // first two component of the
+                                               // referenceArray denote to the
+                                               // fluid and boundary particles
+      thrust::fill(fsiGeneralData->rigidIdentifierD.begin() +
+                       (updatePortion.x - numObjectsH->startRigidMarkers),
+                   fsiGeneralData->rigidIdentifierD.begin() +
+                       (updatePortion.y - numObjectsH->startRigidMarkers),
+                   rigidSphereA);
+    }
+  }
+}
+////--------------------------------------------------------------------------------------------------------------------------------
+
+void ChBce::Populate_RigidSPH_MeshPos_LRF(SphMarkerDataD *sphMarkersD,
+                                          FsiBodiesDataD *fsiBodiesD) {
+  if (numObjectsH->numRigidBodies == 0) {
+    return;
+  }
+
+  MakeRigidIdentifier();
+
+  Real3 *rigidSPH_MeshPos_LRF_D =
+      mR3CAST(fsiGeneralData->rigidSPH_MeshPos_LRF_D);
+  const Real3 *posRadD = mR3CAST(sphMarkersD->posRadD);
+  const uint *rigidIdentifierD = U1CAST(fsiGeneralData->rigidIdentifierD);
+  const Real3 *posRigidD = mR3CAST(fsiBodiesD->posRigid_fsiBodies_D);
+  const Real4 *qD = mR4CAST(fsiBodiesD->q_fsiBodies_D);
+  const int numRigid_SphMarkers = numObjectsH->numRigid_SphMarkers;
+  const int startRigidMarkers = numObjectsH->startRigidMarkers;
+
+#pragma omp parallel for
+  for (int index = 0; index < numRigid_SphMarkers; index++) {
+    int rigidIndex = rigidIdentifierD[index];
+    uint rigidMarkerIndex = index + startRigidMarkers;
+    Real3 a1, a2, a3;
+    RotationMatirixFromQuaternion(a1, a2, a3, qD[rigidIndex]);
+    Real3 dist3 = posRadD[rigidMarkerIndex] - posRigidD[rigidIndex];
+    rigidSPH_MeshPos_LRF_D[index] =
+        InverseRotate_By_RotationMatrix_DeviceHost(a1, a2, a3, dist3);
+  }
+
+  UpdateRigidMarkersPositionVelocity(sphMarkersD, fsiBodiesD);
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+void ChBce::RecalcSortedVelocityPressure_BCE(
+    thrust::device_vector<Real3> &velMas_ModifiedBCE,
+    thrust::device_vector<Real4> &rhoPreMu_ModifiedBCE,
+    const thrust::device_vector<Real3> &sortedPosRad,
+    const thrust::device_vector<Real3> &sortedVelMas,
+    const thrust::device_vector<Real4> &sortedRhoPreMu,
+    const thrust::device_vector<uint> &cellStart,
+    const thrust::device_vector<uint> &cellEnd,
+    const thrust::device_vector<uint> &mapOriginalToSorted,
+    const thrust::device_vector<Real3> &bceAcc, int2 updatePortion) {
+  Real3 *velMasBceD = mR3CAST(velMas_ModifiedBCE);
+  Real4 *rhoPreMuBceD = mR4CAST(rhoPreMu_ModifiedBCE);
+  const Real3 *sortedPosRadD = mR3CAST(sortedPosRad);
+  const Real3 *sortedVelMasD = mR3CAST(sortedVelMas);
+  const Real4 *sortedRhoPreMuD = mR4CAST(sortedRhoPreMu);
+  const uint *cellStartD = U1CAST(cellStart);
+  const uint *cellEndD = U1CAST(cellEnd);
+  const uint *mapOriginalToSortedD = U1CAST(mapOriginalToSorted);
+  const Real3 *bceAccD = bceAcc.size() ? mR3CAST(bceAcc) : NULL;
+  const int numBce = updatePortion.y - updatePortion.x;
+
+  int isError = 0;
+#pragma omp parallel for schedule(dynamic, 64) reduction(|| : isError)
+  for (int bceIndex = 0; bceIndex < numBce; bceIndex++) {
+    uint sphIndex = bceIndex + updatePortion.x;
+    uint idA = mapOriginalToSortedD[sphIndex];
+    Real4 rhoPreMuA = sortedRhoPreMuD[idA];
+    Real3 posRadA = sortedPosRadD[idA];
+    Real3 velMasA = sortedVelMasD[idA];
+    int isAffectedV = 0;
+    int isAffectedP = 0;
+
+    Real3 sumVW = mR3(0);
+    Real sumWAll = 0;
+    Real3 sumRhoRW = mR3(0);
+    Real sumPW = 0;
+    Real sumWFluid = 0;
+
+    int3 gridPos = calcGridPos(posRadA);
+    for (int z = -1; z <= 1; z++) {
+      for (int y = -1; y <= 1; y++) {
+        for (int x = -1; x <= 1; x++) {
+          BCE_modification_Share(sumVW, sumWAll, sumRhoRW, sumPW, sumWFluid,
+                                 isAffectedV, isAffectedP,
+                                 gridPos + mI3(x, y, z), posRadA,
+                                 sortedPosRadD, sortedVelMasD,
+                                 sortedRhoPreMuD, cellStartD, cellEndD);
+        }
+      }
+    }
+
+    if (isAffectedV) {
+      velMasBceD[bceIndex] = 2 * velMasA - sumVW / sumWAll;
+    }
+    if (isAffectedP) {
+      // pressure
+      Real3 a3 = mR3(0);
+      if (fabs(rhoPreMuA.w) > 0) { // rigid BCE
+        int rigidBceIndex = sphIndex - numObjectsD.startRigidMarkers;
+        if (rigidBceIndex < 0 ||
+            rigidBceIndex >= numObjectsD.numRigid_SphMarkers) {
+          isError = 1;
+          continue;
+        }
+        a3 = bceAccD[rigidBceIndex];
+      }
+      Real pressure =
+          (sumPW + dot(paramsD.gravity - a3, sumRhoRW)) / sumWFluid;
+      Real density = InvEos(pressure);
+      rhoPreMuBceD[bceIndex] =
+          mR4(density, pressure, rhoPreMuA.z, rhoPreMuA.w);
+    }
+  }
+
+  if (isError) {
+    throw std::runtime_error(
+        "Error! program crashed in  RecalcSortedVelocityPressure_BCE!\n");
+  }
+}
+//--------------------------------------------------------------------------------------------------------------------------------
+// calculate marker acceleration, required in ADAMI
+void ChBce::CalcBceAcceleration(
+    thrust::device_vector<Real3> &bceAcc,
+    const thrust::device_vector<Real4> &q_fsiBodies_D,
+    const thrust::device_vector<Real3> &accRigid_fsiBodies_D,
+    const thrust::device_vector<Real3> &omegaVelLRF_fsiBodies_D,
+    const thrust::device_vector<Real3> &omegaAccLRF_fsiBodies_D,
+    const thrust::device_vector<Real3> &rigidSPH_MeshPos_LRF_D,
+    const thrust::device_vector<uint> &rigidIdentifierD,
+    int numRigid_SphMarkers) {
+  Real3 *bceAccD = mR3CAST(bceAcc);
+  const Real4 *qD = mR4CAST(q_fsiBodies_D);
+  const Real3 *accRigidD = mR3CAST(accRigid_fsiBodies_D);
+  const Real3 *omegaVelD = mR3CAST(omegaVelLRF_fsiBodies_D);
+  const Real3 *omegaAccD = mR3CAST(omegaAccLRF_fsiBodies_D);
+  const Real3 *meshPosD = mR3CAST(rigidSPH_MeshPos_LRF_D);
+  const uint *rigidIdentifier = U1CAST(rigidIdentifierD);
+
+#pragma omp parallel for
+  for (int bceIndex = 0; bceIndex < numRigid_SphMarkers; bceIndex++) {
+    int rigidBodyIndex = rigidIdentifier[bceIndex];
+    Real3 acc3 = accRigidD[rigidBodyIndex]; // linear acceleration (CM)
+
+    Real3 a1, a2, a3;
+    RotationMatirixFromQuaternion(a1, a2, a3, qD[rigidBodyIndex]);
+    Real3 wVel3 = omegaVelD[rigidBodyIndex];
+    Real3 rigidSPH_MeshPos_LRF = meshPosD[bceIndex];
+    Real3 wVelCrossS = cross(wVel3, rigidSPH_MeshPos_LRF);
+    Real3 wVelCrossWVelCrossS = cross(wVel3, wVelCrossS);
+    acc3 += mR3(dot(a1, wVelCrossWVelCrossS), dot(a2, wVelCrossWVelCrossS),
+                dot(a3, wVelCrossWVelCrossS)); // centrigugal acceleration
+
+    Real3 wAcc3 = omegaAccD[rigidBodyIndex];
+    Real3 wAccCrossS = cross(wAcc3, rigidSPH_MeshPos_LRF);
+    acc3 += mR3(dot(a1, wAccCrossS), dot(a2, wAccCrossS),
+                dot(a3, wAccCrossS)); // tangential acceleration
+
+    bceAccD[bceIndex] = acc3;
+  }
+}
+//--------------------------------------------------------------------------------------------------------------------------------
+void ChBce::ModifyBceVelocity(SphMarkerDataD *sphMarkersD,
+                              FsiBodiesDataD *fsiBodiesD) {
+  // modify BCE velocity and pressure
+  int numRigidAndBoundaryMarkers =
+      fsiGeneralData->referenceArray[2 + numObjectsH->numRigidBodies - 1].y -
+      fsiGeneralData->referenceArray[0].y;
+  if ((numObjectsH->numBoundaryMarkers + numObjectsH->numRigid_SphMarkers) !=
+      numRigidAndBoundaryMarkers) {
+    throw std::runtime_error("Error! number of rigid and boundary markers are "
+                             "saved incorrectly. Thrown from "
+                             "ModifyBceVelocity!\n");
+  }
+  if (!(velMas_ModifiedBCE.size() == numRigidAndBoundaryMarkers &&
+        rhoPreMu_ModifiedBCE.size() == numRigidAndBoundaryMarkers)) {
+    throw std::runtime_error("Error! size error velMas_ModifiedBCE and "
+                             "rhoPreMu_ModifiedBCE. Thrown from "
+                             "ModifyBceVelocity!\n");
+  }
+  int2 updatePortion = mI2(
+      fsiGeneralData->referenceArray[0].y,
+      fsiGeneralData->referenceArray[2 + numObjectsH->numRigidBodies - 1].y);
+  if (paramsH->bceType == ADAMI) {
+    thrust::device_vector<Real3> bceAcc(numObjectsH->numRigid_SphMarkers);
+    if (numObjectsH->numRigid_SphMarkers > 0) {
+      CalcBceAcceleration(
+          bceAcc, fsiBodiesD->q_fsiBodies_D, fsiBodiesD->accRigid_fsiBodies_D,
+          fsiBodiesD->omegaVelLRF_fsiBodies_D,
+          fsiBodiesD->omegaAccLRF_fsiBodies_D,
+          fsiGeneralData->rigidSPH_MeshPos_LRF_D,
+          fsiGeneralData->rigidIdentifierD, numObjectsH->numRigid_SphMarkers);
+    }
+    RecalcSortedVelocityPressure_BCE(
+        velMas_ModifiedBCE, rhoPreMu_ModifiedBCE, sortedSphMarkersD->posRadD,
+        sortedSphMarkersD->velMasD, sortedSphMarkersD->rhoPresMuD,
+        markersProximityD->cellStartD, markersProximityD->cellEndD,
+        markersProximityD->mapOriginalToSorted, bceAcc, updatePortion);
+    bceAcc.clear();
+  } else {
+    thrust::copy(sphMarkersD->velMasD.begin() + updatePortion.x,
+                 sphMarkersD->velMasD.begin() + updatePortion.y,
+                 velMas_ModifiedBCE.begin());
+    thrust::copy(sphMarkersD->rhoPresMuD.begin() + updatePortion.x,
+                 sphMarkersD->rhoPresMuD.begin() + updatePortion.y,
+                 rhoPreMu_ModifiedBCE.begin());
+  }
+}
+//--------------------------------------------------------------------------------------------------------------------------------
+// Accumulates the forces and torques that the BCE markers of each rigid body
+// receive from the fluid.
+void ChBce::Rigid_Forces_Torques(SphMarkerDataD *sphMarkersD,
+                                 FsiBodiesDataD *fsiBodiesD) {
+  // Arman: InitSystem has to be called before this point to set the number of
+  // objects
+
+  if (numObjectsH->numRigidBodies == 0) {
+    return;
+  }
+  //################################################### make force and torque
+  //arrays
+  //####### Force (Acceleration)
+  if (totalSurfaceInteractionRigid4.size() != numObjectsH->numRigidBodies ||
+      dummyIdentify.size() != numObjectsH->numRigidBodies ||
+      torqueMarkersD.size() != numObjectsH->numRigid_SphMarkers) {
+    throw std::runtime_error("Error! wrong size: totalSurfaceInteractionRigid4 "
+                             "or torqueMarkersD or dummyIdentify. Thrown from "
+                             "Rigid_Forces_Torques!\n");
+  }
+
+  thrust::fill(totalSurfaceInteractionRigid4.begin(),
+               totalSurfaceInteractionRigid4.end(), mR4(0));
+  thrust::fill(torqueMarkersD.begin(), torqueMarkersD.end(), mR3(0));
+
+  thrust::equal_to<uint> binary_pred;
+
+  //** forces on BCE markers of each rigid body are accumulated at center.
+  //"totalSurfaceInteractionRigid4" is got built.
+  (void)thrust::reduce_by_key(
+      fsiGeneralData->rigidIdentifierD.begin(),
+      fsiGeneralData->rigidIdentifierD.end(),
+      fsiGeneralData->derivVelRhoD.begin() + numObjectsH->startRigidMarkers,
+      dummyIdentify.begin(), totalSurfaceInteractionRigid4.begin(), binary_pred,
+      thrust::plus<Real4>());
+
+  //** accumulated BCE forces at center are transformed to acceleration of rigid
+  //body "rigid_FSI_ForcesD".
+  Real3 *rigid_FSI_ForcesD = mR3CAST(fsiGeneralData->rigid_FSI_ForcesD);
+  const Real4 *totalSurfaceInteraction =
+      mR4CAST(totalSurfaceInteractionRigid4);
+  const int numRigidBodies = numObjectsH->numRigidBodies;
+  for (int rigidSphereA = 0; rigidSphereA < numRigidBodies; rigidSphereA++) {
+    rigid_FSI_ForcesD[rigidSphereA] =
+        paramsH->markerMass * mR3(totalSurfaceInteraction[rigidSphereA]);
+  }
+
+  //####### Torque
+  //** the current position of the rigid, 'posRigidD', is used to calculate the
+  //moment of BCE acceleration at the rigid
+  //*** body center (i.e. torque/mass). "torqueMarkersD" gets built.
+  Real3 *torqueD = mR3CAST(torqueMarkersD);
+  const Real4 *derivVelRhoD = mR4CAST(fsiGeneralData->derivVelRhoD);
+  const Real3 *posRadD = mR3CAST(sphMarkersD->posRadD);
+  const uint *rigidIdentifierD = U1CAST(fsiGeneralData->rigidIdentifierD);
+  const Real3 *posRigidD = mR3CAST(fsiBodiesD->posRigid_fsiBodies_D);
+  const int numRigid_SphMarkers = numObjectsH->numRigid_SphMarkers;
+  const int startRigidMarkers = numObjectsH->startRigidMarkers;
+
+#pragma omp parallel for
+  for (int index = 0; index < numRigid_SphMarkers; index++) {
+    uint rigidMarkerIndex = index + startRigidMarkers;
+    Real3 dist3 =
+        Distance(posRadD[rigidMarkerIndex], posRigidD[rigidIdentifierD[index]]);
+    // markerMass converts from SPH acceleration to force
+    torqueD[index] = paramsD.markerMass *
+                     cross(dist3, mR3(derivVelRhoD[rigidMarkerIndex]));
+  }
+
+  (void)thrust::reduce_by_key(fsiGeneralData->rigidIdentifierD.begin(),
+                              fsiGeneralData->rigidIdentifierD.end(),
+                              torqueMarkersD.begin(), dummyIdentify.begin(),
+                              fsiGeneralData->rigid_FSI_TorquesD.begin(),
+                              binary_pred, thrust::plus<Real3>());
+}
+//--------------------------------------------------------------------------------------------------------------------------------
+void ChBce::UpdateRigidMarkersPositionVelocity(SphMarkerDataD *sphMarkersD,
+                                               FsiBodiesDataD *fsiBodiesD) {
+  if (numObjectsH->numRigidBodies == 0) {
+    return;
+  }
+
+  //** "posRadD2"/"velMasD2" associated to BCE markers are updated based on new
+  // rigid body (position, orientation)/(velocity, angular velocity)
+  Real3 *posRadD = mR3CAST(sphMarkersD->posRadD);
+  Real3 *velMasD = mR3CAST(sphMarkersD->velMasD);
+  const Real3 *meshPosD = mR3CAST(fsiGeneralData->rigidSPH_MeshPos_LRF_D);
+  const uint *rigidIdentifierD = U1CAST(fsiGeneralData->rigidIdentifierD);
+  const Real3 *posRigidD = mR3CAST(fsiBodiesD->posRigid_fsiBodies_D);
+  const Real4 *velMassRigidD = mR4CAST(fsiBodiesD->velMassRigid_fsiBodies_D);
+  const Real3 *omegaLRF_D = mR3CAST(fsiBodiesD->omegaVelLRF_fsiBodies_D);
+  const Real4 *qD = mR4CAST(fsiBodiesD->q_fsiBodies_D);
+  const int numRigid_SphMarkers = numObjectsH->numRigid_SphMarkers;
+  const int startRigidMarkers = numObjectsH->startRigidMarkers;
+
+#pragma omp parallel for
+  for (int index = 0; index < numRigid_SphMarkers; index++) {
+    uint rigidMarkerIndex = index + startRigidMarkers;
+    int rigidBodyIndex = rigidIdentifierD[index];
+
+    Real3 a1, a2, a3;
+    RotationMatirixFromQuaternion(a1, a2, a3, qD[rigidBodyIndex]);
+
+    Real3 rigidSPH_MeshPos_LRF = meshPosD[index];
+
+    // position
+    Real3 p_Rigid = posRigidD[rigidBodyIndex];
+    posRadD[rigidMarkerIndex] = p_Rigid + mR3(dot(a1, rigidSPH_MeshPos_LRF),
+                                              dot(a2, rigidSPH_MeshPos_LRF),
+                                              dot(a3, rigidSPH_MeshPos_LRF));
+
+    // velocity
+    Real4 vM_Rigid = velMassRigidD[rigidBodyIndex];
+    Real3 omegaCrossS = cross(omegaLRF_D[rigidBodyIndex], rigidSPH_MeshPos_LRF);
+    velMasD[rigidMarkerIndex] =
+        mR3(vM_Rigid) + mR3(dot(a1, omegaCrossS), dot(a2, omegaCrossS),
+                            dot(a3, omegaCrossS));
+  }
+}
+
+} // end namespace fsi
+} // end namespace chrono
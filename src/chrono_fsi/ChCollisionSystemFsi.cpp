@@ -0,0 +1,187 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Author: Arman Pazouki
+// =============================================================================
+//
+// Base class for processing proximity in fsi system.//
+// OpenMP (CPU) implementation, compiled instead of ChCollisionSystemFsi.cu when
+// CHRONO_FSI_USE_CUDA is not defined.
+// =============================================================================
+
+#include "chrono_fsi/ChCollisionSystemFsi.cuh"
+#include "chrono_fsi/ChDeviceUtils.cuh"
+#include "chrono_fsi/ChSphGeneral.cuh"
+#include <stdexcept>
+#include <thrust/sort.h>
+
+namespace chrono {
+namespace fsi {
+
+// Host copies of the simulation parameters and number of objects, used by the
+// functions of ChSphGeneral.cuh in all the CPU translation units.
+SimParams paramsD;
+NumberOfObjects numObjectsD;
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+ChCollisionSystemFsi::ChCollisionSystemFsi(
+    SphMarkerDataD *otherSortedSphMarkersD,
+    ProximityDataD *otherMarkersProximityD, SimParams *otherParamsH,
+    NumberOfObjects *otherNumObjects)
+    : sortedSphMarkersD(otherSortedSphMarkersD),
+      markersProximityD(otherMarkersProximityD), paramsH(otherParamsH),
+      numObjectsH(otherNumObjects) {
+  sphMarkersD = NULL;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+void ChCollisionSystemFsi::Finalize() {
+  paramsD = *paramsH;
+  numObjectsD = *numObjectsH;
+}
+//--------------------------------------------------------------------------------------------------------------------------------
+
+ChCollisionSystemFsi::~ChCollisionSystemFsi() {}
+//--------------------------------------------------------------------------------------------------------------------------------
+
+void ChCollisionSystemFsi::calcHash() {
+  if (!(markersProximityD->gridMarkerHashD.size() ==
+            numObjectsH->numAllMarkers &&
+        markersProximityD->gridMarkerIndexD.size() ==
+            numObjectsH->numAllMarkers)) {
+    throw std::runtime_error("Error! size error, calcHash!");
+  }
+
+  uint *gridMarkerHashD = U1CAST(markersProximityD->gridMarkerHashD);
+  uint *gridMarkerIndexD = U1CAST(markersProximityD->gridMarkerIndexD);
+  const Real3 *posRad = mR3CAST(sphMarkersD->posRadD);
+  const int numAllMarkers = numObjectsH->numAllMarkers;
+  const Real3 boxMin = paramsD.worldOrigin;
+  const Real3 boxMax = paramsD.worldOrigin + paramsD.boxDims;
+
+  int isError = 0;
+#pragma omp parallel for reduction(|| : isError)
+  for (int index = 0; index < numAllMarkers; index++) {
+    Real3 p = posRad[index];
+
+    if (!(isfinite(p.x) && isfinite(p.y) && isfinite(p.z))) {
+      isError = 1;
+      continue;
+    }
+
+    /* Check particle is inside the domain. */
+    if (p.x < boxMin.x || p.y < boxMin.y || p.z < boxMin.z) {
+      isError = 1;
+      continue;
+    }
+    if (p.x > boxMax.x || p.y > boxMax.y || p.z > boxMax.z) {
+      isError = 1;
+      continue;
+    }
+
+    /* Store the hash of the bin and the particle index associated to it */
+    gridMarkerHashD[index] = calcGridHash(calcGridPos(p));
+    gridMarkerIndexD[index] = index;
+  }
+
+  if (isError) {
+    throw std::runtime_error("Error! program crashed in  calcHash!\n");
+  }
+}
+
+void ChCollisionSystemFsi::ResetCellSize(int s) {
+  markersProximityD->cellStartD.resize(s);
+  markersProximityD->cellEndD.resize(s);
+}
+
+void ChCollisionSystemFsi::reorderDataAndFindCellStart() {
+  int3 cellsDim = paramsH->gridSize;
+  int numCells = cellsDim.x * cellsDim.y * cellsDim.z;
+  if (!(markersProximityD->cellStartD.size() == numCells &&
+        markersProximityD->cellEndD.size() == numCells)) {
+    throw std::runtime_error(
+        "Error! size error, reorderDataAndFindCellStart!\n");
+  }
+
+  thrust::fill(markersProximityD->cellStartD.begin(),
+               markersProximityD->cellStartD.end(), 0);
+  thrust::fill(markersProximityD->cellEndD.begin(),
+               markersProximityD->cellEndD.end(), 0);
+
+  uint *cellStartD = U1CAST(markersProximityD->cellStartD);
+  uint *cellEndD = U1CAST(markersProximityD->cellEndD);
+  const uint *gridMarkerHashD = U1CAST(markersProximityD->gridMarkerHashD);
+  const uint *gridMarkerIndexD = U1CAST(markersProximityD->gridMarkerIndexD);
+  uint *mapOriginalToSorted = U1CAST(markersProximityD->mapOriginalToSorted);
+  const Real3 *posRadD = mR3CAST(sphMarkersD->posRadD);
+  const Real3 *velMasD = mR3CAST(sphMarkersD->velMasD);
+  const Real4 *rhoPresMuD = mR4CAST(sphMarkersD->rhoPresMuD);
+  Real3 *sortedPosRadD = mR3CAST(sortedSphMarkersD->posRadD);
+  Real3 *sortedVelMasD = mR3CAST(sortedSphMarkersD->velMasD);
+  Real4 *sortedRhoPreMuD = mR4CAST(sortedSphMarkersD->rhoPresMuD);
+  const int numAllMarkers = numObjectsH->numAllMarkers;
+
+  int isError = 0;
+#pragma omp parallel for reduction(|| : isError)
+  for (int index = 0; index < numAllMarkers; index++) {
+    /* The first marker of each run of equal hashes starts its cell and ends
+     * the cell of the previous marker. Each cell is written by one marker */
+    uint hash = gridMarkerHashD[index];
+    if (index == 0 || hash != gridMarkerHashD[index - 1]) {
+      cellStartD[hash] = index;
+      if (index > 0)
+        cellEndD[gridMarkerHashD[index - 1]] = index;
+    }
+    if (index == numAllMarkers - 1) {
+      cellEndD[hash] = index + 1;
+    }
+
+    /* Gather the data in sorted order. gridMarkerIndexD is a permutation, so
+     * the inverse map can be scattered directly instead of sorted */
+    uint originalIndex = gridMarkerIndexD[index];
+    mapOriginalToSorted[originalIndex] = index;
+
+    Real3 posRad = posRadD[originalIndex];
+    Real3 velMas = velMasD[originalIndex];
+    Real4 rhoPreMu = rhoPresMuD[originalIndex];
+
+    if (!(isfinite(posRad.x) && isfinite(posRad.y) && isfinite(posRad.z) &&
+          isfinite(velMas.x) && isfinite(velMas.y) && isfinite(velMas.z) &&
+          isfinite(rhoPreMu.x) && isfinite(rhoPreMu.y) &&
+          isfinite(rhoPreMu.z) && isfinite(rhoPreMu.w))) {
+      isError = 1;
+    }
+    sortedPosRadD[index] = posRad;
+    sortedVelMasD[index] = velMas;
+    sortedRhoPreMuD[index] = rhoPreMu;
+  }
+
+  if (isError) {
+    throw std::runtime_error(
+        "Error! particle data is NAN, reorderDataAndFindCellStart!\n");
+  }
+}
+
+void ChCollisionSystemFsi::ArrangeData(SphMarkerDataD *otherSphMarkersD) {
+  sphMarkersD = otherSphMarkersD;
+  int3 cellsDim = paramsH->gridSize;
+  int numCells = cellsDim.x * cellsDim.y * cellsDim.z;
+  ResetCellSize(numCells);
+  calcHash();
+  thrust::sort_by_key(markersProximityD->gridMarkerHashD.begin(),
+                      markersProximityD->gridMarkerHashD.end(),
+                      markersProximityD->gridMarkerIndexD.begin());
+  reorderDataAndFindCellStart();
+}
+
+} // end namespace fsi
+} // end namespace chrono
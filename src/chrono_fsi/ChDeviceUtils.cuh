@@ -20,6 +20,7 @@
 
 #include "chrono_fsi/ChApiFsi.h"
 #include "chrono_fsi/custom_math.h"
+#include <cstdio>
 #include <thrust/device_vector.h>
 #include <thrust/host_vector.h>
 
@@ -88,6 +89,7 @@ typedef unsigned int uint;
 //
 // Legacy CUTIL macros. Currently default to no-ops (TODO)
 // ----------------------------------------------------------------------------
+#ifdef CHRONO_FSI_USE_CUDA
 #define cudaCheckError()                                                       \
   {                                                                            \
     cudaError_t e = cudaGetLastError();                                        \
@@ -131,6 +133,9 @@ private:
   cudaEvent_t m_start;
   cudaEvent_t m_stop;
 };
+#else
+#define cudaCheckError()
+#endif
 
 // --------------------------------------------------------------------
 // ChDeviceUtils
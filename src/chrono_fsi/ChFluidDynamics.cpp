@@ -0,0 +1,302 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Author: Arman Pazouki
+// =============================================================================
+//
+// Class for performing time integration in fluid system.//
+// OpenMP (CPU) implementation, compiled instead of ChFluidDynamics.cu when
+// CHRONO_FSI_USE_CUDA is not defined.
+// =============================================================================
+
+#include "chrono_fsi/ChDeviceUtils.cuh"
+#include "chrono_fsi/ChFluidDynamics.cuh"
+#include "chrono_fsi/ChSphGeneral.cuh"
+#include <stdexcept>
+
+namespace chrono {
+namespace fsi {
+
+// -----------------------------------------------------------------------------
+/// Calculate the share of density influence on a given marker from all other
+/// markers in a given cell
+
+static inline void collideCellDensityReInit(
+    Real &densityShare, Real &denominator, int3 gridPos, uint index,
+    Real3 posRadA, const Real3 *sortedPosRad, const Real4 *sortedRhoPreMu,
+    const uint *cellStart, const uint *cellEnd) {
+  uint gridHash = calcGridHash(gridPos);
+  // empty cells have cellStart == cellEnd
+  uint startIndex = cellStart[gridHash];
+  uint endIndex = cellEnd[gridHash];
+  for (uint j = startIndex; j < endIndex; j++) {
+    if (j != index) { // check not colliding with self
+      Real3 posRadB = sortedPosRad[j];
+      Real4 rhoPreMuB = sortedRhoPreMu[j];
+      Real3 dist3 = Distance(posRadA, posRadB);
+      Real d = length(dist3);
+      if (d > RESOLUTION_LENGTH_MULT * paramsD.HSML)
+        continue;
+      Real partialDensity = paramsD.markerMass * W3(d);
+      densityShare += partialDensity;
+      denominator += partialDensity / rhoPreMuB.x;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// Apply the periodic BC along one direction to a marker.
+///
+/// Returns true if the marker was moved.
+static inline bool ApplyPeriodicBoundary(Real &pos, Real4 &rhoPresMu, Real cMin,
+                                         Real cMax, Real deltaPress) {
+  if (pos > cMax) {
+    pos -= (cMax - cMin);
+    if (rhoPresMu.w < -.1) {
+      rhoPresMu.y = rhoPresMu.y + deltaPress;
+    }
+    return true;
+  }
+  if (pos < cMin) {
+    pos += (cMax - cMin);
+    if (rhoPresMu.w < -.1) {
+      rhoPresMu.y = rhoPresMu.y - deltaPress;
+    }
+    return true;
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+// CLASS FOR FLUID DYNAMICS SYSTEM
+// -----------------------------------------------------------------------------
+
+ChFluidDynamics::ChFluidDynamics(ChBce *otherBceWorker,
+                                 ChFsiDataManager *otherFsiData,
+                                 SimParams *otherParamsH,
+                                 NumberOfObjects *otherNumObjects)
+    : fsiData(otherFsiData), paramsH(otherParamsH),
+      numObjectsH(otherNumObjects) {
+  forceSystem =
+      new ChFsiForceParallel(otherBceWorker, &(fsiData->sortedSphMarkersD),
+                             &(fsiData->markersProximityD),
+                             &(fsiData->fsiGeneralData), paramsH, numObjectsH);
+}
+
+// -----------------------------------------------------------------------------
+
+void ChFluidDynamics::Finalize() {
+  paramsD = *paramsH;
+  numObjectsD = *numObjectsH;
+  forceSystem->Finalize();
+}
+
+// -----------------------------------------------------------------------------
+
+ChFluidDynamics::~ChFluidDynamics() { delete forceSystem; }
+
+// -----------------------------------------------------------------------------
+
+void ChFluidDynamics::IntegrateSPH(SphMarkerDataD *sphMarkersD2,
+                                   SphMarkerDataD *sphMarkersD1,
+                                   FsiBodiesDataD *fsiBodiesD1, Real dT) {
+  forceSystem->ForceSPH(sphMarkersD1, fsiBodiesD1);
+  this->UpdateFluid(sphMarkersD2, dT);
+  this->ApplyBoundarySPH_Markers(sphMarkersD2);
+}
+
+// -----------------------------------------------------------------------------
+/// Update the density, velocity and position of the markers with an explicit
+/// Euler scheme. Pressure is obtained from the density and an Equation of
+/// State.
+
+void ChFluidDynamics::UpdateFluid(SphMarkerDataD *sphMarkersD, Real dT) {
+  int2 updatePortion = mI2(
+      0, fsiData->fsiGeneralData
+             .referenceArray[fsiData->fsiGeneralData.referenceArray.size() - 1]
+             .y);
+
+  Real3 *posRadD = mR3CAST(sphMarkersD->posRadD);
+  Real3 *velMasD = mR3CAST(sphMarkersD->velMasD);
+  Real4 *rhoPresMuD = mR4CAST(sphMarkersD->rhoPresMuD);
+  const Real3 *vel_XSPH_D = mR3CAST(fsiData->fsiGeneralData.vel_XSPH_D);
+  const Real4 *derivVelRhoD = mR4CAST(fsiData->fsiGeneralData.derivVelRhoD);
+  const Real maxVel = paramsH->tweakMultV * paramsH->HSML / paramsH->dT;
+  const Real maxDerivRho = paramsH->tweakMultRho * paramsH->rho0 / paramsH->dT;
+
+  int isError = 0;
+#pragma omp parallel for reduction(|| : isError)
+  for (int index = updatePortion.x; index < updatePortion.y; index++) {
+    Real4 derivVelRho = derivVelRhoD[index];
+    Real4 rhoPresMu = rhoPresMuD[index];
+
+    if (rhoPresMu.w < 0) {
+      //-------------
+      // ** position
+      //-------------
+      Real3 vel_XSPH = vel_XSPH_D[index];
+      if (!(isfinite(vel_XSPH.x) && isfinite(vel_XSPH.y) &&
+            isfinite(vel_XSPH.z))) {
+        if (paramsD.enableAggressiveTweak) {
+          vel_XSPH = mR3(0);
+        } else {
+          isError = 1;
+          continue;
+        }
+      }
+      if (length(vel_XSPH) > maxVel && paramsD.enableTweak) {
+        vel_XSPH *= maxVel / length(vel_XSPH);
+      }
+
+      Real3 updatedPositon = posRadD[index] + vel_XSPH * dT;
+      if (!(isfinite(updatedPositon.x) && isfinite(updatedPositon.y) &&
+            isfinite(updatedPositon.z))) {
+        isError = 1;
+        continue;
+      }
+      posRadD[index] = updatedPositon; // posRadD updated
+
+      //-------------
+      // ** velocity
+      //-------------
+      Real3 updatedVelocity = velMasD[index] + mR3(derivVelRho) * dT;
+      if (!(isfinite(updatedVelocity.x) && isfinite(updatedVelocity.y) &&
+            isfinite(updatedVelocity.z))) {
+        if (paramsD.enableAggressiveTweak) {
+          updatedVelocity = mR3(0);
+        } else {
+          isError = 1;
+          continue;
+        }
+      }
+      if (length(updatedVelocity) > maxVel && paramsD.enableTweak) {
+        updatedVelocity *= maxVel / length(updatedVelocity);
+      }
+      velMasD[index] = updatedVelocity;
+    }
+
+    if (!(isfinite(derivVelRho.w))) {
+      if (paramsD.enableAggressiveTweak) {
+        derivVelRho.w = 0;
+      } else {
+        isError = 1;
+        continue;
+      }
+    }
+    if (fabs(derivVelRho.w) > maxDerivRho && paramsD.enableTweak) {
+      // to take care of the sign as well
+      derivVelRho.w *= maxDerivRho / fabs(derivVelRho.w);
+    }
+    Real rho2 = rhoPresMu.x + derivVelRho.w * dT;
+    rhoPresMu.y = Eos(rho2, rhoPresMu.w);
+    rhoPresMu.x = rho2;
+    if (!(isfinite(rhoPresMu.x) && isfinite(rhoPresMu.y) &&
+          isfinite(rhoPresMu.z) && isfinite(rhoPresMu.w))) {
+      isError = 1;
+      continue;
+    }
+    rhoPresMuD[index] = rhoPresMu; // rhoPresMuD updated
+  }
+
+  if (isError) {
+    throw std::runtime_error("Error! program crashed in  UpdateFluid!\n");
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief ApplyBoundarySPH_Markers
+ * @details
+ * 		Applies the periodic boundaries along x, y and z (in this order) in a
+ * single pass over the markers.
+ */
+void ChFluidDynamics::ApplyBoundarySPH_Markers(SphMarkerDataD *sphMarkersD) {
+  Real3 *posRadD = mR3CAST(sphMarkersD->posRadD);
+  Real4 *rhoPresMuD = mR4CAST(sphMarkersD->rhoPresMuD);
+  const Real3 cMin = paramsH->cMin;
+  const Real3 cMax = paramsH->cMax;
+  const Real3 deltaPress = paramsH->deltaPress;
+  const int numAllMarkers = numObjectsH->numAllMarkers;
+
+#pragma omp parallel for
+  for (int index = 0; index < numAllMarkers; index++) {
+    Real4 rhoPresMu = rhoPresMuD[index];
+    if (fabs(rhoPresMu.w) < .1) {
+      continue;
+    } // no need to do anything if it is a boundary particle
+    Real3 posRad = posRadD[index];
+    bool moved = ApplyPeriodicBoundary(posRad.x, rhoPresMu, cMin.x, cMax.x,
+                                       deltaPress.x);
+    moved |= ApplyPeriodicBoundary(posRad.y, rhoPresMu, cMin.y, cMax.y,
+                                   deltaPress.y);
+    moved |= ApplyPeriodicBoundary(posRad.z, rhoPresMu, cMin.z, cMax.z,
+                                   deltaPress.z);
+    if (moved) {
+      posRadD[index] = posRad;
+      rhoPresMuD[index] = rhoPresMu;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// Shepard filter of the density. It does include the normalization close to
+/// the boundaries and free surface.
+
+void ChFluidDynamics::DensityReinitialization() {
+  thrust::device_vector<Real4> dummySortedRhoPreMu =
+      fsiData->sortedSphMarkersD.rhoPresMuD;
+
+  Real4 *dummyRhoPreMuD = mR4CAST(dummySortedRhoPreMu);
+  const Real3 *sortedPosRad = mR3CAST(fsiData->sortedSphMarkersD.posRadD);
+  const Real4 *sortedRhoPreMu = mR4CAST(fsiData->sortedSphMarkersD.rhoPresMuD);
+  const uint *cellStart = U1CAST(fsiData->markersProximityD.cellStartD);
+  const uint *cellEnd = U1CAST(fsiData->markersProximityD.cellEndD);
+  const int numAllMarkers = numObjectsH->numAllMarkers;
+
+#pragma omp parallel for schedule(dynamic, 64)
+  for (int index = 0; index < numAllMarkers; index++) {
+    Real3 posRadA = sortedPosRad[index];
+    Real4 rhoPreMuA = sortedRhoPreMu[index];
+    if (rhoPreMuA.w > -.1)
+      continue;
+
+    int3 gridPos = calcGridPos(posRadA);
+    Real densityShare = 0.0f;
+    Real denominator = 0.0f;
+    for (int z = -1; z <= 1; z++) {
+      for (int y = -1; y <= 1; y++) {
+        for (int x = -1; x <= 1; x++) {
+          collideCellDensityReInit(densityShare, denominator,
+                                   gridPos + mI3(x, y, z), index, posRadA,
+                                   sortedPosRad, sortedRhoPreMu, cellStart,
+                                   cellEnd);
+        }
+      }
+    }
+
+    // include the particle in its summation as well
+    Real newDensity = densityShare + paramsD.markerMass * W3(0);
+    Real newDenominator =
+        denominator + paramsD.markerMass * W3(0) / rhoPreMuA.x;
+    rhoPreMuA.x = newDensity / newDenominator;
+    rhoPreMuA.y = Eos(rhoPreMuA.x, rhoPreMuA.w);
+    dummyRhoPreMuD[index] = rhoPreMuA;
+  }
+
+  ChFsiForceParallel::CopySortedToOriginal_Invasive_R4(
+      fsiData->sphMarkersD1.rhoPresMuD, dummySortedRhoPreMu,
+      fsiData->markersProximityD.gridMarkerIndexD);
+  dummySortedRhoPreMu.clear();
+}
+
+} // end namespace fsi
+} // end namespace chrono
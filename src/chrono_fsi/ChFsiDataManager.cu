@@ -17,6 +17,8 @@
 
 #include "chrono_fsi/ChDeviceUtils.cuh"
 #include "chrono_fsi/ChFsiDataManager.cuh"
+#include <iostream>
+#include <stdexcept>
 #include <thrust/sort.h>
 
 namespace chrono {
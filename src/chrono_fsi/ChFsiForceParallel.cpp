@@ -0,0 +1,419 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Author: Arman Pazouki
+// =============================================================================
+//
+// Base class for processing sph force in fsi system.//
+// OpenMP (CPU) implementation, compiled instead of ChFsiForceParallel.cu when
+// CHRONO_FSI_USE_CUDA is not defined.
+// =============================================================================
+#include "chrono_fsi/ChDeviceUtils.cuh"
+#include "chrono_fsi/ChFsiForceParallel.cuh"
+#include "chrono_fsi/ChSphGeneral.cuh"
+#include <stdexcept>
+#include <thrust/sort.h>
+
+namespace chrono {
+namespace fsi {
+
+//--------------------------------------------------------------------------------------------------------------------------------
+// collide a particle against all other particles in a given cell
+static inline Real3 deltaVShare(int3 gridPos, uint index, Real3 posRadA,
+                                Real3 velMasA, Real4 rhoPresMuA,
+                                const Real3 *sortedPosRad,
+                                const Real3 *sortedVelMas,
+                                const Real4 *sortedRhoPreMu,
+                                const uint *cellStart, const uint *cellEnd) {
+  uint gridHash = calcGridHash(gridPos);
+  Real3 deltaV = mR3(0.0f);
+
+  // empty cells have cellStart == cellEnd
+  uint startIndex = cellStart[gridHash];
+  uint endIndex = cellEnd[gridHash];
+  for (uint j = startIndex; j < endIndex; j++) {
+    if (j != index) { // check not colliding with self
+      Real3 posRadB = sortedPosRad[j];
+      Real3 dist3 = Distance(posRadA, posRadB);
+      Real d = length(dist3);
+      if (d > RESOLUTION_LENGTH_MULT * paramsD.HSML)
+        continue;
+      Real4 rhoPresMuB = sortedRhoPreMu[j];
+      if (rhoPresMuB.w > -.1)
+        continue; //# B must be fluid, accoring to colagrossi (2003)
+      Real multRho = 2.0f / (rhoPresMuA.x + rhoPresMuB.x);
+      Real3 velMasB = sortedVelMas[j];
+      deltaV += paramsD.markerMass * (velMasB - velMasA) * W3(d) * multRho;
+    }
+  }
+  return deltaV;
+}
+//--------------------------------------------------------------------------------------------------------------------------------
+// modify pressure for body force
+static inline void modifyPressure(Real4 &rhoPresMuB, const Real3 &dist3Alpha) {
+  // body force in x direction
+  rhoPresMuB.y = (dist3Alpha.x > 0.5 * paramsD.boxDims.x)
+                     ? (rhoPresMuB.y - paramsD.deltaPress.x)
+                     : rhoPresMuB.y;
+  rhoPresMuB.y = (dist3Alpha.x < -0.5 * paramsD.boxDims.x)
+                     ? (rhoPresMuB.y + paramsD.deltaPress.x)
+                     : rhoPresMuB.y;
+  // body force in y direction
+  rhoPresMuB.y = (dist3Alpha.y > 0.5 * paramsD.boxDims.y)
+                     ? (rhoPresMuB.y - paramsD.deltaPress.y)
+                     : rhoPresMuB.y;
+  rhoPresMuB.y = (dist3Alpha.y < -0.5 * paramsD.boxDims.y)
+                     ? (rhoPresMuB.y + paramsD.deltaPress.y)
+                     : rhoPresMuB.y;
+  // body force in z direction
+  rhoPresMuB.y = (dist3Alpha.z > 0.5 * paramsD.boxDims.z)
+                     ? (rhoPresMuB.y - paramsD.deltaPress.z)
+                     : rhoPresMuB.y;
+  rhoPresMuB.y = (dist3Alpha.z < -0.5 * paramsD.boxDims.z)
+                     ? (rhoPresMuB.y + paramsD.deltaPress.z)
+                     : rhoPresMuB.y;
+}
+//--------------------------------------------------------------------------------------------------------------------------------
+// Same as DifVelocityRho in ChFsiForceParallel.cu (artificial viscosity type 2
+// with the Ferrari density correction)
+static inline Real4 DifVelocityRho(const Real3 &dist3, Real d,
+                                   const Real3 &velMasA,
+                                   const Real3 &vel_XSPH_A,
+                                   const Real3 &velMasB,
+                                   const Real3 &vel_XSPH_B,
+                                   const Real4 &rhoPresMuA,
+                                   const Real4 &rhoPresMuB,
+                                   Real multViscosity) {
+  Real3 gradW = GradW(dist3);
+
+  Real rAB_Dot_GradW = dot(dist3, gradW);
+  Real rAB_Dot_GradW_OverDist =
+      rAB_Dot_GradW /
+      (d * d + paramsD.epsMinMarkersDis * paramsD.HSML * paramsD.HSML);
+  Real3 derivV = -paramsD.markerMass *
+                     (rhoPresMuA.y / (rhoPresMuA.x * rhoPresMuA.x) +
+                      rhoPresMuB.y / (rhoPresMuB.x * rhoPresMuB.x)) *
+                     gradW +
+                 paramsD.markerMass * (8.0f * multViscosity) * paramsD.mu0 *
+                     pow(rhoPresMuA.x + rhoPresMuB.x, Real(-2)) *
+                     rAB_Dot_GradW_OverDist * (velMasA - velMasB);
+
+  // Ferrari Modification
+  Real derivRho = paramsD.markerMass * dot(vel_XSPH_A - vel_XSPH_B, gradW);
+  Real cA = FerrariCi(rhoPresMuA.x);
+  Real cB = FerrariCi(rhoPresMuB.x);
+  derivRho -= rAB_Dot_GradW / (d + paramsD.epsMinMarkersDis * paramsD.HSML) *
+              fmax(cA, cB) / rhoPresMuB.x * (rhoPresMuB.x - rhoPresMuA.x);
+
+  return mR4(derivV, derivRho);
+}
+//--------------------------------------------------------------------------------------------------------------------------------
+// collide a particle against all other particles in a given cell
+static inline Real4
+collideCell(int3 gridPos, uint index, Real3 posRadA, Real3 velMasA,
+            Real3 vel_XSPH_A, Real4 rhoPresMuA, const Real3 *sortedPosRad,
+            const Real3 *sortedVelMas, const Real3 *vel_XSPH_Sorted_D,
+            const Real4 *sortedRhoPreMu, const Real3 *velMas_ModifiedBCE,
+            const Real4 *rhoPreMu_ModifiedBCE, const uint *gridMarkerIndex,
+            const uint *cellStart, const uint *cellEnd, int &isError) {
+  uint gridHash = calcGridHash(gridPos);
+  Real4 derivVelRho = mR4(0);
+
+  // empty cells have cellStart == cellEnd
+  uint startIndex = cellStart[gridHash];
+  uint endIndex = cellEnd[gridHash];
+  for (uint j = startIndex; j < endIndex; j++) {
+    if (j != index) { // check not colliding with self
+      Real3 posRadB = sortedPosRad[j];
+      Real3 dist3Alpha = posRadA - posRadB;
+      Real3 dist3 = Modify_Local_PosB(posRadB, posRadA);
+      Real d = length(dist3);
+      if (d > RESOLUTION_LENGTH_MULT * paramsD.HSML)
+        continue;
+
+      Real4 rhoPresMuB = sortedRhoPreMu[j];
+      if (rhoPresMuA.w > -.1 && rhoPresMuB.w > -.1) { // no rigid-rigid force
+        continue;
+      }
+
+      modifyPressure(rhoPresMuB, dist3Alpha);
+      Real3 velMasB = sortedVelMas[j];
+      if (rhoPresMuB.w > -.1) {
+        int bceIndexB = gridMarkerIndex[j] - (numObjectsD.numFluidMarkers);
+        if (!(bceIndexB >= 0 &&
+              bceIndexB < numObjectsD.numBoundaryMarkers +
+                              numObjectsD.numRigid_SphMarkers)) {
+          isError = 1;
+          continue;
+        }
+        rhoPresMuB = rhoPreMu_ModifiedBCE[bceIndexB];
+        velMasB = velMas_ModifiedBCE[bceIndexB];
+      }
+      Real multViscosit = 1;
+      Real3 vel_XSPH_B = vel_XSPH_Sorted_D[j];
+      derivVelRho += DifVelocityRho(dist3, d, velMasA, vel_XSPH_A, velMasB,
+                                    vel_XSPH_B, rhoPresMuA, rhoPresMuB,
+                                    multViscosit);
+    }
+  }
+  return derivVelRho;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+ChFsiForceParallel::ChFsiForceParallel(ChBce *otherBceWorker,
+                                       SphMarkerDataD *otherSortedSphMarkersD,
+                                       ProximityDataD *otherMarkersProximityD,
+                                       FsiGeneralData *otherFsiGeneralData,
+                                       SimParams *otherParamsH,
+                                       NumberOfObjects *otherNumObjects)
+    : bceWorker(otherBceWorker), sortedSphMarkersD(otherSortedSphMarkersD),
+      markersProximityD(otherMarkersProximityD),
+      fsiGeneralData(otherFsiGeneralData), paramsH(otherParamsH),
+      numObjectsH(otherNumObjects) {
+  fsiCollisionSystem = new ChCollisionSystemFsi(
+      sortedSphMarkersD, markersProximityD, paramsH, numObjectsH);
+
+  sphMarkersD = NULL;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+void ChFsiForceParallel::Finalize() {
+  paramsD = *paramsH;
+  numObjectsD = *numObjectsH;
+  vel_XSPH_Sorted_D.resize(numObjectsH->numAllMarkers);
+  fsiCollisionSystem->Finalize();
+}
+//--------------------------------------------------------------------------------------------------------------------------------
+
+ChFsiForceParallel::~ChFsiForceParallel() { delete fsiCollisionSystem; }
+//--------------------------------------------------------------------------------------------------------------------------------
+// On the CPU the sorted-to-original permutation is applied with a direct
+// scatter, so "sorted" is left unchanged by the invasive versions.
+void ChFsiForceParallel::CopySortedToOriginal_Invasive_R3(
+    thrust::device_vector<Real3> &original,
+    thrust::device_vector<Real3> &sorted,
+    const thrust::device_vector<uint> &gridMarkerIndex) {
+  CopySortedToOriginal_NonInvasive_R3(original, sorted, gridMarkerIndex);
+}
+//--------------------------------------------------------------------------------------------------------------------------------
+void ChFsiForceParallel::CopySortedToOriginal_NonInvasive_R3(
+    thrust::device_vector<Real3> &original,
+    const thrust::device_vector<Real3> &sorted,
+    const thrust::device_vector<uint> &gridMarkerIndex) {
+  Real3 *originalD = mR3CAST(original);
+  const Real3 *sortedD = mR3CAST(sorted);
+  const uint *index = U1CAST(gridMarkerIndex);
+  const int size = (int)sorted.size();
+#pragma omp parallel for
+  for (int i = 0; i < size; i++) {
+    originalD[index[i]] = sortedD[i];
+  }
+}
+//--------------------------------------------------------------------------------------------------------------------------------
+void ChFsiForceParallel::CopySortedToOriginal_Invasive_R4(
+    thrust::device_vector<Real4> &original,
+    thrust::device_vector<Real4> &sorted,
+    const thrust::device_vector<uint> &gridMarkerIndex) {
+  CopySortedToOriginal_NonInvasive_R4(original, sorted, gridMarkerIndex);
+}
+//--------------------------------------------------------------------------------------------------------------------------------
+void ChFsiForceParallel::CopySortedToOriginal_NonInvasive_R4(
+    thrust::device_vector<Real4> &original,
+    thrust::device_vector<Real4> &sorted,
+    const thrust::device_vector<uint> &gridMarkerIndex) {
+  Real4 *originalD = mR4CAST(original);
+  const Real4 *sortedD = mR4CAST(sorted);
+  const uint *index = U1CAST(gridMarkerIndex);
+  const int size = (int)sorted.size();
+#pragma omp parallel for
+  for (int i = 0; i < size; i++) {
+    originalD[index[i]] = sortedD[i];
+  }
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+void ChFsiForceParallel::CalculateXSPH_velocity() {
+  /* Calculate vel_XSPH */
+  if (vel_XSPH_Sorted_D.size() != numObjectsH->numAllMarkers) {
+    throw std::runtime_error("Error! size error vel_XSPH_Sorted_D Thrown from "
+                             "CalculateXSPH_velocity!\n");
+  }
+
+  Real3 *vel_XSPH = mR3CAST(vel_XSPH_Sorted_D);
+  const Real3 *sortedPosRad = mR3CAST(sortedSphMarkersD->posRadD);
+  const Real3 *sortedVelMas = mR3CAST(sortedSphMarkersD->velMasD);
+  const Real4 *sortedRhoPreMu = mR4CAST(sortedSphMarkersD->rhoPresMuD);
+  const uint *cellStart = U1CAST(markersProximityD->cellStartD);
+  const uint *cellEnd = U1CAST(markersProximityD->cellEndD);
+  const int numAllMarkers = numObjectsH->numAllMarkers;
+
+  int isError = 0;
+  // markers are sorted by cell, so neighbouring iterations share cells
+#pragma omp parallel for schedule(dynamic, 64) reduction(|| : isError)
+  for (int index = 0; index < numAllMarkers; index++) {
+    Real4 rhoPreMuA = sortedRhoPreMu[index];
+    Real3 velMasA = sortedVelMas[index];
+    if (rhoPreMuA.w > -0.1) { // v_XSPH is calculated only for fluid markers.
+                              // Keep unchanged if not fluid.
+      vel_XSPH[index] = velMasA;
+      continue;
+    }
+
+    Real3 posRadA = sortedPosRad[index];
+    Real3 deltaV = mR3(0);
+    int3 gridPos = calcGridPos(posRadA);
+    for (int z = -1; z <= 1; z++) {
+      for (int y = -1; y <= 1; y++) {
+        for (int x = -1; x <= 1; x++) {
+          deltaV += deltaVShare(gridPos + mI3(x, y, z), index, posRadA,
+                                velMasA, rhoPreMuA, sortedPosRad,
+                                sortedVelMas, sortedRhoPreMu, cellStart,
+                                cellEnd);
+        }
+      }
+    }
+
+    Real3 vXSPH = velMasA + paramsD.EPS_XSPH * deltaV;
+    if (!(isfinite(vXSPH.x) && isfinite(vXSPH.y) && isfinite(vXSPH.z))) {
+      isError = 1;
+    }
+    vel_XSPH[index] = vXSPH;
+  }
+
+  if (isError) {
+    throw std::runtime_error(
+        "Error! program crashed in  CalculateXSPH_velocity!\n");
+  }
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Wrapper function for collide
+ * @details
+ * 		Computes the SPH accelerations and density derivatives of all
+ * markers, one marker per loop iteration.
+ */
+void ChFsiForceParallel::collide(
+    thrust::device_vector<Real4> &sortedDerivVelRho_fsi_D,
+    thrust::device_vector<Real3> &sortedPosRad,
+    thrust::device_vector<Real3> &sortedVelMas,
+    thrust::device_vector<Real3> &vel_XSPH_Sorted_D,
+    thrust::device_vector<Real4> &sortedRhoPreMu,
+    thrust::device_vector<Real3> &velMas_ModifiedBCE,
+    thrust::device_vector<Real4> &rhoPreMu_ModifiedBCE,
+
+    thrust::device_vector<uint> &gridMarkerIndex,
+    thrust::device_vector<uint> &cellStart,
+    thrust::device_vector<uint> &cellEnd) {
+  Real4 *derivVelRhoD = mR4CAST(sortedDerivVelRho_fsi_D);
+  const Real3 *posRadD = mR3CAST(sortedPosRad);
+  const Real3 *velMasD = mR3CAST(sortedVelMas);
+  const Real3 *vel_XSPH_D = mR3CAST(vel_XSPH_Sorted_D);
+  const Real4 *rhoPreMuD = mR4CAST(sortedRhoPreMu);
+  const Real3 *velMasBceD = mR3CAST(velMas_ModifiedBCE);
+  const Real4 *rhoPreMuBceD = mR4CAST(rhoPreMu_ModifiedBCE);
+  const uint *gridMarkerIndexD = U1CAST(gridMarkerIndex);
+  const uint *cellStartD = U1CAST(cellStart);
+  const uint *cellEndD = U1CAST(cellEnd);
+  const int numAllMarkers = numObjectsH->numAllMarkers;
+
+  int isError = 0;
+#pragma omp parallel for schedule(dynamic, 64) reduction(|| : isError)
+  for (int index = 0; index < numAllMarkers; index++) {
+    Real3 posRadA = posRadD[index];
+    Real3 velMasA = velMasD[index];
+    Real4 rhoPreMuA = rhoPreMuD[index];
+    Real3 vel_XSPH_A = vel_XSPH_D[index];
+    Real4 derivVelRho = derivVelRhoD[index];
+
+    int3 gridPos = calcGridPos(posRadA);
+    for (int x = -1; x <= 1; x++) {
+      for (int y = -1; y <= 1; y++) {
+        for (int z = -1; z <= 1; z++) {
+          derivVelRho += collideCell(
+              gridPos + mI3(x, y, z), index, posRadA, velMasA, vel_XSPH_A,
+              rhoPreMuA, posRadD, velMasD, vel_XSPH_D, rhoPreMuD, velMasBceD,
+              rhoPreMuBceD, gridMarkerIndexD, cellStartD, cellEndD, isError);
+        }
+      }
+    }
+
+    if (!(isfinite(derivVelRho.x) && isfinite(derivVelRho.y) &&
+          isfinite(derivVelRho.z))) {
+      isError = 1;
+    }
+    if (!(isfinite(derivVelRho.w))) {
+      isError = 1;
+    }
+    derivVelRhoD[index] = derivVelRho;
+  }
+
+  if (isError) {
+    throw std::runtime_error("Error! program crashed in  collide!\n");
+  }
+}
+//--------------------------------------------------------------------------------------------------------------------------------
+
+void ChFsiForceParallel::CollideWrapper() {
+  thrust::device_vector<Real4> m_dSortedDerivVelRho_fsi_D(
+      numObjectsH->numAllMarkers); // Store Rho, Pressure, Mu of each particle
+                                   // in the device memory
+  thrust::fill(m_dSortedDerivVelRho_fsi_D.begin(),
+               m_dSortedDerivVelRho_fsi_D.end(), mR4(0));
+
+  collide(m_dSortedDerivVelRho_fsi_D, sortedSphMarkersD->posRadD,
+          sortedSphMarkersD->velMasD, vel_XSPH_Sorted_D,
+          sortedSphMarkersD->rhoPresMuD, bceWorker->velMas_ModifiedBCE,
+          bceWorker->rhoPreMu_ModifiedBCE, markersProximityD->gridMarkerIndexD,
+          markersProximityD->cellStartD, markersProximityD->cellEndD);
+
+  CopySortedToOriginal_Invasive_R3(fsiGeneralData->vel_XSPH_D,
+                                   vel_XSPH_Sorted_D,
+                                   markersProximityD->gridMarkerIndexD);
+  CopySortedToOriginal_Invasive_R4(fsiGeneralData->derivVelRhoD,
+                                   m_dSortedDerivVelRho_fsi_D,
+                                   markersProximityD->gridMarkerIndexD);
+
+  m_dSortedDerivVelRho_fsi_D.clear();
+}
+//--------------------------------------------------------------------------------------------------------------------------------
+void ChFsiForceParallel::AddGravityToFluid() {
+  // add gravity to fluid markers
+  /* Add outside forces. Don't add gravity to rigids, BCE, and boundaries, it is
+   * added in ChSystem */
+  Real4 totalFluidBodyForce4 = mR4(paramsH->bodyForce3 + paramsH->gravity);
+  Real4 *derivVelRhoD = mR4CAST(fsiGeneralData->derivVelRhoD);
+  const int start = fsiGeneralData->referenceArray[0].x;
+  const int end = fsiGeneralData->referenceArray[0].y;
+#pragma omp parallel for
+  for (int i = start; i < end; i++) {
+    derivVelRhoD[i] += totalFluidBodyForce4;
+  }
+}
+//--------------------------------------------------------------------------------------------------------------------------------
+
+void ChFsiForceParallel::ForceSPH(SphMarkerDataD *otherSphMarkersD,
+                                  FsiBodiesDataD *otherFsiBodiesD) {
+  sphMarkersD = otherSphMarkersD;
+
+  fsiCollisionSystem->ArrangeData(sphMarkersD);
+  bceWorker->ModifyBceVelocity(sphMarkersD, otherFsiBodiesD);
+  CalculateXSPH_velocity();
+  CollideWrapper();
+  AddGravityToFluid();
+}
+
+} // end namespace fsi
+} // end namespace chrono
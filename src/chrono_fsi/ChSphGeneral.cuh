@@ -26,8 +26,15 @@
 namespace chrono {
 namespace fsi {
 
+#ifdef CHRONO_FSI_USE_CUDA
 __constant__ SimParams paramsD;
 __constant__ NumberOfObjects numObjectsD;
+#else
+// CPU backend: a single host copy shared by all translation units, set in the
+// Finalize() functions (defined in ChCollisionSystemFsi.cpp)
+extern SimParams paramsD;
+extern NumberOfObjects numObjectsD;
+#endif
 //--------------------------------------------------------------------------------------------------------------------------------
 // 3D SPH kernel function, W3_SplineA
 __device__ inline Real
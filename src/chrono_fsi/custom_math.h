@@ -1,12 +1,64 @@
 #ifndef CUSTOM_MATH_H
 #define CUSTOM_MATH_H
 
-#include <cuda_runtime.h> // for __host__ __device__ flags
 #include "chrono_fsi/ChConfigFSI.h"
+#ifdef CHRONO_FSI_USE_CUDA
+#include <cuda_runtime.h> // for __host__ __device__ flags
+#endif
 #ifndef __CUDACC__
 #include <math.h>
 #endif
 
+#ifndef CHRONO_FSI_USE_CUDA
+////////////////////////////////////////////////////////////////////////////////
+// host definitions of the CUDA qualifiers and vector types (CPU backend)
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __host__
+#define __host__
+#endif
+#ifndef __device__
+#define __device__
+#endif
+
+struct int2 {
+  int x, y;
+};
+struct int3 {
+  int x, y, z;
+};
+struct int4 {
+  int x, y, z, w;
+};
+struct uint2 {
+  unsigned int x, y;
+};
+struct uint3 {
+  unsigned int x, y, z;
+};
+struct uint4 {
+  unsigned int x, y, z, w;
+};
+struct float2 {
+  float x, y;
+};
+struct float3 {
+  float x, y, z;
+};
+struct float4 {
+  float x, y, z, w;
+};
+struct double2 {
+  double x, y;
+};
+struct double3 {
+  double x, y, z;
+};
+struct double4 {
+  double x, y, z, w;
+};
+#endif
+
 namespace chrono {
 namespace fsi {
 
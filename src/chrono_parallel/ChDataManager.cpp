@@ -142,3 +142,125 @@ void ChParallelDataManager::AddFEAContainer(ChFEAContainer* container) {
     delete fea_container;
     fea_container = container;
 }
+
+// Gather the entries of a per-body (or per-shape) vector in the given order.
+// Vectors that are not allocated for this system type are left untouched.
+template <typename T>
+static void PermuteVector(custom_vector<T>& data, const custom_vector<uint>& order) {
+    if (data.size() != order.size())
+        return;
+    custom_vector<T> sorted(order.size());
+#pragma omp parallel for
+    for (int i = 0; i < order.size(); i++) {
+        sorted[i] = data[order[i]];
+    }
+    data.swap(sorted);
+}
+
+void ChParallelDataManager::ReorderRigidBodies(const custom_vector<uint>& order) {
+    const uint num_bodies = num_rigid_bodies;
+    const uint num_shapes = num_rigid_shapes;
+
+    // Inverse permutation, the new index of every body
+    custom_vector<uint> body_map(num_bodies);
+#pragma omp parallel for
+    for (int i = 0; i < num_bodies; i++) {
+        body_map[order[i]] = i;
+    }
+
+    PermuteVector(host_data.pos_rigid, order);
+    PermuteVector(host_data.rot_rigid, order);
+    PermuteVector(host_data.active_rigid, order);
+    PermuteVector(host_data.collide_rigid, order);
+    PermuteVector(host_data.mass_rigid, order);
+    PermuteVector(host_data.ct_body_map, order);
+    PermuteVector(host_data.rigid_original_id, order);
+
+    // Material properties (DVI and DEM)
+    PermuteVector(host_data.fric_data, order);
+    PermuteVector(host_data.cohesion_data, order);
+    PermuteVector(host_data.compliance_data, order);
+    PermuteVector(host_data.elastic_moduli, order);
+    PermuteVector(host_data.mu, order);
+    PermuteVector(host_data.cr, order);
+    PermuteVector(host_data.dem_coeffs, order);
+    PermuteVector(host_data.adhesionMultDMT_data, order);
+
+#pragma omp parallel for
+    for (int i = 0; i < num_bodies; i++) {
+        host_data.rigid_current_index[host_data.rigid_original_id[i]] = i;
+    }
+
+    // Shapes are stored grouped by body. A counting sort on the new body index
+    // keeps the shapes of each body together and in their original order.
+    // The shape geometry (sphere_rigid, box_like_rigid, ...) is only referenced
+    // through start_rigid and does not need to move.
+    custom_vector<uint> shape_map(num_shapes);
+    if (num_shapes > 0) {
+        custom_vector<uint> shape_start(num_bodies + 1, 0);
+        for (int i = 0; i < num_shapes; i++) {
+            shape_start[body_map[shape_data.id_rigid[i]] + 1]++;
+        }
+        for (int i = 0; i < num_bodies; i++) {
+            shape_start[i + 1] += shape_start[i];
+        }
+        custom_vector<uint> shape_order(num_shapes);
+        for (int i = 0; i < num_shapes; i++) {
+            uint body = body_map[shape_data.id_rigid[i]];
+            shape_map[i] = shape_start[body]++;
+            shape_order[shape_map[i]] = i;
+        }
+
+        PermuteVector(shape_data.fam_rigid, shape_order);
+        PermuteVector(shape_data.id_rigid, shape_order);
+        PermuteVector(shape_data.typ_rigid, shape_order);
+        PermuteVector(shape_data.start_rigid, shape_order);
+        PermuteVector(shape_data.length_rigid, shape_order);
+        PermuteVector(shape_data.ObR_rigid, shape_order);
+        PermuteVector(shape_data.ObA_rigid, shape_order);
+
+#pragma omp parallel for
+        for (int i = 0; i < num_shapes; i++) {
+            shape_data.id_rigid[i] = body_map[shape_data.id_rigid[i]];
+        }
+    }
+
+    // The DEM contact history (multi-step tangential displacement) is stored on
+    // the body with the larger index and refers to the other body and to both
+    // shapes by index. After renumbering the history may change owner, in which
+    // case the stored displacement (other body relative to owner) flips sign.
+    if (host_data.shear_neigh.size() == max_shear * num_bodies) {
+        custom_vector<vec3> shear_neigh(max_shear * num_bodies, vec3(-1, -1, -1));
+        custom_vector<real3> shear_disp(max_shear * num_bodies, real3(0, 0, 0));
+        custom_vector<int> shear_count(num_bodies, 0);
+
+        for (int b = 0; b < num_bodies; b++) {
+            for (int s = 0; s < max_shear; s++) {
+                vec3 neigh = host_data.shear_neigh[max_shear * b + s];
+                if (neigh.x == -1)
+                    continue;
+                int body1 = body_map[b];
+                int body2 = body_map[neigh.x];
+                int shape1 = num_shapes > 0 ? shape_map[neigh.y] : neigh.y;
+                int shape2 = num_shapes > 0 ? shape_map[neigh.z] : neigh.z;
+                real3 disp = host_data.shear_disp[max_shear * b + s];
+
+                int owner = Max(body1, body2);
+                if (owner != body1)
+                    disp = -disp;
+                // Histories that no longer fit on their new owner are dropped,
+                // the same as the solver does when a body runs out of slots
+                if (shear_count[owner] == max_shear)
+                    continue;
+                int index = max_shear * owner + shear_count[owner]++;
+                shear_neigh[index] = vec3(Min(body1, body2), Max(shape1, shape2), Min(shape1, shape2));
+                shear_disp[index] = disp;
+            }
+        }
+        host_data.shear_neigh.swap(shear_neigh);
+        host_data.shear_disp.swap(shear_disp);
+    }
+
+    // Contact forces (DVI) are stored per body index and are now out of date
+    Fc_current = false;
+}
@@ -305,6 +305,11 @@ struct host_container {
     custom_vector<char> active_rigid;
     custom_vector<char> collide_rigid;
     custom_vector<real> mass_rigid;
+    // Bodies can be reordered in memory (see collision_settings::reorder_frequency)
+    // These two vectors map between the current index of a body and the index it
+    // had when it was added to the system, which stays constant
+    custom_vector<uint> rigid_original_id;    // original index of the body stored at each index
+    custom_vector<uint> rigid_current_index;  // current index of the body with a given original index
 
     // Information for 3dof nodes
     custom_vector<real3> pos_3dof;
@@ -385,6 +390,14 @@ struct host_container {
     // While E is the compliance matrix, in reality it is completely diagonal
     // therefore it is stored in a vector for performance reasons
     DynamicVector<real> E;
+    // Preconditioner, only filled in when settings.solver.precondition is enabled.
+    // Rigid contacts use the inverse of their 1x1, 3x3 or 6x6 Delassus block
+    // (block-Jacobi): N_block holds the blocks of all contacts one after the other
+    // (row-major) and P_block their inverses. P scales the other constraints: the
+    // bilaterals by the inverse of their diagonal entry and the 3dof and FEA
+    // constraints by a single common factor, which leaves their projection exact.
+    DynamicVector<real> P;
+    custom_vector<real> N_block, P_block;
 
     // Contact forces (DVI)
     DynamicVector<real> Fc;
@@ -405,6 +418,10 @@ class CH_PARALLEL_API ChParallelDataManager {
     ~ChParallelDataManager();
     void Add3DOFContainer(Ch3DOFContainer* container);
     void AddFEAContainer(ChFEAContainer* container);
+    // Permute all rigid body and collision shape data so that the body stored at
+    // index order[i] moves to index i. Shapes are regrouped by their new body and
+    // the DEM contact history is renumbered accordingly
+    void ReorderRigidBodies(const custom_vector<uint>& order);
     // Structure that contains the data on the host, the naming convention is
     // from when the code supported the GPU (host vs device)
     host_container host_data;
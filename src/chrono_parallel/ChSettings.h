@@ -54,6 +54,9 @@ class collision_settings {
         narrowphase_algorithm = NARROWPHASE_HYBRID_MPR;
         grid_density = 5;
         fixed_bins = true;
+        // Bodies are kept in the order in which they were added to the system
+        // unless the user asks for them to be periodically sorted in space.
+        reorder_frequency = 0;
     }
 
     real3 min_bounding_point, max_bounding_point;
@@ -82,6 +85,14 @@ class collision_settings {
     real grid_density;
     // use fixed number of bins instead of tuning them
     bool fixed_bins;
+    // Rigid bodies and their collision shapes are sorted along a Morton curve
+    // every reorder_frequency steps so that objects that are close in space are
+    // also close in memory. This helps the broadphase, narrowphase and solver on
+    // large granular simulations where bodies are added in an arbitrary order.
+    // Body IDs change when this happens, see ChSystemParallel::GetBodyIndex.
+    // Fixed bodies are kept first, in the order they were added.
+    // A value of zero disables the reordering.
+    int reorder_frequency;
 };
 
 // solver_settings, like the name implies is the structure that contains all
@@ -123,6 +134,8 @@ class solver_settings {
         max_power_iteration = 15;
         power_iter_tolerance = 0.1;
         skip_residual = 1;
+        use_mixed_precision = false;
+        refinement_steps = 3;
     }
 
     // The solver type variable defines name of the solver that will be used to
@@ -161,6 +174,9 @@ class solver_settings {
     bool test_objective;
     bool use_full_inertia_tensor;
     bool cache_step_length;
+    // Precondition APGD, BB and SPGQP with the inverse Delassus block of each
+    // contact (block-Jacobi), the contacts are then projected in the metric of
+    // their block
     bool precondition;
     bool use_power_iteration;
     int max_power_iteration;
@@ -209,6 +225,14 @@ class solver_settings {
     real tolerance_objective;
     // Compute residual every x iterations
     int skip_residual;
+    // When enabled the Shur product inside the solver is evaluated with single
+    // precision copies of D_T and M_invD, halving the memory traffic of every
+    // iteration. The multipliers, the residual and the integration stay in
+    // double precision, the accuracy is recovered with iterative refinement.
+    bool use_mixed_precision;
+    // Maximum number of refinement steps in mixed precision mode, the iteration
+    // budget of a solve is split evenly between them
+    uint refinement_steps;
 };
 
 class settings_container {
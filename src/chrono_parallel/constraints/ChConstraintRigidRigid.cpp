@@ -56,6 +56,48 @@ void Cone_single(real& gamma_n, real& gamma_s, const real& mu) {
     gamma_s *= tproj_div_t;
 }
 
+// Cholesky factorization N = L * L^T of a symmetric block of size n (row-major).
+// Returns false if the block is not (numerically) positive definite.
+bool Cholesky_block(int n, const real* N, real* L) {
+    real max_diag = 0;
+    for (int i = 0; i < n; i++) {
+        max_diag = Max(max_diag, N[i * n + i]);
+    }
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j <= i; j++) {
+            real sum = N[i * n + j];
+            for (int k = 0; k < j; k++) {
+                sum -= L[i * n + k] * L[j * n + k];
+            }
+            if (i == j) {
+                if (sum <= 1e-10 * max_diag) {
+                    return false;
+                }
+                L[i * n + i] = Sqrt(sum);
+            } else {
+                L[i * n + j] = sum / L[j * n + j];
+            }
+        }
+    }
+    return true;
+}
+
+// Solve L * L^T * x = b in place, with L from Cholesky_block.
+void Cholesky_solve(int n, const real* L, real* x) {
+    for (int i = 0; i < n; i++) {
+        for (int k = 0; k < i; k++) {
+            x[i] -= L[i * n + k] * x[k];
+        }
+        x[i] /= L[i * n + i];
+    }
+    for (int i = n - 1; i >= 0; i--) {
+        for (int k = i + 1; k < n; k++) {
+            x[i] -= L[k * n + i] * x[k];
+        }
+        x[i] /= L[i * n + i];
+    }
+}
+
 void ChConstraintRigidRigid::func_Project_normal(int index, const vec2* ids, const real* cohesion, real* gamma) {
     real gamma_x = gamma[index * 1 + 0];
     vec2 body_id = ids[index];
@@ -329,6 +371,211 @@ void ChConstraintRigidRigid::Build_E() {
     }
 }
 
+void ChConstraintRigidRigid::Build_P() {
+    if (data_manager->num_rigid_contacts <= 0) {
+        return;
+    }
+    const CompressedMatrix<real>& D_T = data_manager->host_data.D_T;
+    const CompressedMatrix<real>& M_inv = data_manager->host_data.M_inv;
+    const DynamicVector<real>& E = data_manager->host_data.E;
+    custom_vector<real>& N_block = data_manager->host_data.N_block;
+    custom_vector<real>& P_block = data_manager->host_data.P_block;
+    uint num_contacts = data_manager->num_rigid_contacts;
+    int num_rows = offset;
+
+    N_block.resize(num_contacts * num_rows * num_rows);
+    P_block.resize(num_contacts * num_rows * num_rows);
+
+#pragma omp parallel for
+    for (int index = 0; index < data_manager->num_rigid_contacts; index++) {
+        int rows[6];
+        Contact_rows(index, rows);
+        real* N = &N_block[index * num_rows * num_rows];
+        real* P = &P_block[index * num_rows * num_rows];
+
+        // Assemble the Delassus block N = D_i^T * M_inv * D_i + E_i. Every row of D_T
+        // only touches the 12 dofs of the two bodies in contact and M_inv is block
+        // diagonal, so all lookups below are in rows with at most a few entries.
+        for (int r = 0; r < num_rows; r++) {
+            for (int c = 0; c < num_rows; c++) {
+                N[r * num_rows + c] = 0;
+            }
+            for (CompressedMatrix<real>::ConstIterator it = D_T.begin(rows[r]); it != D_T.end(rows[r]); ++it) {
+                for (CompressedMatrix<real>::ConstIterator jt = M_inv.begin(it->index()); jt != M_inv.end(it->index());
+                     ++jt) {
+                    real m = it->value() * jt->value();
+                    for (int c = 0; c < num_rows; c++) {
+                        N[r * num_rows + c] += m * D_T(rows[c], jt->index());
+                    }
+                }
+            }
+            N[r * num_rows + r] += E[rows[r]];
+        }
+
+        // The block is singular if the contact rows are dependent (e.g. rolling and
+        // spinning on a body without rotational inertia) or if both bodies are fixed.
+        // Such a contact is scaled by a single factor, its largest diagonal entry.
+        real L[36];
+        if (!Cholesky_block(num_rows, N, L)) {
+            real scale = 0;
+            for (int r = 0; r < num_rows; r++) {
+                scale = Max(scale, N[r * num_rows + r]);
+            }
+            if (scale <= 0) {
+                scale = 1;
+            }
+            for (int r = 0; r < num_rows * num_rows; r++) {
+                N[r] = 0;
+            }
+            for (int r = 0; r < num_rows; r++) {
+                N[r * num_rows + r] = scale;
+            }
+            Cholesky_block(num_rows, N, L);
+        }
+
+        // P = N^-1, column by column
+        for (int c = 0; c < num_rows; c++) {
+            real e[6] = {0, 0, 0, 0, 0, 0};
+            e[c] = 1;
+            Cholesky_solve(num_rows, L, e);
+            for (int r = 0; r < num_rows; r++) {
+                P[r * num_rows + c] = e[r];
+            }
+        }
+    }
+}
+
+void ChConstraintRigidRigid::Contact_rows(int index, int* rows) {
+    uint num_contacts = data_manager->num_rigid_contacts;
+    rows[0] = index;
+    if (offset >= 3) {
+        rows[1] = num_contacts + index * 2 + 0;
+        rows[2] = num_contacts + index * 2 + 1;
+    }
+    if (offset == 6) {
+        rows[3] = 3 * num_contacts + index * 3 + 0;
+        rows[4] = 3 * num_contacts + index * 3 + 1;
+        rows[5] = 3 * num_contacts + index * 3 + 2;
+    }
+}
+
+void ChConstraintRigidRigid::Block_x(const custom_vector<real>& blocks,
+                                     const DynamicVector<real>& x,
+                                     DynamicVector<real>& output) {
+    int num_rows = offset;
+
+#pragma omp parallel for
+    for (int index = 0; index < data_manager->num_rigid_contacts; index++) {
+        int rows[6];
+        Contact_rows(index, rows);
+        const real* B = &blocks[index * num_rows * num_rows];
+        for (int r = 0; r < num_rows; r++) {
+            real sum = 0;
+            for (int c = 0; c < num_rows; c++) {
+                sum += B[r * num_rows + c] * x[rows[c]];
+            }
+            output[rows[r]] = sum;
+        }
+    }
+}
+
+void ChConstraintRigidRigid::Px(const DynamicVector<real>& x, DynamicVector<real>& output) {
+    Block_x(data_manager->host_data.P_block, x, output);
+}
+
+void ChConstraintRigidRigid::P_invx(const DynamicVector<real>& x, DynamicVector<real>& output) {
+    Block_x(data_manager->host_data.N_block, x, output);
+}
+
+void ChConstraintRigidRigid::Project_Scaled(real* gamma) {
+    custom_vector<vec2>& bids = data_manager->host_data.bids_rigid_rigid;
+    custom_vector<real3>& friction = data_manager->host_data.fric_rigid_rigid;
+    custom_vector<real>& cohesion = data_manager->host_data.coh_rigid_rigid;
+    const custom_vector<real>& N_block = data_manager->host_data.N_block;
+    int num_rows = offset;
+    // Convergence of the projection of each contact
+    const int max_iter = 100;
+    const real tol = 1e-10;
+
+#pragma omp parallel for
+    for (int index = 0; index < data_manager->num_rigid_contacts; index++) {
+        int rows[6];
+        Contact_rows(index, rows);
+        const real* N = &N_block[index * num_rows * num_rows];
+
+        // Nothing to do if the Euclidean projection leaves the point unchanged
+        real gamma_hat[6];
+        bool inside = true;
+        for (int r = 0; r < num_rows; r++) {
+            gamma_hat[r] = gamma[rows[r]];
+        }
+        host_Project_single(index, bids.data(), friction.data(), cohesion.data(), gamma);
+        for (int r = 0; r < num_rows; r++) {
+            inside = inside && (gamma[rows[r]] == gamma_hat[r]);
+        }
+        if (inside) {
+            continue;
+        }
+
+        // Minimize (x - gamma_hat)^T N (x - gamma_hat) over the friction cone with
+        // ADMM, splitting the quadratic (x) from the cone (z). The z update is the
+        // Euclidean projection of the contact, so the cone, cohesion and solver
+        // mode are handled exactly as in Project. Starts from the Euclidean
+        // projection, which is already stored in gamma.
+        real rho = 0;
+        for (int r = 0; r < num_rows; r++) {
+            rho += N[r * num_rows + r];
+        }
+        rho /= num_rows;
+        real A[36], L[36];
+        for (int r = 0; r < num_rows * num_rows; r++) {
+            A[r] = N[r];
+        }
+        for (int r = 0; r < num_rows; r++) {
+            A[r * num_rows + r] += rho;
+        }
+        Cholesky_block(num_rows, A, L);
+
+        real N_gamma_hat[6], x[6], z[6], u[6];
+        real norm_N_gamma_hat = 0;
+        for (int r = 0; r < num_rows; r++) {
+            N_gamma_hat[r] = 0;
+            for (int c = 0; c < num_rows; c++) {
+                N_gamma_hat[r] += N[r * num_rows + c] * gamma_hat[c];
+            }
+            norm_N_gamma_hat += N_gamma_hat[r] * N_gamma_hat[r];
+            z[r] = gamma[rows[r]];
+            u[r] = 0;
+        }
+        norm_N_gamma_hat = Sqrt(norm_N_gamma_hat);
+
+        for (int iter = 0; iter < max_iter; iter++) {
+            for (int r = 0; r < num_rows; r++) {
+                x[r] = N_gamma_hat[r] + rho * (z[r] - u[r]);
+            }
+            Cholesky_solve(num_rows, L, x);
+            for (int r = 0; r < num_rows; r++) {
+                gamma[rows[r]] = x[r] + u[r];
+            }
+            host_Project_single(index, bids.data(), friction.data(), cohesion.data(), gamma);
+            real primal = 0, dual = 0, norm_z = 0;
+            for (int r = 0; r < num_rows; r++) {
+                real z_new = gamma[rows[r]];
+                u[r] += x[r] - z_new;
+                primal += (x[r] - z_new) * (x[r] - z_new);
+                dual += (z_new - z[r]) * (z_new - z[r]);
+                norm_z += z_new * z_new;
+                z[r] = z_new;
+            }
+            if (Sqrt(primal) <= tol * (1 + Sqrt(norm_z)) &&
+                rho * Sqrt(dual) <= tol * (1 + norm_N_gamma_hat)) {
+                break;
+            }
+        }
+        // gamma holds the last z, which is always in the cone
+    }
+}
+
 void ChConstraintRigidRigid::Build_D() {
     LOG(INFO) << "ChConstraintRigidRigid::Build_D";
     real3* norm = data_manager->host_data.norm_rigid_rigid.data();
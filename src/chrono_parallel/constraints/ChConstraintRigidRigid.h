@@ -103,11 +103,24 @@ class CH_PARALLEL_API ChConstraintRigidRigid {
     void func_Project_spinning(int index, const vec2* ids, const real3* fric, real* gam);
     void Dx(const DynamicVector<real>& x, DynamicVector<real>& output);
     void D_Tx(const DynamicVector<real>& x, DynamicVector<real>& output);
+    // Multiply the rows of the rigid contacts by the block-Jacobi preconditioner
+    // (the inverse Delassus blocks) or by its inverse (the Delassus blocks),
+    // the other rows of the output are left untouched
+    void Px(const DynamicVector<real>& x, DynamicVector<real>& output);
+    void P_invx(const DynamicVector<real>& x, DynamicVector<real>& output);
+    // Project the rigid contacts in the metric of the preconditioner: each contact
+    // is moved to the point of its friction cone closest to the given one in the
+    // norm of its Delassus block, which is what the preconditioned solvers need
+    // for the projection to be the one of the scaled problem
+    void Project_Scaled(real* gamma);
 
     // Compute the vector of corrections
     void Build_b();
     // Compute the diagonal compliance matrix
     void Build_E();
+    // Compute the Delassus block of every contact and its inverse, the block-Jacobi
+    // preconditioner, requires D_T, M_inv and E to be up to date
+    void Build_P();
     // Compute the jacobian matrix, no allocation is performed here,
     // GenerateSparsity should take care of that
     void Build_D();
@@ -118,6 +131,12 @@ class CH_PARALLEL_API ChConstraintRigidRigid {
     int offset;
 
   protected:
+    // Rows of a contact in the constraint vector: the normal, the two tangential
+    // and the three spinning/rolling rows, depending on the solver mode (offset)
+    void Contact_rows(int index, int* rows);
+    // Multiply the rows of each contact by the corresponding block
+    void Block_x(const custom_vector<real>& blocks, const DynamicVector<real>& x, DynamicVector<real>& output);
+
     custom_vector<bool2> contact_active_pairs;
 
     real inv_h;
@@ -19,7 +19,49 @@
 
 #include "chrono_parallel/ChCudaDefines.h"
 #include <iostream>
+#include <cmath>
 //#include "chrono_parallel/math/float.h"
+
+#ifndef __CUDACC__
+#include "chrono_parallel/ChConfigParallel.h"
+#endif
+
+#if defined(__CUDACC__) || defined(CHRONO_PARALLEL_USE_CUDA)
+#include <vector_types.h>
+#include <vector_functions.h>
+#else
+// Host only build, provide the subset of the CUDA vector types used by the float math
+struct float2 {
+    float x, y;
+};
+struct float3 {
+    float x, y, z;
+};
+struct int3 {
+    int x, y, z;
+};
+static inline float2 make_float2(float x, float y) {
+    float2 t;
+    t.x = x;
+    t.y = y;
+    return t;
+}
+static inline float3 make_float3(float x, float y, float z) {
+    float3 t;
+    t.x = x;
+    t.y = y;
+    t.z = z;
+    return t;
+}
+static inline int3 make_int3(int x, int y, int z) {
+    int3 t;
+    t.x = x;
+    t.y = y;
+    t.z = z;
+    return t;
+}
+#endif
+
 namespace chrono {
 
 #define FLT_EPSILON 1.19209290E-07F
@@ -187,6 +187,7 @@ class CH_PARALLEL_API ChFluidContainer : public Ch3DOFContainer {
     int mpm_iterations;
     std::thread mpm_thread;
     bool mpm_init;
+    bool mpm_use_cpu;  // Run the MPM solve with OpenMP instead of CUDA, set before Initialize (default without CUDA)
     MPM_Settings temp_settings;
     custom_vector<float> mpm_pos, mpm_vel, mpm_jejp;
 
@@ -300,6 +301,7 @@ class CH_PARALLEL_API Ch3DOFRigidContainer : public Ch3DOFContainer {
 
     std::thread mpm_thread;
     bool mpm_init;
+    bool mpm_use_cpu;  // Run the MPM solve with OpenMP instead of CUDA, set before Initialize (default without CUDA)
     MPM_Settings temp_settings;
 
   private:
@@ -39,6 +39,11 @@ Ch3DOFRigidContainer::Ch3DOFRigidContainer(ChSystemParallelDVI* physics_system)
     theta_c = 2.5e-2;
     alpha_flip = .95;
     mpm_init = false;
+#ifdef CHRONO_PARALLEL_USE_CUDA
+    mpm_use_cpu = false;
+#else
+    mpm_use_cpu = true;
+#endif
     family.x = 1;
     family.y = 0x7FFF;
 }
@@ -59,7 +64,6 @@ void Ch3DOFRigidContainer::Update(double ChTime) {
     uint num_rigid_bodies = data_manager->num_rigid_bodies;
     uint num_shafts = data_manager->num_shafts;
     real3 h_gravity = data_manager->settings.step_size * mass * data_manager->settings.gravity;
-#ifdef CHRONO_PARALLEL_USE_CUDA
     if (mpm_init) {
         temp_settings.dt = data_manager->settings.step_size;
         temp_settings.kernel_radius = kernel_radius;
@@ -95,10 +99,18 @@ void Ch3DOFRigidContainer::Update(double ChTime) {
                 mpm_vel[i * 3 + 2] = data_manager->host_data.vel_3dof[i].z;
             }
 
-            MPM_UpdateDeformationGradient(std::ref(temp_settings), std::ref(mpm_pos), std::ref(mpm_vel),
-                                          std::ref(mpm_jejp));
+            if (mpm_use_cpu) {
+                MPM_CPU_UpdateDeformationGradient(std::ref(temp_settings), std::ref(mpm_pos), std::ref(mpm_vel),
+                                                  std::ref(mpm_jejp));
 
-            mpm_thread = std::thread(MPM_Solve, std::ref(temp_settings), std::ref(mpm_pos), std::ref(mpm_vel));
+                mpm_thread =
+                    std::thread(MPM_CPU_Solve, std::ref(temp_settings), std::ref(mpm_pos), std::ref(mpm_vel));
+            } else {
+                MPM_UpdateDeformationGradient(std::ref(temp_settings), std::ref(mpm_pos), std::ref(mpm_vel),
+                                              std::ref(mpm_jejp));
+
+                mpm_thread = std::thread(MPM_Solve, std::ref(temp_settings), std::ref(mpm_pos), std::ref(mpm_vel));
+            }
 
             //            for (int i = 0; i < data_manager->num_fluid_bodies; i++) {
             //                data_manager->host_data.vel_3dof[i].x = mpm_vel[i * 3 + 0];
@@ -107,7 +119,6 @@ void Ch3DOFRigidContainer::Update(double ChTime) {
             //            }
         }
     }
-#endif
 
 #pragma omp parallel for
     for (int i = 0; i < num_fluid_bodies; i++) {
@@ -276,7 +287,6 @@ void Ch3DOFRigidContainer::Setup(int start_constraint) {
 }
 
 void Ch3DOFRigidContainer::Initialize() {
-#ifdef CHRONO_PARALLEL_USE_CUDA
     temp_settings.dt = data_manager->settings.step_size;
     temp_settings.kernel_radius = kernel_radius;
     temp_settings.inv_radius = 1.0 / kernel_radius;
@@ -304,10 +314,13 @@ void Ch3DOFRigidContainer::Initialize() {
             mpm_pos[i * 3 + 2] = data_manager->host_data.pos_3dof[i].z;
         }
 
-        MPM_Initialize(temp_settings, mpm_pos);
+        if (mpm_use_cpu) {
+            MPM_CPU_Initialize(temp_settings, mpm_pos);
+        } else {
+            MPM_Initialize(temp_settings, mpm_pos);
+        }
     }
     mpm_init = true;
-#endif
 }
 
 void Ch3DOFRigidContainer::Build_D() {
@@ -540,7 +553,6 @@ real3 Ch3DOFRigidContainer::GetBodyContactTorque(uint body_id) {
     return real3(contact_forces[body_id * 6 + 3], contact_forces[body_id * 6 + 4], contact_forces[body_id * 6 + 5]);
 }
 void Ch3DOFRigidContainer::PreSolve() {
-#ifdef CHRONO_PARALLEL_USE_CUDA
     if (mpm_thread.joinable()) {
         mpm_thread.join();
 #pragma omp parallel for
@@ -551,7 +563,6 @@ void Ch3DOFRigidContainer::PreSolve() {
             data_manager->host_data.v[body_offset + index * 3 + 2] = mpm_vel[p * 3 + 2];
         }
     }
-#endif
 }
 void Ch3DOFRigidContainer::PostSolve() {}
 
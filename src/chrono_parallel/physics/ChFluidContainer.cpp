@@ -46,6 +46,11 @@ ChFluidContainer::ChFluidContainer(ChSystemParallelDVI* physics_system) {
     theta_c = 2.5e-2;
     alpha_flip = .95;
     mpm_init = false;
+#ifdef CHRONO_PARALLEL_USE_CUDA
+    mpm_use_cpu = false;
+#else
+    mpm_use_cpu = true;
+#endif
 
     family.x = 1;
     family.y = 0x7FFF;
@@ -70,7 +75,6 @@ void ChFluidContainer::Update(double ChTime) {
     custom_vector<real3>& vel_fluid = data_manager->host_data.vel_3dof;
     real3 g_acc = data_manager->settings.gravity;
     real3 h_gravity = data_manager->settings.step_size * mass * g_acc;
-#ifdef CHRONO_PARALLEL_USE_CUDA
     if (mpm_init) {
         temp_settings.dt = data_manager->settings.step_size;
         temp_settings.kernel_radius = kernel_radius;
@@ -106,10 +110,18 @@ void ChFluidContainer::Update(double ChTime) {
                 mpm_vel[i * 3 + 2] = data_manager->host_data.vel_3dof[i].z;
             }
 
-            MPM_UpdateDeformationGradient(std::ref(temp_settings), std::ref(mpm_pos), std::ref(mpm_vel),
-                                          std::ref(mpm_jejp));
+            if (mpm_use_cpu) {
+                MPM_CPU_UpdateDeformationGradient(std::ref(temp_settings), std::ref(mpm_pos), std::ref(mpm_vel),
+                                                  std::ref(mpm_jejp));
 
-            mpm_thread = std::thread(MPM_Solve, std::ref(temp_settings), std::ref(mpm_pos), std::ref(mpm_vel));
+                mpm_thread =
+                    std::thread(MPM_CPU_Solve, std::ref(temp_settings), std::ref(mpm_pos), std::ref(mpm_vel));
+            } else {
+                MPM_UpdateDeformationGradient(std::ref(temp_settings), std::ref(mpm_pos), std::ref(mpm_vel),
+                                              std::ref(mpm_jejp));
+
+                mpm_thread = std::thread(MPM_Solve, std::ref(temp_settings), std::ref(mpm_pos), std::ref(mpm_vel));
+            }
 
             for (int i = 0; i < data_manager->num_fluid_bodies; i++) {
                 data_manager->host_data.vel_3dof[i].x = mpm_vel[i * 3 + 0];
@@ -119,7 +131,6 @@ void ChFluidContainer::Update(double ChTime) {
         }
 
     }
-#endif
 #pragma omp parallel for
     for (int i = 0; i < num_fluid_bodies; i++) {
         // This was moved to after fluid collision detection
@@ -283,7 +294,6 @@ void ChFluidContainer::Setup(int start_constraint) {
 }
 
 void ChFluidContainer::Initialize() {
-#ifdef CHRONO_PARALLEL_USE_CUDA
     temp_settings.dt = data_manager->settings.step_size;
     temp_settings.kernel_radius = kernel_radius;
     temp_settings.inv_radius = 1.0 / kernel_radius;
@@ -311,10 +321,13 @@ void ChFluidContainer::Initialize() {
             mpm_pos[i * 3 + 2] = data_manager->host_data.pos_3dof[i].z;
         }
 
-        MPM_Initialize(temp_settings, mpm_pos);
+        if (mpm_use_cpu) {
+            MPM_CPU_Initialize(temp_settings, mpm_pos);
+        } else {
+            MPM_Initialize(temp_settings, mpm_pos);
+        }
     }
     mpm_init = true;
-#endif
 }
 void ChFluidContainer::Density_FluidMPM() {
     custom_vector<real3>& sorted_pos = data_manager->host_data.sorted_pos_3dof;
@@ -640,7 +653,6 @@ void ChFluidContainer::GenerateSparsity() {
 }
 
 void ChFluidContainer::PreSolve() {
-#ifdef CHRONO_PARALLEL_USE_CUDA
     if (mpm_thread.joinable()) {
         mpm_thread.join();
 #pragma omp parallel for
@@ -651,7 +663,6 @@ void ChFluidContainer::PreSolve() {
             data_manager->host_data.v[body_offset + index * 3 + 2] = mpm_vel[p * 3 + 2];
         }
     }
-#endif
 
     if (gamma_old.size() > 0) {
         if (enable_viscosity) {
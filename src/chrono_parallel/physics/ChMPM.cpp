@@ -0,0 +1,662 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Description: OpenMP implementation of the Pure MPM solve in ChMPM.cu. The
+// pipeline and the data layout are the same as on the GPU. Instead of atomics
+// the particle to grid transfers bin the markers by grid cell and process the
+// cells in 5x5x5 colors, two cells of the same color never touch the same node.
+// =============================================================================
+
+#include <algorithm>
+#include <vector>
+
+#include "chrono_parallel/physics/ChMPM.cuh"
+#include "chrono_parallel/physics/MPMUtils.h"
+#include "chrono_parallel/math/matrixf.cuh"
+
+namespace chrono {
+namespace {
+
+#define a_min 1e-13
+#define a_max 1e13
+#define neg_BB1_fallback 0.11
+#define neg_BB2_fallback 0.12
+
+// Width of the two ring stencil, also the number of colors per axis
+#define STENCIL_WIDTH 5
+#define NUM_COLORS (STENCIL_WIDTH * STENCIL_WIDTH * STENCIL_WIDTH)
+
+MPM_Settings host_settings;
+
+float3 min_bounding_point;
+float3 max_bounding_point;
+
+std::vector<float> pos, vel, JE_JP;
+std::vector<float> node_mass;
+std::vector<float> marker_volume;
+std::vector<float> grid_vel, delta_v;
+std::vector<float> rhs;
+std::vector<float> marker_Fe, marker_Fe_hat, marker_Fp;
+std::vector<float> PolarS, PolarR;
+
+std::vector<float> old_vel_node_mpm;
+std::vector<float> ml, mg, mg_p, ml_p;
+std::vector<float> marker_plasticity;
+
+// Markers sorted by the grid cell they live in and the non-empty cells sorted by color
+std::vector<int> marker_cell;
+std::vector<int> cell_start;
+std::vector<int> cell_markers;
+std::vector<int> color_start;
+std::vector<int> color_cells;
+
+// The interpolation weights are separable, evaluate them once per axis
+struct Stencil {
+    int cx, cy, cz;
+    float Nx[STENCIL_WIDTH], Ny[STENCIL_WIDTH], Nz[STENCIL_WIDTH];
+    float dNx[STENCIL_WIDTH], dNy[STENCIL_WIDTH], dNz[STENCIL_WIDTH];
+};
+
+inline void ComputeStencil(const float* sorted_pos, const int p, Stencil& s) {
+    const float bin_edge = host_settings.bin_edge;
+    const float inv_bin_edge = host_settings.inv_bin_edge;
+    const float xix = sorted_pos[p * 3 + 0];
+    const float xiy = sorted_pos[p * 3 + 1];
+    const float xiz = sorted_pos[p * 3 + 2];
+    s.cx = GridCoord(xix, inv_bin_edge, min_bounding_point.x);
+    s.cy = GridCoord(xiy, inv_bin_edge, min_bounding_point.y);
+    s.cz = GridCoord(xiz, inv_bin_edge, min_bounding_point.z);
+    for (int n = 0; n < STENCIL_WIDTH; n++) {
+        const float Tx = (xix - ((s.cx + n - 2) * bin_edge + min_bounding_point.x)) * inv_bin_edge;
+        const float Ty = (xiy - ((s.cy + n - 2) * bin_edge + min_bounding_point.y)) * inv_bin_edge;
+        const float Tz = (xiz - ((s.cz + n - 2) * bin_edge + min_bounding_point.z)) * inv_bin_edge;
+        s.Nx[n] = N(Tx);
+        s.Ny[n] = N(Ty);
+        s.Nz[n] = N(Tz);
+        s.dNx[n] = dN(Tx) * inv_bin_edge;
+        s.dNy[n] = dN(Ty) * inv_bin_edge;
+        s.dNz[n] = dN(Tz) * inv_bin_edge;
+    }
+}
+
+#define LOOP_TWO_RING_CPU(X)                                                                               \
+    for (int k = 0; k < STENCIL_WIDTH; ++k) {                                                              \
+        for (int j = 0; j < STENCIL_WIDTH; ++j) {                                                          \
+            for (int i = 0; i < STENCIL_WIDTH; ++i) {                                                      \
+                const int current_node =                                                                   \
+                    GridHash(s.cx + i - 2, s.cy + j - 2, s.cz + k - 2, host_settings.bins_per_axis_x,      \
+                             host_settings.bins_per_axis_y, host_settings.bins_per_axis_z);                \
+                X                                                                                          \
+            }                                                                                              \
+        }                                                                                                  \
+    }
+
+// Gradient of the weight of node (i,j,k)
+#define STENCIL_GRADIENT                                \
+    const float valx = s.dNx[i] * s.Ny[j] * s.Nz[k];    \
+    const float valy = s.Nx[i] * s.dNy[j] * s.Nz[k];    \
+    const float valz = s.Nx[i] * s.Ny[j] * s.dNz[k];
+
+// Apply a particle to grid kernel to every marker, markers that could write to the same node are never
+// processed at the same time
+template <typename Kernel>
+void ScatterColored(Kernel kernel) {
+    for (int color = 0; color < NUM_COLORS; color++) {
+#pragma omp parallel for schedule(dynamic, 16)
+        for (int c = color_start[color]; c < color_start[color + 1]; c++) {
+            const int cell = color_cells[c];
+            for (int i = cell_start[cell]; i < cell_start[cell + 1]; i++) {
+                kernel(cell_markers[i]);
+            }
+        }
+    }
+}
+
+void ComputeBounds() {
+    max_bounding_point = make_float3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    min_bounding_point = make_float3(FLT_MAX, FLT_MAX, FLT_MAX);
+
+#pragma omp parallel
+    {
+        float3 lower = make_float3(FLT_MAX, FLT_MAX, FLT_MAX);
+        float3 upper = make_float3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+#pragma omp for
+        for (int p = 0; p < host_settings.num_mpm_markers; p++) {
+            const float3 xi = make_float3(pos[p * 3 + 0], pos[p * 3 + 1], pos[p * 3 + 2]);
+            lower = Min(lower, xi);
+            upper = Max(upper, xi);
+        }
+#pragma omp critical
+        {
+            min_bounding_point = Min(min_bounding_point, lower);
+            max_bounding_point = Max(max_bounding_point, upper);
+        }
+    }
+
+    min_bounding_point.x = host_settings.kernel_radius * roundf(min_bounding_point.x / host_settings.kernel_radius);
+    min_bounding_point.y = host_settings.kernel_radius * roundf(min_bounding_point.y / host_settings.kernel_radius);
+    min_bounding_point.z = host_settings.kernel_radius * roundf(min_bounding_point.z / host_settings.kernel_radius);
+
+    max_bounding_point.x = host_settings.kernel_radius * roundf(max_bounding_point.x / host_settings.kernel_radius);
+    max_bounding_point.y = host_settings.kernel_radius * roundf(max_bounding_point.y / host_settings.kernel_radius);
+    max_bounding_point.z = host_settings.kernel_radius * roundf(max_bounding_point.z / host_settings.kernel_radius);
+
+    max_bounding_point = max_bounding_point + host_settings.kernel_radius * 8;
+    min_bounding_point = min_bounding_point - host_settings.kernel_radius * 6;
+
+    host_settings.bin_edge = host_settings.kernel_radius * 2;
+
+    host_settings.bins_per_axis_x = (max_bounding_point.x - min_bounding_point.x) / host_settings.bin_edge;
+    host_settings.bins_per_axis_y = (max_bounding_point.y - min_bounding_point.y) / host_settings.bin_edge;
+    host_settings.bins_per_axis_z = (max_bounding_point.z - min_bounding_point.z) / host_settings.bin_edge;
+
+    host_settings.inv_bin_edge = float(1.) / host_settings.bin_edge;
+    host_settings.num_mpm_nodes =
+        host_settings.bins_per_axis_x * host_settings.bins_per_axis_y * host_settings.bins_per_axis_z;
+}
+
+// Counting sort of the markers by cell, followed by a counting sort of the non-empty cells by color
+void BinMarkers() {
+    const int num_markers = host_settings.num_mpm_markers;
+    const int num_nodes = host_settings.num_mpm_nodes;
+    const int bx = host_settings.bins_per_axis_x;
+    const int by = host_settings.bins_per_axis_y;
+
+    marker_cell.resize(num_markers);
+#pragma omp parallel for
+    for (int p = 0; p < num_markers; p++) {
+        const int cx = GridCoord(pos[p * 3 + 0], host_settings.inv_bin_edge, min_bounding_point.x);
+        const int cy = GridCoord(pos[p * 3 + 1], host_settings.inv_bin_edge, min_bounding_point.y);
+        const int cz = GridCoord(pos[p * 3 + 2], host_settings.inv_bin_edge, min_bounding_point.z);
+        marker_cell[p] = GridHash(cx, cy, cz, bx, by, host_settings.bins_per_axis_z);
+    }
+
+    cell_start.assign(num_nodes + 1, 0);
+    for (int p = 0; p < num_markers; p++) {
+        cell_start[marker_cell[p] + 1]++;
+    }
+    color_start.assign(NUM_COLORS + 1, 0);
+    for (int cell = 0; cell < num_nodes; cell++) {
+        if (cell_start[cell + 1] > 0) {
+            const int color = (cell % bx) % STENCIL_WIDTH + STENCIL_WIDTH * (((cell / bx) % by) % STENCIL_WIDTH) +
+                              STENCIL_WIDTH * STENCIL_WIDTH * ((cell / (bx * by)) % STENCIL_WIDTH);
+            color_start[color + 1]++;
+        }
+        cell_start[cell + 1] += cell_start[cell];
+    }
+    for (int color = 0; color < NUM_COLORS; color++) {
+        color_start[color + 1] += color_start[color];
+    }
+
+    std::vector<int> offset(cell_start.begin(), cell_start.end() - 1);
+    cell_markers.resize(num_markers);
+    for (int p = 0; p < num_markers; p++) {
+        cell_markers[offset[marker_cell[p]]++] = p;
+    }
+
+    std::vector<int> color_offset(color_start.begin(), color_start.end() - 1);
+    color_cells.resize(color_start[NUM_COLORS]);
+    for (int cell = 0; cell < num_nodes; cell++) {
+        if (cell_start[cell + 1] > cell_start[cell]) {
+            const int color = (cell % bx) % STENCIL_WIDTH + STENCIL_WIDTH * (((cell / bx) % by) % STENCIL_WIDTH) +
+                              STENCIL_WIDTH * STENCIL_WIDTH * ((cell / (bx * by)) % STENCIL_WIDTH);
+            color_cells[color_offset[color]++] = cell;
+        }
+    }
+}
+
+void Rasterize(bool with_velocity) {
+    ScatterColored([&](const int p) {
+        Stencil s;
+        ComputeStencil(pos.data(), p, s);
+        if (with_velocity) {
+            const float vix = vel[p * 3 + 0];
+            const float viy = vel[p * 3 + 1];
+            const float viz = vel[p * 3 + 2];
+            LOOP_TWO_RING_CPU(                                                           //
+                const float weight = s.Nx[i] * s.Ny[j] * s.Nz[k] * host_settings.mass;  //
+                node_mass[current_node] += weight;                                       //
+                grid_vel[current_node * 3 + 0] += weight * vix;                          //
+                grid_vel[current_node * 3 + 1] += weight * viy;                          //
+                grid_vel[current_node * 3 + 2] += weight * viz;)
+        } else {
+            LOOP_TWO_RING_CPU(node_mass[current_node] += s.Nx[i] * s.Ny[j] * s.Nz[k] * host_settings.mass;)
+        }
+    });
+}
+
+void NormalizeWeights() {
+#pragma omp parallel for
+    for (int i = 0; i < host_settings.num_mpm_nodes; i++) {
+        const float n_mass = node_mass[i];
+        if (n_mass > FLT_EPSILON) {
+            grid_vel[i * 3 + 0] /= n_mass;
+            grid_vel[i * 3 + 1] /= n_mass;
+            grid_vel[i * 3 + 2] /= n_mass;
+        }
+    }
+}
+
+void ComputeParticleVolumes() {
+    const float bin_edge = host_settings.bin_edge;
+#pragma omp parallel for
+    for (int p = 0; p < host_settings.num_mpm_markers; p++) {
+        Stencil s;
+        ComputeStencil(pos.data(), p, s);
+        float particle_density = 0;
+        LOOP_TWO_RING_CPU(particle_density += node_mass[current_node] * s.Nx[i] * s.Ny[j] * s.Nz[k];)
+        // Inverse density to remove division
+        particle_density = (bin_edge * bin_edge * bin_edge) / particle_density;
+        marker_volume[p] = host_settings.mass * particle_density;
+    }
+}
+
+// Velocity gradient at a marker
+inline Mat33f VelocityGradient(const Stencil& s, const float* v_array) {
+    Mat33f vel_grad(0.0f);
+    LOOP_TWO_RING_CPU(                                 //
+        const float vnx = v_array[current_node * 3 + 0];  //
+        const float vny = v_array[current_node * 3 + 1];  //
+        const float vnz = v_array[current_node * 3 + 2];  //
+        STENCIL_GRADIENT                                  //
+        vel_grad[0] += vnx * valx; vel_grad[1] += vny * valx; vel_grad[2] += vnz * valx;  //
+        vel_grad[3] += vnx * valy; vel_grad[4] += vny * valy; vel_grad[5] += vnz * valy;  //
+        vel_grad[6] += vnx * valz; vel_grad[7] += vny * valz; vel_grad[8] += vnz * valz;)
+    return vel_grad;
+}
+
+// Scatter the divergence of a per marker stress like quantity to the grid
+inline void ScatterStress(const Stencil& s, const Mat33f& VAP, float* result_array) {
+    LOOP_TWO_RING_CPU(                                                       //
+        STENCIL_GRADIENT                                                     //
+        result_array[current_node * 3 + 0] += VAP[0] * valx + VAP[3] * valy + VAP[6] * valz;  //
+        result_array[current_node * 3 + 1] += VAP[1] * valx + VAP[4] * valy + VAP[7] * valz;  //
+        result_array[current_node * 3 + 2] += VAP[2] * valx + VAP[5] * valy + VAP[8] * valz;)
+}
+
+void UpdateDeformationGradient() {
+    const int num_markers = host_settings.num_mpm_markers;
+#pragma omp parallel for
+    for (int p = 0; p < num_markers; p++) {
+        Stencil s;
+        ComputeStencil(pos.data(), p, s);
+        const Mat33f vel_grad = VelocityGradient(s, grid_vel.data());
+
+        Mat33f delta_F = (Mat33f(1.0) + host_settings.dt * vel_grad);
+        Mat33f m_FE(marker_Fe.data(), p, num_markers);
+        Mat33f m_FPpre(marker_Fp.data(), p, num_markers);
+
+        Mat33f Fe_tmp = delta_F * m_FE;
+        Mat33f F_tmp = Fe_tmp * m_FPpre;
+        Mat33f U, V;
+        float3 E;
+        SVD(Fe_tmp, U, E, V);
+        float3 E_clamped = E;
+
+        // Clamp to sphere, same yield model as the GPU solver
+        float center = 1.0 + (host_settings.theta_s - host_settings.theta_c) * .5;
+        float radius = (host_settings.theta_s + host_settings.theta_c) * .5;
+        float3 offset = E - center;
+        float lent = Length(offset);
+        if (lent > radius) {
+            offset = offset * radius / lent;
+        }
+        E_clamped = offset + center;
+        marker_plasticity[p] = fabsf(E.x * E.y * E.z - E_clamped.x * E_clamped.y * E_clamped.z);
+
+        // Inverse of Diagonal E_clamped matrix is 1/E_clamped
+        Mat33f m_FP = V * MultTranspose(Mat33f(1.0 / E_clamped), U) * F_tmp;
+        float JP_new = Determinant(m_FP);
+        // Ensure that F_p is purely deviatoric
+        Mat33f T1 = powf(JP_new, 1.0 / 3.0) * U * MultTranspose(Mat33f(E_clamped), V);
+        Mat33f T2 = powf(JP_new, -1.0 / 3.0) * m_FP;
+
+        JE_JP[p * 2 + 0] = Determinant(T1);
+        JE_JP[p * 2 + 1] = Determinant(T2);
+
+        T1.Store(marker_Fe.data(), p, num_markers);
+        T2.Store(marker_Fp.data(), p, num_markers);
+    }
+}
+
+void FeHat() {
+    const int num_markers = host_settings.num_mpm_markers;
+#pragma omp parallel for
+    for (int p = 0; p < num_markers; p++) {
+        Stencil s;
+        ComputeStencil(pos.data(), p, s);
+        const Mat33f Fe_hat_t = VelocityGradient(s, grid_vel.data());
+        Mat33f m_Fe(marker_Fe.data(), p, num_markers);
+        Mat33f m_Fe_hat = (Mat33f(1.0) + host_settings.dt * Fe_hat_t) * m_Fe;
+        m_Fe_hat.Store(marker_Fe_hat.data(), p, num_markers);
+    }
+}
+
+void ApplyForces() {
+    const int num_markers = host_settings.num_mpm_markers;
+    ScatterColored([&](const int p) {
+        const Mat33f FE(marker_Fe.data(), p, num_markers);
+        const Mat33f FE_hat(marker_Fe_hat.data(), p, num_markers);
+
+        const float a = -one_third;
+        const float J = Determinant(FE_hat);
+        const float Ja = powf(J, a);
+        const float current_mu = host_settings.mu * expf(host_settings.hardening_coefficient * (marker_plasticity[p]));
+
+        Mat33f JaFE = Ja * FE;
+        Mat33f UE, VE;
+        float3 EE;
+        SVD(JaFE, UE, EE, VE); /* Perform a polar decomposition, FE=RE*SE, RE is the Unitary part*/
+        Mat33f RE = MultTranspose(UE, VE);
+        Mat33f SE = VE * MultTranspose(EE, VE);
+        RE.Store(PolarR.data(), p, num_markers);
+
+        PolarS[p + 0 * num_markers] = SE[0];
+        PolarS[p + 1 * num_markers] = SE[1];
+        PolarS[p + 2 * num_markers] = SE[2];
+        PolarS[p + 3 * num_markers] = SE[4];
+        PolarS[p + 4 * num_markers] = SE[5];
+        PolarS[p + 5 * num_markers] = SE[8];
+
+        const Mat33f H = AdjointTranspose(FE_hat) * (1.0f / J);
+        const Mat33f A = 2.f * current_mu * (JaFE - RE);
+        const Mat33f Z_B = Z__B(A, FE_hat, Ja, a, H);
+        const Mat33f vPEDFepT = host_settings.dt * marker_volume[p] * MultTranspose(Z_B, FE);
+
+        Stencil s;
+        ComputeStencil(pos.data(), p, s);
+        LOOP_TWO_RING_CPU(                                                          //
+            const float mass = node_mass[current_node];                             //
+            if (mass > 0) {                                                         //
+                STENCIL_GRADIENT                                                    //
+                const float fx = vPEDFepT[0] * valx + vPEDFepT[3] * valy + vPEDFepT[6] * valz;
+                const float fy = vPEDFepT[1] * valx + vPEDFepT[4] * valy + vPEDFepT[7] * valz;
+                const float fz = vPEDFepT[2] * valx + vPEDFepT[5] * valy + vPEDFepT[8] * valz;
+                grid_vel[current_node * 3 + 0] -= fx / mass;
+                grid_vel[current_node * 3 + 1] -= fy / mass;
+                grid_vel[current_node * 3 + 2] -= fz / mass;
+            })
+    });
+}
+
+void Rhs() {
+#pragma omp parallel for
+    for (int current_node = 0; current_node < host_settings.num_mpm_nodes; current_node++) {
+        const float mass = node_mass[current_node];
+        if (mass > 0) {
+            rhs[current_node * 3 + 0] = mass * grid_vel[current_node * 3 + 0];
+            rhs[current_node * 3 + 1] = mass * grid_vel[current_node * 3 + 1];
+            rhs[current_node * 3 + 2] = mass * grid_vel[current_node * 3 + 2];
+        } else {
+            rhs[current_node * 3 + 0] = 0;
+            rhs[current_node * 3 + 1] = 0;
+            rhs[current_node * 3 + 2] = 0;
+        }
+    }
+}
+
+// output = A * input, output must be zero on entry
+void Multiply(const std::vector<float>& input, std::vector<float>& output) {
+    const int num_markers = host_settings.num_mpm_markers;
+    const float* v_array = input.data();
+    float* result_array = output.data();
+
+    ScatterColored([&](const int p) {
+        Stencil s;
+        ComputeStencil(pos.data(), p, s);
+        const Mat33f m_FE(marker_Fe.data(), p, num_markers);
+        const Mat33f delta_F = VelocityGradient(s, v_array) * m_FE;
+
+        const float current_mu =
+            2.0f * host_settings.mu * expf(host_settings.hardening_coefficient * (marker_plasticity[p]));
+
+        const Mat33f RE(PolarR.data(), p, num_markers);
+        const Mat33f F(marker_Fe_hat.data(), p, num_markers);
+        const float a = -one_third;
+        const float J = Determinant(F);
+        const float Ja = powf(J, a);
+        const Mat33f H = AdjointTranspose(F) * (1.0f / J);
+
+        const Mat33f B_Z = B__Z(delta_F, F, Ja, a, H);
+        const Mat33f WE = TransposeMult(RE, B_Z);
+        // C is the original second derivative
+        SymMat33f SE;
+        SE[0] = PolarS[p + num_markers * 0];
+        SE[1] = PolarS[p + num_markers * 1];
+        SE[2] = PolarS[p + num_markers * 2];
+        SE[3] = PolarS[p + num_markers * 3];
+        SE[4] = PolarS[p + num_markers * 4];
+        SE[5] = PolarS[p + num_markers * 5];
+        const Mat33f C_B_Z = current_mu * (B_Z - Solve_dR(RE, SE, WE));
+
+        const Mat33f FE = Ja * F;
+        const Mat33f A = current_mu * (FE - RE);
+        const Mat33f P1 = Z__B(C_B_Z, F, Ja, a, H);
+        const Mat33f P2 = (a * DoubleDot(H, delta_F)) * Z__B(A, F, Ja, a, H);
+        const Mat33f P3 = (a * Ja * DoubleDot(A, delta_F)) * H;
+        const Mat33f P4 = (-a * Ja * DoubleDot(A, F)) * H * TransposeMult(delta_F, H);
+
+        const Mat33f VAP = marker_volume[p] * MultTranspose(P1 + P2 + P3 + P4, m_FE);
+        ScatterStress(s, VAP, result_array);
+    });
+
+#pragma omp parallel for
+    for (int i = 0; i < host_settings.num_mpm_nodes; i++) {
+        const float mass = node_mass[i];
+        if (mass > 0) {
+            result_array[i * 3 + 0] += mass * (v_array[i * 3 + 0]);
+            result_array[i * 3 + 1] += mass * (v_array[i * 3 + 1]);
+            result_array[i * 3 + 2] += mass * (v_array[i * 3 + 2]);
+        }
+    }
+}
+
+void BBSolver(const std::vector<float>& r, std::vector<float>& delta_v) {
+    const int size = r.size();
+    float lastgoodres = 10e30;
+    float alpha = 0.0001;
+
+    ml = delta_v;
+    mg.assign(size, 0);
+    ml_p.resize(size);
+    mg_p.resize(size);
+
+    Multiply(ml, mg);
+#pragma omp parallel for
+    for (int i = 0; i < size; i++) {
+        mg[i] = mg[i] - r[i];
+    }
+
+    for (int current_iteration = 0; current_iteration < host_settings.num_iterations; current_iteration++) {
+#pragma omp parallel for
+        for (int i = 0; i < size; i++) {
+            ml_p[i] = ml[i] - alpha * mg[i];
+            mg_p[i] = 0;
+        }
+
+        Multiply(ml_p, mg_p);
+
+        float dot_ms_ms = 0, dot_ms_my = 0, dot_my_my = 0;
+#pragma omp parallel for reduction(+ : dot_ms_ms, dot_ms_my, dot_my_my)
+        for (int i = 0; i < size; i++) {
+            mg_p[i] = mg_p[i] - r[i];
+            const float ms = ml_p[i] - ml[i];
+            const float my = mg_p[i] - mg[i];
+            dot_ms_ms += ms * ms;
+            dot_ms_my += ms * my;
+            dot_my_my += my * my;
+        }
+
+        if (current_iteration % 2 == 0) {
+            if (dot_ms_my <= 0) {
+                alpha = neg_BB1_fallback;
+            } else {
+                alpha = fminf(a_max, fmaxf(a_min, dot_ms_ms / dot_ms_my));
+            }
+        } else {
+            if (dot_ms_my <= 0) {
+                alpha = neg_BB2_fallback;
+            } else {
+                alpha = fminf(a_max, fmaxf(a_min, dot_ms_my / dot_my_my));
+            }
+        }
+
+        ml.swap(ml_p);
+        mg.swap(mg_p);
+
+        float dot_g_proj_norm = 0;
+#pragma omp parallel for reduction(+ : dot_g_proj_norm)
+        for (int i = 0; i < size; i++) {
+            dot_g_proj_norm += mg[i] * mg[i];
+        }
+        float g_proj_norm = sqrtf(dot_g_proj_norm);
+
+        if (g_proj_norm < lastgoodres) {
+            lastgoodres = g_proj_norm;
+            delta_v = ml;
+        }
+    }
+}
+
+void IncrementVelocity() {
+#pragma omp parallel for
+    for (int i = 0; i < host_settings.num_mpm_nodes * 3; i++) {
+        grid_vel[i] += delta_v[i] - old_vel_node_mpm[i];
+    }
+}
+
+void UpdateParticleVelocity() {
+    const float alpha = host_settings.alpha_flip;
+#pragma omp parallel for
+    for (int p = 0; p < host_settings.num_mpm_markers; p++) {
+        Stencil s;
+        ComputeStencil(pos.data(), p, s);
+        float3 V_flip = make_float3(vel[p * 3 + 0], vel[p * 3 + 1], vel[p * 3 + 2]);
+        float3 V_pic = make_float3(0.0, 0.0, 0.0);
+
+        LOOP_TWO_RING_CPU(                                                            //
+            const float weight = s.Nx[i] * s.Ny[j] * s.Nz[k];                         //
+            const float vnx = grid_vel[current_node * 3 + 0];                         //
+            const float vny = grid_vel[current_node * 3 + 1];                         //
+            const float vnz = grid_vel[current_node * 3 + 2];                         //
+            V_pic.x += vnx * weight;                                                  //
+            V_pic.y += vny * weight;                                                  //
+            V_pic.z += vnz * weight;                                                  //
+            V_flip.x += (vnx - old_vel_node_mpm[current_node * 3 + 0]) * weight;      //
+            V_flip.y += (vny - old_vel_node_mpm[current_node * 3 + 1]) * weight;      //
+            V_flip.z += (vnz - old_vel_node_mpm[current_node * 3 + 2]) * weight;)
+        float3 new_vel = (1.0 - alpha) * V_pic + alpha * V_flip;
+
+        float speed = Length(new_vel);
+        if (speed > host_settings.max_velocity) {
+            new_vel = new_vel * host_settings.max_velocity / speed;
+        }
+        vel[p * 3 + 0] = new_vel.x;
+        vel[p * 3 + 1] = new_vel.y;
+        vel[p * 3 + 2] = new_vel.z;
+    }
+}
+
+}  // end anonymous namespace
+
+void MPM_CPU_UpdateDeformationGradient(MPM_Settings& settings,
+                                       std::vector<float>& positions,
+                                       std::vector<float>& velocities,
+                                       std::vector<float>& jejp) {
+    host_settings = settings;
+    pos = positions;
+    vel = velocities;
+
+    ComputeBounds();
+    BinMarkers();
+
+    node_mass.assign(host_settings.num_mpm_nodes, 0);
+    grid_vel.assign(host_settings.num_mpm_nodes * 3, 0);
+
+    Rasterize(true);
+    NormalizeWeights();
+    UpdateDeformationGradient();
+
+    jejp = JE_JP;
+}
+
+void MPM_CPU_Solve(MPM_Settings& settings, std::vector<float>& positions, std::vector<float>& velocities) {
+    old_vel_node_mpm = grid_vel;
+    rhs.resize(host_settings.num_mpm_nodes * 3);
+
+    FeHat();
+    ApplyForces();
+    Rhs();
+
+    delta_v = old_vel_node_mpm;
+    BBSolver(rhs, delta_v);
+
+    IncrementVelocity();
+    UpdateParticleVelocity();
+
+    velocities = vel;
+}
+
+void MPM_CPU_Initialize(MPM_Settings& settings, std::vector<float>& positions) {
+    host_settings = settings;
+    pos = positions;
+    const int num_markers = host_settings.num_mpm_markers;
+
+    ComputeBounds();
+    BinMarkers();
+
+    marker_volume.resize(num_markers);
+    node_mass.assign(host_settings.num_mpm_nodes, 0);
+
+    Rasterize(false);
+    ComputeParticleVolumes();
+
+    marker_Fe.resize(num_markers * 9);
+    marker_Fe_hat.resize(num_markers * 9);
+    marker_Fp.resize(num_markers * 9);
+    PolarR.resize(num_markers * 9);
+    PolarS.resize(num_markers * 6);
+    JE_JP.resize(num_markers * 2);
+    marker_plasticity.assign(num_markers * 2, 0);
+
+#pragma omp parallel for
+    for (int i = 0; i < num_markers; i++) {
+        Mat33f T(1.0f);
+        T.Store(marker_Fe.data(), i, num_markers);
+        T.Store(marker_Fp.data(), i, num_markers);
+        T.Store(PolarR.data(), i, num_markers);
+
+        PolarS[i + num_markers * 0] = 1.0f;
+        PolarS[i + num_markers * 1] = 0.0f;
+        PolarS[i + num_markers * 2] = 0.0f;
+        PolarS[i + num_markers * 3] = 1.0f;
+        PolarS[i + num_markers * 4] = 0.0f;
+        PolarS[i + num_markers * 5] = 1.0f;
+    }
+}
+
+#ifndef CHRONO_PARALLEL_USE_CUDA
+// Without CUDA the GPU entry points fall back to the CPU solver
+void MPM_Initialize(MPM_Settings& settings, std::vector<float>& positions) {
+    MPM_CPU_Initialize(settings, positions);
+}
+void MPM_Solve(MPM_Settings& settings, std::vector<float>& positions, std::vector<float>& velocities) {
+    MPM_CPU_Solve(settings, positions, velocities);
+}
+void MPM_UpdateDeformationGradient(MPM_Settings& settings,
+                                   std::vector<float>& positions,
+                                   std::vector<float>& velocities,
+                                   std::vector<float>& jejp) {
+    MPM_CPU_UpdateDeformationGradient(settings, positions, velocities, jejp);
+}
+#endif
+}
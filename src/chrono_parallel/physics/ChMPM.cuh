@@ -42,4 +42,13 @@ void MPM_UpdateDeformationGradient(MPM_Settings& settings,
                                    std::vector<float>& positions,
                                    std::vector<float>& velocities,
                                    std::vector<float>& jejp);
+
+// OpenMP implementation of the same solve, see ChMPM.cpp. Without CUDA the functions above forward to these.
+void MPM_CPU_Initialize(MPM_Settings& settings, std::vector<float>& positions);
+void MPM_CPU_Solve(MPM_Settings& settings, std::vector<float>& positions, std::vector<float>& velocities);
+
+void MPM_CPU_UpdateDeformationGradient(MPM_Settings& settings,
+                                       std::vector<float>& positions,
+                                       std::vector<float>& velocities,
+                                       std::vector<float>& jejp);
 }
@@ -20,6 +20,8 @@
 
 #include <numeric>
 
+#include <thrust/sort.h>
+
 using namespace chrono;
 using namespace chrono::collision;
 #ifdef LOGGINGENABLED
@@ -38,6 +40,7 @@ ChSystemParallel::ChSystemParallel(unsigned int max_objects) : ChSystem(1000, 10
     cd_accumulator.resize(10, 0);
     frame_threads = 0;
     frame_bins = 0;
+    frame_reorder = 0;
     old_timer = 0;
     old_timer_cd = 0;
     detect_optimal_threads = false;
@@ -82,6 +85,16 @@ int ChSystemParallel::Integrate_Y() {
     data_manager->system_timer.Reset();
     data_manager->system_timer.start("step");
 
+    // Periodically sort the bodies in space, this has to happen before the
+    // system-wide vectors are filled in Update()
+    int reorder_frequency = data_manager->settings.collision.reorder_frequency;
+    if (reorder_frequency > 0) {
+        if (frame_reorder % reorder_frequency == 0) {
+            ReorderBodies();
+        }
+        frame_reorder++;
+    }
+
     Setup();
 
     data_manager->system_timer.start("update");
@@ -190,6 +203,8 @@ void ChSystemParallel::AddBody(std::shared_ptr<ChBody> newbody) {
     // This is only need because bilaterals need to know what bodies to
     // refer to. Not used by contacts
     newbody->SetId(data_manager->num_rigid_bodies);
+    data_manager->host_data.rigid_original_id.push_back(data_manager->num_rigid_bodies);
+    data_manager->host_data.rigid_current_index.push_back(data_manager->num_rigid_bodies);
 
     bodylist.push_back(newbody);
     data_manager->num_rigid_bodies++;
@@ -209,6 +224,91 @@ void ChSystemParallel::AddBody(std::shared_ptr<ChBody> newbody) {
     AddMaterialSurfaceData(newbody);
 }
 
+//
+// Spread the lower 10 bits of a number so that there are two zero bits between
+// each of them, used to interleave three coordinates into a Morton code.
+//
+static inline uint SpreadBits(uint v) {
+    v = (v * 0x00010001u) & 0xFF0000FFu;
+    v = (v * 0x00000101u) & 0x0F00F00Fu;
+    v = (v * 0x00000011u) & 0xC30C30C3u;
+    v = (v * 0x00000005u) & 0x49249249u;
+    return v;
+}
+
+//
+// Sort the rigid bodies by the Morton code of their position on a 1024^3 grid
+// spanning all bodies. The body list and all body IDs are updated here, the
+// data manager permutes the system-wide vectors. With the Bullet collision
+// system the companion IDs reported by the narrowphase are body indices, so
+// they are remapped as well.
+//
+// Fixed bodies are kept first, in their original order. The DEM contact history
+// is stored on the body with the larger index (see ChIterativeSolverParallelDEM),
+// which assumes that large bodies such as containers come first: moved among the
+// other bodies, they would own the histories of all the contacts on them and run
+// out of slots.
+//
+void ChSystemParallel::ReorderBodies() {
+    const uint num_bodies = data_manager->num_rigid_bodies;
+    if (num_bodies < 2)
+        return;
+
+    custom_vector<real3> pos(num_bodies);
+#pragma omp parallel for
+    for (int i = 0; i < num_bodies; i++) {
+        ChVector<>& body_pos = bodylist[i]->GetPos();
+        pos[i] = real3(body_pos.x, body_pos.y, body_pos.z);
+    }
+
+    real3 pos_min(C_LARGE_REAL), pos_max(-C_LARGE_REAL);
+    for (int i = 0; i < num_bodies; i++) {
+        pos_min = Min(pos_min, pos[i]);
+        pos_max = Max(pos_max, pos[i]);
+    }
+    real3 scale = real3(1023) / Max(pos_max - pos_min, C_EPSILON);
+
+    custom_vector<uint> codes(num_bodies);
+    custom_vector<uint> order(num_bodies);
+#pragma omp parallel for
+    for (int i = 0; i < num_bodies; i++) {
+        real3 cell = (pos[i] - pos_min) * scale;
+        uint code = (SpreadBits(uint(cell.x)) << 2) | (SpreadBits(uint(cell.y)) << 1) | SpreadBits(uint(cell.z));
+        codes[i] = bodylist[i]->GetBodyFixed() ? 0 : code + 1;
+        order[i] = i;
+    }
+    thrust::stable_sort_by_key(THRUST_PAR codes.begin(), codes.end(), order.begin());
+
+    bool sorted = true;
+    for (int i = 0; i < num_bodies && sorted; i++) {
+        sorted = (order[i] == i);
+    }
+    if (sorted)
+        return;
+
+    std::vector<std::shared_ptr<ChBody> > sorted_bodies(num_bodies);
+#pragma omp parallel for
+    for (int i = 0; i < num_bodies; i++) {
+        sorted_bodies[i] = bodylist[order[i]];
+        sorted_bodies[i]->SetId(i);
+        if (collision_system_type == COLLSYS_BULLET_PARALLEL) {
+            ChModelBullet* model = static_cast<ChModelBullet*>(sorted_bodies[i]->GetCollisionModel());
+            model->GetBulletModel()->setCompanionId(i);
+        }
+    }
+    bodylist.swap(sorted_bodies);
+
+    data_manager->ReorderRigidBodies(order);
+}
+
+uint ChSystemParallel::GetBodyIndex(uint original_id) const {
+    return data_manager->host_data.rigid_current_index[original_id];
+}
+
+uint ChSystemParallel::GetBodyOriginalId(uint body_id) const {
+    return data_manager->host_data.rigid_original_id[body_id];
+}
+
 //
 // Add physics items, other than bodies or links, to the system.
 // We keep track separately of ChShaft elements which are maintained in their
@@ -68,6 +68,16 @@ class CH_PARALLEL_API ChSystemParallel : public ChSystem {
     void Update3DOFBodies();
     void RecomputeThreads();
 
+    /// Sort the rigid bodies (and their collision shapes) along a Morton curve so
+    /// that bodies that are close in space are also close in memory. This changes
+    /// the body IDs, the original IDs remain available through GetBodyOriginalId.
+    /// Called automatically when collision_settings::reorder_frequency is set.
+    void ReorderBodies();
+    /// Get the current ID of the body that was added to the system with the given ID.
+    uint GetBodyIndex(uint original_id) const;
+    /// Get the ID a body was added to the system with, given its current ID.
+    uint GetBodyOriginalId(uint body_id) const;
+
     virtual void AddMaterialSurfaceData(std::shared_ptr<ChBody> newbody) = 0;
     virtual void UpdateMaterialSurfaceData(int index, ChBody* body) = 0;
     virtual void Setup();
@@ -125,7 +135,7 @@ class CH_PARALLEL_API ChSystemParallel : public ChSystem {
 
     int detect_optimal_bins;
     std::vector<double> timer_accumulator, cd_accumulator;
-    uint frame_threads, frame_bins, counter;
+    uint frame_threads, frame_bins, frame_reorder, counter;
     std::vector<ChLink*>::iterator it;
 
     COLLISIONSYSTEMTYPE collision_system_type;
@@ -25,6 +25,7 @@ ChSystemParallelDVI::ChSystemParallelDVI(unsigned int max_objects) : ChSystemPar
     data_manager->system_timer.AddTimer("ChIterativeSolverParallel_E");
     data_manager->system_timer.AddTimer("ChIterativeSolverParallel_R");
     data_manager->system_timer.AddTimer("ChIterativeSolverParallel_N");
+    data_manager->system_timer.AddTimer("ChIterativeSolverParallel_P");
 }
 
 ChSystemParallelDVI::ChSystemParallelDVI(const ChSystemParallelDVI& other) : ChSystemParallel(other) {
@@ -78,16 +78,29 @@ class CH_PARALLEL_API ChIterativeSolverParallelDVI : public ChIterativeSolverPar
     void ComputeR();
     ///< Compute the Shur matrix N.
     void ComputeN();
+    ///< Compute the Jacobi scaling (preconditioner), only if enabled in the settings.
+    void ComputeP();
     ///< Set the RHS vector depending on the local solver mode
     void SetR();
     ///< This function computes an initial guess for each contact
     void PreSolve();
     ///< This function is used to change the solver algorithm.
     void ChangeSolverType(SOLVERTYPE type);
+    ///< Solve the full system with the current local solver mode. In mixed
+    ///< precision mode this performs iterative refinement around the solver.
+    uint SolveFull(const uint max_iter);
+    ///< Compute the double precision residual R - N * gamma (into refine_rhs) and
+    ///< return the norm of the projected gradient, used by iterative refinement.
+    real RefinementResidual();
 
   private:
     ChShurProduct ShurProductFull;
     ChProjectConstraints ProjectFull;
+
+    // Mixed precision solve
+    ChShurProductMixed ShurProductMixed;
+    ChProjectShifted ProjectShifted;
+    DynamicVector<real> refine_rhs, refine_delta, refine_temp;
 };
 
 class CH_PARALLEL_API ChIterativeSolverParallelDEM : public ChIterativeSolverParallel {
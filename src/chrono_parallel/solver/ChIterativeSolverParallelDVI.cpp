@@ -65,6 +65,7 @@ void ChIterativeSolverParallelDVI::RunTimeStep() {
     ComputeE();
     ComputeR();
     ComputeN();
+    ComputeP();
     data_manager->system_timer.start("ChIterativeSolverParallel_Solve");
 
     data_manager->node_container->PreSolve();
@@ -81,6 +82,10 @@ void ChIterativeSolverParallelDVI::RunTimeStep() {
     ShurProductBilateral.Setup(data_manager);
     ShurProductFEM.Setup(data_manager);
     ProjectFull.Setup(data_manager);
+    if (data_manager->settings.solver.use_mixed_precision) {
+        ShurProductMixed.Setup(data_manager);
+        ProjectShifted.Setup(data_manager);
+    }
 
     PerformStabilization();
 
@@ -91,12 +96,7 @@ void ChIterativeSolverParallelDVI::RunTimeStep() {
             SetR();
             LOG(INFO) << "ChIterativeSolverParallelDVI::RunTimeStep - Solve Normal";
             data_manager->measures.solver.total_iteration +=
-                solver->Solve(ShurProductFull,                                     //
-                              ProjectFull,                                         //
-                              data_manager->settings.solver.max_iteration_normal,  //
-                              data_manager->num_constraints,                       //
-                              data_manager->host_data.R,                           //
-                              data_manager->host_data.gamma);                      //
+                SolveFull(data_manager->settings.solver.max_iteration_normal);
         }
     }
     if (data_manager->settings.solver.solver_mode == SLIDING || data_manager->settings.solver.solver_mode == SPINNING) {
@@ -105,12 +105,7 @@ void ChIterativeSolverParallelDVI::RunTimeStep() {
             SetR();
             LOG(INFO) << "ChIterativeSolverParallelDVI::RunTimeStep - Solve Sliding";
             data_manager->measures.solver.total_iteration +=
-                solver->Solve(ShurProductFull,                                      //
-                              ProjectFull,                                          //
-                              data_manager->settings.solver.max_iteration_sliding,  //
-                              data_manager->num_constraints,                        //
-                              data_manager->host_data.R,                            //
-                              data_manager->host_data.gamma);                       //
+                SolveFull(data_manager->settings.solver.max_iteration_sliding);
         }
     }
     if (data_manager->settings.solver.solver_mode == SPINNING) {
@@ -119,12 +114,7 @@ void ChIterativeSolverParallelDVI::RunTimeStep() {
             SetR();
             LOG(INFO) << "ChIterativeSolverParallelDVI::RunTimeStep - Solve Spinning";
             data_manager->measures.solver.total_iteration +=
-                solver->Solve(ShurProductFull,                                       //
-                              ProjectFull,                                           //
-                              data_manager->settings.solver.max_iteration_spinning,  //
-                              data_manager->num_constraints,                         //
-                              data_manager->host_data.R,                             //
-                              data_manager->host_data.gamma);                        //
+                SolveFull(data_manager->settings.solver.max_iteration_spinning);
         }
     }
 
@@ -320,6 +310,63 @@ void ChIterativeSolverParallelDVI::ComputeN() {
     data_manager->system_timer.stop("ChIterativeSolverParallel_N");
 }
 
+void ChIterativeSolverParallelDVI::ComputeP() {
+    if (data_manager->settings.solver.precondition == false || data_manager->num_constraints <= 0) {
+        return;
+    }
+
+    LOG(INFO) << "ChIterativeSolverParallelDVI::ComputeP";
+    data_manager->system_timer.start("ChIterativeSolverParallel_P");
+    const CompressedMatrix<real>& D_T = data_manager->host_data.D_T;
+    const CompressedMatrix<real>& M_inv = data_manager->host_data.M_inv;
+    const DynamicVector<real>& E = data_manager->host_data.E;
+    DynamicVector<real>& P = data_manager->host_data.P;
+    uint num_unilaterals = data_manager->num_unilaterals;
+    uint num_bilaterals = data_manager->num_bilaterals;
+    uint num_constraints = data_manager->num_constraints;
+
+    P.resize(num_constraints);
+
+    // Diagonal entries of the bilaterals, 3dof and FEA constraints
+#pragma omp parallel for
+    for (int i = num_unilaterals; i < num_constraints; i++) {
+        real N_ii = E[i];
+        for (CompressedMatrix<real>::ConstIterator it = D_T.begin(i); it != D_T.end(i); ++it) {
+            for (CompressedMatrix<real>::ConstIterator jt = M_inv.begin(it->index()); jt != M_inv.end(it->index());
+                 ++jt) {
+                N_ii += it->value() * jt->value() * D_T(i, jt->index());
+            }
+        }
+        P[i] = N_ii;
+    }
+
+    // Bilaterals are not projected and are scaled by their diagonal entry. The 3dof and
+    // FEA constraints are projected onto cones, so they share one factor, the inverse
+    // of their mean diagonal entry.
+    real sum = 0;
+    int count = 0;
+    for (int i = num_unilaterals + num_bilaterals; i < num_constraints; i++) {
+        if (P[i] > 0) {
+            sum += P[i];
+            count++;
+        }
+    }
+    real scale = (sum > 0) ? count / sum : 1.0;
+#pragma omp parallel for
+    for (int i = num_unilaterals; i < num_constraints; i++) {
+        if (i < num_unilaterals + num_bilaterals) {
+            P[i] = (P[i] > 0) ? 1.0 / P[i] : 1.0;
+        } else {
+            P[i] = scale;
+        }
+    }
+
+    // Rigid contacts use the inverse of their Delassus block
+    data_manager->rigid_rigid->Build_P();
+
+    data_manager->system_timer.stop("ChIterativeSolverParallel_P");
+}
+
 void ChIterativeSolverParallelDVI::SetR() {
     LOG(INFO) << "ChIterativeSolverParallelDVI::SetR()";
     if (data_manager->num_constraints <= 0) {
@@ -374,6 +421,59 @@ void ChIterativeSolverParallelDVI::SetR() {
     }
 }
 
+uint ChIterativeSolverParallelDVI::SolveFull(const uint max_iter) {
+    DynamicVector<real>& R = data_manager->host_data.R;
+    DynamicVector<real>& gamma = data_manager->host_data.gamma;
+    uint num_constraints = data_manager->num_constraints;
+
+    if (data_manager->settings.solver.use_mixed_precision == false) {
+        return solver->Solve(ShurProductFull, ProjectFull, max_iter, num_constraints, R, gamma);
+    }
+
+    // Iterative refinement: the residual of the current solution is computed in
+    // double precision and the solver, running on the single precision Shur
+    // product, only solves for a correction. The shifted projection keeps
+    // gamma + correction inside the friction cones.
+    uint num_steps = std::max(data_manager->settings.solver.refinement_steps, 1u);
+    uint max_iter_step = std::max(max_iter / num_steps, 1u);
+    uint total_iterations = 0;
+    real residual = RefinementResidual();
+
+    for (uint step = 0; step < num_steps; step++) {
+        if (residual < data_manager->settings.solver.tol_speed || total_iterations >= max_iter) {
+            break;
+        }
+
+        refine_delta.resize(num_constraints);
+        reset(refine_delta);
+        ProjectShifted.shift = gamma;
+        total_iterations +=
+            solver->Solve(ShurProductMixed, ProjectShifted, max_iter_step, num_constraints, refine_rhs, refine_delta);
+        gamma += refine_delta;
+        ProjectFull(gamma.data());
+
+        residual = RefinementResidual();
+    }
+
+    data_manager->measures.solver.residual = residual;
+    return total_iterations;
+}
+
+real ChIterativeSolverParallelDVI::RefinementResidual() {
+    const DynamicVector<real>& R = data_manager->host_data.R;
+    const DynamicVector<real>& gamma = data_manager->host_data.gamma;
+    real gdiff = 1.0 / pow(data_manager->num_constraints, 2.0);
+
+    ShurProductFull(gamma, refine_rhs);
+    refine_rhs = R - refine_rhs;
+
+    // Projected gradient residual, the same measure used by the solvers
+    refine_temp = gamma + gdiff * refine_rhs;
+    ProjectFull(refine_temp.data());
+    refine_temp = (1.0 / gdiff) * (gamma - refine_temp);
+    return Sqrt((real)(refine_temp, refine_temp));
+}
+
 void ChIterativeSolverParallelDVI::ComputeImpulses() {
     LOG(INFO) << "ChIterativeSolverParallelDVI::ComputeImpulses()";
     const DynamicVector<real>& M_invk = data_manager->host_data.M_invk;
@@ -101,6 +101,55 @@ void ChShurProductBilateral::operator()(const DynamicVector<real>& x, DynamicVec
     output = NshurB * x;
 }
 
+void ChShurProductMixed::Setup(ChParallelDataManager* data_container_) {
+    ChShurProduct::Setup(data_container_);
+    if (data_manager->num_constraints == 0) {
+        return;
+    }
+    // Converted once per step, every solver iteration only reads the copies
+    D_T_sp = data_manager->host_data.D_T;
+    M_invD_sp = data_manager->host_data.M_invD;
+}
+
+void ChShurProductMixed::operator()(const DynamicVector<real>& x, DynamicVector<real>& output) {
+    data_manager->system_timer.start("ShurProduct");
+
+    const DynamicVector<real>& E = data_manager->host_data.E;
+    uint num_rigid_contacts = data_manager->num_rigid_contacts;
+    uint num_unilaterals = data_manager->num_unilaterals;
+    uint num_bilaterals = data_manager->num_bilaterals;
+    uint num_constraints = data_manager->num_constraints;
+
+    x_sp = x;
+    tmp_sp = M_invD_sp * x_sp;
+    out_sp = D_T_sp * tmp_sp;
+    output = out_sp;
+    output += E * x;
+
+    // Same as the double precision product: rows that are not part of the
+    // current local solve are zero. Their multipliers are zero so the columns
+    // do not contribute.
+    if (data_manager->settings.solver.local_solver_mode != data_manager->settings.solver.solver_mode) {
+        uint num_other = num_constraints - num_unilaterals - num_bilaterals;
+        subvector(output, num_unilaterals + num_bilaterals, num_other) = 0;
+
+        switch (data_manager->settings.solver.local_solver_mode) {
+            case BILATERAL:
+                subvector(output, 0, num_unilaterals) = 0;
+                break;
+            case NORMAL:
+                subvector(output, num_rigid_contacts, num_unilaterals - num_rigid_contacts) = 0;
+                break;
+            case SLIDING:
+                subvector(output, num_rigid_contacts * 3, num_unilaterals - num_rigid_contacts * 3) = 0;
+                break;
+            case SPINNING:
+                break;
+        }
+    }
+    data_manager->system_timer.stop("ShurProduct");
+}
+
 void ChShurProductFEM::Setup(ChParallelDataManager* data_container_) {
     ChShurProduct::Setup(data_container_);
 //    if (data_manager->num_fea_tets == 0) {
@@ -10,12 +10,51 @@ void ChProjectConstraints::operator()(real* data) {
     data_manager->system_timer.stop("ChSolverParallel_Project");
 }
 
+void ChProjectConstraints::Scaled(real* data) {
+    data_manager->system_timer.start("ChSolverParallel_Project");
+    data_manager->rigid_rigid->Project_Scaled(data);
+    // The other constraints share one scaling factor (see ComputeP), their
+    // Euclidean projection is also the one in the scaled metric
+    data_manager->node_container->Project(data);
+    data_manager->fea_container->Project(data);
+    data_manager->system_timer.stop("ChSolverParallel_Project");
+}
+
+void ChProjectShifted::operator()(real* data) {
+    const size_t size = shift.size();
+    temp.resize(size);
+#pragma omp parallel for
+    for (int i = 0; i < size; i++) {
+        temp[i] = shift[i] + data[i];
+    }
+    ChProjectConstraints::operator()(temp.data());
+#pragma omp parallel for
+    for (int i = 0; i < size; i++) {
+        data[i] = temp[i] - shift[i];
+    }
+}
+
+void ChProjectShifted::Scaled(real* data) {
+    const size_t size = shift.size();
+    temp.resize(size);
+#pragma omp parallel for
+    for (int i = 0; i < size; i++) {
+        temp[i] = shift[i] + data[i];
+    }
+    ChProjectConstraints::Scaled(temp.data());
+#pragma omp parallel for
+    for (int i = 0; i < size; i++) {
+        data[i] = temp[i] - shift[i];
+    }
+}
+
 ChSolverParallel::ChSolverParallel() {
     current_iteration = 0;
     rigid_rigid = NULL;
     three_dof = NULL;
     fem = NULL;
     bilateral = NULL;
+    precondition = false;
 }
 
 //=================================================================================================================================
@@ -60,3 +99,41 @@ real ChSolverParallel::LargestEigenValue(ChShurProduct& ShurProduct, DynamicVect
     }
     return lambda;
 }
+
+bool ChSolverParallel::SetupPreconditioner(const uint size) {
+    const DynamicVector<real>& P = data_manager->host_data.P;
+    // The preconditioner is built for the full system, reduced solves such as the
+    // bilateral stabilization use a different numbering and are not scaled
+    precondition = data_manager->settings.solver.precondition && P.size() == size;
+    return precondition;
+}
+
+void ChSolverParallel::ApplyP(const DynamicVector<real>& x, DynamicVector<real>& output) {
+    const DynamicVector<real>& P = data_manager->host_data.P;
+    uint num_unilaterals = data_manager->num_unilaterals;
+    output.resize(x.size());
+#pragma omp parallel for
+    for (int i = num_unilaterals; i < x.size(); i++) {
+        output[i] = P[i] * x[i];
+    }
+    data_manager->rigid_rigid->Px(x, output);
+}
+
+void ChSolverParallel::ApplyPinv(const DynamicVector<real>& x, DynamicVector<real>& output) {
+    const DynamicVector<real>& P = data_manager->host_data.P;
+    uint num_unilaterals = data_manager->num_unilaterals;
+    output.resize(x.size());
+#pragma omp parallel for
+    for (int i = num_unilaterals; i < x.size(); i++) {
+        output[i] = x[i] / P[i];
+    }
+    data_manager->rigid_rigid->P_invx(x, output);
+}
+
+void ChSolverParallel::ProjectStep(ChProjectConstraints& Project, DynamicVector<real>& x) {
+    if (precondition) {
+        Project.Scaled(x.data());
+    } else {
+        Project(x.data());
+    }
+}
@@ -34,6 +34,8 @@ class CH_PARALLEL_API ChProjectConstraints {
 
     // Project the Lagrange multipliers
     virtual void operator()(real* data);
+    // Project the Lagrange multipliers in the metric of the preconditioner
+    virtual void Scaled(real* data);
 
     // Pointer to the system's data manager
     ChParallelDataManager* data_manager;
@@ -45,6 +47,21 @@ class CH_PARALLEL_API ChProjectNone : public ChProjectConstraints {
 
     // Project the Lagrange multipliers
     virtual void operator()(real* data) {}
+    virtual void Scaled(real* data) {}
+};
+
+// Projection used when solving for a correction to a known solution: the
+// multipliers given to the functor are relative to the shift vector
+class CH_PARALLEL_API ChProjectShifted : public ChProjectConstraints {
+  public:
+    ChProjectShifted() {}
+    virtual ~ChProjectShifted() {}
+
+    // Project shift + data and store the result relative to shift
+    virtual void operator()(real* data);
+    virtual void Scaled(real* data);
+
+    DynamicVector<real> shift, temp;
 };
 //========================================================================================================
 
@@ -74,6 +91,21 @@ class CH_PARALLEL_API ChShurProductBilateral : public ChShurProduct {
     CompressedMatrix<real> NshurB;
 };
 
+// Shur product evaluated with single precision copies of D_T and M_invD, the
+// compliance term and the result are kept in double precision
+class CH_PARALLEL_API ChShurProductMixed : public ChShurProduct {
+  public:
+    ChShurProductMixed() {}
+    virtual ~ChShurProductMixed() {}
+    virtual void Setup(ChParallelDataManager* data_container_);
+
+    // Perform the Shur Product
+    virtual void operator()(const DynamicVector<real>& x, DynamicVector<real>& AX);
+
+    CompressedMatrix<float> D_T_sp, M_invD_sp;
+    DynamicVector<float> x_sp, tmp_sp, out_sp;
+};
+
 class CH_PARALLEL_API ChShurProductFEM : public ChShurProduct {
   public:
     ChShurProductFEM() {}
@@ -117,7 +149,17 @@ class CH_PARALLEL_API ChSolverParallel {
 
     real LargestEigenValue(ChShurProduct& ShurProduct, DynamicVector<real>& temp, real lambda = 0);
 
+    // Decide if the preconditioner (host_data.P and the blocks of the rigid
+    // contacts) is used for a problem of this size
+    bool SetupPreconditioner(const uint size);
+    // Multiply by the preconditioner or by its inverse
+    void ApplyP(const DynamicVector<real>& x, DynamicVector<real>& output);
+    void ApplyPinv(const DynamicVector<real>& x, DynamicVector<real>& output);
+    // Project in the metric of the preconditioner if the solve is preconditioned
+    void ProjectStep(ChProjectConstraints& Project, DynamicVector<real>& x);
+
     int current_iteration;  // The current iteration number of the solver
+    bool precondition;      // True if the current solve is preconditioned
 
     ChConstraintRigidRigid* rigid_rigid;
     ChConstraintBilateral* bilateral;
@@ -174,8 +216,12 @@ class CH_PARALLEL_API ChSolverParallelAPGD : public ChSolverParallel {
 
     void UpdateR();
 
+    // Quadratic upper bound on the change of the objective along the step d,
+    // measured in the preconditioned metric if preconditioning is active
+    real QuadraticModel(const DynamicVector<real>& g, const DynamicVector<real>& d);
+
     // APGD specific vectors
-    DynamicVector<real> obj2_temp, obj1_temp, temp, g, gamma_new, y, gamma_hat, N_gamma_new, _t_g;
+    DynamicVector<real> obj2_temp, obj1_temp, temp, g, gamma_new, y, gamma_hat, N_gamma_new, _t_g, Pg, Pinv_d;
     real L, t;
     real g_diff;
     real theta, theta_new, beta_new;
@@ -201,7 +247,7 @@ class CH_PARALLEL_API ChSolverParallelBB : public ChSolverParallel {
     void UpdateR();
 
     // BB specific vectors
-    DynamicVector<real> temp, ml, mg, mg_p, ml_candidate, ms, my, mdir, ml_p;
+    DynamicVector<real> temp, ml, mg, mg_p, ml_candidate, ms, my, mdir, ml_p, Pmg, Pv;
     DynamicVector<real> mD, invmD;
 };
 class CH_PARALLEL_API ChSolverParallelMinRes : public ChSolverParallel {
@@ -239,7 +285,7 @@ class CH_PARALLEL_API ChSolverParallelSPGQP : public ChSolverParallel {
 
     // BB specific vectors
     real alpha, f_max, xi, beta_bar, beta_tilde, beta_k, gam;
-    DynamicVector<real> g, d_k, x, temp, Ad_k, g_alpha, x_candidate;
+    DynamicVector<real> g, d_k, x, temp, Ad_k, g_alpha, x_candidate, Pg, Pinv_d;
     std::vector<real> f_hist;
 };
 
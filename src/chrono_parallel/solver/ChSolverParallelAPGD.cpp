@@ -37,6 +37,14 @@ void ChSolverParallelAPGD::UpdateR() {
     R_n = -b_n - D_n_T * M_invk + s_n;
 }
 
+real ChSolverParallelAPGD::QuadraticModel(const DynamicVector<real>& g, const DynamicVector<real>& d) {
+    if (precondition) {
+        ApplyPinv(d, Pinv_d);
+        return (g, d) + 0.5 * L * (d, Pinv_d);
+    }
+    return (g + 0.5 * L * d, d);
+}
+
 uint ChSolverParallelAPGD::Solve(ChShurProduct& ShurProduct,
                          ChProjectConstraints& Project,
                          const uint max_iter,
@@ -52,6 +60,9 @@ uint ChSolverParallelAPGD::Solve(ChShurProduct& ShurProduct,
 
     DynamicVector<real> one(size, 1.0);
     data_manager->system_timer.start("ChSolverParallel_Solve");
+    SetupPreconditioner(size);
+    // With preconditioning the steps are taken along P*g instead of g
+    const DynamicVector<real>& dir = precondition ? Pg : g;
     gamma_hat.resize(size);
     N_gamma_new.resize(size);
     temp.resize(size);
@@ -89,7 +100,7 @@ uint ChSolverParallelAPGD::Solve(ChShurProduct& ShurProduct,
         } else {
             L = 1.0;
         }
-    } else if (data_manager->settings.solver.use_power_iteration) {
+    } else if (data_manager->settings.solver.use_power_iteration && !precondition) {
         data_manager->measures.solver.lambda_max =
             LargestEigenValue(ShurProduct, temp, data_manager->measures.solver.lambda_max);
         L = data_manager->measures.solver.lambda_max;
@@ -101,6 +112,11 @@ uint ChSolverParallelAPGD::Solve(ChShurProduct& ShurProduct,
         } else {
             // If the N matrix is zero for some reason, temp will be zero
             ShurProduct(temp, temp);
+            // Estimate the step length for the scaled system
+            if (precondition) {
+                ApplyP(temp, Pg);
+                temp = Pg;
+            }
             // If temp is zero then L will be zero
             L = Sqrt((real)(temp, temp)) / norm_temp;
         }
@@ -129,16 +145,19 @@ uint ChSolverParallelAPGD::Solve(ChShurProduct& ShurProduct,
         ShurProduct(y, temp);
         // ShurProduct(y, g);
         g = temp - r;
-        gamma_new = y - t * g;
-        Project(gamma_new.data());
+        if (precondition) {
+            ApplyP(g, Pg);
+        }
+        gamma_new = y - t * dir;
+        ProjectStep(Project, gamma_new);
         ShurProduct(gamma_new, N_gamma_new);
         obj2 = (y, 0.5 * temp - r);
         temp = gamma_new - y;
-        while ((gamma_new, 0.5 * N_gamma_new - r) > obj2 + (g + 0.5 * L * temp, temp)) {
+        while ((gamma_new, 0.5 * N_gamma_new - r) > obj2 + QuadraticModel(g, temp)) {
             L = 2.0 * L;
             t = 1.0 / L;
-            gamma_new = y - t * g;
-            Project(gamma_new.data());
+            gamma_new = y - t * dir;
+            ProjectStep(Project, gamma_new);
             ShurProduct(gamma_new, N_gamma_new);
             obj1 = (gamma_new, 0.5 * N_gamma_new - r);
             temp = gamma_new - y;
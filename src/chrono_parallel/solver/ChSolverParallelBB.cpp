@@ -37,6 +37,10 @@ uint ChSolverParallelBB::Solve(ChShurProduct& ShurProduct,
     real& lastgoodres = data_manager->measures.solver.residual;
     real& objective_value = data_manager->measures.solver.objective_value;
 
+    SetupPreconditioner(size);
+    // With preconditioning the steps are taken along P*mg instead of mg
+    const DynamicVector<real>& dir = precondition ? Pmg : mg;
+
     // ChTimer<> t1, t2, t3, t4;
     // t1.start();
 
@@ -79,14 +83,13 @@ uint ChSolverParallelBB::Solve(ChShurProduct& ShurProduct,
         } else {
             alpha = 0.0001;
         }
-    } else if (data_manager->settings.solver.use_power_iteration) {
+    } else if (data_manager->settings.solver.use_power_iteration && !precondition) {
         data_manager->measures.solver.lambda_max =
             LargestEigenValue(ShurProduct, temp, data_manager->measures.solver.lambda_max);
         alpha = 1.95 / data_manager->measures.solver.lambda_max;
     }
     real gmma = 1e-4;
     real gdiff = 1.0 / pow(size, 2.0);
-    bool do_preconditioning = false;
     real neg_BB1_fallback = 0.11;
     real neg_BB2_fallback = 0.12;
     ml = gamma;
@@ -106,8 +109,11 @@ uint ChSolverParallelBB::Solve(ChShurProduct& ShurProduct,
 
     for (current_iteration = 0; current_iteration < max_iter; current_iteration++) {
         // t2.start();
-        temp = (ml - alpha * mg);
-        Project(temp.data());
+        if (precondition) {
+            ApplyP(mg, Pmg);
+        }
+        temp = (ml - alpha * dir);
+        ProjectStep(Project, temp);
         mdir = temp - ml;
 
         real dTg = (mdir, mg);
@@ -154,6 +160,10 @@ uint ChSolverParallelBB::Solve(ChShurProduct& ShurProduct,
 
         if (current_iteration % 2 == 0) {
             real sDs = (ms, ms);
+            if (precondition) {
+                ApplyPinv(ms, Pv);
+                sDs = (ms, Pv);
+            }
             real sy = (ms, my);
             if (sy <= 0) {
                 alpha = neg_BB1_fallback;
@@ -163,6 +173,10 @@ uint ChSolverParallelBB::Solve(ChShurProduct& ShurProduct,
         } else {
             real sy = (ms, my);
             real yDy = (my, my);
+            if (precondition) {
+                ApplyP(my, Pv);
+                yDy = (my, Pv);
+            }
             if (sy <= 0) {
                 alpha = neg_BB2_fallback;
             } else {
@@ -37,6 +37,10 @@ uint ChSolverParallelSPGQP::Solve(ChShurProduct& ShurProduct,
 
     real& lastgoodres = data_manager->measures.solver.residual;
     real& objective_value = data_manager->measures.solver.objective_value;
+
+    SetupPreconditioner(size);
+    // With preconditioning the steps are taken along P*g instead of g
+    const DynamicVector<real>& dir = precondition ? Pg : g;
     real sigma_min = 0.1;
     real sigma_max = 0.9999;
     real gam = .1;
@@ -60,7 +64,7 @@ uint ChSolverParallelSPGQP::Solve(ChShurProduct& ShurProduct,
         } else {
             alpha = 0.0001;
         }
-    } else if (data_manager->settings.solver.use_power_iteration) {
+    } else if (data_manager->settings.solver.use_power_iteration && !precondition) {
         data_manager->measures.solver.lambda_max =
             LargestEigenValue(ShurProduct, temp, data_manager->measures.solver.lambda_max);
         alpha = 1.95 / data_manager->measures.solver.lambda_max;
@@ -73,8 +77,11 @@ uint ChSolverParallelSPGQP::Solve(ChShurProduct& ShurProduct,
     f_hist[0] = (0.5 * (g - r, x));
 
     for (current_iteration = 0; current_iteration < max_iter; current_iteration++) {
-        temp = x - alpha * g;
-        Project(temp.data());
+        if (precondition) {
+            ApplyP(g, Pg);
+        }
+        temp = x - alpha * dir;
+        ProjectStep(Project, temp);
         // g_alpha = 1.0 / alpha * (x - temp);
 
         // printf("||g_alpha||: %f \n", Sqrt((g_alpha, g_alpha)));
@@ -101,7 +108,12 @@ uint ChSolverParallelSPGQP::Solve(ChShurProduct& ShurProduct,
         x = x + beta_k * d_k;
         g = g + beta_k * Ad_k;
         f_hist[current_iteration + 1] = (0.5 * (g - r, x));
-        alpha = (d_k, d_k) / (Ad_k_dot_d_k);
+        if (precondition) {
+            ApplyPinv(d_k, Pinv_d);
+            alpha = (d_k, Pinv_d) / (Ad_k_dot_d_k);
+        } else {
+            alpha = (d_k, d_k) / (Ad_k_dot_d_k);
+        }
 
         temp = x - gdiff * g;
         Project(temp.data());
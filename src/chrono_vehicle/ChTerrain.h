@@ -19,7 +19,10 @@
 #ifndef CH_TERRAIN_H
 #define CH_TERRAIN_H
 
+#include <vector>
+
 #include "chrono/core/ChVector.h"
+#include "chrono/core/ChVector2.h"
 
 #include "chrono_vehicle/ChApiVehicle.h"
 
@@ -53,6 +56,20 @@ class CH_VEHICLE_API ChTerrain {
 
     /// Get the terrain normal at the specified (x,y) location.
     virtual ChVector<> GetNormal(double x, double y) const = 0;
+
+    /// Get the terrain heights and normals at a set of (x,y) locations (e.g. the points of a
+    /// tire contact patch). The default implementation calls GetHeight and GetNormal for each point.
+    virtual void GetHeightsAndNormals(const std::vector<ChVector2<> >& points,  ///< [in] query locations
+                                      std::vector<double>& heights,            ///< [out] terrain heights
+                                      std::vector<ChVector<> >& normals        ///< [out] terrain normals
+                                      ) const {
+        heights.resize(points.size());
+        normals.resize(points.size());
+        for (size_t i = 0; i < points.size(); i++) {
+            heights[i] = GetHeight(points[i].x, points[i].y);
+            normals[i] = GetNormal(points[i].x, points[i].y);
+        }
+    }
 };
 
 /// @} vehicle_terrain
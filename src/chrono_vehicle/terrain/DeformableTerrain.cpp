@@ -17,7 +17,9 @@
 // =============================================================================
 
 #include <cstdio>
+#include <algorithm>
 #include <cmath>
+#include <map>
 
 #include "chrono/physics/ChMaterialSurface.h"
 #include "chrono/physics/ChMaterialSurfaceDEM.h"
@@ -80,6 +82,19 @@ const ChCoordsys<>& DeformableTerrain::GetPlane() const { return m_ground->plane
 // Get the trimesh that defines the ground shape.
 const std::shared_ptr<ChTriangleMeshShape> DeformableTerrain::GetMesh() const { return m_ground->m_trimesh_shape; }
 
+// Get the soil wrench on a rigid body.
+void DeformableTerrain::GetContactForce(std::shared_ptr<ChBody> body, ChVector<>& force, ChVector<>& torque) const {
+    force = VNULL;
+    torque = VNULL;
+    for (size_t iw = 0; iw < m_ground->body_wrenches.size(); ++iw) {
+        if (m_ground->body_wrenches[iw].body == body.get()) {
+            force = m_ground->body_wrenches[iw].force;
+            torque = m_ground->body_wrenches[iw].moment - Vcross(body->GetPos(), force);
+            return;
+        }
+    }
+}
+
 // Enable bulldozing effect.
 void DeformableTerrain::SetBulldozingFlow(bool mb) {
     m_ground->do_bulldozing = mb;
@@ -143,11 +158,20 @@ double DeformableTerrain::GetTestHighOffset() const {
     return m_ground->test_high_offset;
 }
 
+void DeformableTerrain::SetActiveRegion(bool val) {
+    m_ground->use_active_region = val;
+}
+
+bool DeformableTerrain::GetActiveRegion() const {
+    return m_ground->use_active_region;
+}
+
 // Set the color plot type.
 void DeformableTerrain::SetPlotType(DataPlotType mplot, double mmin, double mmax) {
     m_ground->plot_type = mplot;
     m_ground->plot_v_min = mmin;
     m_ground->plot_v_max = mmax;
+    m_ground->full_update = true;
 }
 
 // Initialize the terrain as a flat grid
@@ -205,6 +229,11 @@ DeformableSoil::DeformableSoil(ChSystem* system) {
     Janosi_shear = 0.01;
     elastic_K = 50000000;
 
+    tile_size = 0;
+    current_stamp = 0;
+    full_update = true;
+    use_active_region = true;
+
     Initialize(0,3,3,10,10);
     
     plot_type = DeformableTerrain::PLOT_NONE;
@@ -448,30 +477,24 @@ void DeformableSoil::SetupAuxData() {
     }
 
     m_trimesh_shape->GetMesh().ComputeNeighbouringTriangleMap(this->tri_map);
-}
 
-// Reset the list of forces, and fills it with forces from a soil contact model.
-void DeformableSoil::ComputeInternalForces() {
+    ComputeVertexAreas();
 
-    // Readibility aliases
+    SetupActiveRegion();
+    active_vertices.clear();
+    dirty_vertices.clear();
+    full_update = true;
+}
+
+// Compute the (pseudo)areas per node, projected on the soil plane.
+// For a X-Z rectangular grid-like mesh it is simply area[i]= xsize/xsteps * zsize/zsteps,
+// but the following is more general, also for generic meshes.
+void DeformableSoil::ComputeVertexAreas() {
     std::vector<ChVector<> >& vertices = m_trimesh_shape->GetMesh().getCoordsVertices();
-    std::vector<ChVector<> >& normals = m_trimesh_shape->GetMesh().getCoordsNormals();
-    std::vector<ChVector<float> >& colors =  m_trimesh_shape->GetMesh().getCoordsColors();
     std::vector<ChVector<int> >& idx_vertices = m_trimesh_shape->GetMesh().getIndicesVertexes();
     std::vector<ChVector<int> >& idx_normals = m_trimesh_shape->GetMesh().getIndicesNormals();
-    
-    // 
-    // Reset the load list
-    //
-
-    this->GetLoadList().clear();
 
-    //
-    // Compute (pseudo)areas per node
-    //
-    
-    // for a X-Z rectangular grid-like mesh it is simply area[i]= xsize/xsteps * zsize/zsteps, 
-    // but the following is more general, also for generic meshes:
+    p_area.resize(vertices.size());
     for (unsigned int iv = 0; iv < vertices.size(); ++iv) {
         p_area[iv] = 0;
     }
@@ -487,21 +510,336 @@ void DeformableSoil::ComputeInternalForces() {
         p_area[idx_normals[it].y] += triangle_area /3.0;
         p_area[idx_normals[it].z] += triangle_area /3.0;
     }
+}
+
+// Key of the tile with integer coordinates ix, iz on the soil plane.
+static long long TileKey(int ix, int iz) {
+    return (long long)ix * 4294967296LL + (long long)(unsigned int)iz;
+}
+
+static void TileCoords(long long key, int& ix, int& iz) {
+    ix = (int)(key >> 32);
+    iz = (int)(unsigned int)(key & 0xffffffffLL);
+}
+
+// Build the list of triangles incident to each index (compressed rows), for one
+// of the index arrays of the mesh.
+static void ComputeIncidence(const std::vector<ChVector<int> >& idx,
+                             size_t n_items,
+                             std::vector<int>& start,
+                             std::vector<int>& triangles) {
+    start.assign(n_items + 1, 0);
+    for (size_t it = 0; it < idx.size(); ++it) {
+        ++start[idx[it].x + 1];
+        ++start[idx[it].y + 1];
+        ++start[idx[it].z + 1];
+    }
+    for (size_t i = 0; i < n_items; ++i)
+        start[i + 1] += start[i];
+    triangles.resize(start[n_items]);
+    std::vector<int> pos(start.begin(), start.end() - 1);
+    for (size_t it = 0; it < idx.size(); ++it) {
+        triangles[pos[idx[it].x]++] = (int)it;
+        triangles[pos[idx[it].y]++] = (int)it;
+        triangles[pos[idx[it].z]++] = (int)it;
+    }
+}
+
+// Bin the vertexes in square tiles on the soil plane. Vertexes only move along the plane
+// normal, so the tiles stay valid until the mesh is refined or the plane is changed.
+void DeformableSoil::SetupActiveRegion() {
+    std::vector<ChVector<> >& vertices = m_trimesh_shape->GetMesh().getCoordsVertices();
+    std::vector<ChVector<> >& normals = m_trimesh_shape->GetMesh().getCoordsNormals();
+    std::vector<ChVector<int> >& idx_vertices = m_trimesh_shape->GetMesh().getIndicesVertexes();
+    std::vector<ChVector<int> >& idx_normals = m_trimesh_shape->GetMesh().getIndicesNormals();
+
+    // tiles of about 16x16 triangle edges
+    double tot_area = 0;
+    for (size_t iv = 0; iv < p_area.size(); ++iv)
+        tot_area += p_area[iv];
+    tile_size = 1.0;
+    if (idx_vertices.size() > 0 && tot_area > 0)
+        tile_size = 16.0 * sqrt(2.0 * tot_area / (double)idx_vertices.size());
+
+    tiles.clear();
+    for (size_t iv = 0; iv < vertices.size(); ++iv) {
+        ChVector<> loc = plane.TransformParentToLocal(vertices[iv]);
+        tiles[TileKey((int)floor(loc.x / tile_size), (int)floor(loc.z / tile_size))].push_back((int)iv);
+    }
+
+    ComputeIncidence(idx_vertices, vertices.size(), vertex_triangles_start, vertex_triangles);
+    ComputeIncidence(idx_normals, normals.size(), normal_triangles_start, normal_triangles);
+
+    vertex_stamp.assign(vertices.size(), 0);
+    aux_plane = plane;
+}
+
+// Recompute the normals of the triangles around the changed vertexes, as the average of
+// the normals of the adjacent faces.
+void DeformableSoil::UpdateNormals(const std::vector<int>* changed) {
+    std::vector<ChVector<> >& vertices = m_trimesh_shape->GetMesh().getCoordsVertices();
+    std::vector<ChVector<> >& normals = m_trimesh_shape->GetMesh().getCoordsNormals();
+    std::vector<ChVector<int> >& idx_vertices = m_trimesh_shape->GetMesh().getIndicesVertexes();
+    std::vector<ChVector<int> >& idx_normals = m_trimesh_shape->GetMesh().getIndicesNormals();
+
+    std::vector<int> affected;
+    if (changed) {
+        for (auto iv : *changed) {
+            for (int k = vertex_triangles_start[iv]; k < vertex_triangles_start[iv + 1]; ++k) {
+                affected.push_back(idx_normals[vertex_triangles[k]].x);
+                affected.push_back(idx_normals[vertex_triangles[k]].y);
+                affected.push_back(idx_normals[vertex_triangles[k]].z);
+            }
+        }
+        std::sort(affected.begin(), affected.end());
+        affected.erase(std::unique(affected.begin(), affected.end()), affected.end());
+    }
+
+    int n_normals = changed ? (int)affected.size() : (int)normals.size();
+
+#pragma omp parallel for schedule(static)
+    for (int k = 0; k < n_normals; ++k) {
+        int in = changed ? affected[k] : k;
+        ChVector<> sum(0, 0, 0);
+        for (int j = normal_triangles_start[in]; j < normal_triangles_start[in + 1]; ++j) {
+            const ChVector<int>& tri = idx_vertices[normal_triangles[j]];
+            // Calculate the triangle normal as a normalized cross product.
+            ChVector<> nrm = -Vcross(vertices[tri.y] - vertices[tri.x], vertices[tri.z] - vertices[tri.x]);
+            nrm.Normalize();
+            sum += nrm;
+        }
+        int n_tris = normal_triangles_start[in + 1] - normal_triangles_start[in];
+        normals[in] = n_tris ? sum / (double)n_tris : sum;
+    }
+}
+
+// Recompute the false colors of the changed vertexes.
+void DeformableSoil::UpdateColors(const std::vector<int>* changed) {
+    std::vector<ChVector<> >& vertices = m_trimesh_shape->GetMesh().getCoordsVertices();
+    std::vector<ChVector<float> >& colors =  m_trimesh_shape->GetMesh().getCoordsColors();
+
+    if (plot_type == DeformableTerrain::PLOT_NONE) {
+        colors.clear();
+        return;
+    }
+    if (colors.size() != vertices.size()) {
+        colors.resize(vertices.size());
+        changed = nullptr;
+    }
+
+    size_t n_colors = changed ? changed->size() : vertices.size();
+    for (size_t k = 0; k < n_colors; ++k) {
+        size_t iv = changed ? (*changed)[k] : k;
+        ChColor mcolor;
+        switch (plot_type) {
+            case DeformableTerrain::PLOT_LEVEL:
+                mcolor = ChColor::ComputeFalseColor(p_level[iv], plot_v_min, plot_v_max);
+                break;
+            case DeformableTerrain::PLOT_LEVEL_INITIAL:
+                mcolor = ChColor::ComputeFalseColor(p_level_initial[iv], plot_v_min, plot_v_max);
+                break;
+            case DeformableTerrain::PLOT_SINKAGE:
+                mcolor = ChColor::ComputeFalseColor(p_sinkage[iv], plot_v_min, plot_v_max);
+                break;
+            case DeformableTerrain::PLOT_SINKAGE_ELASTIC:
+                mcolor = ChColor::ComputeFalseColor(p_sinkage_elastic[iv], plot_v_min, plot_v_max);
+                break;
+            case DeformableTerrain::PLOT_SINKAGE_PLASTIC:
+                mcolor = ChColor::ComputeFalseColor(p_sinkage_plastic[iv], plot_v_min, plot_v_max);
+                break;
+            case DeformableTerrain::PLOT_STEP_PLASTIC_FLOW:
+                mcolor = ChColor::ComputeFalseColor(p_step_plastic_flow[iv], plot_v_min, plot_v_max);
+                break;
+            case DeformableTerrain::PLOT_K_JANOSI:
+                mcolor = ChColor::ComputeFalseColor(p_kshear[iv], plot_v_min, plot_v_max);
+                break;
+            case DeformableTerrain::PLOT_PRESSURE:
+                mcolor = ChColor::ComputeFalseColor(p_sigma[iv], plot_v_min, plot_v_max);
+                break;
+            case DeformableTerrain::PLOT_PRESSURE_YELD:
+                mcolor = ChColor::ComputeFalseColor(p_sigma_yeld[iv], plot_v_min, plot_v_max);
+                break;
+            case DeformableTerrain::PLOT_SHEAR:
+                mcolor = ChColor::ComputeFalseColor(p_tau[iv], plot_v_min, plot_v_max);
+                break;
+            case DeformableTerrain::PLOT_ISLAND_ID:
+                mcolor = ChColor(0,0,1);
+                if (p_erosion[iv] == true)
+                    mcolor = ChColor(1,1,1);
+                if (p_id_island[iv] >0)
+                    mcolor = ChColor::ComputeFalseColor(4 +(p_id_island[iv] % 8), 0, 12);
+                if (p_id_island[iv] <0)
+                    mcolor = ChColor(0,0,0);
+                break;
+            case DeformableTerrain::PLOT_IS_TOUCHED:
+                if (p_sigma[iv]>0)
+                    mcolor = ChColor(1,0,0);
+                else 
+                    mcolor = ChColor(0,0,1);
+                break;
+        }
+        colors[iv] = {mcolor.R, mcolor.G, mcolor.B};
+    }
+}
+
+// Add the loads of the container and the soil wrenches on the rigid bodies.
+void DeformableSoil::IntLoadResidual_F(const unsigned int off, ChVectorDynamic<>& R, const double c) {
+    ChLoadContainer::IntLoadResidual_F(off, R, c);
+
+    for (size_t iw = 0; iw < body_wrenches.size(); ++iw) {
+        ChBody* body = body_wrenches[iw].body;
+        if (!body->Variables().IsActive())
+            continue;
+        // moment about the current center of mass, as for forces applied at fixed absolute points
+        ChVector<> torque = body_wrenches[iw].moment - Vcross(body->GetPos(), body_wrenches[iw].force);
+        R.PasteSumVector(body_wrenches[iw].force * c, body->GetOffset_w(), 0);
+        R.PasteSumVector(body->Dir_World2Body(torque) * c, body->GetOffset_w() + 3, 0);
+    }
+}
+
+// Reset the list of forces, and fills it with forces from a soil contact model.
+void DeformableSoil::ComputeInternalForces() {
+
+    // Readibility aliases
+    std::vector<ChVector<> >& vertices = m_trimesh_shape->GetMesh().getCoordsVertices();
+    std::vector<ChVector<int> >& idx_vertices = m_trimesh_shape->GetMesh().getIndicesVertexes();
+    
+    // 
+    // Reset the load list
+    //
+
+    this->GetLoadList().clear();
+
+    //
+    // (Pseudo)areas per node and tiles: vertexes only move along the plane normal, so they
+    // change only if the mesh is refined or the plane is changed
+    //
+
+    if (!(plane == aux_plane)) {
+        ComputeVertexAreas();
+        SetupActiveRegion();
+        full_update = true;
+    }
+    if (!use_active_region)
+        full_update = true;
 
     ChVector<> N    = plane.TransformDirectionLocalToParent(ChVector<>(0,1,0));
 
+    //
+    // Select the vertexes whose ray can hit something: the vertical segment tested by the
+    // ray must overlap the bounding box of at least one collision model
+    //
+
+    std::vector<ChVector<>> aabb_min;
+    std::vector<ChVector<>> aabb_max;
+    bool test_all = false;
+    for (auto body : *this->GetSystem()->Get_bodylist()) {
+        if (!body->GetCollide())
+            continue;
+        ChVector<> bbmin, bbmax;
+        body->GetTotalAABB(bbmin, bbmax);
+        aabb_min.push_back(bbmin);
+        aabb_max.push_back(bbmax);
+    }
+    for (auto item : *this->GetSystem()->Get_otherphysicslist()) {
+        if (item.get() == this)
+            continue;
+        // other items (FEA meshes, sub-assemblies..) do not provide a bounding box
+        if (item->GetCollide() || std::dynamic_pointer_cast<ChAssembly>(item))
+            test_all = true;
+    }
+
+    int n_verts = (int)vertices.size();
+    hit_contactable.resize(n_verts);
+    hit_force.resize(n_verts);
+    hit_point.resize(n_verts);
+
+    //
+    // Collect the vertexes to process: the ones in the tiles under the bounding boxes, plus
+    // the ones hit or moved at the last step, that must be reset. All the others are at rest,
+    // with no pressure, so the work per step depends on the contact area, not on the mesh size.
+    //
+
+    ++current_stamp;
+    work_vertices.clear();
+    auto add_work_vertex = [this](int iv) {
+        if (vertex_stamp[iv] != current_stamp) {
+            vertex_stamp[iv] = current_stamp;
+            work_vertices.push_back(iv);
+        }
+    };
+
+    if (full_update || test_all) {
+        work_vertices.resize(n_verts);
+        for (int i = 0; i < n_verts; ++i)
+            work_vertices[i] = i;
+    } else {
+        for (size_t ib = 0; ib < aabb_min.size(); ++ib) {
+            // tiles covered by the box, as projected on the soil plane
+            double x_min = 1e30, x_max = -1e30, z_min = 1e30, z_max = -1e30;
+            for (int ic = 0; ic < 8; ++ic) {
+                ChVector<> corner((ic & 1) ? aabb_max[ib].x : aabb_min[ib].x,
+                                  (ic & 2) ? aabb_max[ib].y : aabb_min[ib].y,
+                                  (ic & 4) ? aabb_max[ib].z : aabb_min[ib].z);
+                ChVector<> loc = plane.TransformParentToLocal(corner);
+                x_min = ChMin(x_min, loc.x);
+                x_max = ChMax(x_max, loc.x);
+                z_min = ChMin(z_min, loc.z);
+                z_max = ChMax(z_max, loc.z);
+            }
+            double ix0 = floor(x_min / tile_size);
+            double ix1 = floor(x_max / tile_size);
+            double iz0 = floor(z_min / tile_size);
+            double iz1 = floor(z_max / tile_size);
+
+            if ((ix1 - ix0 + 1) * (iz1 - iz0 + 1) <= (double)tiles.size()) {
+                for (int ix = (int)ix0; ix <= (int)ix1; ++ix) {
+                    for (int iz = (int)iz0; iz <= (int)iz1; ++iz) {
+                        auto tile = tiles.find(TileKey(ix, iz));
+                        if (tile == tiles.end())
+                            continue;
+                        for (auto iv : tile->second)
+                            add_work_vertex(iv);
+                    }
+                }
+            } else {
+                // large (or unbounded) box: scan the tiles
+                for (auto& tile : tiles) {
+                    int ix, iz;
+                    TileCoords(tile.first, ix, iz);
+                    if (ix < ix0 || ix > ix1 || iz < iz0 || iz > iz1)
+                        continue;
+                    for (auto iv : tile.second)
+                        add_work_vertex(iv);
+                }
+            }
+        }
+        for (auto iv : active_vertices)
+            add_work_vertex(iv);
+        for (auto iv : dirty_vertices)
+            add_work_vertex(iv);
+
+        std::sort(work_vertices.begin(), work_vertices.end());
+    }
+    int n_work = (int)work_vertices.size();
+
     //
     // Perform ray-hit test to detect the contact point sinkage
     // 
-    
-    
-//#pragma omp parallel for
-    for (int i=0; i< vertices.size(); ++i) {
-        collision::ChCollisionSystem::ChRayhitResult mrayhit_result;
+    // The rays only read the collision system and each vertex updates only its own data,
+    // so the vertexes are processed in parallel; the forces are applied afterwards.
+    // The erosion flags are packed in a std::vector<bool>, where neighbouring vertexes share
+    // a word, so they are cleared here rather than in the parallel loop.
+
+    p_erosion.assign(p_erosion.size(), false);
+
+#pragma omp parallel for schedule(dynamic, 256)
+    for (int iw = 0; iw < n_work; ++iw) {
+        int i = work_vertices[iw];
         p_sigma[i] = 0;
         p_sinkage_elastic[i] = 0;
         p_step_plastic_flow[i]=0;
-        p_erosion[i] = false;
+        hit_contactable[i] = nullptr;
 
         p_level[i] = plane.TransformLocalToParent(vertices[i]).y;
 
@@ -511,7 +849,17 @@ void DeformableSoil::ComputeInternalForces() {
         p_hit_level[i] = 1e9;
         double p_hit_offset = 1e9;
 
+        bool candidate = test_all;
+        for (size_t ib = 0; ib < aabb_min.size() && !candidate; ++ib) {
+            candidate = ChMin(from.x, to.x) <= aabb_max[ib].x && ChMax(from.x, to.x) >= aabb_min[ib].x &&
+                        ChMin(from.y, to.y) <= aabb_max[ib].y && ChMax(from.y, to.y) >= aabb_min[ib].y &&
+                        ChMin(from.z, to.z) <= aabb_max[ib].z && ChMax(from.z, to.z) >= aabb_min[ib].z;
+        }
+        if (!candidate)
+            continue;
+
         // DO THE RAY-HIT TEST HERE:
+        collision::ChCollisionSystem::ChRayhitResult mrayhit_result;
         this->GetSystem()->GetCollisionSystem()->RayHit(from,to,mrayhit_result);
 
         if (mrayhit_result.hit == true) {
@@ -568,24 +916,9 @@ void DeformableSoil::ComputeInternalForces() {
                 Fn = N * p_area[i] * p_sigma[i];
                 Ft = T * p_area[i] * p_tau[i];
 
-                if (ChBody* rigidbody = dynamic_cast<ChBody*>(contactable)) {
-                    // [](){} Trick: no deletion for this shared ptr, since 'rigidbody' was not a new ChBody() 
-                    // object, but an already used pointer because mrayhit_result.hitModel->GetPhysicsItem() 
-                    // cannot return it as shared_ptr, as needed by the ChLoadBodyForce:
-                    std::shared_ptr<ChBody> srigidbody(rigidbody, [](ChBody*){}); 
-                    std::shared_ptr<ChLoadBodyForce> mload(
-                        new ChLoadBodyForce(srigidbody, Fn + Ft, false, vertices[i], false));
-                    this->Add(mload);
-                }
-                if (ChLoadableUV* surf = dynamic_cast<ChLoadableUV*>(contactable)) {
-                    // [](){} Trick: no deletion for this shared ptr
-                    std::shared_ptr<ChLoadableUV> ssurf(surf, [](ChLoadableUV*){});
-                    std::shared_ptr<ChLoad<ChLoaderForceOnSurface>> mload(
-                        new ChLoad<ChLoaderForceOnSurface>(ssurf));
-                    mload->loader.SetForce( Fn +Ft );
-                    mload->loader.SetApplication(0.5, 0.5); //***TODO*** set UV, now just in middle
-                    this->Add(mload);
-                }
+                hit_contactable[i] = contactable;
+                hit_force[i] = Fn + Ft;
+                hit_point[i] = vertices[i];
                 
                 // Update mesh representation
                 vertices[i] = p_vertices_initial[i] - N * p_sinkage[i];
@@ -596,11 +929,51 @@ void DeformableSoil::ComputeInternalForces() {
 
     } // end loop on vertexes
 
+    active_vertices.clear();
+    for (auto iv : work_vertices) {
+        if (p_hit_level[iv] < 1e9)
+            active_vertices.push_back(iv);
+    }
+
+    //
+    // Apply the forces: rigid bodies get a single wrench, summing the forces of all their
+    // vertexes; deformable surfaces get one load per vertex
+    //
+
+    body_wrenches.clear();
+    std::map<ChBody*, size_t> wrench_index;
+    for (auto i : work_vertices) {
+        ChContactable* contactable = hit_contactable[i];
+        if (!contactable)
+            continue;
+        if (ChBody* rigidbody = dynamic_cast<ChBody*>(contactable)) {
+            auto iw = wrench_index.find(rigidbody);
+            if (iw == wrench_index.end()) {
+                iw = wrench_index.insert(std::make_pair(rigidbody, body_wrenches.size())).first;
+                BodyWrench wrench = {rigidbody, VNULL, VNULL};
+                body_wrenches.push_back(wrench);
+            }
+            body_wrenches[iw->second].force += hit_force[i];
+            body_wrenches[iw->second].moment += Vcross(hit_point[i], hit_force[i]);
+        }
+        if (ChLoadableUV* surf = dynamic_cast<ChLoadableUV*>(contactable)) {
+            // [](){} Trick: no deletion for this shared ptr
+            std::shared_ptr<ChLoadableUV> ssurf(surf, [](ChLoadableUV*){});
+            std::shared_ptr<ChLoad<ChLoaderForceOnSurface>> mload(
+                new ChLoad<ChLoaderForceOnSurface>(ssurf));
+            mload->loader.SetForce(hit_force[i]);
+            mload->loader.SetApplication(0.5, 0.5); //***TODO*** set UV, now just in middle
+            this->Add(mload);
+        }
+    }
+
     
     //
     // Refine the mesh detail
     //
 
+    bool mesh_refined = false;
+
     if (do_refinement) {  
         
         std::vector<std::vector<double>*> aux_data_double; 
@@ -624,16 +997,16 @@ void DeformableSoil::ComputeInternalForces() {
         aux_data_vect.push_back(&p_vertices_initial);
         aux_data_vect.push_back(&p_speeds);
 
-        // loop on triangles to see which needs refinement
+        // triangles which need refinement: the ones with at least one touching vertex
         std::vector<int> marked_tris;
-        for (int it = 0; it< idx_vertices.size(); ++it) {
-            // see if at least one of the vertexes are touching
-            if ( p_sigma[idx_vertices[it].x] >0 || 
-                 p_sigma[idx_vertices[it].y] >0 ||
-                 p_sigma[idx_vertices[it].z] >0 ) {
-                marked_tris.push_back(it);
+        for (auto iv : work_vertices) {
+            if (p_sigma[iv] > 0) {
+                for (int k = vertex_triangles_start[iv]; k < vertex_triangles_start[iv + 1]; ++k)
+                    marked_tris.push_back(vertex_triangles[k]);
             }
         }
+        std::sort(marked_tris.begin(), marked_tris.end());
+        marked_tris.erase(std::unique(marked_tris.begin(), marked_tris.end()), marked_tris.end());
     
         // custom edge refinement criterion: do not use default edge length, 
         // length of the edge as projected on soil plane
@@ -664,32 +1037,28 @@ void DeformableSoil::ComputeInternalForces() {
         }
         // TO DO adjust this incrementally
         
-        connected_vertexes.clear();
-        connected_vertexes.resize( vertices.size() );
-        for (unsigned int iface = 0; iface < idx_vertices.size(); ++iface) {
-            connected_vertexes[idx_vertices[iface].x].insert(idx_vertices[iface].y);
-            connected_vertexes[idx_vertices[iface].x].insert(idx_vertices[iface].z);
-            connected_vertexes[idx_vertices[iface].y].insert(idx_vertices[iface].x);
-            connected_vertexes[idx_vertices[iface].y].insert(idx_vertices[iface].z);
-            connected_vertexes[idx_vertices[iface].z].insert(idx_vertices[iface].x);
-            connected_vertexes[idx_vertices[iface].z].insert(idx_vertices[iface].y);
-        }
+        if ((int)vertices.size() != n_verts) {
+            connected_vertexes.clear();
+            connected_vertexes.resize( vertices.size() );
+            for (unsigned int iface = 0; iface < idx_vertices.size(); ++iface) {
+                connected_vertexes[idx_vertices[iface].x].insert(idx_vertices[iface].y);
+                connected_vertexes[idx_vertices[iface].x].insert(idx_vertices[iface].z);
+                connected_vertexes[idx_vertices[iface].y].insert(idx_vertices[iface].x);
+                connected_vertexes[idx_vertices[iface].y].insert(idx_vertices[iface].z);
+                connected_vertexes[idx_vertices[iface].z].insert(idx_vertices[iface].x);
+                connected_vertexes[idx_vertices[iface].z].insert(idx_vertices[iface].y);
+            }
 
-        // Recompute areas (could be optimized)
-        for (unsigned int iv = 0; iv < vertices.size(); ++iv) {
-            p_area[iv] = 0;
-        }
-        for (unsigned int it = 0; it < idx_vertices.size(); ++it) {
-            ChVector<> AB = vertices[idx_vertices[it].y] - vertices[idx_vertices[it].x];
-            ChVector<> AC = vertices[idx_vertices[it].z] - vertices[idx_vertices[it].x];
-            AB = plane.TransformDirectionParentToLocal(AB);
-            AC = plane.TransformDirectionParentToLocal(AC);
-            AB.y=0;
-            AC.y=0;
-            double triangle_area = 0.5*(Vcross(AB,AC)).Length();
-            p_area[idx_normals[it].x] += triangle_area /3.0;
-            p_area[idx_normals[it].y] += triangle_area /3.0;
-            p_area[idx_normals[it].z] += triangle_area /3.0;
+            // Recompute areas and tiles
+            ComputeVertexAreas();
+            SetupActiveRegion();
+
+            // the new vertexes have interpolated data, to be reset at the next step
+            for (int iv = n_verts; iv < (int)vertices.size(); ++iv) {
+                work_vertices.push_back(iv);
+                active_vertices.push_back(iv);
+            }
+            mesh_refined = true;
         }
     }
 
@@ -697,9 +1066,12 @@ void DeformableSoil::ComputeInternalForces() {
     // Flow material to the side of rut, using heuristics
     // 
 
+    dirty_vertices.clear();
+
     if (do_bulldozing) {
+        // the vertexes out of the work list are untouched and not in any island or boundary
         std::set<int> touched_vertexes;
-        for (int iv = 0; iv< vertices.size(); ++iv) {
+        for (auto iv : work_vertices) {
             p_id_island[iv] = 0;
             if (p_sigma[iv]>0)
                 touched_vertexes.insert(iv);
@@ -788,6 +1160,13 @@ void DeformableSoil::ComputeInternalForces() {
             domain_erosion.insert(front_erosion2.begin(), front_erosion2.end());
             front_erosion = front_erosion2;
         }
+        // The boundaries and the erosion domain must be reset at the next step
+        ++current_stamp;
+        for (auto ie : domain_erosion) {
+            vertex_stamp[ie] = current_stamp;
+            dirty_vertices.push_back(ie);
+        }
+
         // Erosion smoothing algorithm on domain
         for (int ismo = 0; ismo <3; ++ismo) {
             for (auto is : domain_erosion) {
@@ -827,6 +1206,11 @@ void DeformableSoil::ComputeInternalForces() {
                             p_level_initial[is]     += clamped_d_y_i;
                             vertices[is]            += N * clamped_d_y_i;
                             p_vertices_initial[is]  += N * clamped_d_y_i;      
+
+                            if (vertex_stamp[ivc] != current_stamp) {
+                                vertex_stamp[ivc] = current_stamp;
+                                dirty_vertices.push_back(ivc);
+                            }
                         }
                     }
                 }
@@ -838,91 +1222,20 @@ void DeformableSoil::ComputeInternalForces() {
 
 
     //
-    // Update the visualization colors
+    // Update the visualization colors and normals, only around the changed vertexes
     // 
-    if (plot_type != DeformableTerrain::PLOT_NONE) {
-        colors.resize(vertices.size());
-        for (size_t iv = 0; iv< vertices.size(); ++iv) {
-            ChColor mcolor;
-            switch (plot_type) {
-                case DeformableTerrain::PLOT_LEVEL:
-                    mcolor = ChColor::ComputeFalseColor(p_level[iv], plot_v_min, plot_v_max);
-                    break;
-                case DeformableTerrain::PLOT_LEVEL_INITIAL:
-                    mcolor = ChColor::ComputeFalseColor(p_level_initial[iv], plot_v_min, plot_v_max);
-                    break;
-                case DeformableTerrain::PLOT_SINKAGE:
-                    mcolor = ChColor::ComputeFalseColor(p_sinkage[iv], plot_v_min, plot_v_max);
-                    break;
-                case DeformableTerrain::PLOT_SINKAGE_ELASTIC:
-                    mcolor = ChColor::ComputeFalseColor(p_sinkage_elastic[iv], plot_v_min, plot_v_max);
-                    break;
-                case DeformableTerrain::PLOT_SINKAGE_PLASTIC:
-                    mcolor = ChColor::ComputeFalseColor(p_sinkage_plastic[iv], plot_v_min, plot_v_max);
-                    break;
-                case DeformableTerrain::PLOT_STEP_PLASTIC_FLOW:
-                    mcolor = ChColor::ComputeFalseColor(p_step_plastic_flow[iv], plot_v_min, plot_v_max);
-                    break;
-                case DeformableTerrain::PLOT_K_JANOSI:
-                    mcolor = ChColor::ComputeFalseColor(p_kshear[iv], plot_v_min, plot_v_max);
-                    break;
-                case DeformableTerrain::PLOT_PRESSURE:
-                    mcolor = ChColor::ComputeFalseColor(p_sigma[iv], plot_v_min, plot_v_max);
-                    break;
-                case DeformableTerrain::PLOT_PRESSURE_YELD:
-                    mcolor = ChColor::ComputeFalseColor(p_sigma_yeld[iv], plot_v_min, plot_v_max);
-                    break;
-                case DeformableTerrain::PLOT_SHEAR:
-                    mcolor = ChColor::ComputeFalseColor(p_tau[iv], plot_v_min, plot_v_max);
-                    break;
-                case DeformableTerrain::PLOT_ISLAND_ID:
-                    mcolor = ChColor(0,0,1);
-                    if (p_erosion[iv] == true)
-                        mcolor = ChColor(1,1,1);
-                    if (p_id_island[iv] >0)
-                        mcolor = ChColor::ComputeFalseColor(4 +(p_id_island[iv] % 8), 0, 12);
-                    if (p_id_island[iv] <0)
-                        mcolor = ChColor(0,0,0);
-                    break;
-                case DeformableTerrain::PLOT_IS_TOUCHED:
-                    if (p_sigma[iv]>0)
-                        mcolor = ChColor(1,0,0);
-                    else 
-                        mcolor = ChColor(0,0,1);
-                    break;
-            }
-            colors[iv] = {mcolor.R, mcolor.G, mcolor.B};
-        }
-    } else {
-        colors.clear();
-    }
-
-    //
-    // Update the visualization normals
-    // 
-
-    std::vector<int> accumulators(vertices.size(), 0);
 
-    // Calculate normals and then average the normals from all adjacent faces.
-    for (unsigned int it = 0; it < idx_vertices.size(); ++it) {
-        // Calculate the triangle normal as a normalized cross product.
-        ChVector<> nrm = -Vcross(vertices[idx_vertices[it].y] - vertices[idx_vertices[it].x],
-                                vertices[idx_vertices[it].z] - vertices[idx_vertices[it].x]);
-        nrm.Normalize();
-        // Increment the normals of all incident vertices by the face normal
-        normals[idx_normals[it].x] += nrm;
-        normals[idx_normals[it].y] += nrm;
-        normals[idx_normals[it].z] += nrm;
-        // Increment the count of all incident vertices by 1
-        accumulators[idx_normals[it].x] += 1;
-        accumulators[idx_normals[it].y] += 1;
-        accumulators[idx_normals[it].z] += 1;
+    // the vertexes move only if pressed or bulldozed
+    std::vector<int> moved_vertices(dirty_vertices);
+    for (auto iv : work_vertices) {
+        if (p_sigma[iv] > 0)
+            moved_vertices.push_back(iv);
     }
+    UpdateNormals((full_update || mesh_refined) ? nullptr : &moved_vertices);
 
-    // Set the normals to the average values.
-    for (unsigned int in = 0; in < vertices.size(); ++in) {
-        normals[in] /= (double)accumulators[in];
-    }
+    work_vertices.insert(work_vertices.end(), dirty_vertices.begin(), dirty_vertices.end());
+    UpdateColors(full_update ? nullptr : &work_vertices);
+    full_update = false;
 
     // 
     // Compute the forces 
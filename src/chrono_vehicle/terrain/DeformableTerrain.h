@@ -21,6 +21,7 @@
 
 #include <set>
 #include <string>
+#include <unordered_map>
 
 #include "chrono/assets/ChColor.h"
 #include "chrono/assets/ChColorAsset.h"
@@ -148,6 +149,19 @@ public:
     void SetTestHighOffset(double moff);
     double GetTestHighOffset() const;
 
+    /// If true (default), only the vertexes under the bounding boxes of the colliding bodies, and
+    /// the ones changed at the last step, are processed at each step. If false, all the vertexes
+    /// of the mesh are processed at each step, as a reference for the active region.
+    /// This limits the work per step, not the memory: the soil state is still stored for every
+    /// vertex of the mesh.
+    void SetActiveRegion(bool val);
+    bool GetActiveRegion() const;
+
+
+    /// Get the total force and torque applied by the soil on the specified rigid body, as computed at
+    /// the beginning of the last step. The torque is about the current center of mass of the body, in
+    /// absolute coordinates. Both are zero if the body is not in contact with the soil.
+    void GetContactForce(std::shared_ptr<ChBody> body, ChVector<>& force, ChVector<>& torque) const;
 
     /// Set the color plot type for the soil mesh.
     /// Also, when a scalar plot is used, also define which is the max-min range in the falsecolor colormap.
@@ -248,17 +262,26 @@ class CH_VEHICLE_API DeformableSoil : public ChLoadContainer {
     virtual void IntLoadResidual_F(const unsigned int off,  ///< offset in R residual
                                    ChVectorDynamic<>& R,    ///< result: the R residual, R += c*F
                                    const double c           ///< a scaling factor
-                                   ) override {
+                                   ) override;
 
-        // Overloading base class, that takes all F vectors from the list of forces and put all them in R
-        ChLoadContainer::IntLoadResidual_F(off, R, c);
-    }
-    
 
     // This is called after Initialize(), it precomputes aux.topology
     // data structures for the mesh, aux. material data, etc.
     void SetupAuxData();
 
+    // Computes the areas of the vertexes, projected on the soil plane.
+    void ComputeVertexAreas();
+
+    // Bins the vertexes in tiles on the soil plane, and builds the vertex-triangle incidence
+    // used to update normals locally.
+    void SetupActiveRegion();
+
+    // Recomputes the normals around the vertexes in the list (or everywhere, if null).
+    void UpdateNormals(const std::vector<int>* changed);
+
+    // Recomputes the false colors of the vertexes in the list (or everywhere, if null).
+    void UpdateColors(const std::vector<int>* changed);
+
     std::shared_ptr<ChColorAsset> m_color;
     std::shared_ptr<ChTriangleMeshShape> m_trimesh_shape;
     double m_height;
@@ -280,6 +303,38 @@ class CH_VEHICLE_API DeformableSoil : public ChLoadContainer {
     std::vector<int>    p_id_island;
     std::vector<bool>   p_erosion;
 
+    // Soil force on a rigid body, with its moment about the absolute origin.
+    struct BodyWrench {
+        ChBody* body;
+        ChVector<> force;
+        ChVector<> moment;
+    };
+    std::vector<BodyWrench> body_wrenches;
+
+    // per-vertex results of the ray-hit tests (kept to avoid reallocations)
+    std::vector<ChContactable*> hit_contactable;
+    std::vector<ChVector<>> hit_force;
+    std::vector<ChVector<>> hit_point;
+
+    // Active region: only the vertexes in the tiles under the colliding bodies, or changed at
+    // the last step, are processed. The tiles are squares on the soil plane, hashed by their
+    // integer coordinates, so that memory grows with the mesh and not with the course extent.
+    // The tiles only index the vertexes: the per-vertex state above stays dense over the mesh.
+    double tile_size;
+    std::unordered_map<long long, std::vector<int>> tiles;
+    ChCoordsys<> aux_plane;  // plane used for p_area and tiles
+    std::vector<int> vertex_triangles_start;  // triangles of each vertex (compressed rows)
+    std::vector<int> vertex_triangles;
+    std::vector<int> normal_triangles_start;  // triangles of each normal (compressed rows)
+    std::vector<int> normal_triangles;
+    std::vector<int> vertex_stamp;  // to collect vertexes without duplicates
+    int current_stamp;
+    std::vector<int> work_vertices;    // vertexes processed in the current step
+    std::vector<int> active_vertices;  // vertexes hit at the last step
+    std::vector<int> dirty_vertices;   // vertexes changed by the bulldozing at the last step
+    bool full_update;                  // normals and colors must be recomputed everywhere
+    bool use_active_region;            // if false, all vertexes are processed at each step
+
     double Bekker_Kphi;
     double Bekker_Kc;
     double Bekker_n;
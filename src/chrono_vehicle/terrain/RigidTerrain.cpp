@@ -16,6 +16,7 @@
 //
 // =============================================================================
 
+#include <algorithm>
 #include <cstdio>
 #include <cmath>
 
@@ -52,7 +53,11 @@ RigidTerrain::RigidTerrain(ChSystem* system)
       m_kn(2e5f),
       m_gn(40),
       m_kt(2e5f),
-      m_gt(20) {
+      m_gt(20),
+      m_nv_x(0),
+      m_nv_y(0),
+      m_grid_nx(0),
+      m_grid_ny(0) {
     // Create the ground body and add it to the system.
     m_ground = std::shared_ptr<ChBody>(system->NewBody());
     m_ground->SetIdentifier(-1);
@@ -86,7 +91,11 @@ RigidTerrain::RigidTerrain(ChSystem* system, const std::string& filename)
       m_kn(2e5f),
       m_gn(40),
       m_kt(2e5f),
-      m_gt(20) {
+      m_gt(20),
+      m_nv_x(0),
+      m_nv_y(0),
+      m_grid_nx(0),
+      m_grid_ny(0) {
     // Create the ground body and add it to the system.
     m_ground = std::shared_ptr<ChBody>(system->NewBody());
     m_ground->SetIdentifier(-1);
@@ -295,6 +304,8 @@ void RigidTerrain::Initialize(const std::string& mesh_file, const std::string& m
 
     m_mesh_name = mesh_name;
     m_type = MESH;
+
+    SetupMeshGrid();
 }
 
 // -----------------------------------------------------------------------------
@@ -430,6 +441,95 @@ void RigidTerrain::Initialize(const std::string& heightmap_file,
 
     m_mesh_name = mesh_name;
     m_type = HEIGHT_MAP;
+
+    m_nv_x = nv_x;
+    m_nv_y = nv_y;
+    m_dx = dx;
+    m_dy = dy;
+}
+
+// -----------------------------------------------------------------------------
+// Build a uniform grid over the (x,y) bounding boxes of the mesh triangles.
+// The cell size is the mean extent of the triangles, so that each cell overlaps
+// a few triangles only.
+// -----------------------------------------------------------------------------
+void RigidTerrain::SetupMeshGrid() {
+    std::vector<ChVector<> >& vertices = m_trimesh.getCoordsVertices();
+    std::vector<ChVector<int> >& idx_vertices = m_trimesh.getIndicesVertexes();
+
+    m_grid_nx = 0;
+    m_grid_ny = 0;
+    m_grid_start.clear();
+    m_grid_triangles.clear();
+
+    // Triangles that can be hit from above (vertical walls are skipped)
+    std::vector<int> tris;
+    double x_min = 1e30, x_max = -1e30, y_min = 1e30, y_max = -1e30;
+    double sum_extent = 0;
+    for (int it = 0; it < (int)idx_vertices.size(); ++it) {
+        const ChVector<>& A = vertices[idx_vertices[it].x];
+        const ChVector<>& B = vertices[idx_vertices[it].y];
+        const ChVector<>& C = vertices[idx_vertices[it].z];
+        ChVector<> nrm = Vcross(B - A, C - A);
+        if (std::abs(nrm.z) <= 1e-9 * nrm.Length())
+            continue;
+        tris.push_back(it);
+        double tx_min = std::min(A.x, std::min(B.x, C.x));
+        double tx_max = std::max(A.x, std::max(B.x, C.x));
+        double ty_min = std::min(A.y, std::min(B.y, C.y));
+        double ty_max = std::max(A.y, std::max(B.y, C.y));
+        x_min = std::min(x_min, tx_min);
+        x_max = std::max(x_max, tx_max);
+        y_min = std::min(y_min, ty_min);
+        y_max = std::max(y_max, ty_max);
+        sum_extent += std::max(tx_max - tx_min, ty_max - ty_min);
+    }
+    if (tris.empty())
+        return;
+
+    // Cell size: mean triangle extent, but no more than about 4 cells per triangle
+    double size_x = x_max - x_min;
+    double size_y = y_max - y_min;
+    m_grid_cell = sum_extent / tris.size();
+    m_grid_cell = std::max(m_grid_cell, std::sqrt(size_x * size_y / (4.0 * tris.size())));
+    m_grid_cell = std::max(m_grid_cell, 1e-9 * std::max(size_x, size_y));
+    if (m_grid_cell <= 0)
+        m_grid_cell = 1;
+    m_grid_x0 = x_min;
+    m_grid_y0 = y_min;
+    m_grid_nx = (int)std::floor(size_x / m_grid_cell) + 1;
+    m_grid_ny = (int)std::floor(size_y / m_grid_cell) + 1;
+
+    // Count, then fill, the triangles overlapping each cell
+    m_grid_start.assign(m_grid_nx * m_grid_ny + 1, 0);
+    for (int pass = 0; pass < 2; ++pass) {
+        std::vector<int> pos;
+        if (pass == 1) {
+            for (int ic = 0; ic < m_grid_nx * m_grid_ny; ++ic)
+                m_grid_start[ic + 1] += m_grid_start[ic];
+            m_grid_triangles.resize(m_grid_start.back());
+            pos.assign(m_grid_start.begin(), m_grid_start.end() - 1);
+        }
+        for (auto it : tris) {
+            const ChVector<>& A = vertices[idx_vertices[it].x];
+            const ChVector<>& B = vertices[idx_vertices[it].y];
+            const ChVector<>& C = vertices[idx_vertices[it].z];
+            int ix0 = (int)std::floor((std::min(A.x, std::min(B.x, C.x)) - m_grid_x0) / m_grid_cell);
+            int ix1 = (int)std::floor((std::max(A.x, std::max(B.x, C.x)) - m_grid_x0) / m_grid_cell);
+            int iy0 = (int)std::floor((std::min(A.y, std::min(B.y, C.y)) - m_grid_y0) / m_grid_cell);
+            int iy1 = (int)std::floor((std::max(A.y, std::max(B.y, C.y)) - m_grid_y0) / m_grid_cell);
+            ix1 = std::min(ix1, m_grid_nx - 1);
+            iy1 = std::min(iy1, m_grid_ny - 1);
+            for (int iy = iy0; iy <= iy1; ++iy) {
+                for (int ix = ix0; ix <= ix1; ++ix) {
+                    if (pass == 0)
+                        ++m_grid_start[ix + m_grid_nx * iy + 1];
+                    else
+                        m_grid_triangles[pos[ix + m_grid_nx * iy]++] = it;
+                }
+            }
+        }
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -448,47 +548,121 @@ void RigidTerrain::ExportMeshPovray(const std::string& out_dir) {
 }
 
 // -----------------------------------------------------------------------------
-// Return the terrain height at the specified location
+// Find the terrain height and normal at the specified location.
+// For a height map, the cell and the triangle are found directly from the grid
+// spacing; locations outside the map take the height of the closest border.
+// For a mesh, the triangles in the grid cell are tested, and the highest one
+// above the location is used.
 // -----------------------------------------------------------------------------
-double RigidTerrain::GetHeight(double x, double y) const {
+bool RigidTerrain::FindHeightNormal(double x, double y, double& height, ChVector<>& normal) const {
+    height = 0;
+    normal = ChVector<>(0, 0, 1);
+
     switch (m_type) {
         case FLAT:
-            return m_height;
-        case MESH: {
-            double height = 0;
-            //// TODO
-            return height;
-        }
+            height = m_height;
+            return true;
+
         case HEIGHT_MAP: {
-            double height = 0;
-            //// TODO
-            return height;
+            if (m_nv_x < 2 || m_nv_y < 2)
+                return false;
+            const std::vector<ChVector<> >& vertices = m_trimesh.getCoordsVertices();
+            double sx = ChClamp((x + 0.5 * (m_nv_x - 1) * m_dx) / m_dx, 0.0, m_nv_x - 1.0);
+            double sy = ChClamp((y + 0.5 * (m_nv_y - 1) * m_dy) / m_dy, 0.0, m_nv_y - 1.0);
+            int ix = std::min((int)sx, m_nv_x - 2);
+            int iy = std::min((int)sy, m_nv_y - 2);
+            double u = sx - ix;
+            double v = sy - iy;
+            int v0 = ix + m_nv_x * iy;
+            double h00 = vertices[v0].z;
+            double h10 = vertices[v0 + 1].z;
+            double h01 = vertices[v0 + m_nv_x].z;
+            double h11 = vertices[v0 + m_nv_x + 1].z;
+            // Same triangles as the mesh, split by the diagonal (ix,iy)-(ix+1,iy+1)
+            double dh_du, dh_dv;
+            if (v >= u) {
+                dh_du = h11 - h01;
+                dh_dv = h01 - h00;
+            } else {
+                dh_du = h10 - h00;
+                dh_dv = h11 - h10;
+            }
+            height = h00 + u * dh_du + v * dh_dv;
+            normal = ChVector<>(-dh_du / m_dx, -dh_dv / m_dy, 1);
+            normal.Normalize();
+            return true;
+        }
+
+        case MESH: {
+            if (m_grid_nx == 0)
+                return false;
+            int ix = (int)std::floor((x - m_grid_x0) / m_grid_cell);
+            int iy = (int)std::floor((y - m_grid_y0) / m_grid_cell);
+            if (ix < 0 || ix >= m_grid_nx || iy < 0 || iy >= m_grid_ny)
+                return false;
+            const std::vector<ChVector<> >& vertices = m_trimesh.getCoordsVertices();
+            const std::vector<ChVector<int> >& idx_vertices = m_trimesh.getIndicesVertexes();
+            int cell = ix + m_grid_nx * iy;
+            bool found = false;
+            for (int k = m_grid_start[cell]; k < m_grid_start[cell + 1]; ++k) {
+                const ChVector<int>& tri = idx_vertices[m_grid_triangles[k]];
+                const ChVector<>& A = vertices[tri.x];
+                const ChVector<>& B = vertices[tri.y];
+                const ChVector<>& C = vertices[tri.z];
+                // Barycentric coordinates of the location, in the (x,y) plane
+                double det = (B.x - A.x) * (C.y - A.y) - (C.x - A.x) * (B.y - A.y);
+                double s = ((x - A.x) * (C.y - A.y) - (C.x - A.x) * (y - A.y)) / det;
+                double t = ((B.x - A.x) * (y - A.y) - (x - A.x) * (B.y - A.y)) / det;
+                if (s < -1e-10 || t < -1e-10 || s + t > 1 + 1e-10)
+                    continue;
+                double z = A.z + s * (B.z - A.z) + t * (C.z - A.z);
+                if (found && z <= height)
+                    continue;
+                found = true;
+                height = z;
+                normal = Vcross(B - A, C - A);
+                normal.Normalize();
+                if (normal.z < 0)
+                    normal = -normal;
+            }
+            return found;
         }
+
         default:
-            return 0;
+            return false;
     }
 }
 
+// -----------------------------------------------------------------------------
+// Return the terrain height at the specified location
+// -----------------------------------------------------------------------------
+double RigidTerrain::GetHeight(double x, double y) const {
+    double height;
+    ChVector<> normal;
+    FindHeightNormal(x, y, height, normal);
+    return height;
+}
+
 // -----------------------------------------------------------------------------
 // Return the terrain normal at the specified location
 // -----------------------------------------------------------------------------
 ChVector<> RigidTerrain::GetNormal(double x, double y) const {
-    switch (m_type) {
-        case FLAT:
-            return ChVector<>(0, 0, 1);
-        case MESH: {
-            ChVector<> normal(0, 0, 1);
-            //// TODO
-            return normal;
-        }
-        case HEIGHT_MAP: {
-            ChVector<> normal(0, 0, 1);
-            //// TODO
-            return normal;
-        }
-        default:
-            return ChVector<>(0, 0, 1);
-    }
+    double height;
+    ChVector<> normal;
+    FindHeightNormal(x, y, height, normal);
+    return normal;
+}
+
+// -----------------------------------------------------------------------------
+// Return the terrain heights and normals at the specified locations
+// -----------------------------------------------------------------------------
+void RigidTerrain::GetHeightsAndNormals(const std::vector<ChVector2<> >& points,
+                                        std::vector<double>& heights,
+                                        std::vector<ChVector<> >& normals) const {
+    heights.resize(points.size());
+    normals.resize(points.size());
+    for (size_t i = 0; i < points.size(); i++)
+        FindHeightNormal(points[i].x, points[i].y, heights[i], normals[i]);
 }
 
 }  // end namespace vehicle
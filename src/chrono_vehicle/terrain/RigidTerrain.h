@@ -20,6 +20,7 @@
 #define RIGID_TERRAIN_H
 
 #include <string>
+#include <vector>
 
 #include "chrono/assets/ChColor.h"
 #include "chrono/assets/ChColorAsset.h"
@@ -139,6 +140,12 @@ class CH_VEHICLE_API RigidTerrain : public ChTerrain {
     /// Get the terrain normal at the specified (x,y) location.
     virtual chrono::ChVector<> GetNormal(double x, double y) const override;
 
+    /// Get the terrain heights and normals at a set of (x,y) locations.
+    /// Each location is looked up once, for both the height and the normal.
+    virtual void GetHeightsAndNormals(const std::vector<ChVector2<> >& points,
+                                      std::vector<double>& heights,
+                                      std::vector<ChVector<> >& normals) const override;
+
   private:
     Type m_type;
     bool m_vis_enabled;
@@ -157,7 +164,30 @@ class CH_VEHICLE_API RigidTerrain : public ChTerrain {
     float m_kt;
     float m_gt;
 
+    // Height map grid (vertex ix + m_nv_x * iy at x = ix * m_dx - sizeX/2, y = iy * m_dy - sizeY/2)
+    int m_nv_x;
+    int m_nv_y;
+    double m_dx;
+    double m_dy;
+
+    // Uniform grid over the (x,y) bounding boxes of the mesh triangles, with the list of
+    // triangles overlapping each cell in compressed rows
+    double m_grid_x0;
+    double m_grid_y0;
+    double m_grid_cell;
+    int m_grid_nx;
+    int m_grid_ny;
+    std::vector<int> m_grid_start;
+    std::vector<int> m_grid_triangles;
+
     void ApplyContactMaterial();
+
+    /// Build the triangle grid used for the height queries on MESH terrain.
+    void SetupMeshGrid();
+
+    /// Find the terrain height and normal at the specified (x,y) location.
+    /// Returns false (and a height of 0) if the location is outside the terrain mesh.
+    bool FindHeightNormal(double x, double y, double& height, ChVector<>& normal) const;
 };
 
 /// @} vehicle_terrain
@@ -20,6 +20,8 @@
 //
 // =============================================================================
 
+#include <algorithm>
+
 #include "chrono/assets/ChLineShape.h"
 #include "chrono/assets/ChColor.h"
 
@@ -34,6 +36,10 @@ namespace vehicle {
 ChSprocket::ChSprocket(const std::string& name)
     : ChPart(name),
       m_callback(NULL),
+      m_culling(true),
+      m_pass(0),
+      m_scan_interval(10),
+      m_num_missed(0),
       m_friction(0.4f),
       m_restitution(0.1f),
       m_young_modulus(1e7f),
@@ -125,6 +131,77 @@ void ChSprocket::Initialize(std::shared_ptr<ChBodyAuxRef> chassis, const ChVecto
     chassis->GetSystem()->SetCustomComputeCollisionCallback(GetCollisionCallback(track));
 }
 
+// -----------------------------------------------------------------------------
+// Select the track shoes close to the gear axis. Their indices form contiguous
+// (cyclic) sequences of the track chain, which move by at most a few shoes from
+// one step to the next. Starting from the shoes watched at the previous pass,
+// i.e. the ones within one more pitch of the gear, walk along the chain in both
+// directions as long as shoes are within that distance. The watched shoes of a
+// sequence approaching the gear are thus tracked before they come within range.
+// A sequence approaching the gear elsewhere along the chain is only found by a
+// full scan, performed every few passes (and whenever no shoe is watched); the
+// candidates it finds in addition to the walk are counted as missed.
+// -----------------------------------------------------------------------------
+void ChSprocket::SelectContactCandidates(ChTrackAssembly* track, double radius) {
+    size_t num_shoes = track->GetNumTrackShoes();
+    double radius2 = radius * radius;
+    double watch_radius = radius + track->GetTrackShoe(0)->GetPitch();
+    double watch_radius2 = watch_radius * watch_radius;
+
+    // Squared distance from the gear axis, in the (x-z) plane of the gear.
+    auto distance2 = [&](size_t is) {
+        ChVector<> loc = m_gear->TransformPointParentToLocal(track->GetTrackShoePos(is));
+        return loc.x * loc.x + loc.z * loc.z;
+    };
+
+    if (m_visited.size() != num_shoes) {
+        m_visited.assign(num_shoes, 0);
+        m_watched.clear();
+    }
+    m_pass++;
+    m_candidates.clear();
+
+    bool full_scan = !m_culling || m_watched.empty() || m_scan_interval <= 1 || m_pass % m_scan_interval == 0;
+    bool walked = m_culling && !m_watched.empty();
+
+    if (walked) {
+        std::vector<size_t> seeds;
+        seeds.swap(m_watched);
+        while (!seeds.empty()) {
+            size_t is = seeds.back();
+            seeds.pop_back();
+            if (m_visited[is] == m_pass)
+                continue;
+            m_visited[is] = m_pass;
+            double d2 = distance2(is);
+            if (d2 > watch_radius2)
+                continue;
+            m_watched.push_back(is);
+            if (d2 <= radius2)
+                m_candidates.push_back(is);
+            seeds.push_back((is + 1) % num_shoes);
+            seeds.push_back((is + num_shoes - 1) % num_shoes);
+        }
+        std::sort(m_candidates.begin(), m_candidates.end());
+    }
+
+    if (full_scan) {
+        size_t num_walked = m_candidates.size();
+        m_candidates.clear();
+        m_watched.clear();
+        for (size_t is = 0; is < num_shoes; ++is) {
+            double d2 = distance2(is);
+            if (d2 <= watch_radius2)
+                m_watched.push_back(is);
+            if (d2 <= radius2)
+                m_candidates.push_back(is);
+        }
+        // The walk only selects shoes within range, so it found a subset of these.
+        if (walked)
+            m_num_missed += m_candidates.size() - num_walked;
+    }
+}
+
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 double ChSprocket::GetMass() const {
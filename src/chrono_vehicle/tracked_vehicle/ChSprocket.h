@@ -137,6 +137,33 @@ class CH_VEHICLE_API ChSprocket : public ChPart {
     /// Turn on/off collision flag for the gear wheel.
     void SetCollide(bool val) { m_gear->SetCollide(val); }
 
+    /// Enable/disable culling of the track shoes tested for contact with the gear (default: true).
+    /// The track shoes close to the gear form contiguous sequences of the track chain. With
+    /// culling, the search for these sequences starts from the shoes found near the gear at the
+    /// previous step and proceeds along the chain in both directions, instead of testing all
+    /// track shoes. A sequence that comes close to the gear away from the ones already tracked
+    /// is only found by the next full scan (see SetFullScanInterval).
+    void SetShoeCulling(bool val) { m_culling = val; }
+
+    /// Set the number of collision detection passes between two full scans of the track shoes,
+    /// with culling enabled (default: 10). A value of 1 tests all shoes at every pass.
+    void SetFullScanInterval(int val) { m_scan_interval = val; }
+
+    /// Get the number of candidate shoes that the full scans found and the search along the
+    /// chain had missed, since the start of the simulation.
+    size_t GetNumMissedCandidates() const { return m_num_missed; }
+
+    /// Select the track shoes that may be in contact with the gear.
+    /// A shoe is selected if its reference point is within the specified distance from the gear
+    /// axis. The selected shoes (sorted by index) are available through GetContactCandidates().
+    /// This function is called by the gear-shoe collision callbacks at each collision detection pass.
+    void SelectContactCandidates(ChTrackAssembly* track,  ///< [in] pointer to containing track assembly
+                                 double radius            ///< [in] culling distance from the gear axis
+                                 );
+
+    /// Get the indices of the track shoes selected at the last collision detection pass.
+    const std::vector<size_t>& GetContactCandidates() const { return m_candidates; }
+
     /// Get the mass of the sprocket subsystem.
     virtual double GetMass() const;
 
@@ -198,6 +225,14 @@ class CH_VEHICLE_API ChSprocket : public ChPart {
 
     ChSystem::ChCustomComputeCollisionCallback* m_callback;  ///< custom collision functor object
 
+    bool m_culling;                    ///< flag for culling of the track shoes tested for contact
+    std::vector<size_t> m_candidates;  ///< track shoes selected at the last collision detection pass
+    std::vector<size_t> m_watched;     ///< track shoes near the gear at the last pass (search seeds)
+    std::vector<size_t> m_visited;     ///< pass at which each track shoe was last visited
+    size_t m_pass;                     ///< current collision detection pass
+    int m_scan_interval;               ///< number of passes between two full scans
+    size_t m_num_missed;               ///< candidates missed by the search and found by full scans
+
     float m_friction;       ///< contact coefficient of friction
     float m_restitution;    ///< contact coefficient of restitution
     float m_young_modulus;  ///< contact material Young modulus
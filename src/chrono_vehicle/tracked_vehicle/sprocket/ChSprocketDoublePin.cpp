@@ -135,8 +135,12 @@ void SprocketDoublePinContactCB::PerformCustomCollision(ChSystem* system) {
     // Sprocket gear center location (expressed in global frame)
     ChVector<> locS_abs = m_sprocket->GetGearBody()->GetPos();
 
-    // Loop over all track shoes in the associated track
-    for (size_t is = 0; is < m_track->GetNumTrackShoes(); ++is) {
+    // Select the shoes close enough to the sprocket (the shoe reference point is at most
+    // one pitch away from the center of its connector bodies).
+    m_sprocket->SelectContactCandidates(m_track, m_R_sum + m_track->GetTrackShoe(0)->GetPitch());
+
+    // Loop over the candidate track shoes in the associated track
+    for (auto is : m_sprocket->GetContactCandidates()) {
         auto shoe = std::static_pointer_cast<ChTrackShoeDoublePin>(m_track->GetTrackShoe(is));
 
         // Perform collision test for the "left" connector body
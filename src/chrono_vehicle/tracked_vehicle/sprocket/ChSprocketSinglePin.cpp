@@ -111,8 +111,12 @@ void SprocketSinglePinContactCB::PerformCustomCollision(ChSystem* system) {
     // Sprocket gear center location (expressed in global frame)
     ChVector<> locS_abs = m_sprocket->GetGearBody()->GetPos();
 
-    // Loop over all shoes in the associated track.
-    for (size_t is = 0; is < m_track->GetNumTrackShoes(); ++is) {
+    // Select the shoes close enough to the sprocket (the contact cylinders are at most half a
+    // pitch away from the shoe reference point; a full pitch is used as a safety margin).
+    m_sprocket->SelectContactCandidates(m_track, m_R_sum + m_track->GetTrackShoe(0)->GetPitch());
+
+    // Loop over the candidate shoes in the associated track.
+    for (auto is : m_sprocket->GetContactCandidates()) {
         std::shared_ptr<ChTrackShoe> shoe = m_track->GetTrackShoe(is);
 
         // Calculate locations of the centers of the shoe's contact cylinders
@@ -0,0 +1,259 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Real-time execution of a fixed-step simulation loop, with deadline monitoring
+// and optional degradation of the simulation when it cannot keep up.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <thread>
+
+#include "chrono/assets/ChTriangleMeshShape.h"
+#include "chrono/core/ChException.h"
+
+#include "chrono_vehicle/terrain/DeformableTerrain.h"
+#include "chrono_vehicle/utils/ChRealtimeMonitor.h"
+
+namespace chrono {
+namespace vehicle {
+
+// -----------------------------------------------------------------------------
+// Default degradation policy for vehicle simulations
+// -----------------------------------------------------------------------------
+ChVehicleDegradationPolicy::ChVehicleDegradationPolicy(ChSystem* system)
+    : m_system(system),
+      m_terrain(nullptr),
+      m_level(0),
+      m_iters_factor(0.5),
+      m_vis_interval(4),
+      m_refinement(false),
+      m_bulldozing(false) {
+    m_iters_speed = system->GetMaxItersSolverSpeed();
+    m_iters_stab = system->GetMaxItersSolverStab();
+}
+
+void ChVehicleDegradationPolicy::SetTerrain(DeformableTerrain* terrain) {
+    m_terrain = terrain;
+    m_refinement = terrain->GetAutomaticRefinement();
+    m_bulldozing = terrain->GetBulldozingFlow();
+}
+
+void ChVehicleDegradationPolicy::SetLevel(int level) {
+    m_level = level;
+
+    if (level >= 1) {
+        m_system->SetMaxItersSolverSpeed(std::max(1, (int)std::ceil(m_iters_factor * m_iters_speed)));
+        m_system->SetMaxItersSolverStab(std::max(1, (int)std::ceil(m_iters_factor * m_iters_stab)));
+    } else {
+        m_system->SetMaxItersSolverSpeed(m_iters_speed);
+        m_system->SetMaxItersSolverStab(m_iters_stab);
+    }
+
+    if (m_terrain) {
+        m_terrain->SetAutomaticRefinement(level >= 3 ? false : m_refinement);
+        m_terrain->SetBulldozingFlow(level >= 3 ? false : m_bulldozing);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Real-time monitor
+// -----------------------------------------------------------------------------
+ChRealtimeMonitor::ChRealtimeMonitor(double period)
+    : m_period(period),
+      m_pacing(true),
+      m_busy_wait(0),
+      m_started(false),
+      m_degrade_misses(3),
+      m_recover_steps(1000),
+      m_recover_load(0.5),
+      m_level(0),
+      m_consecutive_misses(0),
+      m_consecutive_fast(0),
+      m_level_steps(1, 0) {
+    if (period <= 0)
+        throw ChException("ChRealtimeMonitor: the period must be positive");
+    SetHistogramBins(20);
+    ResetStats();
+}
+
+void ChRealtimeMonitor::SetDegradationPolicy(std::shared_ptr<ChRealtimeDegradationPolicy> policy,
+                                             int degrade_misses,
+                                             int recover_steps,
+                                             double recover_load) {
+    m_policy = policy;
+    m_degrade_misses = degrade_misses;
+    m_recover_steps = recover_steps;
+    m_recover_load = recover_load;
+    m_level_steps.assign(policy ? policy->GetMaxLevel() + 1 : 1, 0);
+    m_consecutive_misses = 0;
+    m_consecutive_fast = 0;
+    m_level = 0;
+    if (policy)
+        policy->SetLevel(0);
+}
+
+void ChRealtimeMonitor::SetHistogramBins(int num_bins) {
+    m_compute_hist.assign(num_bins + 1, 0);
+    m_jitter_hist.assign(num_bins + 1, 0);
+}
+
+void ChRealtimeMonitor::ResetStats() {
+    m_num_steps = 0;
+    m_num_misses = 0;
+    m_last_compute = 0;
+    m_max_compute = 0;
+    m_sum_compute = 0;
+    m_jitter = 0;
+    m_max_jitter = 0;
+    m_sum_jitter = 0;
+    std::fill(m_compute_hist.begin(), m_compute_hist.end(), 0);
+    std::fill(m_jitter_hist.begin(), m_jitter_hist.end(), 0);
+    std::fill(m_level_steps.begin(), m_level_steps.end(), 0);
+}
+
+void ChRealtimeMonitor::Start() {
+    ResetStats();
+    m_release = Clock::now();
+    m_started = true;
+}
+
+// Add a sample to a histogram with bins covering [0, range] and an overflow bin.
+void ChRealtimeMonitor::AddSample(std::vector<long>& hist, double value, double range) {
+    int num_bins = (int)hist.size() - 1;
+    int bin = (int)(value / range * num_bins);
+    hist[std::min(std::max(bin, 0), num_bins)]++;
+}
+
+// -----------------------------------------------------------------------------
+// Step bracketing
+// -----------------------------------------------------------------------------
+void ChRealtimeMonitor::BeginStep() {
+    if (!m_started)
+        Start();
+
+    m_begin = Clock::now();
+    if (!m_pacing)
+        m_release = m_begin;
+    m_jitter = std::max(0.0, Seconds(m_begin - m_release));
+}
+
+bool ChRealtimeMonitor::EndStep() {
+    Clock::time_point end = Clock::now();
+    Clock::time_point deadline = m_release + std::chrono::duration_cast<Clock::duration>(
+                                                 std::chrono::duration<double>(m_period));
+    bool missed = end > deadline;
+
+    // Statistics
+    double compute = Seconds(end - m_begin);
+    m_num_steps++;
+    m_last_compute = compute;
+    m_sum_compute += compute;
+    m_max_compute = std::max(m_max_compute, compute);
+    m_sum_jitter += m_jitter;
+    m_max_jitter = std::max(m_max_jitter, m_jitter);
+    AddSample(m_compute_hist, compute, 2 * m_period);
+    AddSample(m_jitter_hist, m_jitter, m_period);
+    m_level_steps[m_level]++;
+
+    // Degradation
+    if (missed) {
+        m_num_misses++;
+        m_consecutive_misses++;
+        m_consecutive_fast = 0;
+        if (m_policy && m_consecutive_misses >= m_degrade_misses && m_level < m_policy->GetMaxLevel())
+            SetLevel(m_level + 1);
+    } else {
+        m_consecutive_misses = 0;
+        if (compute < m_recover_load * m_period)
+            m_consecutive_fast++;
+        else
+            m_consecutive_fast = 0;
+        if (m_policy && m_consecutive_fast >= m_recover_steps && m_level > 0)
+            SetLevel(m_level - 1);
+    }
+
+    // Schedule the next step: at the end of this period, or now if the deadline was missed.
+    if (missed) {
+        m_release = end;
+        return false;
+    }
+
+    m_release = deadline;
+    if (m_pacing) {
+        if (m_busy_wait > 0) {
+            // Sleep until the busy-wait window, then spin until the deadline.
+            Clock::time_point wake = deadline - std::chrono::duration_cast<Clock::duration>(
+                                                    std::chrono::duration<double>(m_busy_wait));
+            std::this_thread::sleep_until(wake);
+            while (Clock::now() < deadline) {
+            }
+        } else {
+            std::this_thread::sleep_until(deadline);
+        }
+    }
+
+    return true;
+}
+
+void ChRealtimeMonitor::SetLevel(int level) {
+    m_level = level;
+    m_consecutive_misses = 0;
+    m_consecutive_fast = 0;
+    m_policy->SetLevel(level);
+}
+
+// -----------------------------------------------------------------------------
+// Report
+// -----------------------------------------------------------------------------
+void ChRealtimeMonitor::WriteReport(std::ostream& os) const {
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    os << std::fixed << std::setprecision(1);
+
+    os << "Real-time monitor: period " << 1e6 * m_period << " us, " << m_num_steps << " steps, " << m_num_misses
+       << " missed deadlines\n";
+    os << "  compute time (us): mean " << 1e6 * GetMeanComputeTime() << ", max " << 1e6 * m_max_compute << "\n";
+    os << "  jitter (us):       mean " << 1e6 * GetMeanJitter() << ", max " << 1e6 * m_max_jitter << "\n";
+
+    const std::vector<long>* hists[2] = {&m_compute_hist, &m_jitter_hist};
+    const char* names[2] = {"compute time", "jitter"};
+    double ranges[2] = {2 * m_period, m_period};
+    for (int h = 0; h < 2; h++) {
+        const std::vector<long>& hist = *hists[h];
+        int num_bins = (int)hist.size() - 1;
+        double width = ranges[h] / num_bins;
+        os << "  " << names[h] << " histogram (us):\n";
+        for (int i = 0; i < num_bins; i++) {
+            if (hist[i])
+                os << "    [" << std::setw(8) << 1e6 * i * width << ", " << std::setw(8) << 1e6 * (i + 1) * width
+                   << ")  " << hist[i] << "\n";
+        }
+        if (hist[num_bins])
+            os << "    [" << std::setw(8) << 1e6 * ranges[h] << ",      inf)  " << hist[num_bins] << "\n";
+    }
+
+    if (m_policy) {
+        os << "  steps per degradation level:";
+        for (size_t i = 0; i < m_level_steps.size(); i++)
+            os << " " << m_level_steps[i];
+        os << "\n";
+    }
+
+    os.flags(flags);
+    os.precision(precision);
+}
+
+}  // end namespace vehicle
+}  // end namespace chrono
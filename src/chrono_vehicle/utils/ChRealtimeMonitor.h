@@ -0,0 +1,223 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Real-time execution of a fixed-step simulation loop, with deadline monitoring
+// and optional degradation of the simulation when it cannot keep up.
+//
+// =============================================================================
+
+#ifndef CH_REALTIME_MONITOR_H
+#define CH_REALTIME_MONITOR_H
+
+#include <chrono>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include "chrono/physics/ChSystem.h"
+
+#include "chrono_vehicle/ChApiVehicle.h"
+
+namespace chrono {
+namespace vehicle {
+
+class DeformableTerrain;
+
+/// @addtogroup vehicle_utils
+/// @{
+
+/// Interface for a policy that degrades the simulation to keep up with real time.
+/// Level 0 is the nominal configuration; each higher level is cheaper than the previous one.
+class CH_VEHICLE_API ChRealtimeDegradationPolicy {
+  public:
+    virtual ~ChRealtimeDegradationPolicy() {}
+
+    /// Return the highest degradation level of this policy.
+    virtual int GetMaxLevel() const = 0;
+
+    /// Switch the simulation to the specified level (between 0 and GetMaxLevel()).
+    virtual void SetLevel(int level) = 0;
+};
+
+/// Default degradation policy for a vehicle simulation. Each level includes the previous ones:
+/// - level 1: fewer solver iterations (a fraction of the nominal number);
+/// - level 2: visualization (rendering, output of shapes) only every few frames;
+/// - level 3: no mesh refinement and no bulldozing on the deformable terrain (if any).
+class CH_VEHICLE_API ChVehicleDegradationPolicy : public ChRealtimeDegradationPolicy {
+  public:
+    /// Construct the policy for the specified system.
+    /// The current solver settings of the system are taken as the nominal ones.
+    ChVehicleDegradationPolicy(ChSystem* system);
+
+    /// Also coarsen the specified deformable terrain, at the highest level.
+    /// Its current settings are taken as the nominal ones.
+    void SetTerrain(DeformableTerrain* terrain);
+
+    /// Set the fraction of the nominal solver iterations used at level 1 and above (default: 0.5).
+    void SetSolverIterationsFactor(double factor) { m_iters_factor = factor; }
+
+    /// Set the number of frames between visualization frames at level 2 and above (default: 4).
+    void SetVisualizationInterval(int interval) { m_vis_interval = interval; }
+
+    /// Return true if the specified frame should be visualized at the current level.
+    bool IsVisualizationFrame(int frame) const { return m_level < 2 || frame % m_vis_interval == 0; }
+
+    /// Get the current level.
+    int GetLevel() const { return m_level; }
+
+    virtual int GetMaxLevel() const override { return 3; }
+    virtual void SetLevel(int level) override;
+
+  private:
+    ChSystem* m_system;
+    DeformableTerrain* m_terrain;
+    int m_level;
+
+    double m_iters_factor;
+    int m_vis_interval;
+
+    int m_iters_speed;  ///< nominal number of solver iterations (speed)
+    int m_iters_stab;   ///< nominal number of solver iterations (stabilization)
+    bool m_refinement;  ///< nominal terrain mesh refinement
+    bool m_bulldozing;  ///< nominal terrain bulldozing
+};
+
+/// Real-time execution monitor for a fixed-step simulation loop.
+/// Each step of the loop is bracketed by BeginStep() and EndStep(). The monitor measures
+/// the compute time of each step and checks it against its deadline, the end of the step
+/// period. In pacing mode (default), EndStep() also waits for the end of the period, so
+/// that the simulation advances at the pace of the wall clock. A step that ends after its
+/// deadline is a miss; the next step then starts immediately and the schedule is shifted
+/// (missed time is not caught up). The delay between the scheduled and the actual start
+/// of a step is its jitter.
+///
+/// If a degradation policy is set, the monitor raises its level after a number of
+/// consecutive misses, and lowers it again after a number of consecutive steps completed
+/// well within their deadline.
+class CH_VEHICLE_API ChRealtimeMonitor {
+  public:
+    /// Construct a monitor for steps of the specified period (in seconds).
+    ChRealtimeMonitor(double period);
+
+    /// Enable or disable pacing (default: enabled).
+    void SetPacing(bool val) { m_pacing = val; }
+
+    /// Set the time (in seconds) before the end of a period during which EndStep() busy-waits
+    /// instead of sleeping, to reduce jitter (default: 0).
+    void SetBusyWaitTime(double time) { m_busy_wait = time; }
+
+    /// Set the degradation policy and its triggers.
+    void SetDegradationPolicy(std::shared_ptr<ChRealtimeDegradationPolicy> policy,  ///< [in] degradation policy
+                              int degrade_misses = 3,     ///< [in] consecutive misses before raising the level
+                              int recover_steps = 1000,   ///< [in] consecutive fast steps before lowering the level
+                              double recover_load = 0.5   ///< [in] max. compute time of a fast step, per period
+                              );
+
+    /// Set the histograms of compute time and jitter (default: 20 bins).
+    /// The compute time bins cover the interval [0, 2 * period], the jitter bins the interval
+    /// [0, period]; a last, additional bin counts all larger values.
+    void SetHistogramBins(int num_bins);
+
+    /// Set the start of the first period to now.
+    /// Called by the first BeginStep() if not called explicitly.
+    void Start();
+
+    /// Mark the beginning of the computations of a step.
+    void BeginStep();
+
+    /// Mark the end of the computations of a step. Return false if the step missed its deadline.
+    bool EndStep();
+
+    /// Get the step period.
+    double GetPeriod() const { return m_period; }
+
+    /// Get the current degradation level.
+    int GetLevel() const { return m_level; }
+
+    /// Get the number of completed steps.
+    long GetNumSteps() const { return m_num_steps; }
+
+    /// Get the number of missed deadlines.
+    long GetNumMisses() const { return m_num_misses; }
+
+    /// Get the compute time of the last step.
+    double GetLastComputeTime() const { return m_last_compute; }
+
+    /// Get the maximum compute time of a step.
+    double GetMaxComputeTime() const { return m_max_compute; }
+
+    /// Get the average compute time of a step.
+    double GetMeanComputeTime() const { return m_num_steps ? m_sum_compute / m_num_steps : 0; }
+
+    /// Get the maximum jitter.
+    double GetMaxJitter() const { return m_max_jitter; }
+
+    /// Get the average jitter.
+    double GetMeanJitter() const { return m_num_steps ? m_sum_jitter / m_num_steps : 0; }
+
+    /// Get the histogram of compute times (see SetHistogramBins).
+    const std::vector<long>& GetComputeHistogram() const { return m_compute_hist; }
+
+    /// Get the histogram of jitter (see SetHistogramBins).
+    const std::vector<long>& GetJitterHistogram() const { return m_jitter_hist; }
+
+    /// Get the number of steps completed at each degradation level.
+    const std::vector<long>& GetLevelSteps() const { return m_level_steps; }
+
+    /// Reset all statistics (the degradation level is kept).
+    void ResetStats();
+
+    /// Write a summary of the statistics, with both histograms.
+    void WriteReport(std::ostream& os) const;
+
+  private:
+    typedef std::chrono::steady_clock Clock;
+
+    void SetLevel(int level);
+    static double Seconds(Clock::duration d) { return std::chrono::duration<double>(d).count(); }
+    static void AddSample(std::vector<long>& hist, double value, double range);
+
+    double m_period;
+    bool m_pacing;
+    double m_busy_wait;
+
+    bool m_started;
+    Clock::time_point m_release;  ///< scheduled start of the current step
+    Clock::time_point m_begin;    ///< actual start of the computations of the current step
+
+    std::shared_ptr<ChRealtimeDegradationPolicy> m_policy;
+    int m_degrade_misses;
+    int m_recover_steps;
+    double m_recover_load;
+    int m_level;
+    int m_consecutive_misses;
+    int m_consecutive_fast;
+
+    long m_num_steps;
+    long m_num_misses;
+    double m_last_compute;
+    double m_max_compute;
+    double m_sum_compute;
+    double m_jitter;
+    double m_max_jitter;
+    double m_sum_jitter;
+    std::vector<long> m_compute_hist;
+    std::vector<long> m_jitter_hist;
+    std::vector<long> m_level_steps;
+};
+
+/// @} vehicle_utils
+
+}  // end namespace vehicle
+}  // end namespace chrono
+
+#endif
@@ -0,0 +1,308 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Template for a tire model based on lookup tables of the steady-state tire
+// response (e.g. generated from runs of a high-fidelity FEA tire on a test rig).
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+
+#include "chrono/core/ChException.h"
+#include "chrono/physics/ChGlobal.h"
+
+#include "chrono_vehicle/wheeled_vehicle/tire/ChLookupTire.h"
+
+namespace chrono {
+namespace vehicle {
+
+// -----------------------------------------------------------------------------
+// Utility functions for table lookup
+// -----------------------------------------------------------------------------
+
+// Return true if the values are strictly increasing.
+static bool IsIncreasing(const std::vector<double>& v) {
+    for (size_t i = 1; i < v.size(); i++) {
+        if (v[i] <= v[i - 1])
+            return false;
+    }
+    return true;
+}
+
+// Find the grid interval [i, i+1] containing x and the interpolation weight of grid point i+1.
+// The value x is clamped to the grid range. For a grid with a single value, i = 0 and w = 0.
+static void FindInterval(const std::vector<double>& grid, double x, size_t& i, double& w) {
+    if (grid.size() == 1 || x <= grid.front()) {
+        i = 0;
+        w = 0;
+        return;
+    }
+    if (x >= grid.back()) {
+        i = grid.size() - 2;
+        w = 1;
+        return;
+    }
+    i = std::upper_bound(grid.begin(), grid.end(), x) - grid.begin() - 1;
+    w = (x - grid[i]) / (grid[i + 1] - grid[i]);
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+ChLookupTire::ChLookupTire(const std::string& name)
+    : ChTire(name), m_damping(0), m_relax_length_x(0), m_relax_length_y(0) {
+    m_tireforce.force = ChVector<>(0, 0, 0);
+    m_tireforce.point = ChVector<>(0, 0, 0);
+    m_tireforce.moment = ChVector<>(0, 0, 0);
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+void ChLookupTire::Initialize(std::shared_ptr<ChBody> wheel, VehicleSide side) {
+    ChTire::Initialize(wheel, side);
+
+    SetLookupParams();
+    CheckTables();
+
+    // Initialize contact patch state variables to 0.
+    m_data.in_contact = false;
+    m_data.normal_force = 0;
+    m_data.depth = 0;
+    m_states.kappa = 0;
+    m_states.tan_alpha = 0;
+    m_states.alpha = 0;
+    m_states.vx = 0;
+    m_states.abs_vx = 0;
+    m_states.vsx = 0;
+    m_states.vsy = 0;
+}
+
+void ChLookupTire::CheckTables() const {
+    if (m_Fz_grid.empty() || m_kappa_grid.empty() || m_alpha_grid.empty() || m_gamma_grid.empty())
+        throw ChException("ChLookupTire: empty table grid");
+
+    if (!IsIncreasing(m_Fz_grid) || !IsIncreasing(m_kappa_grid) || !IsIncreasing(m_alpha_grid) ||
+        !IsIncreasing(m_gamma_grid))
+        throw ChException("ChLookupTire: table grid values must be strictly increasing");
+
+    if (m_Fz_grid.front() <= 0)
+        throw ChException("ChLookupTire: normal loads must be positive");
+
+    if (m_deflection.size() != m_Fz_grid.size() || !IsIncreasing(m_deflection) || m_deflection.front() <= 0)
+        throw ChException("ChLookupTire: invalid vertical response table");
+
+    size_t size = m_Fz_grid.size() * m_kappa_grid.size() * m_alpha_grid.size() * m_gamma_grid.size();
+    if (m_Fx.size() != size || m_Fy.size() != size || m_Mx.size() != size || m_My.size() != size ||
+        m_Mz.size() != size)
+        throw ChException("ChLookupTire: response table size does not match its grid");
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+void ChLookupTire::AddVisualizationAssets(VisualizationType vis) {
+    if (vis == VisualizationType::NONE)
+        return;
+
+    m_cyl_shape = std::make_shared<ChCylinderShape>();
+    m_cyl_shape->GetCylinderGeometry().rad = GetRadius();
+    m_cyl_shape->GetCylinderGeometry().p1 = ChVector<>(0, GetVisualizationWidth() / 2, 0);
+    m_cyl_shape->GetCylinderGeometry().p2 = ChVector<>(0, -GetVisualizationWidth() / 2, 0);
+    m_wheel->AddAsset(m_cyl_shape);
+
+    m_texture = std::make_shared<ChTexture>();
+    m_texture->SetTextureFilename(GetChronoDataFile("greenwhite.png"));
+    m_wheel->AddAsset(m_texture);
+}
+
+void ChLookupTire::RemoveVisualizationAssets() {
+    // Make sure we only remove the assets added by ChLookupTire::AddVisualizationAssets.
+    // This is important for the ChTire object because a wheel may add its own assets
+    // to the same body (the spindle/wheel).
+    {
+        auto it = std::find(m_wheel->GetAssets().begin(), m_wheel->GetAssets().end(), m_cyl_shape);
+        if (it != m_wheel->GetAssets().end())
+            m_wheel->GetAssets().erase(it);
+    }
+    {
+        auto it = std::find(m_wheel->GetAssets().begin(), m_wheel->GetAssets().end(), m_texture);
+        if (it != m_wheel->GetAssets().end())
+            m_wheel->GetAssets().erase(it);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+void ChLookupTire::Synchronize(double time, const WheelState& wheel_state, const ChTerrain& terrain) {
+    // Invoke the base class function (calculates the camber angle).
+    ChTire::Synchronize(time, wheel_state, terrain);
+
+    // Clear the force accumulators and set the application point to the wheel center.
+    m_tireforce.force = ChVector<>(0, 0, 0);
+    m_tireforce.moment = ChVector<>(0, 0, 0);
+    m_tireforce.point = wheel_state.pos;
+
+    // Extract the wheel normal (expressed in global frame)
+    ChMatrix33<> A(wheel_state.rot);
+    ChVector<> disc_normal = A.Get_A_Yaxis();
+
+    // Assuming the tire is a disc, check contact with terrain
+    m_data.in_contact =
+        disc_terrain_contact(terrain, wheel_state.pos, disc_normal, m_unloaded_radius, m_data.frame, m_data.depth);
+
+    if (m_data.in_contact) {
+        // Wheel velocity in the contact frame
+        m_data.vel = m_data.frame.TransformDirectionParentToLocal(wheel_state.lin_vel);
+
+        // Normal force from the vertical response table, plus damping (a positive
+        // velocity means a decreasing depth). No force if the disc is moving away
+        // from the terrain so fast that the resulting force is negative.
+        double Fn = InterpolateNormalLoad(m_data.depth) - m_damping * m_data.vel.z;
+        m_data.normal_force = std::max(Fn, 0.0);
+
+        m_states.vx = m_data.vel.x;
+        m_states.abs_vx = std::abs(m_data.vel.x);
+        m_states.vsx = m_data.vel.x - wheel_state.omega * m_unloaded_radius;
+        m_states.vsy = m_data.vel.y;
+    } else {
+        // Reset all states if the tire comes off the ground.
+        m_data.normal_force = 0;
+        m_states.kappa = 0;
+        m_states.tan_alpha = 0;
+        m_states.alpha = 0;
+        m_states.vx = 0;
+        m_states.abs_vx = 0;
+        m_states.vsx = 0;
+        m_states.vsy = 0;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+void ChLookupTire::Advance(double step) {
+    // Nothing to do if not in contact (the tire force was reset in Synchronize()).
+    if (!m_data.in_contact)
+        return;
+
+    const double zero_vx = 1e-4;
+    double h = step;
+
+    // Longitudinal slip (steady-state value: -vsx / |vx|).
+    // The relaxation equation (linear) is integrated with the trapezoidal rule:
+    //   kappa_dot = -1/Lx * (vsx + |vx| * kappa)
+    if (m_relax_length_x > 0) {
+        m_states.kappa = ((2 * m_relax_length_x - h * m_states.abs_vx) * m_states.kappa - 2 * h * m_states.vsx) /
+                         (2 * m_relax_length_x + h * m_states.abs_vx);
+    } else {
+        m_states.kappa = (m_states.abs_vx > zero_vx) ? -m_states.vsx / m_states.abs_vx : 0;
+    }
+
+    // Slip angle (steady-state value: atan(vsy / |vx|)).
+    // The relaxation equation for tan(alpha) is integrated with the trapezoidal rule:
+    //   tan_alpha_dot = 1/Ly * (vsy - |vx| * tan_alpha)
+    if (m_relax_length_y > 0) {
+        m_states.tan_alpha =
+            ((2 * m_relax_length_y - h * m_states.abs_vx) * m_states.tan_alpha + 2 * h * m_states.vsy) /
+            (2 * m_relax_length_y + h * m_states.abs_vx);
+    } else {
+        m_states.tan_alpha = (m_states.abs_vx > zero_vx) ? m_states.vsy / m_states.abs_vx : 0;
+    }
+    m_states.alpha = std::atan(m_states.tan_alpha);
+
+    // Forces and moments at the contact point, in the contact frame.
+    ChVector<> force;
+    ChVector<> moment;
+    InterpolateResponse(m_data.normal_force, m_states.kappa, m_states.alpha, GetCamberAngle(), force, moment);
+
+    // The tables describe a tire rolling forward. When rolling backward, the rolling
+    // resistance moment and the aligning moment (due to the pneumatic trail) change sign.
+    if (m_states.vx < 0) {
+        moment.y = -moment.y;
+        moment.z = -moment.z;
+    }
+
+    // Rotate into global coordinates
+    m_tireforce.force = m_data.frame.TransformDirectionLocalToParent(force);
+    m_tireforce.moment = m_data.frame.TransformDirectionLocalToParent(moment);
+
+    // Move the tire forces from the contact patch to the wheel center
+    m_tireforce.moment +=
+        Vcross((m_data.frame.pos + m_data.depth * m_data.frame.rot.GetZaxis()) - m_tireforce.point, m_tireforce.force);
+}
+
+// -----------------------------------------------------------------------------
+// Piecewise linear interpolation of the vertical response table, through the
+// origin (no deflection, no load) and extrapolated with the last slope.
+// -----------------------------------------------------------------------------
+double ChLookupTire::InterpolateNormalLoad(double deflection) const {
+    size_t n = m_deflection.size();
+
+    if (n == 1 || deflection <= m_deflection[0])
+        return m_Fz_grid[0] * deflection / m_deflection[0];
+
+    size_t i = std::upper_bound(m_deflection.begin(), m_deflection.end(), deflection) - m_deflection.begin() - 1;
+    i = std::min(i, n - 2);
+
+    double slope = (m_Fz_grid[i + 1] - m_Fz_grid[i]) / (m_deflection[i + 1] - m_deflection[i]);
+    return m_Fz_grid[i] + slope * (deflection - m_deflection[i]);
+}
+
+// -----------------------------------------------------------------------------
+// Multi-linear interpolation of the steady-state response tables (interpolation
+// between the 16 table entries surrounding the current operating point).
+// -----------------------------------------------------------------------------
+void ChLookupTire::InterpolateResponse(double Fz,
+                                       double kappa,
+                                       double alpha,
+                                       double gamma,
+                                       ChVector<>& force,
+                                       ChVector<>& moment) const {
+    // Outside the range of normal loads, scale the response at the closest load.
+    double Fz_table = std::min(std::max(Fz, m_Fz_grid.front()), m_Fz_grid.back());
+    double scale = Fz / Fz_table;
+
+    size_t i[4];
+    double w[4];
+    FindInterval(m_Fz_grid, Fz_table, i[0], w[0]);
+    FindInterval(m_kappa_grid, kappa, i[1], w[1]);
+    FindInterval(m_alpha_grid, alpha, i[2], w[2]);
+    FindInterval(m_gamma_grid, gamma, i[3], w[3]);
+
+    double Fx = 0;
+    double Fy = 0;
+    double Mx = 0;
+    double My = 0;
+    double Mz = 0;
+
+    for (int corner = 0; corner < 16; corner++) {
+        size_t j[4];
+        double weight = 1;
+        for (int d = 0; d < 4; d++) {
+            bool upper = (corner & (1 << d)) != 0;
+            weight *= upper ? w[d] : 1 - w[d];
+            j[d] = upper ? i[d] + 1 : i[d];
+        }
+        if (weight == 0)
+            continue;
+        size_t k = GetTableIndex(j[0], j[1], j[2], j[3]);
+        Fx += weight * m_Fx[k];
+        Fy += weight * m_Fy[k];
+        Mx += weight * m_Mx[k];
+        My += weight * m_My[k];
+        Mz += weight * m_Mz[k];
+    }
+
+    force = ChVector<>(scale * Fx, scale * Fy, Fz);
+    moment = ChVector<>(scale * Mx, scale * My, scale * Mz);
+}
+
+}  // end namespace vehicle
+}  // end namespace chrono
@@ -0,0 +1,176 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Template for a tire model based on lookup tables of the steady-state tire
+// response (e.g. generated from runs of a high-fidelity FEA tire on a test rig).
+//
+// =============================================================================
+
+#ifndef CH_LOOKUPTIRE_H
+#define CH_LOOKUPTIRE_H
+
+#include <vector>
+
+#include "chrono/physics/ChBody.h"
+#include "chrono/assets/ChCylinderShape.h"
+#include "chrono/assets/ChTexture.h"
+
+#include "chrono_vehicle/wheeled_vehicle/ChTire.h"
+#include "chrono_vehicle/ChTerrain.h"
+
+namespace chrono {
+namespace vehicle {
+
+/// @addtogroup vehicle_wheeled_tire
+/// @{
+
+/// Lookup table tire model.
+/// The tire forces and moments are interpolated (multi-linear interpolation) in tables of the
+/// steady-state response of a tire, as functions of the normal load, longitudinal slip, slip
+/// angle, and camber angle. The normal load is obtained from the tire deflection, interpolated
+/// in a table of the vertical tire response, plus a damping term. The slip quantities follow
+/// the definitions of ChTire and are filtered with first-order relaxation equations.
+///
+/// The tables describe a tire rolling forward; when rolling backward, the rolling resistance
+/// and aligning moments change sign. The slip and camber angles are clamped to the ranges of
+/// the tables. Outside the range of the tables, the forces and moments are scaled with the
+/// normal load (from the lowest or highest load in the tables).
+class CH_VEHICLE_API ChLookupTire : public ChTire {
+  public:
+    ChLookupTire(const std::string& name  ///< [in] name of this tire system
+                 );
+
+    virtual ~ChLookupTire() {}
+
+    /// Initialize this tire system.
+    virtual void Initialize(std::shared_ptr<ChBody> wheel,  ///< [in] associated wheel body
+                            VehicleSide side                ///< [in] left/right vehicle side
+                            ) override;
+
+    /// Add visualization assets for the tire subsystem.
+    virtual void AddVisualizationAssets(VisualizationType vis) override;
+
+    /// Remove visualization assets for the tire subsystem.
+    virtual void RemoveVisualizationAssets() override;
+
+    /// Get the tire radius.
+    /// For a lookup tire, this is the unloaded tire radius.
+    virtual double GetRadius() const override { return m_unloaded_radius; }
+
+    /// Get the tire force and moment.
+    /// This represents the output from this tire system that is passed to the
+    /// vehicle system.  Typically, the vehicle subsystem will pass the tire force
+    /// to the appropriate suspension subsystem which applies it as an external
+    /// force one the wheel body.
+    virtual TireForce GetTireForce(bool cosim = false) const override { return m_tireforce; }
+
+    /// Update the state of this tire system at the current time.
+    /// The tire system is provided the current state of its associated wheel.
+    virtual void Synchronize(double time,                    ///< [in] current time
+                             const WheelState& wheel_state,  ///< [in] current state of associated wheel body
+                             const ChTerrain& terrain        ///< [in] reference to the terrain system
+                             ) override;
+
+    /// Advance the state of this tire by the specified time step.
+    virtual void Advance(double step) override;
+
+    /// Get the width of the tire.
+    double GetWidth() const { return m_width; }
+
+    /// Get visualization width.
+    virtual double GetVisualizationWidth() const { return m_width; }
+
+    /// Get the tire slip angle.
+    virtual double GetSlipAngle() const override { return m_states.alpha; }
+
+    /// Get the tire longitudinal slip.
+    virtual double GetLongitudinalSlip() const override { return m_states.kappa; }
+
+  protected:
+    /// Set the tire parameters and the response tables.
+    virtual void SetLookupParams() = 0;
+
+    /// Check the consistency of the response tables (called during initialization).
+    /// An exception is thrown if the tables are not consistent.
+    void CheckTables() const;
+
+    /// Return the index of the response table entry for the given grid indices.
+    size_t GetTableIndex(size_t iFz, size_t iK, size_t iA, size_t iG) const {
+        return ((iFz * m_kappa_grid.size() + iK) * m_alpha_grid.size() + iA) * m_gamma_grid.size() + iG;
+    }
+
+    /// Lookup tire model parameters
+    double m_unloaded_radius;  ///< unloaded tire radius
+    double m_width;            ///< tire width
+    double m_damping;          ///< vertical damping coefficient
+    double m_relax_length_x;   ///< longitudinal relaxation length (no relaxation if 0)
+    double m_relax_length_y;   ///< lateral relaxation length (no relaxation if 0)
+
+    /// Vertical response: tire deflection at each normal load of the grid (increasing).
+    std::vector<double> m_deflection;
+
+    /// Grids of the steady-state response tables (each increasing).
+    std::vector<double> m_Fz_grid;     ///< normal load
+    std::vector<double> m_kappa_grid;  ///< longitudinal slip
+    std::vector<double> m_alpha_grid;  ///< slip angle
+    std::vector<double> m_gamma_grid;  ///< camber angle
+
+    /// Steady-state response tables, with one entry for each combination of grid values
+    /// (in the order given by GetTableIndex). Forces and moments are expressed in the
+    /// contact frame and applied at the contact point.
+    std::vector<double> m_Fx;
+    std::vector<double> m_Fy;
+    std::vector<double> m_Mx;
+    std::vector<double> m_My;
+    std::vector<double> m_Mz;
+
+  private:
+    /// Interpolate the normal load for the specified deflection.
+    double InterpolateNormalLoad(double deflection) const;
+
+    /// Interpolate the forces and moments in the steady-state response tables.
+    void InterpolateResponse(double Fz, double kappa, double alpha, double gamma, ChVector<>& force, ChVector<>& moment)
+        const;
+
+    struct ContactData {
+        bool in_contact;      // true if disc in contact with terrain
+        ChCoordsys<> frame;   // contact frame (x: long, y: lat, z: normal)
+        ChVector<> vel;       // relative velocity expressed in contact frame
+        double normal_force;  // magnitude of normal contact force
+        double depth;         // penetration depth
+    };
+
+    struct TireStates {
+        double kappa;      // longitudinal slip
+        double tan_alpha;  // tangent of the slip angle
+        double alpha;      // slip angle
+        double vx;         // longitudinal velocity
+        double abs_vx;     // longitudinal speed
+        double vsx;        // longitudinal slip velocity
+        double vsy;        // lateral slip velocity
+    };
+
+    ContactData m_data;
+    TireStates m_states;
+
+    TireForce m_tireforce;
+
+    std::shared_ptr<ChCylinderShape> m_cyl_shape;  ///< visualization cylinder asset
+    std::shared_ptr<ChTexture> m_texture;          ///< visualization texture asset
+};
+
+/// @} vehicle_wheeled_tire
+
+}  // end namespace vehicle
+}  // end namespace chrono
+
+#endif
@@ -303,6 +303,23 @@ void ChPacejkaTire::Advance(double step) {
     ChTimer<double> advance_time;
     m_num_Advance_calls++;
 
+    // Update the slip quantities, then calculate the reactions
+    advance_slips(step, advance_time);
+    calc_reactions();
+
+    // all the reactions have been calculated, stop the advance timer
+    advance_time.stop();
+    m_sum_Advance_time += advance_time();
+
+    // DEBUGGING
+    // m_FM_combined.moment.y = 0;
+    // m_FM_combined.moment.z = 0;
+
+    // evaluate the reaction forces calculated
+    evaluate_reactions(false, false);
+}
+
+void ChPacejkaTire::advance_slips(double step, ChTimer<double>& advance_time) {
     // Do nothing if the wheel does not contact the terrain.  In this case, all
     // reported tire forces will be zero. Still have to update slip quantities, since
     // displacements won't go to zero imeediately
@@ -368,13 +385,17 @@ void ChPacejkaTire::Advance(double step) {
         */
 
     } else {
+        advance_time.start();
+
         // Calculate the vertical load and update tire deflection and rolling radius
         update_verticalLoad(step);
 
         // Calculate kinematic slip quantities
         slip_kinematic();
     }
+}
 
+void ChPacejkaTire::calc_reactions() {
     // Calculate the force and moment reaction, pure slip case
     pureSlipReactions();
 
@@ -392,17 +413,6 @@ void ChPacejkaTire::Advance(double step) {
     double My = calc_My(m_FM_combined.force.x);
     m_FM_pure.moment.y = My;
     m_FM_combined.moment.y = My;
-
-    // all the reactions have been calculated, stop the advance timer
-    advance_time.stop();
-    m_sum_Advance_time += advance_time();
-
-    // DEBUGGING
-    // m_FM_combined.moment.y = 0;
-    // m_FM_combined.moment.z = 0;
-
-    // evaluate the reaction forces calculated
-    evaluate_reactions(false, false);
 }
 
 void ChPacejkaTire::advance_tire(double step) {
@@ -24,6 +24,7 @@
 #include <sstream>
 #include <fstream>
 
+#include "chrono/core/ChTimer.h"
 #include "chrono/physics/ChBody.h"
 #include "chrono/assets/ChCylinderShape.h"
 #include "chrono/assets/ChTexture.h"
@@ -187,6 +188,8 @@ class CH_VEHICLE_API ChPacejkaTire : public ChTire {
     double GetStepsize() const { return m_step_size; }
 
   private:
+    friend class ChPacejkaTireBatch;
+
     // where to find the input parameter file
     const std::string& getPacTireParamFile() const { return m_paramFile; }
 
@@ -241,6 +244,13 @@ class CH_VEHICLE_API ChPacejkaTire : public ChTire {
 
     void advance_tire(double step);
 
+    // first stage of Advance(): update the vertical load and the slip quantities
+    // (kinematic or transient) over the time step; starts advance_time
+    void advance_slips(double step, ChTimer<double>& advance_time);
+
+    // second stage of Advance(): evaluate the Magic Formula reactions
+    void calc_reactions();
+
     // calculate transient slip properties, using first order ODEs to find slip
     // displacements from velocities
     // appends m_slips for the slip displacements, and integrated slip velocity terms
@@ -0,0 +1,512 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Batched evaluation of the Pacejka 2002 Magic Formula for a group of
+// ChPacejkaTire objects (e.g. all tires of one or more vehicles).
+//
+// The formulas below must be kept in sync with ChPacejkaTire: each loop
+// evaluates one of the ChPacejkaTire functions, with the same expressions in
+// the same order, for all tires in contact.
+//
+// =============================================================================
+
+#include <cmath>
+
+#include "chrono/core/ChException.h"
+#include "chrono/core/ChTimer.h"
+#include "chrono/parallel/ChOpenMP.h"
+
+#include "chrono_vehicle/wheeled_vehicle/tire/ChPacejkaTireBatch.h"
+
+// With vector math enabled (CMake option ENABLE_PACEJKA_VECTOR_MATH), this file is
+// compiled with -ffast-math and the Magic Formula loops are vectorized, including the
+// transcendental functions (SIMD variants from libmvec). The results then agree with
+// ChPacejkaTire to round-off only.
+#ifdef CH_PACEJKA_VECTOR_MATH
+#define CH_PACEJKA_SIMD _Pragma("omp simd")
+#else
+#define CH_PACEJKA_SIMD
+#endif
+
+namespace chrono {
+namespace vehicle {
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+ChPacejkaTireBatch::ChPacejkaTireBatch() : m_num_threads(CHOMPfunctions::GetNumProcs()) {}
+
+int ChPacejkaTireBatch::AddTire(std::shared_ptr<ChPacejkaTire> tire) {
+    if (!tire->m_params_defined)
+        throw ChException("ChPacejkaTireBatch: the tire must be initialized with valid parameters");
+    for (size_t i = 0; i < m_tires.size(); i++) {
+        if (m_tires[i] == tire)
+            throw ChException("ChPacejkaTireBatch: the tire is already in the batch");
+    }
+
+    m_tires.push_back(tire);
+    m_slip_time.push_back(0);
+    Resize(m_tires.size());
+
+    return (int)m_tires.size() - 1;
+}
+
+void ChPacejkaTireBatch::Resize(size_t n) {
+    m_lane_tire.resize(n);
+    m_params.resize(n);
+    m_zeta.resize(n);
+
+    std::vector<double>* arrays[] = {
+        &m_Fz,        &m_dF_z,      &m_R0,        &m_R_eff,     &m_omega,     &m_side,      &m_kappa,
+        &m_alpha,     &m_gamma,     &m_V_cx,      &m_cosPrime_alpha,          &m_Fx_pure,   &m_Fy_pure,
+        &m_Mz_pure,   &m_Fx_comb,   &m_Fy_comb,   &m_Mz_comb,   &m_Mx,        &m_My,        &m_S_Hx,
+        &m_kappa_x,   &m_mu_x,      &m_K_x,       &m_B_x,       &m_C_x,       &m_D_x,       &m_E_x,
+        &m_S_Vx,      &m_S_Hy,      &m_alpha_y,   &m_mu_y,      &m_K_y,       &m_S_Vy,      &m_B_y,
+        &m_C_y,       &m_D_y,       &m_E_y,       &m_S_Hf,      &m_alpha_r,   &m_S_Ht,      &m_alpha_t,
+        &m_B_r,       &m_C_r,       &m_D_r,       &m_B_t,       &m_C_t,       &m_D_t0,      &m_D_t,
+        &m_E_t,       &m_t,         &m_MP_z,      &m_M_zr,      &m_S_HxAlpha, &m_alpha_S,   &m_B_xAlpha,
+        &m_C_xAlpha,  &m_E_xAlpha,  &m_G_xAlpha0, &m_G_xAlpha,  &m_S_HyKappa, &m_kappa_S,   &m_B_yKappa,
+        &m_C_yKappa,  &m_E_yKappa,  &m_D_VyKappa, &m_S_VyKappa, &m_G_yKappa0, &m_G_yKappa,  &m_FP_y,
+        &m_s,         &m_alpha_t_eq, &m_alpha_r_eq, &m_M_zr_comb, &m_t_comb,  &m_M_z_x,     &m_M_z_y};
+    for (size_t i = 0; i < sizeof(arrays) / sizeof(arrays[0]); i++)
+        arrays[i]->resize(n);
+}
+
+// -----------------------------------------------------------------------------
+// Advance all tires: same sequence as ChPacejkaTire::Advance, with the Magic
+// Formula evaluated for all tires in contact at once.
+// -----------------------------------------------------------------------------
+void ChPacejkaTireBatch::Advance(double step) {
+    int num_tires = (int)m_tires.size();
+
+    // Update the vertical load and the slip quantities of each tire.
+#pragma omp parallel for num_threads(m_num_threads) schedule(dynamic, 1)
+    for (int i = 0; i < num_tires; i++) {
+        ChPacejkaTire& tire = *m_tires[i];
+        ChTimer<double> advance_time;
+        tire.m_num_Advance_calls++;
+        tire.advance_slips(step, advance_time);
+        if (!tire.m_in_contact)
+            tire.calc_reactions();
+        advance_time.stop();
+        m_slip_time[i] = advance_time();
+    }
+
+    ChTimer<double> reactions_time;
+    reactions_time.start();
+
+    // Gather the inputs of the tires in contact.
+    int n = 0;
+    for (int i = 0; i < num_tires; i++) {
+        const ChPacejkaTire& tire = *m_tires[i];
+        if (!tire.m_in_contact)
+            continue;
+        m_lane_tire[n] = i;
+        m_params[n] = tire.m_params;
+        m_zeta[n] = tire.m_zeta;
+        m_Fz[n] = tire.m_Fz;
+        m_dF_z[n] = tire.m_dF_z;
+        m_R0[n] = tire.m_R0;
+        m_R_eff[n] = tire.m_R_eff;
+        m_omega[n] = tire.m_tireState.omega;
+        m_side[n] = tire.m_sameSide;
+        m_kappa[n] = tire.m_slip->kappaP;
+        m_alpha[n] = tire.m_slip->alphaP;
+        m_gamma[n] = tire.m_slip->gammaP;
+        m_V_cx[n] = tire.m_slip->V_cx;
+        m_cosPrime_alpha[n] = tire.m_slip->cosPrime_alpha;
+        n++;
+    }
+
+    // Evaluate the Magic Formula.
+    PureSlipReactions(n);
+    CombinedSlipReactions(n);
+
+    // Scatter the reactions and intermediate factors back to the tires.
+    for (int k = 0; k < n; k++) {
+        ChPacejkaTire& tire = *m_tires[m_lane_tire[k]];
+
+        tire.m_FM_pure.force.x = m_Fx_pure[k];
+        tire.m_FM_pure.force.y = m_Fy_pure[k];
+        tire.m_FM_pure.moment.x = m_Mx[k];
+        tire.m_FM_pure.moment.y = m_My[k];
+        tire.m_FM_pure.moment.z = m_Mz_pure[k];
+
+        tire.m_FM_combined.force.x = m_Fx_comb[k];
+        tire.m_FM_combined.force.y = m_Fy_comb[k];
+        tire.m_FM_combined.moment.x = m_Mx[k];
+        tire.m_FM_combined.moment.y = m_My[k];
+        tire.m_FM_combined.moment.z = m_Mz_comb[k];
+
+        {
+            pureLongCoefs tmp = {m_S_Hx[k], m_kappa_x[k], m_mu_x[k], m_K_x[k], m_B_x[k],
+                                 m_C_x[k],  m_D_x[k],     m_E_x[k],  m_Fx_pure[k], m_S_Vx[k]};
+            *tire.m_pureLong = tmp;
+        }
+        {
+            pureLatCoefs tmp = {m_S_Hy[k], m_alpha_y[k], m_mu_y[k], m_K_y[k], m_S_Vy[k],
+                                m_B_y[k],  m_C_y[k],     m_D_y[k],  m_E_y[k]};
+            *tire.m_pureLat = tmp;
+        }
+        {
+            pureTorqueCoefs tmp = {m_S_Hf[k], m_alpha_r[k], m_S_Ht[k], m_alpha_t[k], m_cosPrime_alpha[k], m_K_y[k],
+                                   m_B_r[k],  m_C_r[k],     m_D_r[k],  m_B_t[k],     m_C_t[k],             m_D_t0[k],
+                                   m_D_t[k],  m_E_t[k],     m_t[k],    m_MP_z[k],    m_M_zr[k]};
+            *tire.m_pureTorque = tmp;
+        }
+        {
+            combinedLongCoefs tmp = {m_S_HxAlpha[k], m_alpha_S[k],   m_B_xAlpha[k], m_C_xAlpha[k],
+                                     m_E_xAlpha[k],  m_G_xAlpha0[k], m_G_xAlpha[k]};
+            *tire.m_combinedLong = tmp;
+        }
+        {
+            combinedLatCoefs tmp = {m_S_HyKappa[k], m_kappa_S[k],   m_B_yKappa[k],  m_C_yKappa[k], m_E_yKappa[k],
+                                    m_D_VyKappa[k], m_S_VyKappa[k], m_G_yKappa0[k], m_G_yKappa[k]};
+            *tire.m_combinedLat = tmp;
+        }
+        {
+            combinedTorqueCoefs tmp = {m_cosPrime_alpha[k], m_FP_y[k],   m_s[k],     m_alpha_t_eq[k],
+                                       m_alpha_r_eq[k],     m_M_zr_comb[k], m_t_comb[k], m_M_z_x[k],
+                                       m_M_z_y[k]};
+            *tire.m_combinedTorque = tmp;
+        }
+    }
+
+    reactions_time.stop();
+
+    // Finish the step of each tire; the time spent on the Magic Formula is shared
+    // evenly among the tires in contact.
+    double lane_time = (n > 0) ? reactions_time() / n : 0;
+    for (int i = 0; i < num_tires; i++) {
+        ChPacejkaTire& tire = *m_tires[i];
+        tire.m_sum_Advance_time += m_slip_time[i] + (tire.m_in_contact ? lane_time : 0);
+        tire.evaluate_reactions(false, false);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Pure slip reactions (ChPacejkaTire::pureSlipReactions).
+// -----------------------------------------------------------------------------
+void ChPacejkaTireBatch::PureSlipReactions(int n) {
+    // Longitudinal force (ChPacejkaTire::Fx_pureLong)
+    CH_PACEJKA_SIMD
+    for (int k = 0; k < n; k++) {
+        const Pac2002_data& p = *m_params[k];
+        const zetaCoefs& zeta = *m_zeta[k];
+        double Fz = m_Fz[k];
+        double dF_z = m_dF_z[k];
+        double gamma = m_gamma[k];
+
+        double eps_x = 0;
+        double S_Hx = (p.longitudinal.phx1 + p.longitudinal.phx2 * dF_z) * p.scaling.lhx;
+        double kappa_x = m_kappa[k] + S_Hx;
+
+        double mu_x = (p.longitudinal.pdx1 + p.longitudinal.pdx2 * dF_z) *
+                      (1.0 - p.longitudinal.pdx3 * pow(gamma, 2)) * p.scaling.lmux;
+        double K_x = Fz * (p.longitudinal.pkx1 + p.longitudinal.pkx2 * dF_z) * exp(p.longitudinal.pkx3 * dF_z) *
+                     p.scaling.lkx;
+        double C_x = p.longitudinal.pcx1 * p.scaling.lcx;
+        double D_x = mu_x * Fz * zeta.z1;
+        double B_x = K_x / (C_x * D_x + eps_x);
+
+        double sign_kap = (kappa_x >= 0) ? 1 : -1;
+
+        double E_x =
+            (p.longitudinal.pex1 + p.longitudinal.pex2 * dF_z + p.longitudinal.pex3 * pow(dF_z, 2)) *
+            (1.0 - p.longitudinal.pex4 * sign_kap) * p.scaling.lex;
+        double S_Vx = Fz * (p.longitudinal.pvx1 + p.longitudinal.pvx2 * dF_z) * p.scaling.lvx * p.scaling.lmux *
+                      zeta.z1;
+
+        m_S_Hx[k] = S_Hx;
+        m_kappa_x[k] = kappa_x;
+        m_mu_x[k] = mu_x;
+        m_K_x[k] = K_x;
+        m_B_x[k] = B_x;
+        m_C_x[k] = C_x;
+        m_D_x[k] = D_x;
+        m_E_x[k] = E_x;
+        m_S_Vx[k] = S_Vx;
+    }
+    CH_PACEJKA_SIMD
+    for (int k = 0; k < n; k++) {
+        double Bk = m_B_x[k] * m_kappa_x[k];
+        m_Fx_pure[k] = m_D_x[k] * std::sin(m_C_x[k] * std::atan(Bk - m_E_x[k] * (Bk - std::atan(Bk)))) - m_S_Vx[k];
+    }
+
+    // Lateral force (ChPacejkaTire::Fy_pureLat)
+    CH_PACEJKA_SIMD
+    for (int k = 0; k < n; k++) {
+        const Pac2002_data& p = *m_params[k];
+        const zetaCoefs& zeta = *m_zeta[k];
+        double Fz = m_Fz[k];
+        double dF_z = m_dF_z[k];
+        double gamma = m_gamma[k];
+
+        double C_y = p.lateral.pcy1 * p.scaling.lcy;
+        double mu_y =
+            (p.lateral.pdy1 + p.lateral.pdy2 * dF_z) * (1.0 - p.lateral.pdy3 * pow(gamma, 2)) * p.scaling.lmuy;
+        double D_y = mu_y * Fz * zeta.z2;
+
+        double K_y = p.lateral.pky1 * p.vertical.fnomin *
+                     std::sin(2.0 * std::atan(Fz / (p.lateral.pky2 * p.vertical.fnomin))) *
+                     (1.0 - p.lateral.pky3 * std::abs(gamma)) * zeta.z3 * p.scaling.lyka;
+        double B_y = K_y / (C_y * D_y);
+
+        double S_Hy = (p.lateral.phy1 + p.lateral.phy2 * dF_z) * p.scaling.lhy + (p.lateral.phy3 * gamma * zeta.z0) +
+                      zeta.z4 - 1;
+
+        double alpha_y = m_alpha[k] + S_Hy;
+
+        int sign_alpha = (alpha_y >= 0) ? 1 : -1;
+
+        double E_y = (p.lateral.pey1 + p.lateral.pey2 * dF_z) *
+                     (1.0 - (p.lateral.pey3 + p.lateral.pey4 * gamma) * sign_alpha) * p.scaling.ley;
+        double S_Vy = Fz * ((p.lateral.pvy1 + p.lateral.pvy2 * dF_z) * p.scaling.lvy +
+                            (p.lateral.pvy3 + p.lateral.pvy4 * dF_z) * gamma) *
+                      p.scaling.lmuy * zeta.z2;
+
+        m_S_Hy[k] = S_Hy;
+        m_alpha_y[k] = alpha_y;
+        m_mu_y[k] = mu_y;
+        m_K_y[k] = K_y;
+        m_S_Vy[k] = S_Vy;
+        m_B_y[k] = B_y;
+        m_C_y[k] = C_y;
+        m_D_y[k] = D_y;
+        m_E_y[k] = E_y;
+    }
+    CH_PACEJKA_SIMD
+    for (int k = 0; k < n; k++) {
+        double Ba = m_B_y[k] * m_alpha_y[k];
+        double F_y = m_D_y[k] * std::sin(m_C_y[k] * std::atan(Ba - m_E_y[k] * (Ba - std::atan(Ba)))) + m_S_Vy[k];
+        m_Fy_pure[k] = m_side[k] * F_y;
+    }
+
+    // Aligning moment (ChPacejkaTire::Mz_pureLat)
+    CH_PACEJKA_SIMD
+    for (int k = 0; k < n; k++) {
+        const Pac2002_data& p = *m_params[k];
+        const zetaCoefs& zeta = *m_zeta[k];
+        double Fz = m_Fz[k];
+        double dF_z = m_dF_z[k];
+        double R0 = m_R0[k];
+        double alpha = m_alpha[k];
+        double gamma = m_gamma[k];
+
+        int sign_Vx = (m_V_cx[k] >= 0) ? 1 : -1;
+
+        double S_Hf = m_S_Hy[k] + m_S_Vy[k] / m_K_y[k];
+        double alpha_r = alpha + S_Hf;
+        double S_Ht = p.aligning.qhz1 + p.aligning.qhz2 * dF_z + (p.aligning.qhz3 + p.aligning.qhz4 * dF_z) * gamma;
+        double alpha_t = alpha + S_Ht;
+
+        double B_r =
+            (p.aligning.qbz9 * (p.scaling.lky / p.scaling.lmuy) + p.aligning.qbz10 * m_B_y[k] * m_C_y[k]) * zeta.z6;
+        double C_r = zeta.z7;
+        double D_r = Fz * R0 * ((p.aligning.qdz6 + p.aligning.qdz7 * dF_z) * p.scaling.lres +
+                                (p.aligning.qdz8 + p.aligning.qdz9 * dF_z) * gamma) *
+                         p.scaling.lmuy * m_cosPrime_alpha[k] * sign_Vx +
+                     zeta.z8 - 1.0;
+        double B_t = (p.aligning.qbz1 + p.aligning.qbz2 * dF_z + p.aligning.qbz3 * pow(dF_z, 2)) *
+                     (1.0 + p.aligning.qbz4 * gamma + p.aligning.qbz5 * std::abs(gamma)) * p.scaling.lvyka /
+                     p.scaling.lmuy;
+        double C_t = p.aligning.qcz1;
+        double D_t0 = Fz * (R0 / p.vertical.fnomin) * (p.aligning.qdz1 + p.aligning.qdz2 * dF_z) * sign_Vx;
+        double D_t = D_t0 * (1.0 + p.aligning.qdz3 * std::abs(gamma) + p.aligning.qdz4 * pow(gamma, 2)) * zeta.z5 *
+                     p.scaling.ltr;
+
+        m_S_Hf[k] = S_Hf;
+        m_alpha_r[k] = alpha_r;
+        m_S_Ht[k] = S_Ht;
+        m_alpha_t[k] = alpha_t;
+        m_B_r[k] = B_r;
+        m_C_r[k] = C_r;
+        m_D_r[k] = D_r;
+        m_B_t[k] = B_t;
+        m_C_t[k] = C_t;
+        m_D_t0[k] = D_t0;
+        m_D_t[k] = D_t;
+    }
+    CH_PACEJKA_SIMD
+    for (int k = 0; k < n; k++) {
+        const Pac2002_data& p = *m_params[k];
+        double B_t = m_B_t[k];
+        double C_t = m_C_t[k];
+        double alpha_t = m_alpha_t[k];
+        double dF_z = m_dF_z[k];
+
+        double E_t = (p.aligning.qez1 + p.aligning.qez2 * dF_z + p.aligning.qez3 * pow(dF_z, 2)) *
+                     (1.0 + (p.aligning.qez4 + p.aligning.qez5 * m_gamma[k]) * (2.0 / chrono::CH_C_PI) *
+                                std::atan(B_t * C_t * alpha_t));
+        double t = m_D_t[k] *
+                   std::cos(C_t * std::atan(B_t * alpha_t - E_t * (B_t * alpha_t - std::atan(B_t * alpha_t)))) *
+                   m_cosPrime_alpha[k];
+
+        double MP_z = -t * (m_side[k] * m_Fy_pure[k]);
+        double M_zr = m_D_r[k] * std::cos(m_C_r[k] * std::atan(m_B_r[k] * m_alpha_r[k]));
+
+        m_E_t[k] = E_t;
+        m_t[k] = t;
+        m_MP_z[k] = MP_z;
+        m_M_zr[k] = M_zr;
+        m_Mz_pure[k] = m_side[k] * (MP_z + M_zr);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Combined slip reactions (ChPacejkaTire::combinedSlipReactions), followed by
+// the overturning and rolling resistance moments.
+// -----------------------------------------------------------------------------
+void ChPacejkaTireBatch::CombinedSlipReactions(int n) {
+    // Longitudinal force (ChPacejkaTire::Fx_combined)
+    CH_PACEJKA_SIMD
+    for (int k = 0; k < n; k++) {
+        const Pac2002_data& p = *m_params[k];
+        double rbx3 = 1.0;
+
+        double S_HxAlpha = p.longitudinal.rhx1;
+        double alpha_S = m_alpha[k] + S_HxAlpha;
+        double B_xAlpha = (p.longitudinal.rbx1 + rbx3 * pow(m_gamma[k], 2)) *
+                          std::cos(std::atan(p.longitudinal.rbx2 * m_kappa[k])) * p.scaling.lxal;
+        double C_xAlpha = p.longitudinal.rcx1;
+        double E_xAlpha = p.longitudinal.rex1 + p.longitudinal.rex2 * m_dF_z[k];
+
+        double G_xAlpha0 =
+            std::cos(C_xAlpha *
+                     std::atan(B_xAlpha * S_HxAlpha - E_xAlpha * (B_xAlpha * S_HxAlpha - std::atan(B_xAlpha * S_HxAlpha))));
+        double G_xAlpha =
+            std::cos(C_xAlpha *
+                     std::atan(B_xAlpha * alpha_S - E_xAlpha * (B_xAlpha * alpha_S - std::atan(B_xAlpha * alpha_S)))) /
+            G_xAlpha0;
+
+        m_S_HxAlpha[k] = S_HxAlpha;
+        m_alpha_S[k] = alpha_S;
+        m_B_xAlpha[k] = B_xAlpha;
+        m_C_xAlpha[k] = C_xAlpha;
+        m_E_xAlpha[k] = E_xAlpha;
+        m_G_xAlpha0[k] = G_xAlpha0;
+        m_G_xAlpha[k] = G_xAlpha;
+        m_Fx_comb[k] = G_xAlpha * m_Fx_pure[k];
+    }
+
+    // Lateral force (ChPacejkaTire::Fy_combined)
+    CH_PACEJKA_SIMD
+    for (int k = 0; k < n; k++) {
+        const Pac2002_data& p = *m_params[k];
+        const zetaCoefs& zeta = *m_zeta[k];
+        double dF_z = m_dF_z[k];
+        double alpha = m_alpha[k];
+        double gamma = m_gamma[k];
+        double kappa = m_kappa[k];
+        double rby4 = 0;
+
+        double S_HyKappa = p.lateral.rhy1 + p.lateral.rhy2 * dF_z;
+        double kappa_S = kappa + S_HyKappa;
+        double B_yKappa = (p.lateral.rby1 + rby4 * pow(gamma, 2)) *
+                          std::cos(std::atan(p.lateral.rby2 * (alpha - p.lateral.rby3))) * p.scaling.lyka;
+        double C_yKappa = p.lateral.rcy1;
+        double E_yKappa = p.lateral.rey1 + p.lateral.rey2 * dF_z;
+        double D_VyKappa = m_mu_y[k] * m_Fz[k] * (p.lateral.rvy1 + p.lateral.rvy2 * dF_z + p.lateral.rvy3 * gamma) *
+                           std::cos(std::atan(p.lateral.rvy4 * alpha)) * zeta.z2;
+        double S_VyKappa =
+            D_VyKappa * std::sin(p.lateral.rvy5 * std::atan(p.lateral.rvy6 * kappa)) * p.scaling.lvyka;
+        double G_yKappa0 =
+            std::cos(C_yKappa *
+                     std::atan(B_yKappa * S_HyKappa - E_yKappa * (B_yKappa * S_HyKappa - std::atan(B_yKappa * S_HyKappa))));
+        double G_yKappa =
+            std::cos(C_yKappa *
+                     std::atan(B_yKappa * kappa_S - E_yKappa * (B_yKappa * kappa_S - std::atan(B_yKappa * kappa_S)))) /
+            G_yKappa0;
+
+        m_S_HyKappa[k] = S_HyKappa;
+        m_kappa_S[k] = kappa_S;
+        m_B_yKappa[k] = B_yKappa;
+        m_C_yKappa[k] = C_yKappa;
+        m_E_yKappa[k] = E_yKappa;
+        m_D_VyKappa[k] = D_VyKappa;
+        m_S_VyKappa[k] = S_VyKappa;
+        m_G_yKappa0[k] = G_yKappa0;
+        m_G_yKappa[k] = G_yKappa;
+        m_Fy_comb[k] = m_side[k] * (G_yKappa * (m_side[k] * m_Fy_pure[k]) + S_VyKappa);
+    }
+
+    // Aligning moment (ChPacejkaTire::Mz_combined)
+    CH_PACEJKA_SIMD
+    for (int k = 0; k < n; k++) {
+        const Pac2002_data& p = *m_params[k];
+        double alpha_r = m_alpha_r[k];
+        double alpha_t = m_alpha_t[k];
+        double kappa = m_kappa[k];
+        double Fx_combined = m_Fx_comb[k];
+        double Fy_combined = m_side[k] * m_Fy_comb[k];
+
+        double FP_y = Fy_combined - m_S_VyKappa[k];
+        double s = m_R0[k] *
+                   (p.aligning.ssz1 + p.aligning.ssz2 * (Fy_combined / p.vertical.fnomin) +
+                    (p.aligning.ssz3 + p.aligning.ssz4 * m_dF_z[k]) * m_gamma[k]) *
+                   p.scaling.ls;
+        int sign_alpha_t = (alpha_t >= 0) ? 1 : -1;
+        int sign_alpha_r = (alpha_r >= 0) ? 1 : -1;
+
+        double alpha_t_eq = sign_alpha_t * sqrt(pow(alpha_t, 2) + pow(m_K_x[k] / m_K_y[k], 2) * pow(kappa, 2));
+        double alpha_r_eq = sign_alpha_r * sqrt(pow(alpha_r, 2) + pow(m_K_x[k] / m_K_y[k], 2) * pow(kappa, 2));
+
+        m_FP_y[k] = FP_y;
+        m_s[k] = s;
+        m_alpha_t_eq[k] = alpha_t_eq;
+        m_alpha_r_eq[k] = alpha_r_eq;
+    }
+    CH_PACEJKA_SIMD
+    for (int k = 0; k < n; k++) {
+        double B_t = m_B_t[k];
+        double E_t = m_E_t[k];
+        double alpha_t_eq = m_alpha_t_eq[k];
+
+        double M_zr = m_D_r[k] * std::cos(m_C_r[k] * std::atan(m_B_r[k] * m_alpha_r_eq[k])) * m_cosPrime_alpha[k];
+        double t =
+            m_D_t[k] *
+            std::cos(m_C_t[k] * std::atan(B_t * alpha_t_eq - E_t * (B_t * alpha_t_eq - std::atan(B_t * alpha_t_eq)))) *
+            m_cosPrime_alpha[k];
+
+        double M_z_y = -t * m_FP_y[k];
+        double M_z_x = m_s[k] * m_Fx_comb[k];
+
+        m_M_zr_comb[k] = M_zr;
+        m_t_comb[k] = t;
+        m_M_z_x[k] = M_z_x;
+        m_M_z_y[k] = M_z_y;
+        m_Mz_comb[k] = m_side[k] * (M_z_y + M_zr + M_z_x);
+    }
+
+    // Overturning and rolling resistance moments (ChPacejkaTire::calc_Mx and calc_My,
+    // called with the same arguments as in ChPacejkaTire::calc_reactions)
+    CH_PACEJKA_SIMD
+    for (int k = 0; k < n; k++) {
+        const Pac2002_data& p = *m_params[k];
+        double Fz = m_Fz[k];
+        double R0 = m_R0[k];
+
+        double gamma = m_side[k] * m_Fy_comb[k];
+        double Fy_combined = m_gamma[k];
+        double M_x = Fz * R0 * (p.overturning.qsx1 - p.overturning.qsx2 * gamma +
+                                p.overturning.qsx3 * (Fy_combined / p.vertical.fnomin)) *
+                     p.scaling.lmx;
+        m_Mx[k] = m_side[k] * M_x;
+
+        double V_r = m_omega[k] * m_R_eff[k];
+        m_My[k] = -Fz * R0 * (p.rolling.qsy1 * std::atan(V_r / p.model.longvl) +
+                              p.rolling.qsy2 * (m_Fx_comb[k] / p.vertical.fnomin)) *
+                  p.scaling.lmy;
+    }
+}
+
+}  // end namespace vehicle
+}  // end namespace chrono
@@ -0,0 +1,109 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Batched evaluation of the Pacejka 2002 Magic Formula for a group of
+// ChPacejkaTire objects (e.g. all tires of one or more vehicles).
+//
+// =============================================================================
+
+#ifndef CH_PACEJKATIRE_BATCH_H
+#define CH_PACEJKATIRE_BATCH_H
+
+#include <vector>
+
+#include "chrono_vehicle/ChApiVehicle.h"
+#include "chrono_vehicle/wheeled_vehicle/tire/ChPacejkaTire.h"
+
+namespace chrono {
+namespace vehicle {
+
+/// @addtogroup vehicle_wheeled_tire
+/// @{
+
+/// Batch of Pacejka tires advanced together.
+/// Advance() produces the same results as calling ChPacejkaTire::Advance() on each tire
+/// of the batch. The slip quantities of the tires are updated first (concurrently), then
+/// the Magic Formula reactions of all tires in contact are evaluated in a structure of
+/// arrays layout, one formula at a time across all tires, which lets the compiler
+/// vectorize the arithmetic. By default, the transcendental functions are evaluated with
+/// the same scalar calls as ChPacejkaTire, so that the results of both paths are identical
+/// (given the same compiler flags). With the CMake option ENABLE_PACEJKA_VECTOR_MATH (GCC),
+/// they are vectorized too, and the results agree with ChPacejkaTire to round-off only.
+/// Each tire must be synchronized as usual before the batch is advanced, and must not be
+/// advanced on its own while it belongs to the batch.
+class CH_VEHICLE_API ChPacejkaTireBatch {
+  public:
+    ChPacejkaTireBatch();
+
+    ~ChPacejkaTireBatch() {}
+
+    /// Add an initialized tire to the batch and return its index.
+    int AddTire(std::shared_ptr<ChPacejkaTire> tire);
+
+    /// Get the number of tires in the batch.
+    int GetNumTires() const { return (int)m_tires.size(); }
+
+    /// Get the specified tire.
+    std::shared_ptr<ChPacejkaTire> GetTire(int i) const { return m_tires[i]; }
+
+    /// Set the number of threads used to update the tire slips (default: number of processors).
+    void SetNumThreads(int num_threads) { m_num_threads = num_threads; }
+
+    /// Advance the state of all tires by the specified time step.
+    void Advance(double step);
+
+  private:
+    /// Evaluate the pure slip reactions of all tires in contact
+    /// (see ChPacejkaTire::Fx_pureLong, Fy_pureLat, Mz_pureLat).
+    void PureSlipReactions(int n);
+
+    /// Evaluate the combined slip reactions of all tires in contact
+    /// (see ChPacejkaTire::Fx_combined, Fy_combined, Mz_combined, calc_Mx, calc_My).
+    void CombinedSlipReactions(int n);
+
+    /// Resize all arrays to the specified number of tires.
+    void Resize(size_t n);
+
+    std::vector<std::shared_ptr<ChPacejkaTire> > m_tires;
+    std::vector<double> m_slip_time;  ///< time spent in the slip update of each tire
+    int m_num_threads;
+
+    // Tires in contact at the current step: one array entry per tire
+    std::vector<int> m_lane_tire;               ///< index of the tire
+    std::vector<const Pac2002_data*> m_params;  ///< model parameters
+    std::vector<const zetaCoefs*> m_zeta;       ///< spin slip coefficients
+
+    // Inputs
+    std::vector<double> m_Fz, m_dF_z, m_R0, m_R_eff, m_omega, m_side;
+    std::vector<double> m_kappa, m_alpha, m_gamma, m_V_cx, m_cosPrime_alpha;
+
+    // Outputs
+    std::vector<double> m_Fx_pure, m_Fy_pure, m_Mz_pure;
+    std::vector<double> m_Fx_comb, m_Fy_comb, m_Mz_comb, m_Mx, m_My;
+
+    // Intermediate factors (same as in the corresponding ChPacejkaTire structures)
+    std::vector<double> m_S_Hx, m_kappa_x, m_mu_x, m_K_x, m_B_x, m_C_x, m_D_x, m_E_x, m_S_Vx;
+    std::vector<double> m_S_Hy, m_alpha_y, m_mu_y, m_K_y, m_S_Vy, m_B_y, m_C_y, m_D_y, m_E_y;
+    std::vector<double> m_S_Hf, m_alpha_r, m_S_Ht, m_alpha_t, m_B_r, m_C_r, m_D_r;
+    std::vector<double> m_B_t, m_C_t, m_D_t0, m_D_t, m_E_t, m_t, m_MP_z, m_M_zr;
+    std::vector<double> m_S_HxAlpha, m_alpha_S, m_B_xAlpha, m_C_xAlpha, m_E_xAlpha, m_G_xAlpha0, m_G_xAlpha;
+    std::vector<double> m_S_HyKappa, m_kappa_S, m_B_yKappa, m_C_yKappa, m_E_yKappa, m_D_VyKappa, m_S_VyKappa,
+        m_G_yKappa0, m_G_yKappa;
+    std::vector<double> m_FP_y, m_s, m_alpha_t_eq, m_alpha_r_eq, m_M_zr_comb, m_t_comb, m_M_z_x, m_M_z_y;
+};
+
+/// @} vehicle_wheeled_tire
+
+}  // end namespace vehicle
+}  // end namespace chrono
+
+#endif
@@ -0,0 +1,138 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Lookup table tire constructed with data from file (JSON format).
+//
+// =============================================================================
+
+#include <algorithm>
+
+#include "chrono_vehicle/wheeled_vehicle/tire/LookupTire.h"
+#include "chrono_vehicle/ChVehicleModelData.h"
+
+#include "chrono_thirdparty/rapidjson/filereadstream.h"
+
+using namespace rapidjson;
+
+namespace chrono {
+namespace vehicle {
+
+// -----------------------------------------------------------------------------
+// This utility function returns a vector of doubles from the specified JSON array
+// -----------------------------------------------------------------------------
+static std::vector<double> loadArray(const Value& a) {
+    assert(a.IsArray());
+
+    std::vector<double> v(a.Size());
+    for (SizeType i = 0; i < a.Size(); i++)
+        v[i] = a[i].GetDouble();
+    return v;
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+LookupTire::LookupTire(const std::string& filename) : ChLookupTire(""), m_has_mesh(false) {
+    FILE* fp = fopen(filename.c_str(), "r");
+
+    char readBuffer[65536];
+    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
+
+    fclose(fp);
+
+    Document d;
+    d.ParseStream(is);
+
+    Create(d);
+
+    GetLog() << "Loaded JSON: " << filename.c_str() << "\n";
+}
+
+LookupTire::LookupTire(const rapidjson::Document& d) : ChLookupTire(""), m_has_mesh(false) {
+    Create(d);
+}
+
+LookupTire::~LookupTire() {
+}
+
+void LookupTire::Create(const rapidjson::Document& d) {
+    // Read top-level data
+    assert(d.HasMember("Type"));
+    assert(d.HasMember("Template"));
+    assert(d.HasMember("Name"));
+
+    SetName(d["Name"].GetString());
+
+    // Read in tire parameters
+    assert(d.HasMember("Lookup Parameters"));
+    m_unloaded_radius = d["Lookup Parameters"]["Unloaded Radius"].GetDouble();
+    m_width = d["Lookup Parameters"]["Width"].GetDouble();
+    m_damping = d["Lookup Parameters"]["Vertical Damping"].GetDouble();
+    m_relax_length_x = d["Lookup Parameters"]["X Relaxation Length"].GetDouble();
+    m_relax_length_y = d["Lookup Parameters"]["Y Relaxation Length"].GetDouble();
+
+    // Read in the response tables
+    assert(d.HasMember("Lookup Table"));
+    const Value& table = d["Lookup Table"];
+    m_Fz_grid = loadArray(table["Normal Force"]);
+    m_kappa_grid = loadArray(table["Longitudinal Slip"]);
+    m_alpha_grid = loadArray(table["Slip Angle"]);
+    m_gamma_grid = loadArray(table["Camber Angle"]);
+    m_deflection = loadArray(table["Deflection"]);
+    m_Fx = loadArray(table["Fx"]);
+    m_Fy = loadArray(table["Fy"]);
+    m_Mx = loadArray(table["Mx"]);
+    m_My = loadArray(table["My"]);
+    m_Mz = loadArray(table["Mz"]);
+
+    m_visualization_width = m_width;
+
+    // Check how to visualize this tire.
+    if (d.HasMember("Visualization")) {
+        if (d["Visualization"].HasMember("Mesh Filename")) {
+            m_meshFile = d["Visualization"]["Mesh Filename"].GetString();
+            m_meshName = d["Visualization"]["Mesh Name"].GetString();
+            m_has_mesh = true;
+        }
+
+        if (d["Visualization"].HasMember("Width")) {
+            m_visualization_width = d["Visualization"]["Width"].GetDouble();
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+void LookupTire::AddVisualizationAssets(VisualizationType vis) {
+    if (vis == VisualizationType::MESH && m_has_mesh) {
+        geometry::ChTriangleMeshConnected trimesh;
+        trimesh.LoadWavefrontMesh(vehicle::GetDataFile(m_meshFile), false, false);
+        m_trimesh_shape = std::make_shared<ChTriangleMeshShape>();
+        m_trimesh_shape->SetMesh(trimesh);
+        m_trimesh_shape->SetName(m_meshName);
+        m_wheel->AddAsset(m_trimesh_shape);
+    } else {
+        ChLookupTire::AddVisualizationAssets(vis);
+    }
+}
+
+void LookupTire::RemoveVisualizationAssets() {
+    ChLookupTire::RemoveVisualizationAssets();
+
+    // Make sure we only remove the assets added by LookupTire::AddVisualizationAssets.
+    // This is important for the ChTire object because a wheel may add its own assets
+    // to the same body (the spindle/wheel).
+    auto it = std::find(m_wheel->GetAssets().begin(), m_wheel->GetAssets().end(), m_trimesh_shape);
+    if (it != m_wheel->GetAssets().end())
+        m_wheel->GetAssets().erase(it);
+}
+
+}  // end namespace vehicle
+}  // end namespace chrono
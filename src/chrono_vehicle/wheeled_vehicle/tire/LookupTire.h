@@ -0,0 +1,69 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Lookup table tire constructed with data from file (JSON format).
+//
+// =============================================================================
+
+#ifndef LOOKUP_TIRE_H
+#define LOOKUP_TIRE_H
+
+#include "chrono/assets/ChTriangleMeshShape.h"
+
+#include "chrono_vehicle/ChApiVehicle.h"
+#include "chrono_vehicle/wheeled_vehicle/tire/ChLookupTire.h"
+
+#include "chrono_thirdparty/rapidjson/document.h"
+
+namespace chrono {
+namespace vehicle {
+
+/// @addtogroup vehicle_wheeled_tire
+/// @{
+
+/// Lookup table tire constructed with data from file (JSON format).
+/// Besides the tire parameters ("Lookup Parameters"), the file contains a "Lookup Table"
+/// object with the grids "Normal Force", "Longitudinal Slip", "Slip Angle" and "Camber Angle",
+/// the tire "Deflection" at each normal load, and the tables "Fx", "Fy", "Mx", "My" and "Mz"
+/// as flat arrays with the camber angle varying fastest and the normal load slowest.
+/// Such a file can be generated from runs of any tire model on a test rig (see the program
+/// test_VEH_tireLookupTable).
+class CH_VEHICLE_API LookupTire : public ChLookupTire {
+  public:
+    LookupTire(const std::string& filename);
+    LookupTire(const rapidjson::Document& d);
+    ~LookupTire();
+
+    virtual void SetLookupParams() override {}
+
+    virtual double GetVisualizationWidth() const override { return m_visualization_width; }
+
+    virtual void AddVisualizationAssets(VisualizationType vis) override;
+    virtual void RemoveVisualizationAssets() override final;
+
+  private:
+    void Create(const rapidjson::Document& d);
+
+    bool m_has_mesh;
+    std::string m_meshName;
+    std::string m_meshFile;
+    std::shared_ptr<ChTriangleMeshShape> m_trimesh_shape;
+
+    double m_visualization_width;
+};
+
+/// @} vehicle_wheeled_tire
+
+}  // end namespace vehicle
+}  // end namespace chrono
+
+#endif
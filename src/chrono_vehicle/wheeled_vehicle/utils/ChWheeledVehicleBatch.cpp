@@ -0,0 +1,124 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Utility class for advancing a batch of independent wheeled vehicles, each
+// with its own system, in parallel on a shared terrain.
+//
+// =============================================================================
+
+#include "chrono/core/ChException.h"
+#include "chrono/parallel/ChOpenMP.h"
+
+#include "chrono_vehicle/wheeled_vehicle/utils/ChWheeledVehicleBatch.h"
+
+namespace chrono {
+namespace vehicle {
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+ChWheeledVehicleBatch::ChWheeledVehicleBatch(ChTerrain& terrain)
+    : m_terrain(terrain), m_num_threads(CHOMPfunctions::GetNumProcs()), m_time(0) {}
+
+// -----------------------------------------------------------------------------
+// Add a vehicle. Two vehicles in the same system cannot be advanced concurrently.
+// -----------------------------------------------------------------------------
+int ChWheeledVehicleBatch::AddVehicle(std::shared_ptr<ChWheeledVehicle> vehicle,
+                                      std::shared_ptr<ChPowertrain> powertrain,
+                                      const std::vector<std::shared_ptr<ChTire> >& tires,
+                                      std::shared_ptr<ChDriver> driver) {
+    for (size_t i = 0; i < m_members.size(); i++) {
+        if (m_members[i].vehicle->GetSystem() == vehicle->GetSystem())
+            throw ChException("ChWheeledVehicleBatch: each vehicle must have its own system");
+    }
+    if ((int)tires.size() != 2 * vehicle->GetNumberAxles())
+        throw ChException("ChWheeledVehicleBatch: the vehicle needs one tire per wheel");
+
+    if (m_members.empty())
+        m_time = vehicle->GetChTime();
+
+    Member member;
+    member.vehicle = vehicle;
+    member.powertrain = powertrain;
+    member.tires = tires;
+    member.driver = driver;
+    member.tire_forces.resize(tires.size());
+    member.wheel_states.resize(tires.size());
+    member.batched_tires.resize(tires.size());
+    for (size_t i = 0; i < tires.size(); i++) {
+        if (auto pacejka = std::dynamic_pointer_cast<ChPacejkaTire>(tires[i])) {
+            m_pacejka_tires.AddTire(pacejka);
+            member.batched_tires[i] = true;
+        }
+    }
+    m_members.push_back(member);
+
+    return (int)m_members.size() - 1;
+}
+
+// -----------------------------------------------------------------------------
+// Advance all vehicles. The vehicles share nothing but the terrain, which is only
+// read while they are advanced.
+// -----------------------------------------------------------------------------
+void ChWheeledVehicleBatch::Advance(double step) {
+    m_terrain.Synchronize(m_time);
+
+    int num_members = (int)m_members.size();
+#pragma omp parallel for num_threads(m_num_threads) schedule(dynamic, 1)
+    for (int i = 0; i < num_members; i++)
+        AdvanceMember(m_members[i], step);
+    m_pacejka_tires.Advance(step);
+
+    m_terrain.Advance(step);
+    m_time += step;
+}
+
+// -----------------------------------------------------------------------------
+// Exchange data between the systems of one vehicle, then advance them (same
+// sequence as in a single-vehicle simulation loop). The Pacejka tires are
+// advanced later, together with those of the other vehicles.
+// -----------------------------------------------------------------------------
+void ChWheeledVehicleBatch::AdvanceMember(Member& member, double step) {
+    ChWheeledVehicle& vehicle = *member.vehicle;
+    ChPowertrain& powertrain = *member.powertrain;
+
+    // Collect output data from modules (for inter-module communication)
+    double throttle_input = member.driver ? member.driver->GetThrottle() : 0;
+    double steering_input = member.driver ? member.driver->GetSteering() : 0;
+    double braking_input = member.driver ? member.driver->GetBraking() : 0;
+    double powertrain_torque = powertrain.GetOutputTorque();
+    double driveshaft_speed = vehicle.GetDriveshaftSpeed();
+    for (size_t i = 0; i < member.tires.size(); i++) {
+        member.tire_forces[i] = member.tires[i]->GetTireForce();
+        member.wheel_states[i] = vehicle.GetWheelState((int)i);
+    }
+
+    // Update modules (process inputs from other modules)
+    double time = vehicle.GetChTime();
+    if (member.driver)
+        member.driver->Synchronize(time);
+    powertrain.Synchronize(time, throttle_input, driveshaft_speed);
+    vehicle.Synchronize(time, steering_input, braking_input, powertrain_torque, member.tire_forces);
+    for (size_t i = 0; i < member.tires.size(); i++)
+        member.tires[i]->Synchronize(time, member.wheel_states[i], m_terrain);
+
+    // Advance simulation for one timestep for all modules
+    if (member.driver)
+        member.driver->Advance(step);
+    powertrain.Advance(step);
+    vehicle.Advance(step);
+    for (size_t i = 0; i < member.tires.size(); i++) {
+        if (!member.batched_tires[i])
+            member.tires[i]->Advance(step);
+    }
+}
+
+}  // end namespace vehicle
+}  // end namespace chrono
@@ -0,0 +1,122 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Utility class for advancing a batch of independent wheeled vehicles, each
+// with its own system, in parallel on a shared terrain.
+//
+// =============================================================================
+
+#ifndef CH_WHEELED_VEHICLE_BATCH_H
+#define CH_WHEELED_VEHICLE_BATCH_H
+
+#include <vector>
+
+#include "chrono_vehicle/ChApiVehicle.h"
+#include "chrono_vehicle/ChDriver.h"
+#include "chrono_vehicle/ChPowertrain.h"
+#include "chrono_vehicle/ChTerrain.h"
+#include "chrono_vehicle/wheeled_vehicle/ChTire.h"
+#include "chrono_vehicle/wheeled_vehicle/ChWheeledVehicle.h"
+#include "chrono_vehicle/wheeled_vehicle/tire/ChPacejkaTireBatch.h"
+
+namespace chrono {
+namespace vehicle {
+
+/// @addtogroup vehicle_wheeled_utils
+/// @{
+
+/// Batch of independent wheeled vehicles, advanced in parallel on a shared terrain.
+/// Each vehicle must be constructed in its own ChSystem, so that the vehicles can be
+/// stepped concurrently (one thread per vehicle); as a consequence, there is no contact
+/// between the vehicles of a batch. The terrain is synchronized and advanced once per
+/// step, and queried concurrently by the tires in between, so it must support concurrent
+/// calls of its const functions (as RigidTerrain and FlatTerrain do). This makes the batch
+/// suited to vehicles with semi-empirical tires (e.g. ChPacejkaTire, ChFialaTire, ChLugreTire),
+/// which interact with the terrain only through height and normal queries.
+/// The Pacejka tires of all vehicles are advanced together, in a ChPacejkaTireBatch.
+class CH_VEHICLE_API ChWheeledVehicleBatch {
+  public:
+    /// Construct an empty batch on the specified terrain.
+    ChWheeledVehicleBatch(ChTerrain& terrain  ///< [in] terrain shared by all vehicles
+                          );
+
+    ~ChWheeledVehicleBatch() {}
+
+    /// Add a vehicle to the batch and return its index.
+    /// The vehicle and its subsystems must be already initialized. The tires are given in
+    /// wheel order (see WheelID). If no driver is specified, all driver inputs are 0.
+    int AddVehicle(std::shared_ptr<ChWheeledVehicle> vehicle,            ///< [in] vehicle, in its own system
+                   std::shared_ptr<ChPowertrain> powertrain,             ///< [in] powertrain of the vehicle
+                   const std::vector<std::shared_ptr<ChTire> >& tires,  ///< [in] tires, one per wheel
+                   std::shared_ptr<ChDriver> driver = nullptr            ///< [in] driver of the vehicle
+                   );
+
+    /// Get the number of vehicles in the batch.
+    int GetNumVehicles() const { return (int)m_members.size(); }
+
+    /// Get the specified vehicle.
+    std::shared_ptr<ChWheeledVehicle> GetVehicle(int i) const { return m_members[i].vehicle; }
+
+    /// Get the powertrain of the specified vehicle.
+    std::shared_ptr<ChPowertrain> GetPowertrain(int i) const { return m_members[i].powertrain; }
+
+    /// Get the tires of the specified vehicle.
+    const std::vector<std::shared_ptr<ChTire> >& GetTires(int i) const { return m_members[i].tires; }
+
+    /// Get the driver of the specified vehicle (possibly empty).
+    std::shared_ptr<ChDriver> GetDriver(int i) const { return m_members[i].driver; }
+
+    /// Set the number of threads used to advance the vehicles (default: number of processors).
+    /// With a single thread, the vehicles are advanced one after the other.
+    void SetNumThreads(int num_threads) {
+        m_num_threads = num_threads;
+        m_pacejka_tires.SetNumThreads(num_threads);
+    }
+
+    /// Get the number of threads used to advance the vehicles.
+    int GetNumThreads() const { return m_num_threads; }
+
+    /// Get the current time of the batch.
+    double GetChTime() const { return m_time; }
+
+    /// Advance all vehicles by the specified time step.
+    /// The terrain is synchronized, then each vehicle (driver, powertrain, tires and vehicle
+    /// systems) is synchronized and advanced, concurrently with the others, then the Pacejka
+    /// tires of all vehicles are advanced, then the terrain is advanced.
+    void Advance(double step);
+
+  private:
+    struct Member {
+        std::shared_ptr<ChWheeledVehicle> vehicle;
+        std::shared_ptr<ChPowertrain> powertrain;
+        std::vector<std::shared_ptr<ChTire> > tires;
+        std::shared_ptr<ChDriver> driver;
+        TireForces tire_forces;
+        WheelStates wheel_states;
+        std::vector<bool> batched_tires;  ///< tires advanced in the Pacejka tire batch
+    };
+
+    /// Synchronize and advance the systems of one vehicle.
+    void AdvanceMember(Member& member, double step);
+
+    ChTerrain& m_terrain;
+    std::vector<Member> m_members;
+    ChPacejkaTireBatch m_pacejka_tires;
+    int m_num_threads;
+    double m_time;
+};
+
+/// @} vehicle_wheeled_utils
+
+}  // end namespace vehicle
+}  // end namespace chrono
+
+#endif
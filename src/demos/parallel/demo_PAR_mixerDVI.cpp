@@ -27,6 +27,7 @@
 #include <stdio.h>
 #include <vector>
 #include <cmath>
+#include <string>
 
 #include "chrono_parallel/physics/ChSystemParallel.h"
 
@@ -178,6 +179,10 @@ int main(int argc, char* argv[]) {
   uint max_iteration = 30;
   real tolerance = 1e-3;
 
+  // Use the block-Jacobi preconditioner in the solver. Pass "precondition" on
+  // the command line to compare against the unpreconditioned solve.
+  bool precondition = (argc > 1 && std::string(argv[1]) == "precondition");
+
   // Create system
   // -------------
 
@@ -202,6 +207,7 @@ int main(int argc, char* argv[]) {
   msystem.GetSettings()->solver.tolerance = tolerance;
   msystem.GetSettings()->solver.alpha = 0;
   msystem.GetSettings()->solver.contact_recovery_speed = 10000;
+  msystem.GetSettings()->solver.precondition = precondition;
   msystem.ChangeSolverType(APGD);
   msystem.GetSettings()->collision.narrowphase_algorithm = NARROWPHASE_HYBRID_MPR;
 
@@ -241,6 +247,9 @@ int main(int argc, char* argv[]) {
   int out_steps = std::ceil((1 / time_step) / out_fps);
   int out_frame = 0;
   double time = 0;
+  double solver_time = 0;
+  double residual = 0;
+  int iterations = 0;
   for (int i = 0; i < num_steps; i++) {
     if (i % out_steps == 0) {
       OutputData(&msystem, out_frame, time);
@@ -248,7 +257,15 @@ int main(int argc, char* argv[]) {
     }
     msystem.DoStepDynamics(time_step);
     time += time_step;
+    solver_time += msystem.GetTimerSolver();
+    iterations += msystem.data_manager->measures.solver.total_iteration;
+    residual += msystem.data_manager->measures.solver.residual;
   }
+
+  std::cout << "Preconditioning: " << (precondition ? "block-Jacobi" : "none") << std::endl;
+  std::cout << "Solver time:     " << solver_time << std::endl;
+  std::cout << "Iterations/step: " << double(iterations) / num_steps << std::endl;
+  std::cout << "Residual/step:   " << residual / num_steps << std::endl;
 #endif
 
   return 0;
@@ -76,6 +76,7 @@ bool verbose = true;                        // verbose output?
 void RunModel(solver_type solver,              // use MKL solver (if available)
               bool use_adaptiveStep,     // allow step size reduction
               bool use_modifiedNewton,   // use modified Newton method
+              bool use_batchedKernel,    // use batched Gauss point kernel for internal forces
               const std::string& suffix  // output filename suffix
 ) {
 
@@ -101,6 +102,7 @@ void RunModel(solver_type solver,              // use MKL solver (if available)
     cout << endl;
     cout << "Adaptive step:   " << (use_adaptiveStep ? "Yes" : "No") << endl;
     cout << "Modified Newton: " << (use_modifiedNewton ? "Yes" : "No") << endl;
+    cout << "Batched kernel:  " << (use_batchedKernel ? "Yes" : "No") << endl;
     cout << endl;
     cout << "Mesh divisions:  " << numDiv_x << " x " << numDiv_y << endl;
     cout << endl;
@@ -181,6 +183,7 @@ void RunModel(solver_type solver,              // use MKL solver (if available)
                                                           // Set other element properties
         element->SetAlphaDamp(0.0);   // Structural damping for this
         element->SetGravityOn(true);  // element calculates its own gravitational load
+        element->SetBatchedGaussPoints(use_batchedKernel);
                                       // Add element to mesh
         my_mesh->AddElement(element);
     }
@@ -511,22 +514,26 @@ int main(int argc, char* argv[]) {
 
     // Run simulations.
 #ifdef CHRONO_SUPERLUMT
-    RunModel(solver_type::SUPERLUMT, true, false, "SUPERLUMT_adaptive_full");     // MKL, adaptive step, full Newton
-    RunModel(solver_type::SUPERLUMT, true, true, "SUPERLUMT_adaptive_modified");  // MKL, adaptive step, modified Newton
+    RunModel(solver_type::SUPERLUMT, true, false, true, "SUPERLUMT_adaptive_full");     // MKL, adaptive step, full Newton
+    RunModel(solver_type::SUPERLUMT, true, true, true, "SUPERLUMT_adaptive_modified");  // MKL, adaptive step, modified Newton
 #endif
 
 #ifdef CHRONO_MKL
-    RunModel(solver_type::MKL, true, false, "MKL_adaptive_full");     // MKL, adaptive step, full Newton
-    RunModel(solver_type::MKL, true, true, "MKL_adaptive_modified");  // MKL, adaptive step, modified Newton
+    RunModel(solver_type::MKL, true, false, true, "MKL_adaptive_full");     // MKL, adaptive step, full Newton
+    RunModel(solver_type::MKL, true, true, true, "MKL_adaptive_modified");  // MKL, adaptive step, modified Newton
 #endif
 
 #ifdef CHRONO_MUMPS
-    RunModel(solver_type::MUMPS, true, false, "MUMPS_adaptive_full");     // MUMPS, adaptive step, full Newton
-    RunModel(solver_type::MUMPS, true, true, "MUMPS_adaptive_modified");  // MUMPS, adaptive step, modified Newton
+    RunModel(solver_type::MUMPS, true, false, true, "MUMPS_adaptive_full");     // MUMPS, adaptive step, full Newton
+    RunModel(solver_type::MUMPS, true, true, true, "MUMPS_adaptive_modified");  // MUMPS, adaptive step, modified Newton
 #endif
 
-    RunModel(solver_type::MINRES, true, false, "MINRES_adaptive_full");     // MINRES, adaptive step, full Newton
-    RunModel(solver_type::MINRES, true, true, "MINRES_adaptive_modified");  // MINRES, adaptive step, modified Newton
+    RunModel(solver_type::MINRES, true, false, true, "MINRES_adaptive_full");     // MINRES, adaptive step, full Newton
+    RunModel(solver_type::MINRES, true, true, true, "MINRES_adaptive_modified");  // MINRES, adaptive step, modified Newton
+
+    // Same as above, but using the generic quadrature functors for the internal forces
+    RunModel(solver_type::MINRES, true, false, false, "MINRES_adaptive_full_functor");
+    RunModel(solver_type::MINRES, true, true, false, "MINRES_adaptive_modified_functor");
 
     return 0;
 }
@@ -58,6 +58,23 @@ class BaseNode {
     /// Get the cumulative simulation time on this node.
     double GetTotalSimTime() const { return m_cum_sim_time; }
 
+    /// Get the cumulative time this node spent waiting for data from other nodes.
+    double GetTotalWaitTime() const { return m_cum_wait_time; }
+
+    /// Set the coupling lag, in co-simulation steps (0 or 1, default: 0).
+    /// With a lag of 0, the nodes are coupled in lock-step: at each synchronization, a node
+    /// waits for the data the other nodes computed at the same time. With a lag of 1 (Jacobi-style
+    /// coupling), a node uses the data the other nodes sent at the previous synchronization, so
+    /// that all nodes compute concurrently. All nodes must use the same lag.
+    void SetCouplingLag(int lag) { m_lag = (lag > 0) ? 1 : 0; }
+
+    /// Get the coupling lag.
+    int GetCouplingLag() const { return m_lag; }
+
+    /// Enable/disable linear extrapolation of the lagged coupling forces (default: false).
+    /// Only used with a coupling lag of 1.
+    void EnableForceExtrapolation(bool val) { m_extrapolate = val; }
+
     /// Initialize this node.
     /// This function allows the node to initialize itself and, optionally, perform an
     /// initial data exchange with any other node.
@@ -74,6 +91,12 @@ class BaseNode {
     /// integration steps as required, but no inter-node communication should occur.
     virtual void Advance(double step_size) = 0;
 
+    /// Finalize this node.
+    /// This function is called after the last step to allow the node to complete any
+    /// pending data exchange with other nodes (with lagged coupling, the data sent at the
+    /// last synchronization).
+    virtual void Finalize() {}
+
     /// Output logging and debugging data.
     virtual void OutputData(int frame) {}
 
@@ -92,6 +115,12 @@ class BaseNode {
     chrono::ChTimer<double> m_timer;  ///< timer for integration cost
     double m_cum_sim_time;            ///< cumulative integration cost
 
+    chrono::ChTimer<double> m_wait_timer;  ///< timer for waiting on other nodes
+    double m_cum_wait_time;                ///< cumulative time waiting on other nodes
+
+    int m_lag;            ///< coupling lag (0 or 1)
+    bool m_extrapolate;   ///< extrapolate lagged coupling forces?
+
     static const double m_gacc;
 };
 
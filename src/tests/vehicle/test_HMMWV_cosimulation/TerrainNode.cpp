@@ -57,6 +57,7 @@ TerrainNode::TerrainNode(Type type,
       m_type(type),
       m_method(method),
       m_num_tires(num_tires),
+      m_channel(nullptr),
       m_use_checkpoint(use_checkpoint),
       m_render(render),
       m_constructed(false),
@@ -746,21 +747,27 @@ void TerrainNode::CreateFaceProxies(int which) {
 // - extract and send forces at each vertex
 // -----------------------------------------------------------------------------
 void TerrainNode::Synchronize(int step_number, double time) {
+    m_wait_timer.reset();
 
-    // --------------------------------------------------------------
-    // Loop over all tires, receive mesh vertex state, update proxies
-    // --------------------------------------------------------------
+    // ----------------------------------------------------------------
+    // Receive mesh vertex states from all tires and update proxies.
+    // Tires are processed in the order in which their data arrives.
+    // ----------------------------------------------------------------
 
-    for (int which = 0; which < m_num_tires; which++) {
+    m_channel->StartRecvVertexData(step_number);
+
+    while (true) {
+        m_wait_timer.start();
+        int which = m_channel->WaitVertexData();
+        m_wait_timer.stop();
+        if (which < 0)
+            break;
 
-        // Receive tire mesh vertex locations and velocities.
-        MPI_Status status;
+        // Read tire mesh vertex locations and velocities in place from the mesh channel.
         unsigned int num_vert = m_tire_data[which].m_num_vert;
         unsigned int num_tri = m_tire_data[which].m_num_tri;
-        double* vert_data = new double[2 * 3 * num_vert];
-        int* tri_data = new int[3 * num_tri];
-        MPI_Recv(vert_data, 2 * 3 * num_vert, MPI_DOUBLE, TIRE_NODE_RANK(which), step_number, MPI_COMM_WORLD, &status);
-        MPI_Recv(tri_data, 3 * num_tri, MPI_INT, TIRE_NODE_RANK(which), step_number, MPI_COMM_WORLD, &status);
+        const double* vert_data = m_channel->VertexData(which, step_number);
+        const int* tri_data = m_channel->TriangleData(which, step_number);
 
         for (unsigned int iv = 0; iv < num_vert; iv++) {
             unsigned int offset = 3 * iv;
@@ -775,9 +782,6 @@ void TerrainNode::Synchronize(int step_number, double time) {
             m_tire_data[which].m_triangles[it].v3 = tri_data[3 * it + 2];
         }
 
-        delete[] vert_data;
-        delete[] tri_data;
-
         // Set position, rotation, and velocity of proxy bodies.
         switch (m_type) {
             case RIGID:
@@ -808,26 +812,25 @@ void TerrainNode::Synchronize(int step_number, double time) {
 
     for (int which = 0; which < m_num_tires; which++) {
 
-        // Collect contact forces on subset of mesh vertices.
+        // Collect contact forces on subset of mesh vertices, packed directly in the mesh channel.
         // Note that no forces are collected at the first step.
-        std::vector<double> vert_forces;
-        std::vector<int> vert_indices;
+        double* vert_forces = m_channel->ForceData(which, step_number);
+        int* vert_indices = m_channel->IndexData(which, step_number);
+        int num_vert = 0;
 
         if (step_number > 0) {
             switch (m_type) {
             case RIGID:
-                ForcesNodeProxies(which, vert_forces, vert_indices);
+                num_vert = ForcesNodeProxies(which, vert_forces, vert_indices);
                 break;
             case GRANULAR:
-                ForcesFaceProxies(which, vert_forces, vert_indices);
+                num_vert = ForcesFaceProxies(which, vert_forces, vert_indices);
                 break;
             }
         }
 
         // Send vertex indices and forces.
-        int num_vert = (int)vert_indices.size();
-        MPI_Send(vert_indices.data(), num_vert, MPI_INT, TIRE_NODE_RANK(which), step_number, MPI_COMM_WORLD);
-        MPI_Send(vert_forces.data(), 3 * num_vert, MPI_DOUBLE, TIRE_NODE_RANK(which), step_number, MPI_COMM_WORLD);
+        m_channel->SendForceData(which, step_number, num_vert);
 
         msg += std::to_string(num_vert) + "  ";
     }
@@ -835,6 +838,7 @@ void TerrainNode::Synchronize(int step_number, double time) {
     msg += "]";
     cout << m_prefix << msg << endl;
 
+    m_cum_wait_time += m_wait_timer();
 }
 
 // Set position and velocity of proxy bodies based on tire mesh vertices.
@@ -899,17 +903,21 @@ void TerrainNode::UpdateFaceProxies(int which) {
 
 // Collect contact forces on the (node) proxy bodies that are in contact.
 // Load mesh vertex forces and corresponding indices.
-void TerrainNode::ForcesNodeProxies(int which, std::vector<double>& vert_forces, std::vector<int>& vert_indices) {
+// Return the number of vertices with contact forces (at most the number of mesh vertices).
+int TerrainNode::ForcesNodeProxies(int which, double* vert_forces, int* vert_indices) {
+    int count = 0;
     for (unsigned int iv = 0; iv < m_tire_data[which].m_num_vert; iv++) {
         real3 force = m_system->GetBodyContactForce(m_tire_data[which].m_proxies[iv].m_body);
 
         if (!IsZero(force)) {
-            vert_forces.push_back(force.x);
-            vert_forces.push_back(force.y);
-            vert_forces.push_back(force.z);
-            vert_indices.push_back(m_tire_data[which].m_proxies[iv].m_index);
+            vert_forces[3 * count + 0] = force.x;
+            vert_forces[3 * count + 1] = force.y;
+            vert_forces[3 * count + 2] = force.z;
+            vert_indices[count] = m_tire_data[which].m_proxies[iv].m_index;
+            count++;
         }
     }
+    return count;
 }
 
 // Calculate barycentric coordinates (a1, a2, a3) for a given point P
@@ -939,7 +947,8 @@ ChVector<> TerrainNode::CalcBarycentricCoords(const ChVector<>& v1,
 
 // Collect contact forces on the (face) proxy bodies that are in contact.
 // Load mesh vertex forces and corresponding indices.
-void TerrainNode::ForcesFaceProxies(int which, std::vector<double>& vert_forces, std::vector<int>& vert_indices) {
+// Return the number of vertices with contact forces (at most the number of mesh vertices).
+int TerrainNode::ForcesFaceProxies(int which, double* vert_forces, int* vert_indices) {
     // Maintain an unordered map of vertex indices and associated contact forces.
     std::unordered_map<int, ChVector<>> my_map;
 
@@ -981,14 +990,16 @@ void TerrainNode::ForcesFaceProxies(int which, std::vector<double>& vert_forces,
     }
 
     // Extract map keys (indices of vertices in contact) and map values
-    // (corresponding contact forces) and load output vectors.
-    // Note: could improve efficiency by reserving space for vectors.
+    // (corresponding contact forces) and load output arrays.
+    int count = 0;
     for (auto kv : my_map) {
-        vert_indices.push_back(kv.first);
-        vert_forces.push_back(kv.second.x);
-        vert_forces.push_back(kv.second.y);
-        vert_forces.push_back(kv.second.z);
+        vert_indices[count] = kv.first;
+        vert_forces[3 * count + 0] = kv.second.x;
+        vert_forces[3 * count + 1] = kv.second.y;
+        vert_forces[3 * count + 2] = kv.second.z;
+        count++;
     }
+    return count;
 }
 
 // -----------------------------------------------------------------------------
@@ -31,6 +31,7 @@
 #include "chrono_parallel/physics/ChSystemParallel.h"
 
 #include "BaseNode.h"
+#include "TireMeshChannel.h"
 
 // =============================================================================
 
@@ -99,6 +100,10 @@ class TerrainNode : public BaseNode {
     /// If enabled, output files are generated with a frequency of 100 FPS.
     void EnableSettlingOutput(bool val) { m_settling_output = val; }
 
+    /// Set the channel for the exchange of mesh data with the tire nodes.
+    /// The channel must be set after initialization and before the first synchronization.
+    void SetMeshChannel(TireMeshChannel* channel) { m_channel = channel; }
+
     /// Initialize this node.
     /// This function allows the node to initialize itself and, optionally, perform an
     /// initial data exchange with any other node.
@@ -171,6 +176,7 @@ class TerrainNode : public BaseNode {
     int m_num_tires;                    ///< number of vehicle tires
     bool m_fixed_proxies;               ///< flag indicating whether or not proxy bodies are fixed to ground
     std::vector<TireData> m_tire_data;  ///< data for the vehicle tire proxies
+    TireMeshChannel* m_channel;         ///< channel for the exchange of mesh data with the tire nodes
 
     std::shared_ptr<chrono::ChBody> m_platform;  ///< platform rigid body
 
@@ -213,8 +219,8 @@ class TerrainNode : public BaseNode {
     void UpdateNodeProxies(int which);
     void UpdateFaceProxies(int which);
 
-    void ForcesNodeProxies(int which, std::vector<double>& vert_forces, std::vector<int>& vert_indices);
-    void ForcesFaceProxies(int which, std::vector<double>& vert_forces, std::vector<int>& vert_indices);
+    int ForcesNodeProxies(int which, double* vert_forces, int* vert_indices);
+    int ForcesFaceProxies(int which, double* vert_forces, int* vert_indices);
 
     void WriteParticleInformation(chrono::utils::CSV_writer& csv);
 
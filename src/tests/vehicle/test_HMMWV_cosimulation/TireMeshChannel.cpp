@@ -0,0 +1,240 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2015 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Channel for the per-step exchange of tire mesh data between the tire nodes
+// and the terrain node.
+//
+// The data of a tire is stored in one segment:
+//   vertex states (6 * num_vert doubles), vertex forces (3 * num_vert doubles),
+//   triangles (3 * num_tri ints), force vertex indices (num_vert ints)
+// and each tire has one segment per slot; step k uses slot k % (lag + 1).
+// In shared mode, each tire node allocates its segments in the shared window and
+// the terrain node accesses all of them directly. A tire node fills its slot for
+// step k only after it received the forces of step k-lag-1, and the terrain node
+// fills the force data only after it received the vertex data of the same step,
+// so lag + 1 slots suffice.
+//
+// =============================================================================
+
+#include "BaseNode.h"
+#include "TireMeshChannel.h"
+
+// -----------------------------------------------------------------------------
+// Construction of the channel
+// -----------------------------------------------------------------------------
+TireMeshChannel::TireMeshChannel(int num_tires,
+                                 unsigned int num_vert,
+                                 unsigned int num_tri,
+                                 int lag,
+                                 bool allow_shared)
+    : m_num_tires(num_tires),
+      m_num_slots(lag + 1),
+      m_shared(false),
+      m_win(MPI_WIN_NULL),
+      m_node_comm(MPI_COMM_NULL),
+      m_num_vert(num_tires),
+      m_num_tri(num_tires),
+      m_vert_data(num_tires * m_num_slots, nullptr),
+      m_tri_data(num_tires * m_num_slots, nullptr),
+      m_index_data(num_tires * m_num_slots, nullptr),
+      m_force_data(num_tires * m_num_slots, nullptr),
+      m_vert_requests(num_tires, MPI_REQUEST_NULL),
+      m_tri_requests(num_tires, MPI_REQUEST_NULL),
+      m_send_requests(2 * num_tires * m_num_slots, MPI_REQUEST_NULL),
+      m_counts(num_tires * m_num_slots, 0) {
+    int rank;
+    int size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    // Let all ranks know the size of all tire meshes.
+    std::vector<unsigned int> sizes(2 * size);
+    unsigned int my_size[2] = {num_vert, num_tri};
+    MPI_Allgather(my_size, 2, MPI_UNSIGNED, sizes.data(), 2, MPI_UNSIGNED, MPI_COMM_WORLD);
+    for (int which = 0; which < m_num_tires; which++) {
+        m_num_vert[which] = sizes[2 * TIRE_NODE_RANK(which) + 0];
+        m_num_tri[which] = sizes[2 * TIRE_NODE_RANK(which) + 1];
+    }
+
+    // Use shared memory only if all ranks run on the same host.
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &m_node_comm);
+    int node_size;
+    MPI_Comm_size(m_node_comm, &node_size);
+    m_shared = allow_shared && (node_size == size);
+
+    if (m_shared) {
+        // Each tire node allocates its own segment (in its own pages, not in one contiguous block).
+        MPI_Info info;
+        MPI_Info_create(&info);
+        MPI_Info_set(info, "alloc_shared_noncontig", "true");
+        MPI_Aint my_bytes = (rank >= TIRE_NODE_RANK(0)) ? m_num_slots * SegmentSize(num_vert, num_tri) : 0;
+        char* my_base;
+        MPI_Win_allocate_shared(my_bytes, 1, info, m_node_comm, &my_base, &m_win);
+        MPI_Info_free(&info);
+
+        // Locate the segments of the tires this rank exchanges data with.
+        MPI_Group world_group;
+        MPI_Group node_group;
+        MPI_Comm_group(MPI_COMM_WORLD, &world_group);
+        MPI_Comm_group(m_node_comm, &node_group);
+        for (int which = 0; which < m_num_tires; which++) {
+            if (rank != TERRAIN_NODE_RANK && rank != TIRE_NODE_RANK(which))
+                continue;
+            int world_rank = TIRE_NODE_RANK(which);
+            int node_rank;
+            MPI_Group_translate_ranks(world_group, 1, &world_rank, node_group, &node_rank);
+            MPI_Aint bytes;
+            int disp_unit;
+            char* base;
+            MPI_Win_shared_query(m_win, node_rank, &bytes, &disp_unit, &base);
+            SetBuffers(which, base);
+        }
+        MPI_Group_free(&world_group);
+        MPI_Group_free(&node_group);
+
+        // Open a passive access epoch for the lifetime of the channel; the ready messages
+        // order the accesses to the segments.
+        MPI_Win_lock_all(MPI_MODE_NOCHECK, m_win);
+    } else {
+        // Allocate local buffers for the tires this rank exchanges data with.
+        std::vector<MPI_Aint> offsets(m_num_tires, -1);
+        MPI_Aint bytes = 0;
+        for (int which = 0; which < m_num_tires; which++) {
+            if (rank != TERRAIN_NODE_RANK && rank != TIRE_NODE_RANK(which))
+                continue;
+            offsets[which] = bytes;
+            bytes += m_num_slots * SegmentSize(m_num_vert[which], m_num_tri[which]);
+        }
+        m_local.resize(bytes);
+        for (int which = 0; which < m_num_tires; which++) {
+            if (offsets[which] >= 0)
+                SetBuffers(which, m_local.data() + offsets[which]);
+        }
+    }
+}
+
+TireMeshChannel::~TireMeshChannel() {
+    MPI_Waitall((int)m_send_requests.size(), m_send_requests.data(), MPI_STATUSES_IGNORE);
+    if (m_win != MPI_WIN_NULL) {
+        MPI_Win_unlock_all(m_win);
+        MPI_Win_free(&m_win);
+    }
+    if (m_node_comm != MPI_COMM_NULL)
+        MPI_Comm_free(&m_node_comm);
+}
+
+// Size of the segment of a tire, rounded up so that consecutive segments stay aligned.
+MPI_Aint TireMeshChannel::SegmentSize(unsigned int num_vert, unsigned int num_tri) {
+    MPI_Aint bytes = 9 * num_vert * sizeof(double) + (3 * num_tri + num_vert) * sizeof(int);
+    return (bytes + sizeof(double) - 1) / sizeof(double) * sizeof(double);
+}
+
+void TireMeshChannel::SetBuffers(int which, char* base) {
+    unsigned int num_vert = m_num_vert[which];
+    unsigned int num_tri = m_num_tri[which];
+    for (int is = 0; is < m_num_slots; is++) {
+        int slot = Slot(which, is);
+        m_vert_data[slot] = reinterpret_cast<double*>(base + is * SegmentSize(num_vert, num_tri));
+        m_force_data[slot] = m_vert_data[slot] + 6 * num_vert;
+        m_tri_data[slot] = reinterpret_cast<int*>(m_force_data[slot] + 3 * num_vert);
+        m_index_data[slot] = m_tri_data[slot] + 3 * num_tri;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Tire node side
+// -----------------------------------------------------------------------------
+void TireMeshChannel::SendVertexData(int which, int step_number) {
+    int slot = Slot(which, step_number);
+    MPI_Request* requests = &m_send_requests[2 * slot];
+    if (m_shared) {
+        MPI_Win_sync(m_win);
+        MPI_Isend(nullptr, 0, MPI_BYTE, TERRAIN_NODE_RANK, step_number, MPI_COMM_WORLD, &requests[0]);
+    } else {
+        MPI_Isend(m_vert_data[slot], 6 * m_num_vert[which], MPI_DOUBLE, TERRAIN_NODE_RANK, step_number,
+                  MPI_COMM_WORLD, &requests[0]);
+        MPI_Isend(m_tri_data[slot], 3 * m_num_tri[which], MPI_INT, TERRAIN_NODE_RANK, step_number, MPI_COMM_WORLD,
+                  &requests[1]);
+    }
+}
+
+int TireMeshChannel::RecvForceData(int which, int step_number) {
+    int slot = Slot(which, step_number);
+    MPI_Status status;
+    int count;
+    if (m_shared) {
+        MPI_Recv(&count, 1, MPI_INT, TERRAIN_NODE_RANK, step_number, MPI_COMM_WORLD, &status);
+        MPI_Win_sync(m_win);
+    } else {
+        MPI_Recv(m_index_data[slot], m_num_vert[which], MPI_INT, TERRAIN_NODE_RANK, step_number, MPI_COMM_WORLD,
+                 &status);
+        MPI_Get_count(&status, MPI_INT, &count);
+        MPI_Recv(m_force_data[slot], 3 * count, MPI_DOUBLE, TERRAIN_NODE_RANK, step_number, MPI_COMM_WORLD,
+                 &status);
+    }
+
+    // The terrain node is done with the vertex data of this step.
+    MPI_Waitall(2, &m_send_requests[2 * slot], MPI_STATUSES_IGNORE);
+
+    return count;
+}
+
+// -----------------------------------------------------------------------------
+// Terrain node side
+// -----------------------------------------------------------------------------
+void TireMeshChannel::StartRecvVertexData(int step_number) {
+    for (int which = 0; which < m_num_tires; which++) {
+        int slot = Slot(which, step_number);
+
+        // Complete the sends of the forces of the step that last used this slot.
+        MPI_Waitall(2, &m_send_requests[2 * slot], MPI_STATUSES_IGNORE);
+
+        if (m_shared) {
+            MPI_Irecv(nullptr, 0, MPI_BYTE, TIRE_NODE_RANK(which), step_number, MPI_COMM_WORLD,
+                      &m_vert_requests[which]);
+        } else {
+            MPI_Irecv(m_vert_data[slot], 6 * m_num_vert[which], MPI_DOUBLE, TIRE_NODE_RANK(which), step_number,
+                      MPI_COMM_WORLD, &m_vert_requests[which]);
+            MPI_Irecv(m_tri_data[slot], 3 * m_num_tri[which], MPI_INT, TIRE_NODE_RANK(which), step_number,
+                      MPI_COMM_WORLD, &m_tri_requests[which]);
+        }
+    }
+}
+
+int TireMeshChannel::WaitVertexData() {
+    int which;
+    MPI_Waitany(m_num_tires, m_vert_requests.data(), &which, MPI_STATUS_IGNORE);
+    if (which == MPI_UNDEFINED)
+        return -1;
+
+    if (m_shared)
+        MPI_Win_sync(m_win);
+    else
+        MPI_Wait(&m_tri_requests[which], MPI_STATUS_IGNORE);
+
+    return which;
+}
+
+void TireMeshChannel::SendForceData(int which, int step_number, int count) {
+    int slot = Slot(which, step_number);
+    MPI_Request* requests = &m_send_requests[2 * slot];
+    if (m_shared) {
+        MPI_Win_sync(m_win);
+        m_counts[slot] = count;
+        MPI_Isend(&m_counts[slot], 1, MPI_INT, TIRE_NODE_RANK(which), step_number, MPI_COMM_WORLD, &requests[0]);
+    } else {
+        MPI_Isend(m_index_data[slot], count, MPI_INT, TIRE_NODE_RANK(which), step_number, MPI_COMM_WORLD,
+                  &requests[0]);
+        MPI_Isend(m_force_data[slot], 3 * count, MPI_DOUBLE, TIRE_NODE_RANK(which), step_number, MPI_COMM_WORLD,
+                  &requests[1]);
+    }
+}
@@ -0,0 +1,121 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2015 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Channel for the per-step exchange of tire mesh data between the tire nodes
+// and the terrain node.
+//
+// If all ranks run on the same host, the data of each tire lives in an MPI-3
+// shared memory window: the tire node packs its vertex states in place, the
+// terrain node reads them and packs the vertex contact forces in place, and
+// each side only sends the other a short message when its data is ready.
+// Otherwise, the same buffers are exchanged with point-to-point messages.
+//
+// With lagged coupling, a tire node already packs the data of the next step
+// while the terrain node still processes the previous one, so the buffers of
+// each tire are replicated in as many slots, used in turn, as needed.
+//
+// =============================================================================
+
+#ifndef HMMWV_COSIM_TIREMESHCHANNEL_H
+#define HMMWV_COSIM_TIREMESHCHANNEL_H
+
+#include <vector>
+
+#include "mpi.h"
+
+class TireMeshChannel {
+  public:
+    /// Create the channel.
+    /// This is a collective call: it must be made by all ranks, after the nodes were initialized.
+    /// A tire node passes the size of its contact mesh; all other nodes pass zeros.
+    TireMeshChannel(int num_tires,            ///< number of tire nodes
+                    unsigned int num_vert,    ///< number of mesh vertices of this tire node
+                    unsigned int num_tri,     ///< number of mesh triangles of this tire node
+                    int lag = 0,              ///< coupling lag (0 or 1)
+                    bool allow_shared = true  ///< use shared memory if all ranks run on the same host
+                    );
+
+    /// Free the channel, after completing all pending sends.
+    /// This is a collective call, to be made by all ranks before MPI_Finalize.
+    ~TireMeshChannel();
+
+    /// Return true if the tire data is exchanged through shared memory.
+    bool IsShared() const { return m_shared; }
+
+    /// Get the number of mesh vertices of the specified tire.
+    unsigned int GetNumVertices(int which) const { return m_num_vert[which]; }
+
+    /// Get the number of mesh triangles of the specified tire.
+    unsigned int GetNumTriangles(int which) const { return m_num_tri[which]; }
+
+    /// Vertex states of the specified tire at the specified step:
+    /// 3 * num_vert positions, then 3 * num_vert velocities.
+    double* VertexData(int which, int step_number) const { return m_vert_data[Slot(which, step_number)]; }
+
+    /// Mesh connectivity of the specified tire at the specified step: 3 * num_tri vertex indices.
+    int* TriangleData(int which, int step_number) const { return m_tri_data[Slot(which, step_number)]; }
+
+    /// Indices of the vertices of the specified tire with contact forces at the specified step
+    /// (at most num_vert).
+    int* IndexData(int which, int step_number) const { return m_index_data[Slot(which, step_number)]; }
+
+    /// Contact forces on the vertices listed in IndexData (3 per vertex).
+    double* ForceData(int which, int step_number) const { return m_force_data[Slot(which, step_number)]; }
+
+    /// Tire node: make the vertex states and connectivity packed in VertexData and
+    /// TriangleData available to the terrain node. This call does not wait for the terrain node.
+    void SendVertexData(int which, int step_number);
+
+    /// Tire node: wait for the contact forces from the terrain node and return the
+    /// number of vertices listed in IndexData and ForceData.
+    /// Once the forces of a step are received, the vertex buffers of that step can be reused.
+    int RecvForceData(int which, int step_number);
+
+    /// Terrain node: start receiving the vertex data of all tires for the current step.
+    void StartRecvVertexData(int step_number);
+
+    /// Terrain node: wait until the vertex data of one more tire is available in VertexData
+    /// and TriangleData and return the index of that tire. Tires are returned in order of
+    /// arrival; -1 is returned once the data of all tires was received.
+    int WaitVertexData();
+
+    /// Terrain node: make the contact forces packed in IndexData and ForceData available
+    /// to the specified tire node. This call does not wait for the tire node.
+    void SendForceData(int which, int step_number, int count);
+
+  private:
+    int Slot(int which, int step_number) const { return which * m_num_slots + step_number % m_num_slots; }
+    void SetBuffers(int which, char* base);
+    static MPI_Aint SegmentSize(unsigned int num_vert, unsigned int num_tri);
+
+    int m_num_tires;
+    int m_num_slots;       ///< number of buffer slots per tire
+    bool m_shared;         ///< data exchanged through the shared memory window?
+    MPI_Win m_win;         ///< shared memory window (shared mode)
+    MPI_Comm m_node_comm;  ///< communicator of the ranks on this host
+
+    std::vector<unsigned int> m_num_vert;
+    std::vector<unsigned int> m_num_tri;
+    std::vector<char> m_local;  ///< local storage for the tire buffers (message mode)
+
+    std::vector<double*> m_vert_data;
+    std::vector<int*> m_tri_data;
+    std::vector<int*> m_index_data;
+    std::vector<double*> m_force_data;
+
+    std::vector<MPI_Request> m_vert_requests;  ///< pending receives of vertex data (terrain node)
+    std::vector<MPI_Request> m_tri_requests;   ///< pending receives of connectivity (terrain node, message mode)
+    std::vector<MPI_Request> m_send_requests;  ///< pending sends, two per slot
+    std::vector<int> m_counts;                 ///< number of force vertices sent, per slot (shared mode)
+};
+
+#endif
@@ -55,7 +55,8 @@ using namespace chrono::vehicle;
 // Construction of the tire node:
 // - create the (sequential) Chrono system and set solver parameters
 // -----------------------------------------------------------------------------
-TireNode::TireNode(WheelID wheel_id, int num_threads) : BaseNode(""), m_wheel_id(wheel_id) {
+TireNode::TireNode(WheelID wheel_id, int num_threads)
+    : BaseNode(""), m_wheel_id(wheel_id), m_num_vert(0), m_num_tri(0), m_channel(nullptr), m_last_step(-1) {
     m_name = "TIRE_" + std::to_string(m_wheel_id.id());
     m_prefix = "[Tire node " + std::to_string(m_wheel_id.id()) + " ]";
 
@@ -200,9 +201,12 @@ void TireNode::Initialize() {
     // Send tire contact surface specification
     // ---------------------------------------
 
+    m_num_vert = contact_surface->GetNumVertices();
+    m_num_tri = contact_surface->GetNumTriangles();
+
     unsigned int surf_props[2];
-    surf_props[0] = contact_surface->GetNumVertices();
-    surf_props[1] = contact_surface->GetNumTriangles();
+    surf_props[0] = m_num_vert;
+    surf_props[1] = m_num_tri;
     MPI_Send(surf_props, 2, MPI_UNSIGNED, TERRAIN_NODE_RANK, 0, MPI_COMM_WORLD);
 
     cout << m_prefix << " vertices = " << surf_props[0] << "  triangles = " << surf_props[1] << endl;
@@ -247,8 +251,13 @@ void TireNode::Initialize() {
 // - receive (from terrain node) and apply vertex contact forces
 // - accumulate and send (to vehicle node) tire-rim connection forces
 // - receive (from vehicle node) updated wheel state
+// With a coupling lag of 1, the vertex forces and the wheel state received are
+// the ones the other nodes sent at the previous synchronization.
 // -----------------------------------------------------------------------------
 void TireNode::Synchronize(int step_number, double time) {
+    m_last_step = step_number;
+    m_wait_timer.reset();
+
     // -------------------------------
     // Communication with TERRAIN node
     // -------------------------------
@@ -263,11 +272,13 @@ void TireNode::Synchronize(int step_number, double time) {
     PrintLowestNode();
     PrintLowestVertex(vert_pos, vert_vel);
 
-    // Send tire mesh vertex locations and velocities to the terrain node
+    // Send tire mesh vertex locations and velocities to the terrain node.
+    // The data is packed directly in the buffers of the mesh channel.
+    int which = m_wheel_id.id();
     unsigned int num_vert = (unsigned int)vert_pos.size();
     unsigned int num_tri = (unsigned int)triangles.size();
-    double* vert_data = new double[2 * 3 * num_vert];
-    int* tri_data = new int[3 * num_tri];
+    double* vert_data = m_channel->VertexData(which, step_number);
+    int* tri_data = m_channel->TriangleData(which, step_number);
     for (unsigned int iv = 0; iv < num_vert; iv++) {
         vert_data[3 * iv + 0] = vert_pos[iv].x;
         vert_data[3 * iv + 1] = vert_pos[iv].y;
@@ -283,23 +294,30 @@ void TireNode::Synchronize(int step_number, double time) {
         tri_data[3 * it + 1] = triangles[it].y;
         tri_data[3 * it + 2] = triangles[it].z;
     }
-    MPI_Send(vert_data, 2 * 3 * num_vert, MPI_DOUBLE, TERRAIN_NODE_RANK, step_number, MPI_COMM_WORLD);
-    MPI_Send(tri_data, 3 * num_tri, MPI_INT, TERRAIN_NODE_RANK, step_number, MPI_COMM_WORLD);
-
-    // Receive terrain forces.
-    // Note that we use MPI_Probe to figure out the number of indices and forces received.
-    MPI_Status status;
-    int count;
-    MPI_Probe(TERRAIN_NODE_RANK, step_number, MPI_COMM_WORLD, &status);
-    MPI_Get_count(&status, MPI_INT, &count);
-    int* index_data = new int[count];
-    double* force_data = new double[3 * count];
-    MPI_Recv(index_data, count, MPI_INT, TERRAIN_NODE_RANK, step_number, MPI_COMM_WORLD, &status);
-    MPI_Recv(force_data, 3 * count, MPI_DOUBLE, TERRAIN_NODE_RANK, step_number, MPI_COMM_WORLD, &status);
+    m_channel->SendVertexData(which, step_number);
+
+    // Receive terrain forces (read in place from the mesh channel).
+    // With lagged coupling, there are no forces at the first step.
+    int force_step = step_number - m_lag;
+    int count = 0;
+    const int* index_data = nullptr;
+    const double* force_data = nullptr;
+    if (force_step >= 0) {
+        m_wait_timer.start();
+        count = m_channel->RecvForceData(which, force_step);
+        m_wait_timer.stop();
+        index_data = m_channel->IndexData(which, force_step);
+        force_data = m_channel->ForceData(which, force_step);
+    }
 
     cout << m_prefix << " step number: " << step_number << "  vertices in contact: " << count << endl;
 
-    // Repack data and apply forces to the mesh vertices
+    // Repack data and apply forces to the mesh vertices.
+    // With extrapolation of lagged forces, the force on a vertex that was also in contact at
+    // the previous step is extrapolated linearly to the current time.
+    bool extrapolate = (m_lag > 0) && m_extrapolate;
+    if (extrapolate && m_force_hist.empty())
+        m_force_hist.resize(num_vert, VNULL);
     m_vert_indices.resize(count);
     m_vert_pos.resize(count);
     m_vert_forces.resize(count);
@@ -308,17 +326,22 @@ void TireNode::Synchronize(int step_number, double time) {
         m_vert_indices[iv] = index;
         m_vert_pos[iv] = vert_pos[index];
         m_vert_forces[iv] = ChVector<>(force_data[3 * iv + 0], force_data[3 * iv + 1], force_data[3 * iv + 2]);
+        if (extrapolate && !(m_force_hist[index] == VNULL))
+            m_vert_forces[iv] = 2.0 * m_vert_forces[iv] - m_force_hist[index];
+    }
+    if (extrapolate) {
+        for (size_t iv = 0; iv < m_hist_indices.size(); iv++)
+            m_force_hist[m_hist_indices[iv]] = VNULL;
+        for (int iv = 0; iv < count; iv++) {
+            m_force_hist[index_data[iv]] =
+                ChVector<>(force_data[3 * iv + 0], force_data[3 * iv + 1], force_data[3 * iv + 2]);
+        }
+        m_hist_indices.assign(index_data, index_data + count);
     }
     m_contact_load->InputSimpleForces(m_vert_forces, m_vert_indices);
 
     PrintContactData(m_vert_forces, m_vert_indices);
 
-    delete[] vert_data;
-    delete[] tri_data;
-
-    delete[] index_data;
-    delete[] force_data;
-
     // -------------------------------
     // Communication with VEHICLE node
     // -------------------------------
@@ -343,10 +366,18 @@ void TireNode::Synchronize(int step_number, double time) {
     cout << bufTF[3] << " " << bufTF[4] << " " << bufTF[5] << "  ,  ";
     cout << bufTF[6] << " " << bufTF[7] << " " << bufTF[8] << endl;
 
-    // Receive wheel state from the vehicle node
+    // Receive wheel state from the vehicle node.
+    // With lagged coupling, the rim keeps its initial state at the first step.
+    if (step_number < m_lag) {
+        m_cum_wait_time += m_wait_timer();
+        return;
+    }
     double bufWS[14];
     MPI_Status statusWS;
+    m_wait_timer.start();
     MPI_Recv(bufWS, 14, MPI_DOUBLE, VEHICLE_NODE_RANK, m_wheel_id.id(), MPI_COMM_WORLD, &statusWS);
+    m_wait_timer.stop();
+    m_cum_wait_time += m_wait_timer();
     WheelState wheel_state;
     wheel_state.pos = ChVector<>(bufWS[0], bufWS[1], bufWS[2]);
     wheel_state.rot = ChQuaternion<>(bufWS[3], bufWS[4], bufWS[5], bufWS[6]);
@@ -363,6 +394,21 @@ void TireNode::Synchronize(int step_number, double time) {
     m_rim->SetWvel_par(wheel_state.ang_vel);
 }
 
+// -----------------------------------------------------------------------------
+// Finalization of the tire node: with lagged coupling, receive the vertex forces
+// and the wheel state sent at the last synchronization.
+// -----------------------------------------------------------------------------
+void TireNode::Finalize() {
+    if (m_lag == 0 || m_last_step < 0)
+        return;
+
+    m_channel->RecvForceData(m_wheel_id.id(), m_last_step);
+
+    double bufWS[14];
+    MPI_Status statusWS;
+    MPI_Recv(bufWS, 14, MPI_DOUBLE, VEHICLE_NODE_RANK, m_wheel_id.id(), MPI_COMM_WORLD, &statusWS);
+}
+
 // -----------------------------------------------------------------------------
 // Advance simulation of the tire node by the specified duration
 // -----------------------------------------------------------------------------
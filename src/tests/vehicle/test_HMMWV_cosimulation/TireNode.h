@@ -33,6 +33,7 @@
 #include "chrono_vehicle/wheeled_vehicle/tire/ANCFTire.h"
 
 #include "BaseNode.h"
+#include "TireMeshChannel.h"
 
 // =============================================================================
 
@@ -55,6 +56,16 @@ class TireNode : public BaseNode {
     /// Enable/disable tire pressure (default: true).
     void EnableTirePressure(bool val);
 
+    /// Get the number of vertices of the tire contact mesh (available after initialization).
+    unsigned int GetNumVertices() const { return m_num_vert; }
+
+    /// Get the number of triangles of the tire contact mesh (available after initialization).
+    unsigned int GetNumTriangles() const { return m_num_tri; }
+
+    /// Set the channel for the exchange of mesh data with the terrain node.
+    /// The channel must be set after initialization and before the first synchronization.
+    void SetMeshChannel(TireMeshChannel* channel) { m_channel = channel; }
+
     /// Initialize this node.
     /// This function allows the node to initialize itself and, optionally, perform an
     /// initial data exchange with any other node.
@@ -71,6 +82,10 @@ class TireNode : public BaseNode {
     /// integration steps as required, but no inter-node communication should occur.
     virtual void Advance(double step_size) override;
 
+    /// Finalize this node.
+    /// With lagged coupling, this function receives the data sent at the last synchronization.
+    virtual void Finalize() override;
+
     /// Output logging and debugging data.
     virtual void OutputData(int frame) override;
 
@@ -89,12 +104,21 @@ class TireNode : public BaseNode {
     bool m_tire_pressure;                                                   ///< tire pressure enabled?
     std::shared_ptr<chrono::vehicle::ChDeformableTire> m_tire;              ///< deformable tire
     std::shared_ptr<chrono::fea::ChLoadContactSurfaceMesh> m_contact_load;  ///< tire contact surface
+    unsigned int m_num_vert;                                                ///< number of contact mesh vertices
+    unsigned int m_num_tri;                                                 ///< number of contact mesh triangles
+
+    TireMeshChannel* m_channel;  ///< channel for the exchange of mesh data with the terrain node
+    int m_last_step;             ///< number of the last synchronization step
 
     // Current contact forces on tire mesh vertices
     std::vector<int> m_vert_indices;                ///< indices of vertices experiencing contact forces
     std::vector<chrono::ChVector<>> m_vert_pos;     ///< position of vertices experiencing contact forces
     std::vector<chrono::ChVector<>> m_vert_forces;  ///< contact forces on mesh vertices
 
+    // Contact forces received at the previous step (for extrapolation of lagged forces)
+    std::vector<chrono::ChVector<>> m_force_hist;  ///< previous forces, on all mesh vertices
+    std::vector<int> m_hist_indices;               ///< indices of vertices with previous forces
+
     // Private methods
 
     // Write mesh node state information
@@ -76,7 +76,8 @@ private:
 // Construction of the vehicle node:
 // - create the (sequential) Chrono system and set solver parameters
 // -----------------------------------------------------------------------------
-VehicleNode::VehicleNode() : BaseNode("VEHICLE"), m_vehicle(nullptr), m_powertrain(nullptr), m_driver(nullptr) {
+VehicleNode::VehicleNode()
+    : BaseNode("VEHICLE"), m_vehicle(nullptr), m_powertrain(nullptr), m_driver(nullptr), m_last_step(-1) {
     m_prefix = "[Vehicle node]";
 
     cout << m_prefix << " num_threads = 1" << endl;
@@ -161,6 +162,7 @@ void VehicleNode::Initialize() {
 
     m_num_wheels = 2 * m_vehicle->GetNumberAxles();
     m_tire_forces.resize(m_num_wheels);
+    m_prev_tire_forces.resize(m_num_wheels);
 
     // Send wheel initial states.
     // It is assumed that initial linear and angular velocity are always 0.
@@ -193,10 +195,15 @@ void VehicleNode::Initialize() {
 // - receive forces from tire nodes (used in vehicle synchronization)
 // - send current wheel states to tire nodes
 // - synchronize vehicle, powertrain, driver
+// With a coupling lag of 1, the wheel states are sent first and the tire forces
+// received are the ones the tire nodes sent at the previous synchronization.
 // -----------------------------------------------------------------------------
 void VehicleNode::Synchronize(int step_number, double time) {
     //// TODO check this
 
+    m_last_step = step_number;
+    m_wait_timer.reset();
+
     // Get current driver outputs
     double steering = m_driver->GetSteering();
     double throttle = m_driver->GetThrottle();
@@ -206,17 +213,49 @@ void VehicleNode::Synchronize(int step_number, double time) {
     double driveshaft_speed = m_vehicle->GetDriveshaftSpeed();
     double powertrain_torque = m_powertrain->GetOutputTorque();
 
-    // Receive tire forces from each of the tire nodes
+    // Exchange data with the tire nodes
+    if (m_lag == 0) {
+        RecvTireForces(step_number);
+        SendWheelStates();
+    } else {
+        SendWheelStates();
+        if (step_number > 0)
+            RecvTireForces(step_number - 1);
+    }
+    m_cum_wait_time += m_wait_timer();
+
+    // Synchronize vehicle, powertrain, and driver
+    m_vehicle->Synchronize(time, steering, braking, powertrain_torque, m_tire_forces);
+    m_powertrain->Synchronize(time, throttle, driveshaft_speed);
+    m_driver->Synchronize(time);
+}
+
+// Receive tire forces (sent at the specified step) from each of the tire nodes.
+// With extrapolation of lagged forces, the forces and moments are extrapolated
+// linearly from the ones received at the two previous steps.
+void VehicleNode::RecvTireForces(int step_number) {
+    bool extrapolate = (m_lag > 0) && m_extrapolate && step_number > 0;
     double bufTF[9];
     MPI_Status statusTF;
     for (int iw = 0; iw < m_num_wheels; iw++) {
+        m_wait_timer.start();
         MPI_Recv(bufTF, 9, MPI_DOUBLE, TIRE_NODE_RANK(iw), iw, MPI_COMM_WORLD, &statusTF);
-        m_tire_forces[iw].force = ChVector<>(bufTF[0], bufTF[1], bufTF[2]);
-        m_tire_forces[iw].moment = ChVector<>(bufTF[3], bufTF[4], bufTF[5]);
-        m_tire_forces[iw].point = ChVector<>(bufTF[6], bufTF[7], bufTF[8]);
+        m_wait_timer.stop();
+        TireForce tire_force;
+        tire_force.force = ChVector<>(bufTF[0], bufTF[1], bufTF[2]);
+        tire_force.moment = ChVector<>(bufTF[3], bufTF[4], bufTF[5]);
+        tire_force.point = ChVector<>(bufTF[6], bufTF[7], bufTF[8]);
+        m_tire_forces[iw] = tire_force;
+        if (extrapolate) {
+            m_tire_forces[iw].force = 2.0 * tire_force.force - m_prev_tire_forces[iw].force;
+            m_tire_forces[iw].moment = 2.0 * tire_force.moment - m_prev_tire_forces[iw].moment;
+        }
+        m_prev_tire_forces[iw] = tire_force;
     }
+}
 
-    // Send complete wheel states to each of the tire nodes
+// Send complete wheel states to each of the tire nodes
+void VehicleNode::SendWheelStates() {
     double bufWS[14];
     for (int iw = 0; iw < m_num_wheels; iw++) {
         WheelState wheel_state = m_vehicle->GetWheelState(WheelID(iw));
@@ -236,11 +275,20 @@ void VehicleNode::Synchronize(int step_number, double time) {
         bufWS[13] = wheel_state.omega;
         MPI_Send(bufWS, 14, MPI_DOUBLE, TIRE_NODE_RANK(iw), iw, MPI_COMM_WORLD);
     }
+}
 
-    // Synchronize vehicle, powertrain, and driver
-    m_vehicle->Synchronize(time, steering, braking, powertrain_torque, m_tire_forces);
-    m_powertrain->Synchronize(time, throttle, driveshaft_speed);
-    m_driver->Synchronize(time);
+// -----------------------------------------------------------------------------
+// Finalization of the vehicle node: with lagged coupling, receive the tire
+// forces sent at the last synchronization.
+// -----------------------------------------------------------------------------
+void VehicleNode::Finalize() {
+    if (m_lag == 0 || m_last_step < 0)
+        return;
+
+    double bufTF[9];
+    MPI_Status statusTF;
+    for (int iw = 0; iw < m_num_wheels; iw++)
+        MPI_Recv(bufTF, 9, MPI_DOUBLE, TIRE_NODE_RANK(iw), iw, MPI_COMM_WORLD, &statusTF);
 }
 
 // -----------------------------------------------------------------------------
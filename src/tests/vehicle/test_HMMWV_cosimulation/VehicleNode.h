@@ -70,6 +70,10 @@ class VehicleNode : public BaseNode {
     /// integration steps as required, but no inter-node communication should occur.
     virtual void Advance(double step_size) override;
 
+    /// Finalize this node.
+    /// With lagged coupling, this function receives the data sent at the last synchronization.
+    virtual void Finalize() override;
+
     /// Output logging and debugging data.
     virtual void OutputData(int frame) override;
 
@@ -86,10 +90,17 @@ class VehicleNode : public BaseNode {
     chrono::vehicle::ChDriver* m_driver;                     ///< driver system
 
     int m_num_wheels;                           ///< number of vehicle wheels
-    chrono::vehicle::TireForces m_tire_forces;  ///< forces received from tire nodes
+    chrono::vehicle::TireForces m_tire_forces;       ///< forces received from tire nodes
+    chrono::vehicle::TireForces m_prev_tire_forces;  ///< forces received at the previous step
+    int m_last_step;                                 ///< number of the last synchronization step
 
     // Private methods
 
+    // Receive the tire forces sent at the specified step
+    void RecvTireForces(int step_number);
+    // Send the current wheel states
+    void SendWheelStates();
+
     // Write node state information
     void WriteStateInformation(chrono::utils::CSV_writer& csv);
 };
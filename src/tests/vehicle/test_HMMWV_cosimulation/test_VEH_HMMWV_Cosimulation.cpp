@@ -69,6 +69,8 @@ enum {
     OPT_COHESION,
     OPT_INIT_VEL,
     OPT_INIT_OMEGA,
+    OPT_COUPLING_LAG,
+    OPT_EXTRAPOLATE,
     OPT_SUFFIX
 };
 
@@ -91,6 +93,8 @@ CSimpleOptA::SOption g_options[] = {{OPT_THREADS_TIRE, "--num-threads-tire", SO_
                                     {OPT_INIT_VEL, "--initial-fwd-velocity", SO_REQ_CMB},
                                     {OPT_INIT_OMEGA, "-o", SO_REQ_CMB},
                                     {OPT_INIT_OMEGA, "--initial-wheel-omega", SO_REQ_CMB},
+                                    {OPT_COUPLING_LAG, "--coupling-lag", SO_REQ_CMB},
+                                    {OPT_EXTRAPOLATE, "--extrapolate-forces", SO_NONE},
                                     {OPT_SUFFIX, "--suffix", SO_REQ_CMB},
                                     {OPT_HELP, "-?", SO_NONE},
                                     {OPT_HELP, "-h", SO_NONE},
@@ -111,6 +115,8 @@ bool GetProblemSpecs(int argc,
                      bool& use_checkpoint,
                      bool& output,
                      bool& render,
+                     int& coupling_lag,
+                     bool& extrapolate,
                      std::string& suffix);
 
 // =============================================================================
@@ -154,9 +160,11 @@ int main(int argc, char** argv) {
     bool use_checkpoint = false;
     bool output = true;
     bool render = true;
+    int coupling_lag = 0;
+    bool extrapolate = false;
     std::string suffix = "";
     if (!GetProblemSpecs(argc, argv, rank, nthreads_tire, nthreads_terrain, sim_time, coh_pressure, init_fwd_vel,
-                         init_wheel_omega, use_checkpoint, output, render, suffix)) {
+                         init_wheel_omega, use_checkpoint, output, render, coupling_lag, extrapolate, suffix)) {
         MPI_Finalize();
         return 1;
     }
@@ -289,6 +297,39 @@ int main(int argc, char** argv) {
             break;
     }
 
+    // Create the channel for the exchange of tire mesh data between the tire nodes and the
+    // terrain node (collective call). If all ranks run on the same host, the mesh data is
+    // exchanged through shared memory.
+    TireMeshChannel* mesh_channel = nullptr;
+    BaseNode* my_node = nullptr;
+    switch (rank) {
+        case VEHICLE_NODE_RANK:
+            mesh_channel = new TireMeshChannel(4, 0, 0, coupling_lag);
+            my_node = my_vehicle;
+            break;
+        case TERRAIN_NODE_RANK:
+            mesh_channel = new TireMeshChannel(4, 0, 0, coupling_lag);
+            my_terrain->SetMeshChannel(mesh_channel);
+            my_node = my_terrain;
+            cout << my_terrain->GetPrefix() << " mesh data exchange: "
+                 << (mesh_channel->IsShared() ? "shared memory" : "messages") << endl;
+            break;
+        case TIRE_NODE_RANK(0):
+        case TIRE_NODE_RANK(1):
+        case TIRE_NODE_RANK(2):
+        case TIRE_NODE_RANK(3):
+            mesh_channel =
+                new TireMeshChannel(4, my_tire->GetNumVertices(), my_tire->GetNumTriangles(), coupling_lag);
+            my_tire->SetMeshChannel(mesh_channel);
+            my_node = my_tire;
+            break;
+    }
+
+    // Set the coupling scheme. With lagged coupling, the nodes are not kept in lock-step:
+    // each node only waits for the data it needs, sent by the other nodes at the previous step.
+    my_node->SetCouplingLag(coupling_lag);
+    my_node->EnableForceExtrapolation(extrapolate);
+
     // Perform co-simulation.
     // At synchronization, there is bi-directional data exchange:
     //     tire => terrain (vertex state information)
@@ -301,7 +342,8 @@ int main(int argc, char** argv) {
     for (int is = 0; is < sim_steps; is++) {
         double time = is * step_size;
 
-        MPI_Barrier(MPI_COMM_WORLD);
+        if (coupling_lag == 0)
+            MPI_Barrier(MPI_COMM_WORLD);
 
         switch (rank) {
             case VEHICLE_NODE_RANK: {
@@ -356,10 +398,16 @@ int main(int argc, char** argv) {
         }
     }
 
+    // Complete the data exchange and report the time spent computing and waiting for other nodes.
+    my_node->Finalize();
+    cout << my_node->GetPrefix() << " total compute time = " << my_node->GetTotalSimTime()
+         << "  total wait time = " << my_node->GetTotalWaitTime() << endl;
+
     // Cleanup.
     delete my_vehicle;
     delete my_terrain;
     delete my_tire;
+    delete mesh_channel;
 
     MPI_Finalize();
 
@@ -395,6 +443,11 @@ void ShowUsage() {
     cout << "        Disable generation of output files" << endl;
     cout << " --no-rendering" << endl;
     cout << "        Disable OpenGL rendering" << endl;
+    cout << " --coupling-lag=LAG" << endl;
+    cout << "        Specify the coupling lag in co-simulation steps, 0 (lock-step) or 1 (concurrent nodes)" << endl;
+    cout << "        [default: 0]" << endl;
+    cout << " --extrapolate-forces" << endl;
+    cout << "        Extrapolate the lagged coupling forces (only with a coupling lag of 1)" << endl;
     cout << " --suffix=SUFFIX" << endl;
     cout << "        Specify suffix for output directory names [default: \"\"]" << endl;
     cout << " -? -h --help" << endl;
@@ -414,6 +467,8 @@ bool GetProblemSpecs(int argc,
                      bool& use_checkpoint,
                      bool& output,
                      bool& render,
+                     int& coupling_lag,
+                     bool& extrapolate,
                      std::string& suffix) {
     // Create the option parser and pass it the program arguments and the array of valid options.
     CSimpleOptA args(argc, argv, g_options);
@@ -463,6 +518,19 @@ bool GetProblemSpecs(int argc,
             case OPT_INIT_OMEGA:
                 init_wheel_omega = std::stod(args.OptionArg());
                 break;
+            case OPT_COUPLING_LAG:
+                coupling_lag = std::stoi(args.OptionArg());
+                if (coupling_lag != 0 && coupling_lag != 1) {
+                    if (rank == 0) {
+                        cout << "Invalid coupling lag: " << args.OptionArg() << " (must be 0 or 1)" << endl;
+                        ShowUsage();
+                    }
+                    return false;
+                }
+                break;
+            case OPT_EXTRAPOLATE:
+                extrapolate = true;
+                break;
             case OPT_SUFFIX:
                 suffix = args.OptionArg();
                 break;
@@ -0,0 +1,217 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2015 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Test of the tire mesh channel of the HMMWV co-simulation (TireMeshChannel),
+// without the vehicle, tire, and terrain models. To be run with at least 3 MPI
+// ranks, e.g.:
+//    mpiexec -n 6 test_VEH_TireMeshChannel
+// Rank 1 plays the terrain node and ranks 2 and above the tire nodes (rank 0,
+// the vehicle node, only takes part in the collective calls). At each step,
+// each tire node packs vertex data and connectivity which depend on the step
+// and on the tire, with tire meshes of different sizes. The terrain node checks
+// the data of each tire, which must arrive exactly once per step, and sends
+// back forces computed from it, for a number of vertices which varies with the
+// step (including none and all of them), which the tire node then checks.
+// Random delays on all nodes shuffle the order in which the tire data arrives.
+// This is done with and without coupling lag, through shared memory (if all
+// ranks run on the same host) and with point-to-point messages.
+//
+// =============================================================================
+
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include "mpi.h"
+
+#include "BaseNode.h"
+#include "TireMeshChannel.h"
+
+using std::cout;
+using std::endl;
+
+// Number of exchange steps of each run
+const int num_steps = 50;
+
+// Values packed by the tire nodes and by the terrain node
+double VertexValue(int which, int step, unsigned int i) {
+    return step * 1e6 + which * 1e5 + i;
+}
+
+int TriangleValue(int which, int step, unsigned int i) {
+    return 7 * step + 3 * which + (int)i;
+}
+
+double ForceValue(double vertex_value) {
+    return -0.5 * vertex_value;
+}
+
+int ForceCount(int which, int step, unsigned int num_vert) {
+    return (5 * step + which) % (num_vert + 1);
+}
+
+// Wait for up to the specified number of microseconds.
+void RandomDelay(int max_delay) {
+    std::this_thread::sleep_for(std::chrono::microseconds(std::rand() % max_delay));
+}
+
+// Tire node: pack the data of each step and check the forces received for it.
+int TireNode(TireMeshChannel& channel, int which, int lag) {
+    unsigned int num_vert = channel.GetNumVertices(which);
+    unsigned int num_tri = channel.GetNumTriangles(which);
+    int num_errors = 0;
+
+    for (int step = 0; step < num_steps + lag; step++) {
+        if (step < num_steps) {
+            double* vert_data = channel.VertexData(which, step);
+            int* tri_data = channel.TriangleData(which, step);
+            for (unsigned int i = 0; i < 6 * num_vert; i++)
+                vert_data[i] = VertexValue(which, step, i);
+            for (unsigned int i = 0; i < 3 * num_tri; i++)
+                tri_data[i] = TriangleValue(which, step, i);
+            channel.SendVertexData(which, step);
+        }
+
+        // With lagged coupling, the forces of the previous step
+        int force_step = step - lag;
+        if (force_step < 0)
+            continue;
+        int count = channel.RecvForceData(which, force_step);
+        if (count != ForceCount(which, force_step, num_vert)) {
+            num_errors++;
+            continue;
+        }
+        const int* index_data = channel.IndexData(which, force_step);
+        const double* force_data = channel.ForceData(which, force_step);
+        for (int k = 0; k < count; k++) {
+            unsigned int i = num_vert - 1 - k;
+            if (index_data[k] != (int)i || force_data[3 * k + 2] != ForceValue(VertexValue(which, force_step, i)))
+                num_errors++;
+        }
+
+        RandomDelay(2000);
+    }
+
+    return num_errors;
+}
+
+// Terrain node: check the data of each tire and send back the forces.
+int TerrainNode(TireMeshChannel& channel, int num_tires) {
+    int num_errors = 0;
+
+    for (int step = 0; step < num_steps; step++) {
+        std::vector<int> num_received(num_tires, 0);
+        channel.StartRecvVertexData(step);
+        int which;
+        while ((which = channel.WaitVertexData()) >= 0) {
+            num_received[which]++;
+            const double* vert_data = channel.VertexData(which, step);
+            const int* tri_data = channel.TriangleData(which, step);
+            for (unsigned int i = 0; i < 6 * channel.GetNumVertices(which); i++) {
+                if (vert_data[i] != VertexValue(which, step, i))
+                    num_errors++;
+            }
+            for (unsigned int i = 0; i < 3 * channel.GetNumTriangles(which); i++) {
+                if (tri_data[i] != TriangleValue(which, step, i))
+                    num_errors++;
+            }
+        }
+
+        for (which = 0; which < num_tires; which++) {
+            if (num_received[which] != 1)
+                num_errors++;
+            unsigned int num_vert = channel.GetNumVertices(which);
+            int count = ForceCount(which, step, num_vert);
+            int* index_data = channel.IndexData(which, step);
+            double* force_data = channel.ForceData(which, step);
+            for (int k = 0; k < count; k++) {
+                unsigned int i = num_vert - 1 - k;
+                index_data[k] = i;
+                force_data[3 * k + 0] = 0;
+                force_data[3 * k + 1] = 0;
+                force_data[3 * k + 2] = ForceValue(channel.VertexData(which, step)[i]);
+            }
+            channel.SendForceData(which, step, count);
+        }
+
+        RandomDelay(3000);
+    }
+
+    return num_errors;
+}
+
+// Exchange the data of all steps through a new channel. Return the total number of errors (on rank 0).
+int Run(int lag, bool allow_shared, bool& shared) {
+    int rank;
+    int size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    int num_tires = size - TIRE_NODE_RANK(0);
+
+    unsigned int num_vert = 0;
+    unsigned int num_tri = 0;
+    if (rank >= TIRE_NODE_RANK(0)) {
+        num_vert = 200 + 37 * rank;
+        num_tri = 2 * num_vert;
+    }
+
+    int num_errors = 0;
+    {
+        TireMeshChannel channel(num_tires, num_vert, num_tri, lag, allow_shared);
+        if (rank == TERRAIN_NODE_RANK)
+            num_errors = TerrainNode(channel, num_tires);
+        else if (rank >= TIRE_NODE_RANK(0))
+            num_errors = TireNode(channel, rank - TIRE_NODE_RANK(0), lag);
+        shared = channel.IsShared();
+    }
+
+    int total_errors;
+    MPI_Reduce(&num_errors, &total_errors, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+    return total_errors;
+}
+
+int main(int argc, char** argv) {
+    MPI_Init(&argc, &argv);
+
+    int rank;
+    int size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    if (size <= TIRE_NODE_RANK(0)) {
+        if (rank == 0)
+            cout << "This test requires at least " << TIRE_NODE_RANK(0) + 1 << " MPI ranks" << endl;
+        MPI_Finalize();
+        return 1;
+    }
+    std::srand(rank + 1);
+
+    bool passed = true;
+    for (int lag = 0; lag <= 1; lag++) {
+        for (int allow_shared = 1; allow_shared >= 0; allow_shared--) {
+            bool shared;
+            int num_errors = Run(lag, allow_shared != 0, shared);
+            if (rank != 0)
+                continue;
+            cout << "lag " << lag << ", " << (shared ? "shared memory" : "messages") << ": " << num_errors
+                 << " errors" << endl;
+            if (num_errors > 0 || (shared && !allow_shared))
+                passed = false;
+        }
+    }
+
+    if (rank == 0)
+        cout << (passed ? "Test passed" : "Test failed") << endl;
+
+    MPI_Finalize();
+    return passed ? 0 : 1;
+}
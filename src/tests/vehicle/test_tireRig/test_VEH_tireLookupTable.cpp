@@ -0,0 +1,441 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Generation of the steady-state response tables of a tire model, for use with
+// the lookup table tire (LookupTire).
+//
+// The tire (any template specified through a JSON file, typically an FEA-based
+// tire) is run on a simplified tire test rig through a design of experiments
+// over the normal load, longitudinal slip, slip angle, and camber angle. For
+// each operating point, a new rig is created which imposes the forward speed,
+// the orientation of the wheel (slip and camber angles), and the wheel angular
+// speed (longitudinal slip), while the normal load is applied on the wheel
+// carrier, free to move vertically. After the tire response has settled, the
+// tire forces and moments are averaged over a time window, reduced to the
+// contact point, and expressed in the contact frame.
+//
+// The global reference frame has Z up, X towards the front of the vehicle, and
+// Y pointing to the left.
+//
+// =============================================================================
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+
+#include "chrono/ChConfig.h"
+#include "chrono/physics/ChSystemDEM.h"
+#include "chrono/physics/ChLinkEngine.h"
+#include "chrono/physics/ChLinkLinActuator.h"
+#include "chrono/physics/ChLinkLock.h"
+
+#include "chrono_vehicle/ChVehicleModelData.h"
+#include "chrono_vehicle/terrain/RigidTerrain.h"
+#include "chrono_vehicle/wheeled_vehicle/tire/FialaTire.h"
+
+#ifdef CHRONO_FEA
+#include "chrono_vehicle/wheeled_vehicle/tire/ANCFTire.h"
+#include "chrono_vehicle/wheeled_vehicle/tire/ReissnerTire.h"
+#include "chrono_vehicle/wheeled_vehicle/tire/FEATire.h"
+#endif
+
+#ifdef CHRONO_MKL
+#include "chrono_mkl/ChSolverMKL.h"
+#endif
+
+#include "chrono_thirdparty/rapidjson/document.h"
+#include "chrono_thirdparty/rapidjson/filereadstream.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+// =============================================================================
+// USER SETTINGS
+// =============================================================================
+
+// JSON file for the tire model (template ANCFTire, ReissnerTire, FEATire, or FialaTire)
+std::string tire_file("hmmwv/tire/HMMWV_ANCFTire.json");
+
+// Output JSON file for the lookup table tire
+std::string out_file("LookupTire.json");
+
+// Design of experiments: normal loads [N], longitudinal slips, slip angles [deg], camber angles [deg]
+std::vector<double> Fz_grid = {2000, 4000, 6000, 8000};
+std::vector<double> kappa_grid = {-0.2, -0.1, -0.05, -0.02, 0, 0.02, 0.05, 0.1, 0.2};
+std::vector<double> alpha_grid = {-12, -6, -3, -1, 0, 1, 3, 6, 12};
+std::vector<double> gamma_grid = {-4, 0, 4};
+
+// Forward speed of the rig [m/s]
+double speed = 10;
+
+// Simulation time before the response is averaged and length of the averaging window [s]
+double settle_time = 0.5;
+double average_time = 0.25;
+
+// Integration step size for FEA-based tires and for all other tires [s]
+double step_size_fea = 1e-4;
+double step_size = 1e-3;
+
+// Mass and vertical damping of the wheel carrier
+double carrier_mass = 10;
+double carrier_damping = 5e3;
+
+// Parameters of the lookup tire which are not obtained from the steady-state response
+double tire_damping = 500;
+double relax_length_x = 0.1;
+double relax_length_y = 0.3;
+
+// =============================================================================
+
+// Averaged tire response at one operating point.
+struct TireResponse {
+    ChVector<> force;   // force at the contact point, in the contact frame
+    ChVector<> moment;  // moment about the contact point, in the contact frame
+    double deflection;  // tire deflection (with respect to the unloaded radius)
+};
+
+// Create a tire from the specified JSON document. Return an empty pointer if the
+// tire template is not supported.
+std::shared_ptr<ChTire> CreateTire(const rapidjson::Document& d, bool& fea_tire, double& width) {
+    std::string tire_template = d["Template"].GetString();
+
+    if (tire_template.compare("FialaTire") == 0) {
+        auto tire = std::make_shared<FialaTire>(d);
+        fea_tire = false;
+        width = tire->GetWidth();
+        return tire;
+    }
+
+#ifdef CHRONO_FEA
+    std::shared_ptr<ChDeformableTire> tire;
+    if (tire_template.compare("ANCFTire") == 0) {
+        tire = std::make_shared<ANCFTire>(d);
+    } else if (tire_template.compare("ReissnerTire") == 0) {
+        tire = std::make_shared<ReissnerTire>(d);
+    } else if (tire_template.compare("FEATire") == 0) {
+        tire = std::make_shared<FEATire>(d);
+    }
+    if (tire) {
+        tire->EnablePressure(true);
+        tire->EnableContact(true);
+        tire->EnableRimConnection(true);
+        fea_tire = true;
+        width = tire->GetWidth();
+        return tire;
+    }
+#endif
+
+    return std::shared_ptr<ChTire>();
+}
+
+// Set the solver and integrator (MKL and HHT for FEA-based tires, if available).
+void SetSolver(ChSystem& system, bool fea_tire) {
+#ifdef CHRONO_MKL
+    if (fea_tire) {
+        ChSolverMKL<>* mkl_solver_stab = new ChSolverMKL<>;
+        ChSolverMKL<>* mkl_solver_speed = new ChSolverMKL<>;
+        system.ChangeSolverStab(mkl_solver_stab);
+        system.ChangeSolverSpeed(mkl_solver_speed);
+        mkl_solver_speed->SetSparsityPatternLock(true);
+        mkl_solver_stab->SetSparsityPatternLock(true);
+
+        system.SetIntegrationType(ChSystem::INT_HHT);
+        auto integrator = std::static_pointer_cast<ChTimestepperHHT>(system.GetTimestepper());
+        integrator->SetAlpha(-0.2);
+        integrator->SetMaxiters(50);
+        integrator->SetAbsTolerances(5e-05, 1.8e00);
+        integrator->SetMode(ChTimestepperHHT::POSITION);
+        integrator->SetModifiedNewton(false);
+        integrator->SetScaling(true);
+        integrator->SetVerbose(false);
+        return;
+    }
+#endif
+
+    system.SetIntegrationType(ChSystem::INT_EULER_IMPLICIT_LINEARIZED);
+    system.SetMaxItersSolverSpeed(100);
+    system.SetMaxItersSolverStab(100);
+    system.SetSolverType(ChSystem::SOLVER_SOR);
+    system.SetTol(1e-10);
+    system.SetTolForce(1e-8);
+}
+
+// Run the tire on the rig at the specified operating point and return the averaged response.
+TireResponse RunTest(const rapidjson::Document& d, double Fz, double kappa, double alpha, double gamma) {
+    // Create the system (no gravity; the normal load is applied on the wheel carrier)
+    ChSystemDEM system;
+    system.SetContactForceModel(ChSystemDEM::ContactForceModel::PlainCoulomb);
+    system.UseMaterialProperties(false);
+    system.Set_G_acc(ChVector<>(0, 0, 0));
+
+    // Create the tire and set the rig kinematics
+    bool fea_tire;
+    double width;
+    auto tire = CreateTire(d, fea_tire, width);
+    double radius = tire->GetRadius();
+    double step = fea_tire ? step_size_fea : step_size;
+
+    ChQuaternion<> wheel_rot = Q_from_AngZ(-alpha) * Q_from_AngX(gamma);
+    ChVector<> wheel_pos(0, 0, radius);
+    double omega = speed * std::cos(alpha) * (1 + kappa) / radius;
+
+    // Create the rig bodies
+    //   ground        ==prismatic_x==>  chassis  (imposed forward speed)
+    //   chassis       ==prismatic_z==>  carrier  (normal load)
+    //   carrier       ==engine_y==>     rim      (slip and camber angles, imposed angular speed)
+    auto ground = std::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    ground->SetCollide(false);
+    system.AddBody(ground);
+
+    auto chassis = std::make_shared<ChBody>();
+    chassis->SetPos(wheel_pos);
+    chassis->SetPos_dt(ChVector<>(speed, 0, 0));
+    chassis->SetMass(1);
+    system.AddBody(chassis);
+
+    auto carrier = std::make_shared<ChBody>();
+    carrier->SetPos(wheel_pos);
+    carrier->SetPos_dt(ChVector<>(speed, 0, 0));
+    carrier->SetMass(carrier_mass);
+    system.AddBody(carrier);
+
+    auto rim = std::make_shared<ChBody>();
+    rim->SetPos(wheel_pos);
+    rim->SetRot(wheel_rot);
+    rim->SetPos_dt(ChVector<>(speed, 0, 0));
+    rim->SetWvel_loc(ChVector<>(0, omega, 0));
+    rim->SetMass(10);
+    rim->SetInertiaXX(ChVector<>(1, 1, 1));
+    system.AddBody(rim);
+
+    auto prismatic_x = std::make_shared<ChLinkLockPrismatic>();
+    prismatic_x->Initialize(chassis, ground, ChCoordsys<>(wheel_pos, Q_from_AngY(CH_C_PI_2)));
+    system.AddLink(prismatic_x);
+
+    auto actuator = std::make_shared<ChLinkLinActuator>();
+    actuator->Initialize(ground, chassis, false, ChCoordsys<>(wheel_pos, QUNIT),
+                         ChCoordsys<>(wheel_pos + ChVector<>(1, 0, 0), QUNIT));
+    actuator->Set_lin_offset(1);
+    actuator->Set_dist_funct(std::make_shared<ChFunction_Ramp>(0.0, speed));
+    system.AddLink(actuator);
+
+    auto prismatic_z = std::make_shared<ChLinkLockPrismatic>();
+    prismatic_z->Initialize(carrier, chassis, ChCoordsys<>(wheel_pos, QUNIT));
+    system.AddLink(prismatic_z);
+
+    // The engine axis (Z axis of the link frame) is the wheel spin axis (Y axis of the wheel frame)
+    auto engine = std::make_shared<ChLinkEngine>();
+    engine->Initialize(rim, carrier, ChCoordsys<>(wheel_pos, wheel_rot * Q_from_AngX(-CH_C_PI_2)));
+    engine->Set_eng_mode(ChLinkEngine::ENG_MODE_SPEED);
+    engine->Set_spe_funct(std::make_shared<ChFunction_Const>(omega));
+    system.AddLink(engine);
+
+    // Initialize the tire (after setting the rim state, so that FEA nodes get the rim velocity)
+    tire->Initialize(rim, LEFT);
+
+    // Create the terrain
+    RigidTerrain terrain(&system);
+    terrain.SetContactFrictionCoefficient(0.9f);
+    terrain.SetContactRestitutionCoefficient(0.01f);
+    terrain.SetContactMaterialProperties(2e6f, 0.3f);
+    terrain.Initialize(0, 2 * speed * (settle_time + average_time) + 10, 4);
+
+    system.SetupInitial();
+    SetSolver(system, fea_tire);
+
+    // Simulate and average the tire response
+    TireResponse response;
+    response.force = ChVector<>(0, 0, 0);
+    response.moment = ChVector<>(0, 0, 0);
+    response.deflection = 0;
+    int num_samples = 0;
+
+    double time = 0;
+    while (time < settle_time + average_time) {
+        WheelState wheel_state;
+        wheel_state.pos = rim->GetPos();
+        wheel_state.rot = rim->GetRot();
+        wheel_state.lin_vel = rim->GetPos_dt();
+        wheel_state.ang_vel = rim->GetWvel_par();
+        wheel_state.omega = rim->GetWvel_loc().y;
+
+        // Tire force from the last call to Advance (the tire force is reset in Synchronize)
+        TireForce tire_force = tire->GetTireForce();
+        tire->Synchronize(time, wheel_state, terrain);
+
+        carrier->Empty_forces_accumulators();
+        carrier->Accumulate_force(ChVector<>(0, 0, -Fz - carrier_damping * carrier->GetPos_dt().z),
+                                  carrier->GetPos(), false);
+
+        if (!fea_tire) {
+            rim->Empty_forces_accumulators();
+            rim->Accumulate_force(tire_force.force, tire_force.point, false);
+            rim->Accumulate_torque(tire_force.moment, false);
+        }
+
+        system.DoStepDynamics(step);
+        tire->Advance(step);
+        time += step;
+
+        if (time <= settle_time)
+            continue;
+
+        // Contact frame (flat terrain at zero height) and contact point (lowest point of the
+        // undeformed tire, projected onto the terrain), consistent with the lookup tire.
+        tire_force = tire->GetTireForce(true);
+        ChVector<> normal = rim->GetRot().GetYaxis();
+        ChVector<> Z_dir(0, 0, 1);
+        ChVector<> X_dir = Vcross(normal, Z_dir);
+        X_dir.Normalize();
+        ChVector<> Y_dir = Vcross(Z_dir, X_dir);
+        ChVector<> lowest = tire_force.point + radius * Vcross(normal, X_dir);
+        ChVector<> contact(lowest.x, lowest.y, 0);
+
+        ChVector<> moment = tire_force.moment + Vcross(tire_force.point - contact, tire_force.force);
+
+        response.force += ChVector<>(Vdot(tire_force.force, X_dir), Vdot(tire_force.force, Y_dir),
+                                     Vdot(tire_force.force, Z_dir));
+        response.moment += ChVector<>(Vdot(moment, X_dir), Vdot(moment, Y_dir), Vdot(moment, Z_dir));
+        response.deflection -= lowest.z;
+        num_samples++;
+    }
+
+    response.force *= 1.0 / num_samples;
+    response.moment *= 1.0 / num_samples;
+    response.deflection /= num_samples;
+
+    return response;
+}
+
+// Return the index of the grid value closest to zero.
+size_t ClosestToZero(const std::vector<double>& grid) {
+    size_t index = 0;
+    for (size_t i = 1; i < grid.size(); i++) {
+        if (std::abs(grid[i]) < std::abs(grid[index]))
+            index = i;
+    }
+    return index;
+}
+
+// Write an array of values in JSON format.
+void WriteArray(std::ofstream& out, const std::string& name, const std::vector<double>& values, bool last = false) {
+    out << "    \"" << name << "\": [";
+    for (size_t i = 0; i < values.size(); i++) {
+        out << (i > 0 ? ", " : "") << values[i];
+    }
+    out << "]" << (last ? "" : ",") << "\n";
+}
+
+// =============================================================================
+
+int main(int argc, char* argv[]) {
+    // Read the tire specification file
+    std::string filename = vehicle::GetDataFile(tire_file);
+    FILE* fp = fopen(filename.c_str(), "r");
+    if (!fp) {
+        std::cout << "Cannot open tire file " << filename << std::endl;
+        return 1;
+    }
+
+    char readBuffer[65536];
+    rapidjson::FileReadStream is(fp, readBuffer, sizeof(readBuffer));
+    rapidjson::Document d;
+    d.ParseStream(is);
+    fclose(fp);
+
+    bool fea_tire;
+    double width;
+    auto tire = CreateTire(d, fea_tire, width);
+    if (!tire) {
+        std::cout << "Unsupported tire template " << d["Template"].GetString() << std::endl;
+        return 1;
+    }
+    double radius = tire->GetRadius();
+
+    // Convert angles to radians
+    std::vector<double> alpha_rad(alpha_grid.size());
+    std::vector<double> gamma_rad(gamma_grid.size());
+    for (size_t i = 0; i < alpha_grid.size(); i++)
+        alpha_rad[i] = alpha_grid[i] * CH_C_DEG_TO_RAD;
+    for (size_t i = 0; i < gamma_grid.size(); i++)
+        gamma_rad[i] = gamma_grid[i] * CH_C_DEG_TO_RAD;
+
+    // Run the design of experiments. The deflection at each normal load is measured
+    // at the operating point closest to free rolling.
+    size_t iK0 = ClosestToZero(kappa_grid);
+    size_t iA0 = ClosestToZero(alpha_grid);
+    size_t iG0 = ClosestToZero(gamma_grid);
+
+    std::vector<double> deflection(Fz_grid.size());
+    std::vector<double> Fx, Fy, Mx, My, Mz;
+
+    for (size_t iFz = 0; iFz < Fz_grid.size(); iFz++) {
+        for (size_t iK = 0; iK < kappa_grid.size(); iK++) {
+            for (size_t iA = 0; iA < alpha_grid.size(); iA++) {
+                for (size_t iG = 0; iG < gamma_grid.size(); iG++) {
+                    TireResponse r = RunTest(d, Fz_grid[iFz], kappa_grid[iK], alpha_rad[iA], gamma_rad[iG]);
+
+                    Fx.push_back(r.force.x);
+                    Fy.push_back(r.force.y);
+                    Mx.push_back(r.moment.x);
+                    My.push_back(r.moment.y);
+                    Mz.push_back(r.moment.z);
+                    if (iK == iK0 && iA == iA0 && iG == iG0)
+                        deflection[iFz] = r.deflection;
+
+                    std::cout << "Fz = " << Fz_grid[iFz] << "  kappa = " << kappa_grid[iK]
+                              << "  alpha = " << alpha_grid[iA] << "  gamma = " << gamma_grid[iG]
+                              << "   F = " << r.force.x << " " << r.force.y << " " << r.force.z
+                              << "   M = " << r.moment.x << " " << r.moment.y << " " << r.moment.z
+                              << "   deflection = " << r.deflection << std::endl;
+                }
+            }
+        }
+    }
+
+    // Write the lookup table tire specification file
+    std::ofstream out(out_file);
+    out << std::setprecision(8);
+    out << "{\n";
+    out << "  \"Name\":     \"Lookup Tire (" << d["Name"].GetString() << ")\",\n";
+    out << "  \"Type\":     \"Tire\",\n";
+    out << "  \"Template\": \"LookupTire\",\n";
+    out << "\n";
+    out << "  \"Lookup Parameters\": {\n";
+    out << "    \"Unloaded Radius\":     " << radius << ",\n";
+    out << "    \"Width\":               " << width << ",\n";
+    out << "    \"Vertical Damping\":    " << tire_damping << ",\n";
+    out << "    \"X Relaxation Length\": " << relax_length_x << ",\n";
+    out << "    \"Y Relaxation Length\": " << relax_length_y << "\n";
+    out << "  },\n";
+    out << "\n";
+    out << "  \"Lookup Table\": {\n";
+    WriteArray(out, "Normal Force", Fz_grid);
+    WriteArray(out, "Longitudinal Slip", kappa_grid);
+    WriteArray(out, "Slip Angle", alpha_rad);
+    WriteArray(out, "Camber Angle", gamma_rad);
+    WriteArray(out, "Deflection", deflection);
+    WriteArray(out, "Fx", Fx);
+    WriteArray(out, "Fy", Fy);
+    WriteArray(out, "Mx", Mx);
+    WriteArray(out, "My", My);
+    WriteArray(out, "Mz", Mz, true);
+    out << "  }\n";
+    out << "}\n";
+    out.close();
+
+    std::cout << "Lookup table written to " << out_file << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,271 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Unit test for the EAS solver controls of ChElementBrick and ChElementShellANCF.
+// A cantilever plate, meshed with either element, is bent by a tip force, and:
+//  1) the EAS iteration and solve counters are consistent (one solve per element,
+//     or per layer, at each internal force evaluation; at most the maximum number
+//     of iterations per solve) and are cleared by ResetEASStatistics;
+//  2) SetEASMaxIterations(0) and a very loose SetEASTolerance skip all iterations;
+//  3) freezing the EAS parameters (SetEASFreezeTolerance) lowers the number of EAS
+//     iterations per solve and reproduces the tip trajectory of the unfrozen
+//     solution within tolerance. Freezing is off by default: the stale parameters
+//     cost extra Newton iterations of the integrator (i.e. extra solves), so the
+//     total number of EAS iterations is not necessarily lower.
+// =============================================================================
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "chrono/physics/ChSystem.h"
+#include "chrono/solver/ChSolverMINRES.h"
+#include "chrono_fea/ChElementBrick.h"
+#include "chrono_fea/ChElementShellANCF.h"
+#include "chrono_fea/ChMesh.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+const int num_div_x = 4;
+const int num_div_y = 2;
+const double length_x = 1;
+const double length_y = 0.5;
+const double thickness = 0.01;
+const double step_size = 1e-3;
+
+// EAS settings of a run
+struct Settings {
+    double tolerance = 1e-5;
+    int max_iterations = 100;
+    double freeze_tolerance = 0;
+    int num_steps = 20;
+};
+
+// Results of a run
+struct Results {
+    std::vector<double> tip_z;  // tip displacement at each step
+    long iterations = 0;        // EAS iterations, all elements
+    long solves = 0;            // EAS solves, all elements
+    int num_elements = 0;
+};
+
+// Mesh of bricks, one element through the thickness, clamped at x = 0.
+std::shared_ptr<ChNodeFEAxyz> CreateMesh(std::shared_ptr<ChMesh> mesh,
+                                         std::vector<std::shared_ptr<ChElementBrick> >& elements) {
+    auto material = std::make_shared<ChContinuumElastic>();
+    material->Set_density(500);
+    material->Set_E(2.1e8);
+    material->Set_G(2.1e8 / (2 + 2 * 0.3));
+    material->Set_v(0.3);
+
+    double dx = length_x / num_div_x;
+    double dy = length_y / num_div_y;
+    int layer = (num_div_x + 1) * (num_div_y + 1);
+    for (int iz = 0; iz <= 1; iz++)
+        for (int iy = 0; iy <= num_div_y; iy++)
+            for (int ix = 0; ix <= num_div_x; ix++) {
+                auto node = std::make_shared<ChNodeFEAxyz>(ChVector<>(ix * dx, iy * dy, iz * thickness));
+                node->SetMass(0);
+                node->SetFixed(ix == 0);
+                mesh->AddNode(node);
+            }
+
+    for (int iy = 0; iy < num_div_y; iy++)
+        for (int ix = 0; ix < num_div_x; ix++) {
+            int n0 = ix + (num_div_x + 1) * iy;
+            int nodes[8] = {n0, n0 + 1, n0 + num_div_x + 2, n0 + num_div_x + 1, 0, 0, 0, 0};
+            for (int k = 0; k < 4; k++)
+                nodes[k + 4] = nodes[k] + layer;
+            auto element = std::make_shared<ChElementBrick>();
+            ChMatrixNM<double, 3, 1> dimensions;
+            dimensions(0, 0) = dx;
+            dimensions(1, 0) = dy;
+            dimensions(2, 0) = thickness;
+            element->SetInertFlexVec(dimensions);
+            std::shared_ptr<ChNodeFEAxyz> n[8];
+            for (int k = 0; k < 8; k++)
+                n[k] = std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(nodes[k]));
+            element->SetNodes(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7]);
+            element->SetMaterial(material);
+            element->SetElemNum((int)elements.size());
+            element->SetGravityOn(false);
+            element->SetMooneyRivlin(false);
+            element->SetStockAlpha(0, 0, 0, 0, 0, 0, 0, 0, 0);
+            mesh->AddElement(element);
+            elements.push_back(element);
+        }
+
+    return std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(2 * layer - 1));
+}
+
+// Mesh of single-layer shells, clamped at x = 0.
+std::shared_ptr<ChNodeFEAxyz> CreateMesh(std::shared_ptr<ChMesh> mesh,
+                                         std::vector<std::shared_ptr<ChElementShellANCF> >& elements) {
+    auto material = std::make_shared<ChMaterialShellANCF>(500, 2.1e8, 0.3);
+
+    double dx = length_x / num_div_x;
+    double dy = length_y / num_div_y;
+    for (int iy = 0; iy <= num_div_y; iy++)
+        for (int ix = 0; ix <= num_div_x; ix++) {
+            auto node = std::make_shared<ChNodeFEAxyzD>(ChVector<>(ix * dx, iy * dy, 0), ChVector<>(0, 0, 1));
+            node->SetMass(0);
+            node->SetFixed(ix == 0);
+            mesh->AddNode(node);
+        }
+
+    for (int iy = 0; iy < num_div_y; iy++)
+        for (int ix = 0; ix < num_div_x; ix++) {
+            int n0 = ix + (num_div_x + 1) * iy;
+            auto element = std::make_shared<ChElementShellANCF>();
+            element->SetNodes(std::dynamic_pointer_cast<ChNodeFEAxyzD>(mesh->GetNode(n0)),
+                              std::dynamic_pointer_cast<ChNodeFEAxyzD>(mesh->GetNode(n0 + 1)),
+                              std::dynamic_pointer_cast<ChNodeFEAxyzD>(mesh->GetNode(n0 + num_div_x + 2)),
+                              std::dynamic_pointer_cast<ChNodeFEAxyzD>(mesh->GetNode(n0 + num_div_x + 1)));
+            element->SetDimensions(dx, dy);
+            element->AddLayer(thickness, 0, material);
+            element->SetAlphaDamp(0.08);
+            element->SetGravityOn(false);
+            mesh->AddElement(element);
+            elements.push_back(element);
+        }
+
+    return std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode((num_div_x + 1) * (num_div_y + 1) - 1));
+}
+
+template <class Element>
+Results Simulate(const Settings& settings) {
+    ChSystem system;
+    auto mesh = std::make_shared<ChMesh>();
+    std::vector<std::shared_ptr<Element> > elements;
+    std::shared_ptr<ChNodeFEAxyz> tip = CreateMesh(mesh, elements);
+    for (auto& element : elements) {
+        element->SetEASTolerance(settings.tolerance);
+        element->SetEASMaxIterations(settings.max_iterations);
+        element->SetEASFreezeTolerance(settings.freeze_tolerance);
+    }
+    mesh->SetAutomaticGravity(false);
+    system.Add(mesh);
+
+    system.SetSolverType(ChSystem::SOLVER_MINRES);
+    ChSolverMINRES* solver = (ChSolverMINRES*)system.GetSolverSpeed();
+    solver->SetDiagonalPreconditioning(true);
+    system.SetMaxItersSolverSpeed(1000);
+    system.SetTolForce(1e-9);
+
+    system.SetIntegrationType(ChSystem::INT_HHT);
+    auto stepper = std::static_pointer_cast<ChTimestepperHHT>(system.GetTimestepper());
+    stepper->SetAlpha(-0.2);
+    stepper->SetMaxiters(10);
+    stepper->SetAbsTolerances(1e-9);
+    stepper->SetMode(ChTimestepperHHT::POSITION);
+    stepper->SetScaling(true);
+
+    system.SetupInitial();
+
+    Results results;
+    double z0 = tip->GetPos().z;
+    for (int step = 0; step < settings.num_steps; step++) {
+        double t = system.GetChTime();
+        tip->SetForce(ChVector<>(0, 0, -50 * (1 - std::cos(20 * t))));
+        system.DoStepDynamics(step_size);
+        results.tip_z.push_back(tip->GetPos().z - z0);
+    }
+
+    for (auto& element : elements) {
+        results.iterations += element->GetEASIterations();
+        results.solves += element->GetEASSolves();
+        element->ResetEASStatistics();
+        if (element->GetEASIterations() != 0 || element->GetEASSolves() != 0) {
+            std::cout << "Unit test check failed -- the EAS statistics were not reset" << std::endl;
+            exit(1);
+        }
+    }
+    results.num_elements = (int)elements.size();
+
+    std::cout << "  tolerance " << settings.tolerance << ", max iterations " << settings.max_iterations
+              << ", freeze tolerance " << settings.freeze_tolerance << ": " << results.iterations
+              << " EAS iterations, " << results.solves << " solves, tip displacement " << results.tip_z.back()
+              << std::endl;
+    return results;
+}
+
+template <class Element>
+bool Check(const char* name) {
+    std::cout << name << std::endl;
+
+    Settings defaults;
+    Results ref = Simulate<Element>(defaults);
+    if (ref.solves == 0 || ref.iterations == 0) {
+        std::cout << "Unit test check failed -- " << name << ": no EAS solves or iterations" << std::endl;
+        return false;
+    }
+    if (ref.solves % ref.num_elements != 0 || ref.iterations > defaults.max_iterations * ref.solves) {
+        std::cout << "Unit test check failed -- " << name << ": " << ref.iterations << " iterations in " << ref.solves
+                  << " solves" << std::endl;
+        return false;
+    }
+    if (std::abs(ref.tip_z.back()) < 1e-4) {
+        std::cout << "Unit test check failed -- " << name << ": the plate did not bend" << std::endl;
+        return false;
+    }
+
+    // No EAS iterations when the maximum is 0, or the tolerance is always met (without the EAS
+    // iterations the integrator hardly converges on the bricks, so only a couple of steps)
+    Settings no_iterations;
+    no_iterations.max_iterations = 0;
+    no_iterations.num_steps = 2;
+    Settings loose;
+    loose.tolerance = 1e30;
+    loose.num_steps = 2;
+    for (const Settings& settings : {no_iterations, loose}) {
+        Results results = Simulate<Element>(settings);
+        if (results.iterations != 0 || results.solves == 0) {
+            std::cout << "Unit test check failed -- " << name << ": " << results.iterations
+                      << " iterations in " << results.solves << " solves with no iterations allowed" << std::endl;
+            return false;
+        }
+    }
+
+    // Freezing saves iterations per solve and stays close to the unfrozen solution
+    Settings frozen;
+    frozen.freeze_tolerance = 1e-2;
+    Results results = Simulate<Element>(frozen);
+    if (results.iterations * ref.solves >= ref.iterations * results.solves) {
+        std::cout << "Unit test check failed -- " << name << ": " << results.iterations << " iterations in "
+                  << results.solves << " solves with freezing, " << ref.iterations << " in " << ref.solves
+                  << " without" << std::endl;
+        return false;
+    }
+    double max_tip = 0;
+    double max_diff = 0;
+    for (size_t step = 0; step < ref.tip_z.size(); step++) {
+        max_tip = std::max(max_tip, std::abs(ref.tip_z[step]));
+        max_diff = std::max(max_diff, std::abs(results.tip_z[step] - ref.tip_z[step]));
+    }
+    if (max_diff > 1e-4 * max_tip) {
+        std::cout << "Unit test check failed -- " << name << ": the frozen tip trajectory differs by " << max_diff
+                  << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    if (!Check<ChElementBrick>("ChElementBrick"))
+        return 1;
+    if (!Check<ChElementShellANCF>("ChElementShellANCF"))
+        return 1;
+
+    std::cout << "Unit test check succeeded" << std::endl;
+    return 0;
+}
@@ -0,0 +1,189 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Unit test for ChContactSurfaceMesh::SetSingleCollisionModel(): a tetrahedral
+// cube is dropped on a fixed box, once with one collision model per triangle
+// and once with a single collision model for the whole surface. The contacts
+// must be reported to the same triangles, so the two simulations must match
+// (up to small differences in the persistence of the contact points, since the
+// single model culls the triangles with its own AABB tree, not the broadphase).
+// The single model must also reduce the broadphase to one proxy for the surface,
+// with far fewer overlapping pairs, and take less collision detection time.
+// =============================================================================
+
+#include <cmath>
+#include <iostream>
+
+#include "chrono/collision/ChCCollisionSystemBullet.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemDEM.h"
+#include "chrono/solver/ChSolverMINRES.h"
+#include "chrono_fea/ChContactSurfaceMesh.h"
+#include "chrono_fea/ChElementTetra_4.h"
+#include "chrono_fea/ChMesh.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+const int n = 3;           // cells per side of the cube
+const double side = 0.3;   // cube side
+const double drop = 0.01;  // initial gap between the cube and the ground
+
+int NodeIndex(int ix, int iy, int iz) {
+    return (iz * (n + 1) + iy) * (n + 1) + ix;
+}
+
+// Broadphase load and collision time of a simulation
+struct CollisionStats {
+    int num_objects;     // collision objects in the Bullet world
+    int num_pairs;       // overlapping pairs in the broadphase, at the end of the simulation
+    double time;         // total collision detection time
+};
+
+// Drop the cube and return the final positions of its nodes, and the number of contacts
+// at the end of the simulation.
+std::vector<ChVector<> > Simulate(bool single_model, int& ncontacts, CollisionStats& stats) {
+    ChSystemDEM my_system;
+    my_system.Set_G_acc(ChVector<>(0, 0, -9.81));
+
+    auto surf_material = std::make_shared<ChMaterialSurfaceDEM>();
+    surf_material->SetYoungModulus(1e6);
+    surf_material->SetFriction(0.3f);
+    surf_material->SetRestitution(0.1f);
+
+    auto ground = std::make_shared<ChBodyEasyBox>(1, 1, 0.1, 1000, true, false, ChMaterialSurfaceBase::DEM);
+    ground->SetPos(ChVector<>(0, 0, -0.05));
+    ground->SetBodyFixed(true);
+    ground->SetMaterialSurface(surf_material);
+    my_system.Add(ground);
+
+    auto my_mesh = std::make_shared<ChMesh>();
+    auto material = std::make_shared<ChContinuumElastic>();
+    material->Set_E(1e6);
+    material->Set_v(0.3);
+    material->Set_density(1000);
+
+    std::vector<std::shared_ptr<ChNodeFEAxyz> > nodes;
+    for (int iz = 0; iz <= n; iz++)
+        for (int iy = 0; iy <= n; iy++)
+            for (int ix = 0; ix <= n; ix++) {
+                auto node = std::make_shared<ChNodeFEAxyz>(
+                    ChVector<>(ix * side / n - side / 2, iy * side / n - side / 2, iz * side / n + drop));
+                nodes.push_back(node);
+                my_mesh->AddNode(node);
+            }
+
+    // six tetrahedrons per cell, around the main diagonal (conforming between cells)
+    int corner[8][3] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}, {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}};
+    int tets[6][4] = {{0, 1, 2, 6}, {0, 2, 3, 6}, {0, 3, 7, 6}, {0, 7, 4, 6}, {0, 4, 5, 6}, {0, 5, 1, 6}};
+    for (int iz = 0; iz < n; iz++)
+        for (int iy = 0; iy < n; iy++)
+            for (int ix = 0; ix < n; ix++)
+                for (int t = 0; t < 6; t++) {
+                    std::shared_ptr<ChNodeFEAxyz> tn[4];
+                    for (int k = 0; k < 4; k++) {
+                        int* c = corner[tets[t][k]];
+                        tn[k] = nodes[NodeIndex(ix + c[0], iy + c[1], iz + c[2])];
+                    }
+                    // faces of ChElementTetra_4 expect the 4th node below the plane of the first three
+                    ChVector<> p0 = tn[0]->GetPos();
+                    if (Vdot(Vcross(tn[1]->GetPos() - p0, tn[2]->GetPos() - p0), tn[3]->GetPos() - p0) > 0)
+                        std::swap(tn[1], tn[2]);
+                    auto tetra = std::make_shared<ChElementTetra_4>();
+                    tetra->SetNodes(tn[0], tn[1], tn[2], tn[3]);
+                    tetra->SetMaterial(material);
+                    my_mesh->AddElement(tetra);
+                }
+
+    auto contact_surface = std::make_shared<ChContactSurfaceMesh>();
+    my_mesh->AddContactSurface(contact_surface);
+    contact_surface->AddFacesFromBoundary(0.002);
+    contact_surface->SetMaterialSurface(surf_material);
+    contact_surface->SetSingleCollisionModel(single_model);
+
+    my_system.Add(my_mesh);
+    my_system.SetupInitial();
+
+    my_system.SetSolverType(ChSystem::SOLVER_MINRES);
+    my_system.SetSolverWarmStarting(true);
+    my_system.SetMaxItersSolverSpeed(100);
+    my_system.SetTolForce(1e-10);
+
+    stats.time = 0;
+    for (int step = 0; step < 300; step++) {
+        my_system.DoStepDynamics(5e-4);
+        stats.time += my_system.GetTimerCollisionBroad() + my_system.GetTimerCollisionNarrow();
+    }
+    ncontacts = my_system.GetNcontacts();
+
+    auto collision_system = static_cast<collision::ChCollisionSystemBullet*>(my_system.GetCollisionSystem());
+    btCollisionWorld* world = collision_system->GetBulletCollisionWorld();
+    stats.num_objects = world->getNumCollisionObjects();
+    stats.num_pairs = world->getBroadphase()->getOverlappingPairCache()->getNumOverlappingPairs();
+
+    std::vector<ChVector<> > pos;
+    for (size_t i = 0; i < nodes.size(); i++)
+        pos.push_back(nodes[i]->GetPos());
+    return pos;
+}
+
+int main(int argc, char* argv[]) {
+    int ncontacts_tri;
+    int ncontacts_single;
+    CollisionStats stats_tri;
+    CollisionStats stats_single;
+    std::vector<ChVector<> > pos_tri = Simulate(false, ncontacts_tri, stats_tri);
+    std::vector<ChVector<> > pos_single = Simulate(true, ncontacts_single, stats_single);
+
+    double max_diff = 0;
+    double min_z = 1e30;
+    for (size_t i = 0; i < pos_tri.size(); i++) {
+        max_diff = std::max(max_diff, (pos_tri[i] - pos_single[i]).Length());
+        min_z = std::min(min_z, pos_single[i].z);
+    }
+
+    if (ncontacts_single == 0 || ncontacts_single != ncontacts_tri) {
+        std::cout << "Unit test check failed -- contacts: per triangle " << ncontacts_tri << "  single model "
+                  << ncontacts_single << std::endl;
+        return 1;
+    }
+
+    // the cube must be resting on the ground (and not fall through it)
+    if (min_z < -0.005 || min_z > 0.005) {
+        std::cout << "Unit test check failed -- lowest node: " << min_z << std::endl;
+        return 1;
+    }
+
+    if (max_diff > 1e-3) {
+        std::cout << "Unit test check failed -- max position difference: " << max_diff << std::endl;
+        return 1;
+    }
+
+    // the single model is one broadphase proxy (plus the ground), overlapping only the ground,
+    // instead of one proxy per triangle with all the pairs between neighbouring triangles
+    if (stats_single.num_objects != 2 || stats_single.num_pairs > 1 ||
+        stats_tri.num_pairs < 10 * stats_single.num_pairs) {
+        std::cout << "Unit test check failed -- broadphase: collision objects " << stats_tri.num_objects << " / "
+                  << stats_single.num_objects << "  overlapping pairs " << stats_tri.num_pairs << " / "
+                  << stats_single.num_pairs << " (per triangle / single model)" << std::endl;
+        return 1;
+    }
+
+    // and so the collision detection is faster
+    if (stats_single.time >= stats_tri.time) {
+        std::cout << "Unit test check failed -- collision time: per triangle " << stats_tri.time
+                  << " s  single model " << stats_single.time << " s" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Unit test check succeeded" << std::endl;
+    return 0;
+}
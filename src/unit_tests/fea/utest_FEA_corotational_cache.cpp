@@ -0,0 +1,244 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Unit test for the corotated stiffness cache of ChElementTetra_4 and
+// ChElementHexa_8:
+//  1) the cached corotated stiffness matches C*K*C' for the current rotation;
+//  2) the cached matrix is reused (or recomputed) according to the corotation
+//     tolerance;
+//  3) the cached matrix is invalidated when the local stiffness is recomputed,
+//     ex. after a change of material;
+//  4) after a first call, the residual (F and M*v) and Jacobian loading
+//     functions perform no heap allocations (counted by replacing the global
+//     operator new).
+// =============================================================================
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+#include "chrono/physics/ChSystem.h"
+#include "chrono_fea/ChElementHexa_8.h"
+#include "chrono_fea/ChElementTetra_4.h"
+#include "chrono_fea/ChMesh.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+// -----------------------------------------------------------------------------
+// Allocation counting
+
+static std::atomic<long> num_allocations(0);
+
+void* operator new(std::size_t size) {
+    num_allocations++;
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    num_allocations++;
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+// -----------------------------------------------------------------------------
+
+// Rotate all nodes of the element about the Z axis (through the origin) and add a small deformation.
+void MoveNodes(std::shared_ptr<ChElementBase> element, double angle, double scale) {
+    ChMatrix33<> rot(Q_from_AngAxis(angle, VECT_Z));
+    for (int in = 0; in < element->GetNnodes(); in++) {
+        auto node = std::static_pointer_cast<ChNodeFEAxyz>(element->GetNodeN(in));
+        ChVector<> X0 = node->GetX0();
+        node->SetPos(rot * (X0 * scale + ChVector<>(0.001 * in, 0, 0)));
+        node->SetPos_dt(ChVector<>(0.1, 0.2 * in, -0.1));
+    }
+    element->Update();
+}
+
+// Compare the Jacobian of the element with C*K*C' built explicitly from the local stiffness.
+template <class ElementType>
+double CheckCorotatedStiffness(std::shared_ptr<ElementType> element, int nblocks) {
+    int n = 3 * nblocks;
+    ChMatrixDynamic<> C(n, n);
+    for (int ib = 0; ib < nblocks; ib++)
+        C.PasteMatrix(&element->Rotation(), 3 * ib, 3 * ib);
+    ChMatrixDynamic<> CK(n, n);
+    CK.MatrMultiply(C, element->GetStiffnessMatrix());
+    ChMatrixDynamic<> CKCt(n, n);
+    CKCt.MatrMultiplyT(CK, C);
+
+    ChMatrixDynamic<> H(n, n);
+    element->ComputeKRMmatricesGlobal(H, 1.0, 0, 0);
+
+    double max_diff = 0;
+    for (int row = 0; row < n; row++)
+        for (int col = 0; col < n; col++)
+            max_diff = std::max(max_diff, std::abs(H(row, col) - CKCt(row, col)));
+    return max_diff / CKCt.NormInf();
+}
+
+// Check that the stiffness is reused for small rotations, then recomputed for large ones.
+template <class ElementType>
+bool CheckTolerance(std::shared_ptr<ElementType> element, int nblocks) {
+    int n = 3 * nblocks;
+    ChMatrixDynamic<> H0(n, n);
+    ChMatrixDynamic<> H1(n, n);
+
+    element->SetCorotationTolerance(1e-3);
+    MoveNodes(element, 0.2, 1.0);
+    element->ComputeKRMmatricesGlobal(H0, 1.0, 0, 0);
+
+    // Rotation change below tolerance: same (cached) matrix
+    MoveNodes(element, 0.2 + 1e-5, 1.0);
+    element->ComputeKRMmatricesGlobal(H1, 1.0, 0, 0);
+    bool reused = (H1 == H0);
+
+    // Rotation change above tolerance: matrix recomputed
+    MoveNodes(element, 0.25, 1.0);
+    element->ComputeKRMmatricesGlobal(H1, 1.0, 0, 0);
+    bool recomputed = !(H1 == H0) && CheckCorotatedStiffness(element, nblocks) < 1e-12;
+
+    element->SetCorotationTolerance(0);
+
+    if (!reused || !recomputed) {
+        std::cout << "Unit test check failed -- corotation tolerance: reused " << reused << "  recomputed "
+                  << recomputed << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    ChSystem my_system;
+    auto my_mesh = std::make_shared<ChMesh>();
+
+    auto material = std::make_shared<ChContinuumElastic>();
+    material->Set_E(1e7);
+    material->Set_v(0.3);
+    material->Set_density(1000);
+    material->Set_RayleighDampingK(0.01);
+    material->Set_RayleighDampingM(0.1);
+
+    // Tetrahedron
+    std::vector<std::shared_ptr<ChNodeFEAxyz> > tnodes;
+    tnodes.push_back(std::make_shared<ChNodeFEAxyz>(ChVector<>(0, 0, 0)));
+    tnodes.push_back(std::make_shared<ChNodeFEAxyz>(ChVector<>(1, 0, 0)));
+    tnodes.push_back(std::make_shared<ChNodeFEAxyz>(ChVector<>(0, 1, 0)));
+    tnodes.push_back(std::make_shared<ChNodeFEAxyz>(ChVector<>(0, 0, 1)));
+    for (auto node : tnodes)
+        my_mesh->AddNode(node);
+    auto tetra = std::make_shared<ChElementTetra_4>();
+    tetra->SetNodes(tnodes[0], tnodes[1], tnodes[2], tnodes[3]);
+    tetra->SetMaterial(material);
+    my_mesh->AddElement(tetra);
+
+    // Hexahedron
+    double sx = 0.1;
+    double sy = 1.0;
+    double sz = 0.1;
+    std::vector<std::shared_ptr<ChNodeFEAxyz> > hnodes;
+    hnodes.push_back(std::make_shared<ChNodeFEAxyz>(ChVector<>(2, 0, 0)));
+    hnodes.push_back(std::make_shared<ChNodeFEAxyz>(ChVector<>(2, 0, sz)));
+    hnodes.push_back(std::make_shared<ChNodeFEAxyz>(ChVector<>(2 + sx, 0, sz)));
+    hnodes.push_back(std::make_shared<ChNodeFEAxyz>(ChVector<>(2 + sx, 0, 0)));
+    hnodes.push_back(std::make_shared<ChNodeFEAxyz>(ChVector<>(2, sy, 0)));
+    hnodes.push_back(std::make_shared<ChNodeFEAxyz>(ChVector<>(2, sy, sz)));
+    hnodes.push_back(std::make_shared<ChNodeFEAxyz>(ChVector<>(2 + sx, sy, sz)));
+    hnodes.push_back(std::make_shared<ChNodeFEAxyz>(ChVector<>(2 + sx, sy, 0)));
+    for (auto node : hnodes)
+        my_mesh->AddNode(node);
+    auto hexa = std::make_shared<ChElementHexa_8>();
+    hexa->SetNodes(hnodes[0], hnodes[1], hnodes[2], hnodes[3], hnodes[4], hnodes[5], hnodes[6], hnodes[7]);
+    hexa->SetMaterial(material);
+    my_mesh->AddElement(hexa);
+
+    my_system.Add(my_mesh);
+    my_system.SetupInitial();
+    my_system.Setup();
+
+    // 1) Cached corotated stiffness vs. explicit C*K*C'
+    MoveNodes(tetra, 0.3, 1.01);
+    MoveNodes(hexa, -0.4, 0.99);
+    double err_tetra = CheckCorotatedStiffness(tetra, 4);
+    double err_hexa = CheckCorotatedStiffness(hexa, 8);
+    if (err_tetra > 1e-12 || err_hexa > 1e-12) {
+        std::cout << "Unit test check failed -- corotated stiffness error: tetra " << err_tetra << "  hexa "
+                  << err_hexa << std::endl;
+        return 1;
+    }
+
+    // 2) Reuse according to corotation tolerance
+    if (!CheckTolerance(tetra, 4) || !CheckTolerance(hexa, 8))
+        return 1;
+
+    // 3) Recomputing the local stiffness (same rotation) invalidates the cached matrix
+    MoveNodes(tetra, 0.3, 1.01);
+    MoveNodes(hexa, -0.4, 0.99);
+    CheckCorotatedStiffness(tetra, 4);
+    CheckCorotatedStiffness(hexa, 8);
+    material->Set_E(2e7);
+    tetra->ComputeStiffnessMatrix();
+    hexa->ComputeStiffnessMatrix();
+    err_tetra = CheckCorotatedStiffness(tetra, 4);
+    err_hexa = CheckCorotatedStiffness(hexa, 8);
+    if (err_tetra > 1e-12 || err_hexa > 1e-12) {
+        std::cout << "Unit test check failed -- stiffness after material change: tetra " << err_tetra << "  hexa "
+                  << err_hexa << std::endl;
+        return 1;
+    }
+
+    // 4) No heap allocations in the residual and Jacobian loops
+    ChVectorDynamic<> R(my_system.GetNcoords_w());
+    ChVectorDynamic<> w(my_system.GetNcoords_w());
+    w.FillElem(1.0);
+    std::vector<std::shared_ptr<ChElementBase> > elements;
+    elements.push_back(tetra);
+    elements.push_back(hexa);
+
+    // first pass: lazily allocated buffers are set up here
+    for (auto element : elements) {
+        element->EleIntLoadResidual_F(R, 1.0);
+        element->EleIntLoadResidual_Mv(R, w, 1.0);
+        element->KRMmatricesLoad(1.0, 0.1, 1.0);
+    }
+
+    num_allocations = 0;
+    for (int iter = 0; iter < 10; iter++) {
+        for (auto element : elements) {
+            element->Update();
+            element->EleIntLoadResidual_F(R, 1.0);
+            element->EleIntLoadResidual_Mv(R, w, 1.0);
+            element->KRMmatricesLoad(1.0, 0.1, 1.0);
+        }
+    }
+    long allocations = num_allocations;
+    if (allocations != 0) {
+        std::cout << "Unit test check failed -- heap allocations in residual/Jacobian loops: " << allocations
+                  << std::endl;
+        return 1;
+    }
+
+    std::cout << "Unit test check succeeded" << std::endl;
+    return 0;
+}
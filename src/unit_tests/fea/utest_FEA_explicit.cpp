@@ -0,0 +1,164 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Unit test for the explicit central difference timestepper with lumped mass
+// (ChTimestepperCentralDifference), with and without nodal subcycling: a bar of
+// tetrahedrons, refined near its clamped end, is pulled by a sudden axial force
+// at the free end. The tip displacement must match the one of the implicit HHT
+// integrator (with a small step), with and without subcycling.
+// =============================================================================
+
+#include <cmath>
+#include <iostream>
+
+#include "chrono/physics/ChSystem.h"
+#include "chrono/solver/ChSolverMINRES.h"
+#include "chrono_fea/ChElementTetra_4.h"
+#include "chrono_fea/ChMesh.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+const double width = 0.1;
+const double force = 100;
+const double t_end = 0.02;  // about half of the period of the first axial mode
+
+enum Integrator { HHT, EXPLICIT, EXPLICIT_SUBCYCLING };
+
+// Bar along X, one cell in the section; the first cells, near the clamped end, are 8 times shorter.
+std::shared_ptr<ChMesh> MakeBar(std::vector<std::shared_ptr<ChNodeFEAxyz> >& tip_nodes) {
+    auto mesh = std::make_shared<ChMesh>();
+    auto material = std::make_shared<ChContinuumElastic>();
+    material->Set_E(1e7);
+    material->Set_v(0.3);
+    material->Set_density(1000);
+
+    std::vector<double> xs;
+    for (int i = 0; i <= 8; i++)
+        xs.push_back(i * 0.0125);
+    for (int i = 2; i <= 10; i++)
+        xs.push_back(i * 0.1);
+    int nx = (int)xs.size() - 1;
+
+    std::vector<std::shared_ptr<ChNodeFEAxyz> > nodes;
+    for (int ix = 0; ix <= nx; ix++)
+        for (int iz = 0; iz <= 1; iz++)
+            for (int iy = 0; iy <= 1; iy++) {
+                auto node = std::make_shared<ChNodeFEAxyz>(ChVector<>(xs[ix], iy * width, iz * width));
+                node->SetFixed(ix == 0);
+                if (ix == nx) {
+                    node->SetForce(ChVector<>(force / 4, 0, 0));
+                    tip_nodes.push_back(node);
+                }
+                nodes.push_back(node);
+                mesh->AddNode(node);
+            }
+
+    // six tetrahedrons per cell, around the main diagonal
+    int corner[8][3] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}, {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}};
+    int tets[6][4] = {{0, 1, 2, 6}, {0, 2, 3, 6}, {0, 3, 7, 6}, {0, 7, 4, 6}, {0, 4, 5, 6}, {0, 5, 1, 6}};
+    for (int ix = 0; ix < nx; ix++)
+        for (int t = 0; t < 6; t++) {
+            std::shared_ptr<ChNodeFEAxyz> tn[4];
+            for (int k = 0; k < 4; k++) {
+                int* c = corner[tets[t][k]];
+                tn[k] = nodes[((ix + c[0]) * 2 + c[2]) * 2 + c[1]];
+            }
+            auto tetra = std::make_shared<ChElementTetra_4>();
+            tetra->SetNodes(tn[0], tn[1], tn[2], tn[3]);
+            tetra->SetMaterial(material);
+            mesh->AddElement(tetra);
+        }
+    return mesh;
+}
+
+// Simulate up to t_end and return the mean axial displacement of the tip in 'displacement'.
+// Return false if a check on the explicit integrator failed.
+bool Simulate(Integrator integrator, double& displacement) {
+    ChSystem my_system;
+    my_system.Set_G_acc(VNULL);
+
+    std::vector<std::shared_ptr<ChNodeFEAxyz> > tip_nodes;
+    auto mesh = MakeBar(tip_nodes);
+    my_system.Add(mesh);
+    my_system.SetupInitial();
+
+    if (integrator == HHT) {
+        my_system.SetSolverType(ChSystem::SOLVER_MINRES);
+        my_system.SetSolverWarmStarting(true);
+        my_system.SetMaxItersSolverSpeed(200);
+        my_system.SetTolForce(1e-12);
+        my_system.SetIntegrationType(ChSystem::INT_HHT);
+        auto stepper = std::static_pointer_cast<ChTimestepperHHT>(my_system.GetTimestepper());
+        stepper->SetAlpha(0);
+        stepper->SetMaxiters(10);
+        stepper->SetAbsTolerances(1e-10);
+        stepper->SetMode(ChTimestepperHHT::POSITION);
+        while (my_system.GetChTime() < t_end - 1e-10)
+            my_system.DoStepDynamics(2e-5);
+    } else {
+        my_system.SetIntegrationType(ChSystem::INT_CENTRAL_DIFFERENCE);
+        auto stepper = std::static_pointer_cast<ChTimestepperCentralDifference>(my_system.GetTimestepper());
+        if (integrator == EXPLICIT_SUBCYCLING)
+            stepper->SetSubcycling(4);
+        while (my_system.GetChTime() < t_end - 1e-10)
+            my_system.DoStepDynamics(1e-3);
+
+        if (!(stepper->GetStableTimeStep() > 0) || stepper->GetLumpingError() != 0) {
+            std::cout << "Unit test check failed -- stable step: " << stepper->GetStableTimeStep()
+                      << "  lumping error: " << stepper->GetLumpingError() << std::endl;
+            return false;
+        }
+
+        if (integrator == EXPLICIT_SUBCYCLING) {
+            // the nodes of the short cells must not be subcycled, the others must be
+            const ChVectorDynamic<>& periods = stepper->GetSubcyclingPeriods();
+            int num_unit_periods = 0;
+            for (int i = 0; i < periods.GetRows(); i++)
+                if (periods(i) == 1)
+                    num_unit_periods++;
+            if (num_unit_periods < 8 * 4 * 3 || num_unit_periods == periods.GetRows()) {
+                std::cout << "Unit test check failed -- coordinates not subcycled: " << num_unit_periods << " of "
+                          << periods.GetRows() << std::endl;
+                return false;
+            }
+        }
+    }
+
+    displacement = 0;
+    for (size_t i = 0; i < tip_nodes.size(); i++)
+        displacement += (tip_nodes[i]->GetPos().x - tip_nodes[i]->GetX0().x) / tip_nodes.size();
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    double d_hht;
+    double d_cd;
+    double d_sub;
+    if (!Simulate(HHT, d_hht) || !Simulate(EXPLICIT, d_cd) || !Simulate(EXPLICIT_SUBCYCLING, d_sub))
+        return 1;
+
+    // the dynamic elongation is close to twice the static one, F*L/(E*A) = 1e-3
+    if (d_hht < 1e-3 || d_hht > 3e-3) {
+        std::cout << "Unit test check failed -- HHT tip displacement: " << d_hht << std::endl;
+        return 1;
+    }
+    double err_cd = std::abs(d_cd - d_hht) / std::abs(d_hht);
+    double err_sub = std::abs(d_sub - d_hht) / std::abs(d_hht);
+    if (err_cd > 0.02 || err_sub > 0.05) {
+        std::cout << "Unit test check failed -- relative difference from HHT: " << err_cd << "  with subcycling: "
+                  << err_sub << std::endl;
+        return 1;
+    }
+
+    std::cout << "Unit test check succeeded" << std::endl;
+    return 0;
+}
@@ -0,0 +1,163 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Unit test for the cached automatic gravity loads of ChMesh: the gravity
+// residual of ChMesh (computed once, then taken from the cache)
+// must match the one of a ChLoad<ChLoaderGravity> integrated for each element:
+//  1) on a tetrahedral cube, at the first and second evaluation;
+//  2) after a change of G;
+//  3) after the elements are cleared and replaced by the same number of
+//     elements with a different split of the cells;
+//  4) on a copy of the mesh.
+// =============================================================================
+
+#include <cmath>
+#include <iostream>
+
+#include "chrono/physics/ChLoad.h"
+#include "chrono/physics/ChLoaderUVW.h"
+#include "chrono/physics/ChSystem.h"
+#include "chrono_fea/ChElementTetra_4.h"
+#include "chrono_fea/ChMesh.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+const int n = 2;  // cells per side of the cube
+
+int NodeIndex(int ix, int iy, int iz) {
+    return ix + (n + 1) * (iy + (n + 1) * iz);
+}
+
+// Split each cell of the cube in six tetrahedrons around one of its main diagonals
+// (from corner 0 to 6, or from corner 1 to 7).
+void AddElements(std::shared_ptr<ChMesh> mesh,
+                 const std::vector<std::shared_ptr<ChNodeFEAxyz> >& nodes,
+                 std::shared_ptr<ChContinuumElastic> material,
+                 bool other_diagonal) {
+    int corner[8][3] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}, {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}};
+    int tets_a[6][4] = {{0, 1, 2, 6}, {0, 2, 3, 6}, {0, 3, 7, 6}, {0, 7, 4, 6}, {0, 4, 5, 6}, {0, 5, 1, 6}};
+    int tets_b[6][4] = {{1, 2, 3, 7}, {1, 3, 0, 7}, {1, 0, 4, 7}, {1, 4, 5, 7}, {1, 5, 6, 7}, {1, 6, 2, 7}};
+    for (int iz = 0; iz < n; iz++)
+        for (int iy = 0; iy < n; iy++)
+            for (int ix = 0; ix < n; ix++)
+                for (int t = 0; t < 6; t++) {
+                    std::shared_ptr<ChNodeFEAxyz> tn[4];
+                    for (int k = 0; k < 4; k++) {
+                        int* c = corner[other_diagonal ? tets_b[t][k] : tets_a[t][k]];
+                        tn[k] = nodes[NodeIndex(ix + c[0], iy + c[1], iz + c[2])];
+                    }
+                    auto tetra = std::make_shared<ChElementTetra_4>();
+                    tetra->SetNodes(tn[0], tn[1], tn[2], tn[3]);
+                    tetra->SetMaterial(material);
+                    mesh->AddElement(tetra);
+                }
+}
+
+// Gravity residual integrated for each element with its own gravity load.
+ChVectorDynamic<> ReferenceGravity(ChMesh& mesh, int num_dofs, const ChVector<>& G_acc) {
+    ChVectorDynamic<> R(num_dofs);
+    for (unsigned int ie = 0; ie < mesh.GetNelements(); ie++) {
+        auto loadable = std::dynamic_pointer_cast<ChLoadableUVW>(mesh.GetElement(ie));
+        ChLoad<ChLoaderGravity> load(loadable);
+        load.loader.Set_G_acc(G_acc);
+        load.loader.SetNumIntPoints(1);
+        load.ComputeQ(0, 0);
+        load.LoadIntLoadResidual_F(R, 1.0);
+    }
+    return R;
+}
+
+// Gravity residual of the mesh: its residual with the automatic gravity, minus the one without.
+ChVectorDynamic<> MeshGravity(ChMesh& mesh, int num_dofs) {
+    ChVectorDynamic<> R(num_dofs);
+    ChVectorDynamic<> R_internal(num_dofs);
+    mesh.IntLoadResidual_F(0, R, 1.0);
+    mesh.SetAutomaticGravity(false);
+    mesh.IntLoadResidual_F(0, R_internal, 1.0);
+    mesh.SetAutomaticGravity(true);
+    return R - R_internal;
+}
+
+// Compare the cached gravity residual of the mesh (evaluated twice) with the reference.
+bool CheckGravity(ChMesh& mesh, int num_dofs, const ChVector<>& G_acc, const char* what) {
+    ChVectorDynamic<> R_ref = ReferenceGravity(mesh, num_dofs, G_acc);
+    for (int pass = 0; pass < 2; pass++) {
+        ChVectorDynamic<> R = MeshGravity(mesh, num_dofs);
+        double diff = 0;
+        for (int i = 0; i < num_dofs; i++)
+            diff = std::max(diff, std::abs(R(i) - R_ref(i)));
+        if (diff > 1e-12 * R_ref.NormInf()) {
+            std::cout << "Unit test check failed -- " << what << ", evaluation " << pass + 1
+                      << ": cached gravity residual differs by " << diff << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    ChSystem my_system;
+    my_system.Set_G_acc(ChVector<>(0, 0, -9.81));
+
+    auto mesh = std::make_shared<ChMesh>();
+    auto material = std::make_shared<ChContinuumElastic>();
+    material->Set_E(1e6);
+    material->Set_v(0.3);
+    material->Set_density(1000);
+
+    // slightly irregular grid of nodes, so that the two splits load the nodes differently
+    std::vector<std::shared_ptr<ChNodeFEAxyz> > nodes;
+    for (int iz = 0; iz <= n; iz++)
+        for (int iy = 0; iy <= n; iy++)
+            for (int ix = 0; ix <= n; ix++) {
+                ChVector<> pos(ix + 0.1 * iy * iz, iy + 0.2 * ix, iz + 0.15 * ix * iy);
+                auto node = std::make_shared<ChNodeFEAxyz>(pos);
+                nodes.push_back(node);
+                mesh->AddNode(node);
+            }
+    AddElements(mesh, nodes, material, false);
+
+    my_system.Add(mesh);
+    my_system.SetupInitial();
+    my_system.Setup();
+    int num_dofs = my_system.GetNcoords_w();
+
+    if (!CheckGravity(*mesh, num_dofs, my_system.Get_G_acc(), "initial mesh"))
+        return 1;
+
+    my_system.Set_G_acc(ChVector<>(1, 0, -5));
+    if (!CheckGravity(*mesh, num_dofs, my_system.Get_G_acc(), "new G"))
+        return 1;
+
+    // same number of elements, but different ones: the cache must not be reused
+    ChVectorDynamic<> R_old = ReferenceGravity(*mesh, num_dofs, my_system.Get_G_acc());
+    mesh->ClearElements();
+    AddElements(mesh, nodes, material, true);
+    ChVectorDynamic<> R_new = ReferenceGravity(*mesh, num_dofs, my_system.Get_G_acc());
+    double change = 0;
+    for (int i = 0; i < num_dofs; i++)
+        change = std::max(change, std::abs(R_new(i) - R_old(i)));
+    if (change < 1e-3 * R_new.NormInf()) {
+        std::cout << "Unit test check failed -- the element swap does not change the gravity residual" << std::endl;
+        return 1;
+    }
+    if (!CheckGravity(*mesh, num_dofs, my_system.Get_G_acc(), "after element swap"))
+        return 1;
+
+    ChMesh copy(*mesh);
+    copy.SetSystem(&my_system);
+    if (!CheckGravity(copy, num_dofs, my_system.Get_G_acc(), "mesh copy"))
+        return 1;
+
+    std::cout << "Unit test check succeeded" << std::endl;
+    return 0;
+}
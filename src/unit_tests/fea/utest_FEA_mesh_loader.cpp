@@ -0,0 +1,141 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Unit test for ChMeshFileLoader::FromTetGenFile and ChMesh::RenumberNodes:
+// a tetrahedral cube is written to TetGen files with the nodes in random order,
+// loaded back, and renumbered with the reverse Cuthill-McKee algorithm, that must
+// reduce the bandwidth of the node connectivity without changing the mesh.
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+
+#include "chrono_fea/ChElementTetra_4.h"
+#include "chrono_fea/ChMesh.h"
+#include "chrono_fea/ChMeshFileLoader.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+const int n = 12;  // cells per side of the cube
+
+// Maximum difference between the indexes of two nodes of the same element.
+int NodeBandwidth(std::shared_ptr<ChMesh> mesh) {
+    std::map<ChNodeFEAbase*, int> index;
+    for (unsigned int i = 0; i < mesh->GetNnodes(); i++)
+        index[mesh->GetNodes()[i].get()] = i;
+    int bandwidth = 0;
+    for (unsigned int ie = 0; ie < mesh->GetNelements(); ie++) {
+        auto element = mesh->GetElement(ie);
+        for (int a = 0; a < element->GetNnodes(); a++)
+            for (int b = 0; b < element->GetNnodes(); b++)
+                bandwidth = std::max(bandwidth, std::abs(index[element->GetNodeN(a).get()] -
+                                                         index[element->GetNodeN(b).get()]));
+    }
+    return bandwidth;
+}
+
+int main(int argc, char* argv[]) {
+    // Write the TetGen files of a cube, six tetrahedrons per cell, with shuffled node IDs.
+    int nn = (n + 1) * (n + 1) * (n + 1);
+    std::vector<int> id(nn);
+    for (int i = 0; i < nn; i++)
+        id[i] = i;
+    std::shuffle(id.begin(), id.end(), std::mt19937(42));
+    std::vector<int> grid_of_id(nn);
+    for (int i = 0; i < nn; i++)
+        grid_of_id[id[i]] = i;
+
+    {
+        std::ofstream fnode("utest_mesh_loader.node");
+        fnode << "# shuffled cube\n" << nn << " 3 0 0\n";
+        for (int k = 0; k < nn; k++) {
+            int g = grid_of_id[k];
+            fnode << "  " << k + 1 << "  " << (g % (n + 1)) * 0.1 << " " << ((g / (n + 1)) % (n + 1)) * 0.1 << " "
+                  << (g / ((n + 1) * (n + 1))) * 0.1 << "\n";
+        }
+        std::ofstream fele("utest_mesh_loader.ele");
+        fele << n * n * n * 6 << " 4 0\n\n";
+        int corner[8][3] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}, {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}};
+        int tets[6][4] = {{0, 1, 2, 6}, {0, 2, 3, 6}, {0, 3, 7, 6}, {0, 7, 4, 6}, {0, 4, 5, 6}, {0, 5, 1, 6}};
+        int itet = 0;
+        for (int iz = 0; iz < n; iz++)
+            for (int iy = 0; iy < n; iy++)
+                for (int ix = 0; ix < n; ix++)
+                    for (int t = 0; t < 6; t++) {
+                        fele << ++itet;
+                        for (int k = 0; k < 4; k++) {
+                            int* c = corner[tets[t][k]];
+                            int g = ((iz + c[2]) * (n + 1) + iy + c[1]) * (n + 1) + ix + c[0];
+                            fele << " " << id[g] + 1;
+                        }
+                        fele << "\n";
+                    }
+    }
+
+    auto material = std::make_shared<ChContinuumElastic>();
+    auto mesh = std::make_shared<ChMesh>();
+    ChMeshFileLoader::FromTetGenFile(mesh, "utest_mesh_loader.node", "utest_mesh_loader.ele", material);
+    std::remove("utest_mesh_loader.node");
+    std::remove("utest_mesh_loader.ele");
+
+    if (mesh->GetNnodes() != (unsigned int)nn || mesh->GetNelements() != (unsigned int)(n * n * n * 6)) {
+        std::cout << "Unit test check failed -- loaded " << mesh->GetNnodes() << " nodes and "
+                  << mesh->GetNelements() << " tetrahedrons" << std::endl;
+        return 1;
+    }
+
+    // nodes in file order, with the coordinates of their grid point
+    std::vector<std::shared_ptr<ChNodeFEAbase> > loaded_nodes = mesh->GetNodes();
+    for (int k = 0; k < nn; k++) {
+        int g = grid_of_id[k];
+        ChVector<> expected((g % (n + 1)) * 0.1, ((g / (n + 1)) % (n + 1)) * 0.1, (g / ((n + 1) * (n + 1))) * 0.1);
+        ChVector<> pos = std::static_pointer_cast<ChNodeFEAxyz>(loaded_nodes[k])->GetPos();
+        if ((pos - expected).Length() > 1e-12) {
+            std::cout << "Unit test check failed -- node " << k << ": " << pos.x << " " << pos.y << " " << pos.z
+                      << "  expected: " << expected.x << " " << expected.y << " " << expected.z << std::endl;
+            return 1;
+        }
+    }
+
+    // Renumber, and check that the nodes are a permutation of the loaded ones
+    std::vector<std::shared_ptr<ChElementBase> > elements = mesh->GetElements();
+    int bandwidth_file = NodeBandwidth(mesh);
+    mesh->RenumberNodes();
+    int bandwidth_rcm = NodeBandwidth(mesh);
+
+    std::set<ChNodeFEAbase*> before;
+    std::set<ChNodeFEAbase*> after;
+    for (int k = 0; k < nn; k++) {
+        before.insert(loaded_nodes[k].get());
+        after.insert(mesh->GetNodes()[k].get());
+    }
+    if (before != after || after.size() != (size_t)nn || mesh->GetElements() != elements) {
+        std::cout << "Unit test check failed -- renumbering changed the mesh" << std::endl;
+        return 1;
+    }
+
+    // the bandwidth of a structured cube in lexicographic order is about (n+1)^2 + n + 2
+    if (bandwidth_rcm >= bandwidth_file / 10 || bandwidth_rcm > 2 * (n + 1) * (n + 1)) {
+        std::cout << "Unit test check failed -- node bandwidth: file order " << bandwidth_file << "  RCM "
+                  << bandwidth_rcm << std::endl;
+        return 1;
+    }
+
+    std::cout << "Unit test check succeeded" << std::endl;
+    return 0;
+}
@@ -0,0 +1,204 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Unit test for the Craig-Bampton reduction of a ChMesh (ChModalReduction) and
+// for the floating frame ChReducedFlexibleBody:
+//  1) mass properties of the reduced model;
+//  2) lowest elastic frequencies against the unreduced mesh (obtained by taking
+//     all the nodes as interface nodes);
+//  3) save/load round trip of the reduced model;
+//  4) static elongation of a free-floating bar pulled at both ends, integrated
+//     in time with modal damping, against the analytical value F*L/(E*A).
+// =============================================================================
+
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+
+#include "chrono/physics/ChSystem.h"
+#include "chrono/solver/ChSolverMINRES.h"
+#include "chrono_fea/ChElementHexa_8.h"
+#include "chrono_fea/ChMesh.h"
+#include "chrono_fea/ChModalReduction.h"
+#include "chrono_fea/ChReducedFlexibleBody.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+// Bar along Y, square section of side 1, with 2x2 hexahedrons in the section and 'ny' along the axis.
+const int nx = 2;
+const int ny = 6;
+const double side = 1.0;
+const double length = 6.0;
+const double E = 2e7;
+const double rho = 1000;
+
+int NodeIndex(int ix, int iy, int iz) {
+    return (iy * (nx + 1) + iz) * (nx + 1) + ix;
+}
+
+int main(int argc, char* argv[]) {
+    ChSystem my_system;
+    auto my_mesh = std::make_shared<ChMesh>();
+
+    auto material = std::make_shared<ChContinuumElastic>();
+    material->Set_E(E);
+    material->Set_v(0.3);
+    material->Set_density(rho);
+
+    std::vector<std::shared_ptr<ChNodeFEAxyz> > nodes;
+    for (int iy = 0; iy <= ny; iy++)
+        for (int iz = 0; iz <= nx; iz++)
+            for (int ix = 0; ix <= nx; ix++) {
+                auto node = std::make_shared<ChNodeFEAxyz>(
+                    ChVector<>(ix * side / nx, iy * length / ny, iz * side / nx));
+                nodes.push_back(node);
+                my_mesh->AddNode(node);
+            }
+    for (int iy = 0; iy < ny; iy++)
+        for (int iz = 0; iz < nx; iz++)
+            for (int ix = 0; ix < nx; ix++) {
+                auto hexa = std::make_shared<ChElementHexa_8>();
+                hexa->SetNodes(nodes[NodeIndex(ix, iy, iz)], nodes[NodeIndex(ix, iy, iz + 1)],
+                               nodes[NodeIndex(ix + 1, iy, iz + 1)], nodes[NodeIndex(ix + 1, iy, iz)],
+                               nodes[NodeIndex(ix, iy + 1, iz)], nodes[NodeIndex(ix, iy + 1, iz + 1)],
+                               nodes[NodeIndex(ix + 1, iy + 1, iz + 1)], nodes[NodeIndex(ix + 1, iy + 1, iz)]);
+                hexa->SetMaterial(material);
+                my_mesh->AddElement(hexa);
+            }
+
+    // The mesh is used only to compute the reduced model: initialize its elements in a
+    // separate system, not the one used for the simulation.
+    ChSystem mesh_system;
+    mesh_system.Add(my_mesh);
+    mesh_system.SetupInitial();
+
+    // Interface nodes: the two end sections.
+    std::vector<std::shared_ptr<ChNodeFEAxyz> > interface;
+    for (int iy = 0; iy <= ny; iy += ny)
+        for (int iz = 0; iz <= nx; iz++)
+            for (int ix = 0; ix <= nx; ix++)
+                interface.push_back(nodes[NodeIndex(ix, iy, iz)]);
+
+    auto reduced = std::make_shared<ChModalReduction>();
+    reduced->Compute(my_mesh, interface, 10);
+    if (reduced->GetNmodes() != 3 * (int)interface.size() + 10 - 6) {
+        std::cout << "Unit test check failed -- reduced model modes: " << reduced->GetNmodes() << std::endl;
+        return 1;
+    }
+
+    // 1) Mass properties (Hexa_8 elements use a lumped mass: one eighth of the element mass per node)
+    double mass = rho * side * side * length;
+    std::vector<double> node_mass(nodes.size(), 0.0);
+    for (unsigned int ie = 0; ie < my_mesh->GetNelements(); ie++)
+        for (int in = 0; in < 8; in++)
+            for (size_t k = 0; k < nodes.size(); k++)
+                if (my_mesh->GetElement(ie)->GetNodeN(in) == nodes[k])
+                    node_mass[k] += mass / my_mesh->GetNelements() / 8;
+    ChVector<> cog = reduced->GetCOG();
+    ChVector<> Jdiag(VNULL);
+    for (size_t k = 0; k < nodes.size(); k++) {
+        ChVector<> r = nodes[k]->GetX0() - cog;
+        Jdiag += ChVector<>(r.y * r.y + r.z * r.z, r.x * r.x + r.z * r.z, r.x * r.x + r.y * r.y) * node_mass[k];
+    }
+    const ChMatrix33<>& J = reduced->GetInertia();
+    double err_mass = std::abs(reduced->GetMass() - mass) / mass;
+    double err_cog = (cog - ChVector<>(side / 2, length / 2, side / 2)).Length();
+    double err_inertia = (ChVector<>(J(0, 0), J(1, 1), J(2, 2)) - Jdiag).Length() / Jdiag.Length() +
+                         std::abs(J(0, 1)) + std::abs(J(0, 2)) + std::abs(J(1, 2));
+    if (err_mass > 1e-10 || err_cog > 1e-10 || err_inertia > 1e-10) {
+        std::cout << "Unit test check failed -- mass error: " << err_mass << "  COG error: " << err_cog
+                  << "  inertia error: " << err_inertia << std::endl;
+        return 1;
+    }
+
+    // 2) Elastic frequencies against the full model
+    ChModalReduction full;
+    full.Compute(my_mesh, nodes, 0);
+    if (full.GetNmodes() != 3 * (int)nodes.size() - 6) {
+        std::cout << "Unit test check failed -- full model modes: " << full.GetNmodes() << std::endl;
+        return 1;
+    }
+    // the reduced frequencies are upper bounds of the full ones
+    for (int j = 0; j < 6; j++) {
+        double f_full = full.GetFrequency(j);
+        double f_red = reduced->GetFrequency(j);
+        if (f_red < f_full * (1 - 1e-8) || (f_red - f_full) / f_full > 1e-2) {
+            std::cout << "Unit test check failed -- mode " << j << ": full " << f_full << " Hz  reduced " << f_red
+                      << " Hz" << std::endl;
+            return 1;
+        }
+    }
+
+    // 3) Save/load round trip
+    reduced->Save("modal_reduction.dat");
+    auto loaded = std::make_shared<ChModalReduction>();
+    loaded->Load("modal_reduction.dat");
+    std::remove("modal_reduction.dat");
+    ChMatrix33<> loaded_inertia = loaded->GetInertia();
+    ChVectorDynamic<> loaded_eigenvalues = loaded->GetEigenvalues();
+    bool same = (loaded->GetNmodes() == reduced->GetNmodes()) && (loaded->GetNnodes() == reduced->GetNnodes()) &&
+                (loaded->GetMass() == reduced->GetMass()) && (loaded_inertia == reduced->GetInertia()) &&
+                (loaded_eigenvalues == reduced->GetEigenvalues());
+    for (int k = 0; same && k < loaded->GetNnodes(); k++)
+        for (int j = 0; j < loaded->GetNmodes(); j++)
+            same &= (loaded->GetNodeModeShape(k, j) == reduced->GetNodeModeShape(k, j));
+    if (!same) {
+        std::cout << "Unit test check failed -- save/load round trip" << std::endl;
+        return 1;
+    }
+
+    // 4) Free-floating bar pulled at both ends
+    my_system.Set_G_acc(VNULL);
+    auto body = std::make_shared<ChBody>();
+    my_system.AddBody(body);
+    auto flexible = std::make_shared<ChReducedFlexibleBody>(loaded);
+    flexible->Initialize(body, ChFrame<>(ChVector<>(1, 2, 3), Q_from_AngAxis(0.5, VECT_Z)));
+    flexible->SetModalDamping(1.0);
+    my_system.Add(flexible);
+
+    // consistent nodal loads of a uniform traction on the 2x2 end faces
+    double force = 1e4;
+    double weights[3] = {0.25, 0.5, 0.25};
+    ChVector<> axis = body->TransformDirectionLocalToParent(VECT_Y);
+    int ni = nx + 1;
+    for (int i = 0; i < ni * ni; i++) {
+        double w = weights[i % ni] * weights[i / ni];
+        flexible->SetInterfaceForce(i, -axis * force * w);
+        flexible->SetInterfaceForce(ni * ni + i, axis * force * w);
+    }
+
+    my_system.SetupInitial();
+    my_system.SetSolverType(ChSystem::SOLVER_MINRES);
+    my_system.SetMaxItersSolverSpeed(200);
+    my_system.SetTolForce(1e-12);
+
+    for (int step = 0; step < 500; step++)
+        my_system.DoStepDynamics(1e-3);
+
+    double elongation = 0;
+    for (int i = 0; i < ni * ni; i++)
+        elongation += (flexible->GetInterfaceNodePos(ni * ni + i) - flexible->GetInterfaceNodePos(i)).Length();
+    elongation = elongation / (ni * ni) - length;
+    double expected = force * length / (E * side * side);
+    double err_elong = std::abs(elongation - expected) / expected;
+    double drift = (body->GetPos() - ChVector<>(1, 2, 3) - ChFrame<>(VNULL, Q_from_AngAxis(0.5, VECT_Z))
+                                                                 .TransformDirectionLocalToParent(cog))
+                       .Length();
+    if (err_elong > 1e-3 || drift > 1e-8) {
+        std::cout << "Unit test check failed -- elongation: " << elongation << "  expected: " << expected
+                  << "  frame drift: " << drift << std::endl;
+        return 1;
+    }
+
+    std::cout << "Unit test check succeeded" << std::endl;
+    return 0;
+}
@@ -0,0 +1,187 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Unit test for the element colouring of ChMesh: the elements of a colour share
+// no nodes and the colours are assembled in sequence, so the residuals must not
+// depend on the number of threads. A block with a layer of hexahedrons under a
+// layer of tetrahedrons (sharing the nodes of the interface) is deformed, and
+// the internal force, M*v and lumped mass residuals computed with 1 thread are
+// compared bit for bit with those computed with 2 and 4 threads. The same is
+// done for the node states after a few dynamic steps.
+// =============================================================================
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "chrono/parallel/ChOpenMP.h"
+#include "chrono/physics/ChSystem.h"
+#include "chrono/solver/ChSolverMINRES.h"
+#include "chrono_fea/ChElementHexa_8.h"
+#include "chrono_fea/ChElementTetra_4.h"
+#include "chrono_fea/ChMesh.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+const int n = 4;  // cells per side of the block, in x and y
+
+int NodeIndex(int ix, int iy, int iz) {
+    return ix + (n + 1) * (iy + (n + 1) * iz);
+}
+
+struct Model {
+    ChSystem system;
+    std::shared_ptr<ChMesh> mesh;
+    std::vector<std::shared_ptr<ChNodeFEAxyz> > nodes;
+};
+
+// Bottom layer of hexahedrons, top layer of tetrahedrons (six per cell), bottom nodes fixed.
+void CreateModel(Model& m) {
+    m.mesh = std::make_shared<ChMesh>();
+    auto material = std::make_shared<ChContinuumElastic>();
+    material->Set_E(1e6);
+    material->Set_v(0.3);
+    material->Set_density(1000);
+
+    for (int iz = 0; iz <= 2; iz++)
+        for (int iy = 0; iy <= n; iy++)
+            for (int ix = 0; ix <= n; ix++) {
+                auto node = std::make_shared<ChNodeFEAxyz>(ChVector<>(0.1 * ix, 0.1 * iy, 0.1 * iz));
+                node->SetFixed(iz == 0);
+                m.nodes.push_back(node);
+                m.mesh->AddNode(node);
+            }
+
+    int corner[8][3] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}, {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}};
+    int tets[6][4] = {{0, 1, 2, 6}, {0, 2, 3, 6}, {0, 3, 7, 6}, {0, 7, 4, 6}, {0, 4, 5, 6}, {0, 5, 1, 6}};
+    for (int iz = 0; iz < 2; iz++)
+        for (int iy = 0; iy < n; iy++)
+            for (int ix = 0; ix < n; ix++) {
+                std::shared_ptr<ChNodeFEAxyz> cn[8];
+                for (int k = 0; k < 8; k++)
+                    cn[k] = m.nodes[NodeIndex(ix + corner[k][0], iy + corner[k][1], iz + corner[k][2])];
+                if (iz == 0) {
+                    auto hexa = std::make_shared<ChElementHexa_8>();
+                    hexa->SetNodes(cn[0], cn[1], cn[2], cn[3], cn[4], cn[5], cn[6], cn[7]);
+                    hexa->SetMaterial(material);
+                    m.mesh->AddElement(hexa);
+                } else {
+                    for (int t = 0; t < 6; t++) {
+                        auto tetra = std::make_shared<ChElementTetra_4>();
+                        tetra->SetNodes(cn[tets[t][0]], cn[tets[t][1]], cn[tets[t][2]], cn[tets[t][3]]);
+                        tetra->SetMaterial(material);
+                        m.mesh->AddElement(tetra);
+                    }
+                }
+            }
+
+    m.system.Add(m.mesh);
+    m.system.SetSolverType(ChSystem::SOLVER_MINRES);
+    m.system.SetMaxItersSolverSpeed(100);
+    m.system.SetupInitial();
+
+    // deform the block and give it some velocity
+    for (size_t i = 0; i < m.nodes.size(); i++) {
+        if (m.nodes[i]->GetFixed())
+            continue;
+        ChVector<> pos = m.nodes[i]->GetX0();
+        m.nodes[i]->SetPos(pos + ChVector<>(0.01 * pos.z * pos.y, 0.02 * pos.x * pos.z, -0.015 * pos.z * pos.x));
+        m.nodes[i]->SetPos_dt(ChVector<>(0.1 * pos.y, -0.05 * pos.x, 0.2 * pos.z));
+    }
+    m.system.Setup();
+    m.system.Update();
+}
+
+// Residuals of the mesh at its current state.
+std::vector<ChVectorDynamic<> > Residuals(Model& m) {
+    int num_dofs = m.system.GetNcoords_w();
+    ChVectorDynamic<> F(num_dofs);
+    m.mesh->IntLoadResidual_F(0, F, 1.0);
+
+    ChVectorDynamic<> w(num_dofs);
+    for (int i = 0; i < num_dofs; i++)
+        w(i) = 1.0 + 0.1 * i;
+    ChVectorDynamic<> Mv(num_dofs);
+    m.mesh->IntLoadResidual_Mv(0, Mv, w, 1.0);
+
+    ChVectorDynamic<> Md(num_dofs);
+    double err = 0;
+    m.mesh->IntLoadLumpedMass_Md(0, Md, err, 1.0);
+
+    return {F, Mv, Md};
+}
+
+// Node positions and velocities after a few steps.
+std::vector<double> Simulate(Model& m) {
+    for (int step = 0; step < 5; step++)
+        m.system.DoStepDynamics(1e-3);
+    std::vector<double> state;
+    for (size_t i = 0; i < m.nodes.size(); i++) {
+        const ChVector<>& pos = m.nodes[i]->GetPos();
+        const ChVector<>& vel = m.nodes[i]->GetPos_dt();
+        state.insert(state.end(), {pos.x, pos.y, pos.z, vel.x, vel.y, vel.z});
+    }
+    return state;
+}
+
+int main(int argc, char* argv[]) {
+    const char* names[] = {"internal forces", "M*v", "lumped mass"};
+
+    CHOMPfunctions::SetNumThreads(1);
+    Model ref;
+    CreateModel(ref);
+    if (ref.mesh->GetNumElementColors() < 2) {
+        std::cout << "Unit test check failed -- only " << ref.mesh->GetNumElementColors() << " element colours"
+                  << std::endl;
+        return 1;
+    }
+    std::vector<ChVectorDynamic<> > R_ref = Residuals(ref);
+    if (R_ref[0].NormInf() == 0) {
+        std::cout << "Unit test check failed -- no internal forces in the deformed block" << std::endl;
+        return 1;
+    }
+    std::vector<double> state_ref = Simulate(ref);
+    for (size_t i = 0; i < state_ref.size(); i++) {
+        if (!std::isfinite(state_ref[i])) {
+            std::cout << "Unit test check failed -- node state " << i << " is not finite" << std::endl;
+            return 1;
+        }
+    }
+
+    for (int num_threads = 2; num_threads <= 4; num_threads *= 2) {
+        CHOMPfunctions::SetNumThreads(num_threads);
+        Model m;
+        CreateModel(m);
+        std::vector<ChVectorDynamic<> > R = Residuals(m);
+        for (int k = 0; k < 3; k++) {
+            for (int i = 0; i < R[k].GetRows(); i++) {
+                if (R[k](i) != R_ref[k](i)) {
+                    std::cout << "Unit test check failed -- " << names[k] << " with " << num_threads
+                              << " threads, coordinate " << i << ": " << R[k](i) << " vs " << R_ref[k](i)
+                              << " (1 thread)" << std::endl;
+                    return 1;
+                }
+            }
+        }
+        std::vector<double> state = Simulate(m);
+        for (size_t i = 0; i < state.size(); i++) {
+            if (state[i] != state_ref[i]) {
+                std::cout << "Unit test check failed -- node state " << i << " with " << num_threads
+                          << " threads: " << state[i] << " vs " << state_ref[i] << " (1 thread)" << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    std::cout << "Unit test check succeeded" << std::endl;
+    return 0;
+}
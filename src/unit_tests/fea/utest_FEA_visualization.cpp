@@ -0,0 +1,139 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Unit test for the cached update of ChVisualizationFEAmesh: the triangle mesh
+// of a deforming tetrahedral cube, updated with the cached topology, must be the
+// same as the one rebuilt from scratch, and the updates must be skipped within
+// the interval set with SetUpdateInterval().
+// =============================================================================
+
+#include <cmath>
+#include <iostream>
+#include <random>
+
+#include "chrono/assets/ChTriangleMeshShape.h"
+#include "chrono_fea/ChElementTetra_4.h"
+#include "chrono_fea/ChMesh.h"
+#include "chrono_fea/ChVisualizationFEAmesh.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+const int n = 12;  // cells per side of the cube
+
+geometry::ChTriangleMeshConnected& GetTriangleMesh(std::shared_ptr<ChVisualizationFEAmesh> vis) {
+    return std::static_pointer_cast<ChTriangleMeshShape>(vis->GetAssets()[0])->GetMesh();
+}
+
+// Maximum difference between the vertexes, colours and normals of two triangle meshes.
+double Difference(geometry::ChTriangleMeshConnected& a, geometry::ChTriangleMeshConnected& b) {
+    if (a.getCoordsVertices().size() != b.getCoordsVertices().size() ||
+        a.getCoordsColors().size() != b.getCoordsColors().size() ||
+        a.getCoordsNormals().size() != b.getCoordsNormals().size() ||
+        a.getIndicesVertexes().size() != b.getIndicesVertexes().size())
+        return 1e30;
+    double diff = 0;
+    for (size_t i = 0; i < a.getCoordsVertices().size(); i++)
+        diff = std::max(diff, (a.getCoordsVertices()[i] - b.getCoordsVertices()[i]).Length());
+    for (size_t i = 0; i < a.getCoordsColors().size(); i++)
+        diff = std::max(diff, (double)(a.getCoordsColors()[i] - b.getCoordsColors()[i]).Length());
+    for (size_t i = 0; i < a.getCoordsNormals().size(); i++)
+        diff = std::max(diff, (a.getCoordsNormals()[i] - b.getCoordsNormals()[i]).Length());
+    for (size_t i = 0; i < a.getIndicesVertexes().size(); i++)
+        if (!(a.getIndicesVertexes()[i] == b.getIndicesVertexes()[i]))
+            return 1e30;
+    return diff;
+}
+
+int main(int argc, char* argv[]) {
+    // Tetrahedral cube, six tetrahedrons per cell
+    auto mesh = std::make_shared<ChMesh>();
+    auto material = std::make_shared<ChContinuumElastic>();
+    std::vector<std::shared_ptr<ChNodeFEAxyz> > nodes;
+    for (int iz = 0; iz <= n; iz++)
+        for (int iy = 0; iy <= n; iy++)
+            for (int ix = 0; ix <= n; ix++) {
+                auto node = std::make_shared<ChNodeFEAxyz>(ChVector<>(ix * 0.1, iy * 0.1, iz * 0.1));
+                nodes.push_back(node);
+                mesh->AddNode(node);
+            }
+    int corner[8][3] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}, {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}};
+    int tets[6][4] = {{0, 1, 2, 6}, {0, 2, 3, 6}, {0, 3, 7, 6}, {0, 7, 4, 6}, {0, 4, 5, 6}, {0, 5, 1, 6}};
+    for (int iz = 0; iz < n; iz++)
+        for (int iy = 0; iy < n; iy++)
+            for (int ix = 0; ix < n; ix++)
+                for (int t = 0; t < 6; t++) {
+                    std::shared_ptr<ChNodeFEAxyz> tn[4];
+                    for (int k = 0; k < 4; k++) {
+                        int* c = corner[tets[t][k]];
+                        tn[k] = nodes[((iz + c[2]) * (n + 1) + iy + c[1]) * (n + 1) + ix + c[0]];
+                    }
+                    auto tetra = std::make_shared<ChElementTetra_4>();
+                    tetra->SetNodes(tn[0], tn[1], tn[2], tn[3]);
+                    tetra->SetMaterial(material);
+                    mesh->AddElement(tetra);
+                }
+
+    // Same settings, full rebuild / cached topology / cached topology updated every 0.01 s
+    std::shared_ptr<ChVisualizationFEAmesh> vis[3];
+    for (int i = 0; i < 3; i++) {
+        vis[i] = std::make_shared<ChVisualizationFEAmesh>(*mesh);
+        vis[i]->SetFEMdataType(ChVisualizationFEAmesh::E_PLOT_NODE_DISP_NORM);
+        vis[i]->SetColorscaleMinMax(0, 0.05);
+        vis[i]->SetShrinkElements(true, 0.85);
+        vis[i]->SetSmoothFaces(true);
+    }
+    vis[1]->SetCachedTopology(true);
+    vis[2]->SetCachedTopology(true);
+    vis[2]->SetUpdateInterval(0.01);
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> noise(-0.02, 0.02);
+    int nframes = 10;
+    for (int frame = 0; frame < nframes; frame++) {
+        if (frame == nframes / 2) {
+            // same connectivity, other colours
+            vis[0]->SetFEMdataType(ChVisualizationFEAmesh::E_PLOT_NODE_DISP_X);
+            vis[1]->SetFEMdataType(ChVisualizationFEAmesh::E_PLOT_NODE_DISP_X);
+        }
+        for (size_t i = 0; i < nodes.size(); i++)
+            nodes[i]->SetPos(nodes[i]->GetX0() + ChVector<>(noise(generator), noise(generator), noise(generator)));
+
+        vis[0]->Update(mesh.get(), CSYSNORM);
+        vis[1]->Update(mesh.get(), CSYSNORM);
+
+        double diff = Difference(GetTriangleMesh(vis[0]), GetTriangleMesh(vis[1]));
+        if (diff > 1e-9) {
+            std::cout << "Unit test check failed -- frame " << frame << ": difference " << diff << std::endl;
+            return 1;
+        }
+    }
+
+    // Throttled updates, at t = 0, 0.005 (skipped), 0.01
+    mesh->SetChTime(0);
+    vis[2]->Update(mesh.get(), CSYSNORM);
+    ChVector<> v0 = GetTriangleMesh(vis[2]).getCoordsVertices()[0];
+    nodes[0]->SetPos(nodes[0]->GetX0() + ChVector<>(0.01, 0, 0));
+    mesh->SetChTime(0.005);
+    vis[2]->Update(mesh.get(), CSYSNORM);
+    bool skipped = (GetTriangleMesh(vis[2]).getCoordsVertices()[0] == v0);
+    mesh->SetChTime(0.01);
+    vis[2]->Update(mesh.get(), CSYSNORM);
+    bool updated = !(GetTriangleMesh(vis[2]).getCoordsVertices()[0] == v0);
+    if (!skipped || !updated) {
+        std::cout << "Unit test check failed -- throttled update: skipped " << skipped << ", updated " << updated
+                  << std::endl;
+        return 1;
+    }
+
+    std::cout << "Unit test check succeeded" << std::endl;
+    return 0;
+}
@@ -15,7 +15,9 @@
 // Unit test for calculation of cumulative contact forces on a body.
 // The test checks that the cumulative contact force on a container body (fixed
 // to ground) is equal to the sum of the weights of several bodies dropped in
-// the container.
+// the container. The DVI case is also run in mixed precision mode, checking
+// that iterative refinement brings the double precision residual of the
+// solution below a given tolerance.
 //
 // =============================================================================
 
@@ -46,6 +48,10 @@ double start_time = 0.5;  // start check after this period
 double gravity = -9.81;   // gravitational acceleration
 
 double rtol = 1e-3;  // validation relative error
+// Validation residual after iterative refinement (mixed precision). Refinement stops
+// once the residual is below the solver tolerance at impulse level (1e-4 * 1e-3); a
+// single precision solve alone leaves it around 5e-6.
+double res_tol = 1e-7;
 
 // ---------------------------
 // Contact material properties
@@ -89,7 +95,7 @@ double bin_length = 20;
 double bin_thickness = 0.1;
 
 // Forward declaration
-bool test_computecontact(ChMaterialSurfaceBase::ContactMethod method);
+bool test_computecontact(ChMaterialSurfaceBase::ContactMethod method, bool mixed_precision = false);
 
 // ====================================================================================
 
@@ -98,6 +104,7 @@ int main(int argc, char* argv[]) {
     bool passed = true;
     passed &= test_computecontact(ChMaterialSurfaceBase::DEM);
     passed &= test_computecontact(ChMaterialSurfaceBase::DVI);
+    passed &= test_computecontact(ChMaterialSurfaceBase::DVI, true);
 
     // Return 0 if all tests passed.
     return !passed;
@@ -105,7 +112,7 @@ int main(int argc, char* argv[]) {
 
 // ====================================================================================
 
-bool test_computecontact(ChMaterialSurfaceBase::ContactMethod method) {
+bool test_computecontact(ChMaterialSurfaceBase::ContactMethod method, bool mixed_precision) {
     // Create system and contact material.
     char title[100];
     ChSystemParallel* system;
@@ -139,7 +146,7 @@ bool test_computecontact(ChMaterialSurfaceBase::ContactMethod method) {
             break;
         }
         case ChMaterialSurfaceBase::DVI: {
-            std::cout << "Using COMPLEMENTARITY method." << std::endl;
+            std::cout << "Using COMPLEMENTARITY method" << (mixed_precision ? " (mixed precision)." : ".") << std::endl;
             sprintf(title, "Contact Force test (DVI)");
 
             ChSystemParallelDVI* sys = new ChSystemParallelDVI;
@@ -147,6 +154,7 @@ bool test_computecontact(ChMaterialSurfaceBase::ContactMethod method) {
             sys->GetSettings()->solver.max_iteration_normal = 0;
             sys->GetSettings()->solver.max_iteration_sliding = 100;
             sys->GetSettings()->solver.max_iteration_spinning = 0;
+            sys->GetSettings()->solver.use_mixed_precision = mixed_precision;
             sys->ChangeSolverType(APGD);
             system = sys;
 
@@ -240,6 +248,12 @@ bool test_computecontact(ChMaterialSurfaceBase::ContactMethod method) {
                 passed = false;
                 break;
             }
+            if (mixed_precision && system->data_manager->measures.solver.residual > res_tol) {
+                std::cout << "t = " << system->GetChTime()
+                          << "  residual =  " << system->data_manager->measures.solver.residual << std::endl;
+                passed = false;
+                break;
+            }
         }
     }
 
@@ -0,0 +1,227 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the reordering of the rigid bodies (ChSystemParallel::ReorderBodies,
+// see collision_settings::reorder_frequency). Balls of different masses and
+// materials are added in a scrambled order above a container and dropped into
+// it, once with reordering every few steps and once without. The balls must
+// actually be renumbered, the container (fixed) must not, the original IDs must
+// map back to the bodies, and the trajectories of all balls must match
+// those of the run without reordering. They are not identical: the contacts,
+// and the sums over them, are processed in a different order. With the DEM
+// method (and the multi-step tangential displacement model, whose contact
+// history is renumbered with the bodies) only round-off differs; with the DVI
+// method the solver stops at different iterates, so the tolerance is larger,
+// but still far below the errors a wrong renumbering would cause.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "chrono/utils/ChUtilsCreators.h"
+
+#include "chrono_parallel/physics/ChSystemParallel.h"
+
+using namespace chrono;
+
+// ---------------------
+// Simulation parameters
+// ---------------------
+
+int num_steps = 400;
+double time_step = 1e-3;
+int reorder_frequency = 10;
+
+double gravity = -9.81;
+double radius = 0.1;
+int num_per_side = 4;  // balls per side of the initial lattice
+
+double tol_dem = 1e-6;  // validation error on positions and velocities (DEM)
+double tol_dvi = 1e-3;  // validation error on positions and velocities (DVI)
+
+// Positions and velocities of the balls, in the order they were created
+typedef std::vector<ChVector<> > State;
+
+// Contact material with the given friction coefficient
+std::shared_ptr<ChMaterialSurfaceBase> CreateMaterial(ChMaterialSurfaceBase::ContactMethod method, float friction) {
+    if (method == ChMaterialSurfaceBase::DEM) {
+        auto mat = std::make_shared<ChMaterialSurfaceDEM>();
+        mat->SetYoungModulus(1e7f);
+        mat->SetRestitution(0.1f);
+        mat->SetFriction(friction);
+        return mat;
+    }
+    auto mat = std::make_shared<ChMaterialSurface>();
+    mat->SetFriction(friction);
+    return mat;
+}
+
+// Drop the balls and record their states at each step. Returns false if an
+// inconsistency is found in the body IDs.
+bool Simulate(ChMaterialSurfaceBase::ContactMethod method, bool reorder, std::vector<State>& states) {
+    ChSystemParallel* system;
+
+    switch (method) {
+        case ChMaterialSurfaceBase::DEM: {
+            ChSystemParallelDEM* sys = new ChSystemParallelDEM;
+            sys->GetSettings()->solver.contact_force_model = ChSystemDEM::Hertz;
+            sys->GetSettings()->solver.tangential_displ_mode = ChSystemDEM::MultiStep;
+            system = sys;
+            break;
+        }
+        case ChMaterialSurfaceBase::DVI: {
+            ChSystemParallelDVI* sys = new ChSystemParallelDVI;
+            sys->GetSettings()->solver.solver_mode = SLIDING;
+            sys->GetSettings()->solver.max_iteration_normal = 0;
+            sys->GetSettings()->solver.max_iteration_sliding = 100;
+            sys->GetSettings()->solver.max_iteration_spinning = 0;
+            sys->GetSettings()->solver.alpha = 0;
+            sys->GetSettings()->solver.contact_recovery_speed = 1;
+            sys->GetSettings()->solver.tolerance = 1e-8;
+            sys->ChangeSolverType(APGD);
+            // Contacts at rest would otherwise be at the limit of detection, where
+            // round-off decides whether they are found
+            sys->GetSettings()->collision.collision_envelope = 0.05 * radius;
+            system = sys;
+            break;
+        }
+    }
+
+    system->Set_G_acc(ChVector<>(0, 0, gravity));
+    system->GetSettings()->solver.max_iteration_bilateral = 0;
+    system->GetSettings()->collision.bins_per_axis = vec3(5, 5, 5);
+    system->GetSettings()->collision.reorder_frequency = reorder ? reorder_frequency : 0;
+
+    // Container, fixed bodies must keep their place when the bodies are sorted (the DEM
+    // contact history of the balls in contact with it is stored on the balls)
+    double half = num_per_side * radius * 1.5;
+    auto container = utils::CreateBoxContainer(system, -1, CreateMaterial(method, 0.4f), ChVector<>(half, half, 4 * half), 0.1 * radius,
+                              ChVector<>(0, 0, 0), QUNIT, true, false, true, false);
+
+    // Balls on a lattice (slightly perturbed, so that they do not stack up), created
+    // in a scrambled order. Their masses and materials differ, so that per-body data
+    // left behind by the reordering would change the trajectories.
+    std::shared_ptr<ChMaterialSurfaceBase> materials[3] = {
+        CreateMaterial(method, 0.2f), CreateMaterial(method, 0.4f), CreateMaterial(method, 0.6f)};
+    int num_balls = num_per_side * num_per_side * num_per_side;
+    std::vector<std::shared_ptr<ChBody> > balls;
+    for (int k = 0; k < num_balls; k++) {
+        int i = (37 * k) % num_balls;
+        int ix = i % num_per_side;
+        int iy = (i / num_per_side) % num_per_side;
+        int iz = i / (num_per_side * num_per_side);
+        ChVector<> pos((2.5 * ix - 1.25 * (num_per_side - 1) + 0.1 * (iz % 2)) * radius,
+                       (2.5 * iy - 1.25 * (num_per_side - 1) + 0.1 * (ix % 2)) * radius,
+                       (2.5 * iz + 1.5) * radius);
+
+        auto ball = std::shared_ptr<ChBody>(system->NewBody());
+        ball->SetIdentifier(k);
+        double mass = 1 + 0.25 * (k % 4);
+        ball->SetMass(mass);
+        ball->SetInertiaXX(0.4 * mass * radius * radius * ChVector<>(1, 1, 1));
+        ball->SetPos(pos);
+        ball->SetPos_dt(ChVector<>(0.5 * (iy % 2) - 0.25, 0.5 * (iz % 2) - 0.25, 0));
+        ball->SetCollide(true);
+        ball->SetBodyFixed(false);
+        ball->SetMaterialSurface(materials[k % 3]);
+
+        ball->GetCollisionModel()->ClearModel();
+        utils::AddSphereGeometry(ball.get(), radius);
+        ball->GetCollisionModel()->BuildModel();
+
+        system->AddBody(ball);
+        balls.push_back(ball);
+    }
+
+    bool passed = true;
+    int num_moved = 0;
+    for (int step = 0; step < num_steps; step++) {
+        system->DoStepDynamics(time_step);
+
+        if (container->GetId() != 0) {
+            std::cout << "step " << step << ": the container was moved to " << container->GetId() << std::endl;
+            passed = false;
+            break;
+        }
+        // The balls were added after the container, with consecutive IDs
+        for (int k = 0; k < num_balls; k++) {
+            uint original_id = k + 1;
+            uint id = system->GetBodyIndex(original_id);
+            if (balls[k]->GetId() != id || system->GetBodyOriginalId(id) != original_id ||
+                system->Get_bodylist()->at(id) != balls[k]) {
+                std::cout << "step " << step << ": inconsistent IDs for ball " << k << std::endl;
+                passed = false;
+                break;
+            }
+            if (id != original_id)
+                num_moved++;
+        }
+        if (!passed)
+            break;
+
+        State state;
+        for (int k = 0; k < num_balls; k++) {
+            state.push_back(balls[k]->GetPos());
+            state.push_back(balls[k]->GetPos_dt());
+        }
+        states.push_back(state);
+    }
+
+    if (passed && reorder && num_moved == 0) {
+        std::cout << "the bodies were never reordered" << std::endl;
+        passed = false;
+    }
+
+    delete system;
+    return passed;
+}
+
+bool test_reorder(ChMaterialSurfaceBase::ContactMethod method) {
+    std::cout << (method == ChMaterialSurfaceBase::DEM ? "DEM" : "DVI") << std::endl;
+
+    std::vector<State> states_ref;
+    std::vector<State> states;
+    if (!Simulate(method, false, states_ref) || !Simulate(method, true, states)) {
+        std::cout << "Test FAILED" << std::endl;
+        return false;
+    }
+
+    double max_diff = 0;
+    for (size_t step = 0; step < states.size(); step++) {
+        for (size_t i = 0; i < states[step].size(); i++) {
+            max_diff = std::max(max_diff, (states[step][i] - states_ref[step][i]).Length());
+        }
+    }
+    // The balls must have settled in the container
+    double max_height = 0;
+    for (size_t i = 0; i < states_ref.back().size(); i += 2) {
+        max_height = std::max(max_height, states_ref.back()[i].z);
+    }
+
+    double tol = (method == ChMaterialSurfaceBase::DEM) ? tol_dem : tol_dvi;
+    bool passed = (max_diff <= tol) && (max_height < 2.5 * num_per_side * radius);
+    std::cout << "max difference: " << max_diff << ", max height: " << max_height << std::endl;
+    std::cout << "Test " << (passed ? "PASSED" : "FAILED") << std::endl << std::endl;
+    return passed;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+    passed &= test_reorder(ChMaterialSurfaceBase::DEM);
+    passed &= test_reorder(ChMaterialSurfaceBase::DVI);
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
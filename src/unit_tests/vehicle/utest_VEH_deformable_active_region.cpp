@@ -0,0 +1,146 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Unit test for the active region of DeformableTerrain: a driven wheel rolls on
+// deformable soil, with bulldozing and mesh refinement, next to a box dropped on
+// the soil. The simulation is run once processing only the vertexes in the tiles
+// under the colliding bodies (default) and once processing all the vertexes at
+// each step. The vertexes outside the active region are at rest, so the soil
+// forces, the body trajectories and the soil mesh must be the same.
+// =============================================================================
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemDEM.h"
+#include "chrono_vehicle/terrain/DeformableTerrain.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+const int num_steps = 150;
+const double step_size = 0.005;
+
+struct Results {
+    std::vector<ChVector<> > body_pos;
+    std::vector<ChVector<> > body_vel;
+    std::vector<ChVector<> > force;
+    std::vector<ChVector<> > torque;
+    std::vector<ChVector<> > vertices;  // soil mesh at the end of the simulation
+};
+
+void Simulate(bool active_region, Results& results) {
+    ChSystemDEM system;
+
+    auto truss = std::make_shared<ChBody>(ChMaterialSurfaceBase::DEM);
+    truss->SetBodyFixed(true);
+    system.Add(truss);
+
+    // wheel with the axis along X, rolling along Z
+    ChVector<> center(0.4, 0.52, -1.2);
+    auto wheel = std::make_shared<ChBodyEasyCylinder>(0.5, 0.4, 500, true, false, ChMaterialSurfaceBase::DEM);
+    wheel->SetPos(center);
+    wheel->SetRot(Q_from_AngAxis(CH_C_PI_2, VECT_Z));
+    system.Add(wheel);
+
+    auto engine = std::make_shared<ChLinkEngine>();
+    engine->Set_shaft_mode(ChLinkEngine::ENG_SHAFT_OLDHAM);
+    engine->Set_eng_mode(ChLinkEngine::ENG_MODE_SPEED);
+    if (auto mfun = std::dynamic_pointer_cast<ChFunction_Const>(engine->Get_spe_funct()))
+        mfun->Set_yconst(CH_C_PI / 2);
+    engine->Initialize(wheel, truss, ChCoordsys<>(center, Q_from_AngAxis(CH_C_PI_2, VECT_Y)));
+    system.Add(engine);
+
+    // free box, sliding on the soil
+    auto box = std::make_shared<ChBodyEasyBox>(0.3, 0.2, 0.4, 1000, true, false, ChMaterialSurfaceBase::DEM);
+    box->SetPos(ChVector<>(-0.5, 0.15, 0.5));
+    box->SetPos_dt(ChVector<>(0, 0, -0.8));
+    system.Add(box);
+
+    DeformableTerrain terrain(&system);
+    terrain.SetSoilParametersSCM(1.2e6,  // Bekker Kphi
+                                 0,      // Bekker Kc
+                                 1.1,    // Bekker n exponent
+                                 0,      // Mohr cohesive limit (Pa)
+                                 30,     // Mohr friction limit (degrees)
+                                 0.01,   // Janosi shear coefficient (m)
+                                 5e7     // Elastic stiffness (Pa/m), before plastic yeld
+                                 );
+    terrain.SetBulldozingFlow(true);
+    terrain.SetBulldozingParameters(55, 0.8, 5, 10);
+    terrain.SetAutomaticRefinement(true);
+    terrain.SetAutomaticRefinementResolution(0.04);
+    terrain.SetActiveRegion(active_region);
+    terrain.Initialize(0, 2, 4, 40, 80);
+
+    system.SetupInitial();
+
+    ChVector<> force;
+    ChVector<> torque;
+    for (int step = 0; step < num_steps; step++) {
+        system.DoStepDynamics(step_size);
+        std::shared_ptr<ChBody> bodies[] = {wheel, box};
+        for (auto body : bodies) {
+            terrain.GetContactForce(body, force, torque);
+            results.body_pos.push_back(body->GetPos());
+            results.body_vel.push_back(body->GetPos_dt());
+            results.force.push_back(force);
+            results.torque.push_back(torque);
+        }
+    }
+    results.vertices = terrain.GetMesh()->GetMesh().getCoordsVertices();
+}
+
+// Largest difference between two sequences of vectors (infinite if the lengths differ).
+double MaxDifference(const std::vector<ChVector<> >& a, const std::vector<ChVector<> >& b) {
+    if (a.size() != b.size())
+        return 1e30;
+    double diff = 0;
+    for (size_t i = 0; i < a.size(); i++)
+        diff = std::max(diff, (a[i] - b[i]).Length());
+    return diff;
+}
+
+int main(int argc, char* argv[]) {
+    Results active;
+    Results full;
+    Simulate(true, active);
+    Simulate(false, full);
+
+    // both bodies must sink in the soil and be pushed by it
+    double sinkage = 0;
+    for (size_t i = 0; i < active.vertices.size(); i++)
+        sinkage = std::max(sinkage, -active.vertices[i].y);
+    double wheel_force = active.force[active.force.size() - 2].y;
+    double box_force = active.force.back().y;
+    if (wheel_force < 100 || box_force < 10 || sinkage < 0.005) {
+        std::cout << "Unit test check failed -- no soil contact: vertical force " << wheel_force << " (wheel) "
+                  << box_force << " (box)  max sinkage " << sinkage << std::endl;
+        return 1;
+    }
+
+    double diff_pos = MaxDifference(active.body_pos, full.body_pos);
+    double diff_vel = MaxDifference(active.body_vel, full.body_vel);
+    double diff_force = MaxDifference(active.force, full.force);
+    double diff_torque = MaxDifference(active.torque, full.torque);
+    double diff_soil = MaxDifference(active.vertices, full.vertices);
+    if (diff_pos != 0 || diff_vel != 0 || diff_force != 0 || diff_torque != 0 || diff_soil != 0) {
+        std::cout << "Unit test check failed -- active region vs full update: position " << diff_pos
+                  << "  velocity " << diff_vel << "  force " << diff_force << "  torque " << diff_torque << "  soil "
+                  << diff_soil << std::endl;
+        return 1;
+    }
+
+    std::cout << "Unit test check succeeded" << std::endl;
+    return 0;
+}
@@ -0,0 +1,135 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Unit test for the parallel ray casts of DeformableTerrain: a driven wheel
+// rolls on deformable soil, with bulldozing and mesh refinement, once with one
+// OpenMP thread and once with four. Each vertex is processed independently and
+// the forces are summed in vertex order after the parallel loop, so the soil
+// force on the wheel, the wheel trajectory and the soil sinkage must be the same.
+// =============================================================================
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "chrono/parallel/ChOpenMP.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemDEM.h"
+#include "chrono_vehicle/terrain/DeformableTerrain.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+const int num_steps = 150;
+const double step_size = 0.005;
+
+struct Results {
+    std::vector<ChVector<> > wheel_pos;
+    std::vector<ChVector<> > wheel_vel;
+    std::vector<ChVector<> > force;
+    std::vector<ChVector<> > torque;
+    std::vector<ChVector<> > vertices;  // soil mesh at the end of the simulation
+};
+
+void Simulate(int num_threads, Results& results) {
+    CHOMPfunctions::SetNumThreads(num_threads);
+
+    ChSystemDEM system;
+
+    auto truss = std::make_shared<ChBody>(ChMaterialSurfaceBase::DEM);
+    truss->SetBodyFixed(true);
+    system.Add(truss);
+
+    // wheel with the axis along X, rolling along Z
+    ChVector<> center(0, 0.52, -1.2);
+    auto wheel = std::make_shared<ChBodyEasyCylinder>(0.5, 0.4, 500, true, false, ChMaterialSurfaceBase::DEM);
+    wheel->SetPos(center);
+    wheel->SetRot(Q_from_AngAxis(CH_C_PI_2, VECT_Z));
+    system.Add(wheel);
+
+    auto engine = std::make_shared<ChLinkEngine>();
+    engine->Set_shaft_mode(ChLinkEngine::ENG_SHAFT_OLDHAM);
+    engine->Set_eng_mode(ChLinkEngine::ENG_MODE_SPEED);
+    if (auto mfun = std::dynamic_pointer_cast<ChFunction_Const>(engine->Get_spe_funct()))
+        mfun->Set_yconst(CH_C_PI / 2);
+    engine->Initialize(wheel, truss, ChCoordsys<>(center, Q_from_AngAxis(CH_C_PI_2, VECT_Y)));
+    system.Add(engine);
+
+    DeformableTerrain terrain(&system);
+    terrain.SetSoilParametersSCM(1.2e6,  // Bekker Kphi
+                                 0,      // Bekker Kc
+                                 1.1,    // Bekker n exponent
+                                 0,      // Mohr cohesive limit (Pa)
+                                 30,     // Mohr friction limit (degrees)
+                                 0.01,   // Janosi shear coefficient (m)
+                                 5e7     // Elastic stiffness (Pa/m), before plastic yeld
+                                 );
+    terrain.SetBulldozingFlow(true);
+    terrain.SetBulldozingParameters(55, 0.8, 5, 10);
+    terrain.SetAutomaticRefinement(true);
+    terrain.SetAutomaticRefinementResolution(0.04);
+    terrain.Initialize(0, 2, 4, 40, 80);
+
+    system.SetupInitial();
+
+    ChVector<> force;
+    ChVector<> torque;
+    for (int step = 0; step < num_steps; step++) {
+        system.DoStepDynamics(step_size);
+        terrain.GetContactForce(wheel, force, torque);
+        results.wheel_pos.push_back(wheel->GetPos());
+        results.wheel_vel.push_back(wheel->GetPos_dt());
+        results.force.push_back(force);
+        results.torque.push_back(torque);
+    }
+    results.vertices = terrain.GetMesh()->GetMesh().getCoordsVertices();
+}
+
+// Largest difference between two sequences of vectors (infinite if the lengths differ).
+double MaxDifference(const std::vector<ChVector<> >& a, const std::vector<ChVector<> >& b) {
+    if (a.size() != b.size())
+        return 1e30;
+    double diff = 0;
+    for (size_t i = 0; i < a.size(); i++)
+        diff = std::max(diff, (a[i] - b[i]).Length());
+    return diff;
+}
+
+int main(int argc, char* argv[]) {
+    Results serial;
+    Results parallel;
+    Simulate(1, serial);
+    Simulate(4, parallel);
+
+    // the wheel must sink in the soil and be pushed by it
+    double sinkage = 0;
+    for (size_t i = 0; i < serial.vertices.size(); i++)
+        sinkage = std::max(sinkage, -serial.vertices[i].y);
+    if (serial.force.back().y < 100 || sinkage < 0.005) {
+        std::cout << "Unit test check failed -- no soil contact: vertical force " << serial.force.back().y
+                  << "  max sinkage " << sinkage << std::endl;
+        return 1;
+    }
+
+    double diff_pos = MaxDifference(serial.wheel_pos, parallel.wheel_pos);
+    double diff_vel = MaxDifference(serial.wheel_vel, parallel.wheel_vel);
+    double diff_force = MaxDifference(serial.force, parallel.force);
+    double diff_torque = MaxDifference(serial.torque, parallel.torque);
+    double diff_soil = MaxDifference(serial.vertices, parallel.vertices);
+    if (diff_pos != 0 || diff_vel != 0 || diff_force != 0 || diff_torque != 0 || diff_soil != 0) {
+        std::cout << "Unit test check failed -- 1 vs 4 threads: position " << diff_pos << "  velocity " << diff_vel
+                  << "  force " << diff_force << "  torque " << diff_torque << "  soil " << diff_soil << std::endl;
+        return 1;
+    }
+
+    std::cout << "Unit test check succeeded" << std::endl;
+    return 0;
+}
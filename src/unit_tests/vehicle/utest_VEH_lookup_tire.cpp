@@ -0,0 +1,325 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Unit test for the lookup table tire (ChLookupTire). The response tables are
+// generated from a design of experiments on a Fiala tire (with the parameters of
+// the HMMWV Fiala tire and a smooth vertical stiffness): at each grid point, the
+// wheel state is imposed on flat terrain until the tire slips have settled, and
+// the response is reduced to the contact point and expressed in the contact
+// frame, as done by the table generation program. The lookup tire must then:
+//  1) reproduce the Fiala tire at the grid points;
+//  2) approximate it at random points between the grid points (with a vertical
+//     velocity, i.e. with tire damping);
+//  3) relax the slips with the relaxation lengths of the Fiala tire, following
+//     the exact first-order response and the Fiala forces;
+//  4) when rolling backward, keep the longitudinal and lateral forces and flip
+//     the rolling resistance and aligning moments. The Fiala tire flips its
+//     rolling resistance moment too, but not its aligning moment.
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "chrono/physics/ChBody.h"
+#include "chrono_vehicle/terrain/FlatTerrain.h"
+#include "chrono_vehicle/wheeled_vehicle/tire/ChFialaTire.h"
+#include "chrono_vehicle/wheeled_vehicle/tire/ChLookupTire.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+const double radius = 0.461264;
+const double width = 0.8235;
+const double damping = 17513;
+const double relax_length_x = 0.1244;
+const double relax_length_y = 0.0317;
+
+const double step_size = 1e-3;
+const double settle_time = 0.2;
+const double speed = 10;
+
+// Vertical tire stiffness (normal load at the given deflection) and its inverse.
+double NormalLoad(double deflection) {
+    return 2.5e5 * deflection + 1e6 * deflection * deflection;
+}
+
+double Deflection(double Fz) {
+    return (-2.5e5 + std::sqrt(2.5e5 * 2.5e5 + 4 * 1e6 * Fz)) / (2 * 1e6);
+}
+
+// Fiala tire with the parameters of the HMMWV Fiala tire.
+class FialaTestTire : public ChFialaTire {
+  public:
+    FialaTestTire() : ChFialaTire("Fiala") { SetStepsize(1e-4); }
+
+    virtual double GetNormalStiffnessForce(double depth) const override { return NormalLoad(depth); }
+    virtual double GetNormalDampingForce(double depth, double velocity) const override { return damping * velocity; }
+
+    virtual void SetFialaParams() override {
+        m_unloaded_radius = radius;
+        m_width = width;
+        m_rolling_resistance = 0.001;
+        m_c_slip = 52300.24;
+        m_c_alpha = 6669.41;
+        m_u_min = 0.5568;
+        m_u_max = 0.9835;
+        m_relax_length_x = relax_length_x;
+        m_relax_length_y = relax_length_y;
+    }
+};
+
+// Grids and steady-state response tables.
+struct Table {
+    std::vector<double> Fz_grid = {2000, 4000, 6000, 8000};
+    std::vector<double> kappa_grid = {-0.2, -0.15, -0.1, -0.075, -0.05, -0.035, -0.02, -0.01, 0,
+                                      0.01, 0.02,  0.035, 0.05, 0.075, 0.1,   0.15,  0.2};
+    std::vector<double> alpha_grid = {-12, -6, -3, -1, 0, 1, 3, 6, 12};  // [deg], converted in main
+    std::vector<double> gamma_grid = {-0.05, 0.05};
+    std::vector<double> deflection;
+    std::vector<double> Fx, Fy, Mx, My, Mz;
+};
+
+// Lookup tire with the specified tables.
+class TableTire : public ChLookupTire {
+  public:
+    TableTire(const Table& table) : ChLookupTire("Lookup"), m_table(table) {}
+
+    virtual void SetLookupParams() override {
+        m_unloaded_radius = radius;
+        m_width = width;
+        m_damping = damping;
+        m_relax_length_x = relax_length_x;
+        m_relax_length_y = relax_length_y;
+        m_Fz_grid = m_table.Fz_grid;
+        m_kappa_grid = m_table.kappa_grid;
+        m_alpha_grid = m_table.alpha_grid;
+        m_gamma_grid = m_table.gamma_grid;
+        m_deflection = m_table.deflection;
+        m_Fx = m_table.Fx;
+        m_Fy = m_table.Fy;
+        m_Mx = m_table.Mx;
+        m_My = m_table.My;
+        m_Mz = m_table.Mz;
+    }
+
+  private:
+    const Table& m_table;
+};
+
+// Operating point: normal load due to the tire stiffness, slips, camber, and wheel velocity.
+struct OperatingPoint {
+    double Fz;
+    double kappa;
+    double alpha;
+    double gamma;
+    double vx;
+    double vz;
+};
+
+// Tire response at the contact point, in the contact frame.
+struct Response {
+    ChVector<> force;
+    ChVector<> moment;
+};
+
+// Wheel state on flat terrain at zero height for the specified operating point. The wheel spin
+// rate gives the longitudinal slip with the rolling radius of the tire model: the loaded radius
+// for the Fiala tire, the unloaded radius for the lookup tire.
+WheelState GetWheelState(const OperatingPoint& op, bool fiala) {
+    double deflection = Deflection(op.Fz);
+    double rolling_radius = fiala ? radius - deflection : radius;
+    WheelState state;
+    state.pos = ChVector<>(0, 0, radius * std::cos(op.gamma) - deflection);
+    state.rot = Q_from_AngX(op.gamma);
+    state.lin_vel = ChVector<>(op.vx, std::abs(op.vx) * std::tan(op.alpha), op.vz);
+    state.omega = (op.vx + op.kappa * std::abs(op.vx)) / rolling_radius;
+    state.ang_vel = state.rot.GetYaxis() * state.omega;
+    return state;
+}
+
+// Reduce the tire force (applied at the wheel center) to the contact point, in the contact frame.
+Response GetResponse(const ChTire& tire, const WheelState& state) {
+    TireForce tire_force = tire.GetTireForce();
+    ChVector<> normal = state.rot.GetYaxis();
+    ChVector<> Z_dir(0, 0, 1);
+    ChVector<> X_dir = Vcross(normal, Z_dir);
+    X_dir.Normalize();
+    ChVector<> Y_dir = Vcross(Z_dir, X_dir);
+    ChVector<> lowest = state.pos + radius * Vcross(normal, X_dir);
+    ChVector<> contact(lowest.x, lowest.y, 0);
+
+    ChVector<> moment = tire_force.moment + Vcross(tire_force.point - contact, tire_force.force);
+
+    Response r;
+    r.force = ChVector<>(Vdot(tire_force.force, X_dir), Vdot(tire_force.force, Y_dir), Vdot(tire_force.force, Z_dir));
+    r.moment = ChVector<>(Vdot(moment, X_dir), Vdot(moment, Y_dir), Vdot(moment, Z_dir));
+    return r;
+}
+
+// Impose the operating point from zero slips until the slips have settled.
+Response Settle(ChTire& tire, std::shared_ptr<ChBody> wheel, const OperatingPoint& op, bool fiala) {
+    FlatTerrain terrain(0);
+    WheelState state = GetWheelState(op, fiala);
+    tire.Initialize(wheel, LEFT);
+    for (double time = 0; time < settle_time; time += step_size) {
+        tire.Synchronize(time, state, terrain);
+        tire.Advance(step_size);
+    }
+    return GetResponse(tire, state);
+}
+
+// Response with the rolling resistance and/or aligning moments flipped.
+Response Flip(Response r, bool flip_My, bool flip_Mz) {
+    if (flip_My)
+        r.moment.y = -r.moment.y;
+    if (flip_Mz)
+        r.moment.z = -r.moment.z;
+    return r;
+}
+
+// Largest difference between the two responses, relative to the normal force
+// (relative to the normal force times the tire width for the moments).
+double Difference(const Response& a, const Response& b) {
+    double Fn = std::max(a.force.z, b.force.z);
+    double diff = (a.force - b.force).LengthInf() / Fn;
+    return std::max(diff, (a.moment - b.moment).LengthInf() / (Fn * width));
+}
+
+int main(int argc, char* argv[]) {
+    auto wheel = std::make_shared<ChBody>();
+    FialaTestTire fiala;
+
+    // Design of experiments on the Fiala tire
+    Table table;
+    for (auto& alpha : table.alpha_grid)
+        alpha *= CH_C_DEG_TO_RAD;
+    for (auto Fz : table.Fz_grid)
+        table.deflection.push_back(Deflection(Fz));
+    for (auto Fz : table.Fz_grid)
+        for (auto kappa : table.kappa_grid)
+            for (auto alpha : table.alpha_grid)
+                for (auto gamma : table.gamma_grid) {
+                    Response r = Settle(fiala, wheel, {Fz, kappa, alpha, gamma, speed, 0}, true);
+                    table.Fx.push_back(r.force.x);
+                    table.Fy.push_back(r.force.y);
+                    table.Mx.push_back(r.moment.x);
+                    table.My.push_back(r.moment.y);
+                    table.Mz.push_back(r.moment.z);
+                }
+    TableTire lookup(table);
+
+    // 1) Grid points
+    std::mt19937 gen(7);
+    double max_diff = 0;
+    for (int i = 0; i < 50; i++) {
+        auto pick = [&gen](const std::vector<double>& grid) { return grid[gen() % grid.size()]; };
+        OperatingPoint op = {pick(table.Fz_grid), pick(table.kappa_grid), pick(table.alpha_grid),
+                             pick(table.gamma_grid), speed, 0};
+        Response r_lookup = Settle(lookup, wheel, op, false);
+        Response r_fiala = Settle(fiala, wheel, op, true);
+        max_diff = std::max(max_diff, Difference(r_lookup, r_fiala));
+    }
+    std::cout << "grid points: largest difference " << max_diff << std::endl;
+    if (max_diff > 1e-6) {
+        std::cout << "Unit test check failed -- the lookup tire does not reproduce the Fiala tire at the grid points"
+                  << std::endl;
+        return 1;
+    }
+
+    // 2) Random points between the grid points
+    std::uniform_real_distribution<double> u_Fz(2500, 7500);
+    std::uniform_real_distribution<double> u_kappa(-0.18, 0.18);
+    std::uniform_real_distribution<double> u_alpha(-11 * CH_C_DEG_TO_RAD, 11 * CH_C_DEG_TO_RAD);
+    std::uniform_real_distribution<double> u_gamma(-0.04, 0.04);
+    std::uniform_real_distribution<double> u_vz(-0.05, 0.05);
+    max_diff = 0;
+    for (int i = 0; i < 200; i++) {
+        OperatingPoint op = {u_Fz(gen), u_kappa(gen), u_alpha(gen), u_gamma(gen), speed, u_vz(gen)};
+        Response r_lookup = Settle(lookup, wheel, op, false);
+        Response r_fiala = Settle(fiala, wheel, op, true);
+        max_diff = std::max(max_diff, Difference(r_lookup, r_fiala));
+    }
+    std::cout << "random points: largest difference " << max_diff << std::endl;
+    if (max_diff > 0.05) {
+        std::cout << "Unit test check failed -- the lookup tire does not approximate the Fiala tire between the "
+                     "grid points"
+                  << std::endl;
+        return 1;
+    }
+
+    // 3) Relaxation of the slips from zero, in the linear range of the Fiala tire
+    {
+        OperatingPoint op = {5000, 0.02, 1 * CH_C_DEG_TO_RAD, 0, speed, 0};
+        FlatTerrain terrain(0);
+        WheelState state_lookup = GetWheelState(op, false);
+        WheelState state_fiala = GetWheelState(op, true);
+        lookup.Initialize(wheel, LEFT);
+        fiala.Initialize(wheel, LEFT);
+        double max_slip_diff = 0;
+        max_diff = 0;
+        for (double time = 0; time < 0.05; time += step_size) {
+            lookup.Synchronize(time, state_lookup, terrain);
+            fiala.Synchronize(time, state_fiala, terrain);
+            lookup.Advance(step_size);
+            fiala.Advance(step_size);
+            double t = time + step_size;
+            double kappa = op.kappa * (1 - std::exp(-speed * t / relax_length_x));
+            double tan_alpha = std::tan(op.alpha) * (1 - std::exp(-speed * t / relax_length_y));
+            max_slip_diff = std::max(max_slip_diff, std::abs(lookup.GetLongitudinalSlip() - kappa) / op.kappa);
+            max_slip_diff =
+                std::max(max_slip_diff, std::abs(std::tan(lookup.GetSlipAngle()) - tan_alpha) / std::tan(op.alpha));
+            Response r_lookup = GetResponse(lookup, state_lookup);
+            Response r_fiala = GetResponse(fiala, state_fiala);
+            max_diff = std::max(max_diff, Difference(r_lookup, r_fiala));
+        }
+        std::cout << "relaxation: largest slip error " << max_slip_diff << ", largest difference " << max_diff
+                  << std::endl;
+        if (max_slip_diff > 5e-3) {
+            std::cout << "Unit test check failed -- the slips do not follow the relaxation equations" << std::endl;
+            return 1;
+        }
+        if (max_diff > 0.01) {
+            std::cout << "Unit test check failed -- the relaxed response differs from the Fiala tire" << std::endl;
+            return 1;
+        }
+    }
+
+    // 4) Rolling backward
+    max_diff = 0;
+    for (int i = 0; i < 50; i++) {
+        OperatingPoint op = {u_Fz(gen), u_kappa(gen), u_alpha(gen), u_gamma(gen), speed, 0};
+        Response r_forward = Settle(lookup, wheel, op, false);
+        op.vx = -speed;
+        Response r_backward = Settle(lookup, wheel, op, false);
+        Response r_fiala = Settle(fiala, wheel, op, true);
+        if (Difference(r_backward, Flip(r_forward, true, true)) > 1e-9) {
+            std::cout << "Unit test check failed -- rolling backward: force " << r_backward.force.x << " "
+                      << r_backward.force.y << ", moment " << r_backward.moment.y << " " << r_backward.moment.z
+                      << "; forward: force " << r_forward.force.x << " " << r_forward.force.y << ", moment "
+                      << r_forward.moment.y << " " << r_forward.moment.z << std::endl;
+            return 1;
+        }
+        max_diff = std::max(max_diff, Difference(r_backward, Flip(r_fiala, false, true)));
+    }
+    std::cout << "rolling backward: largest difference " << max_diff << " (Fiala aligning moment flipped)"
+              << std::endl;
+    if (max_diff > 0.05) {
+        std::cout << "Unit test check failed -- rolling backward, the lookup tire differs from the Fiala tire"
+                  << std::endl;
+        return 1;
+    }
+
+    std::cout << "Unit test check succeeded" << std::endl;
+    return 0;
+}
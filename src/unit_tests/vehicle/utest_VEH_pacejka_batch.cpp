@@ -0,0 +1,157 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Unit test for ChPacejkaTireBatch: pairs of Pacejka tires are driven through the
+// same slip sweeps (pure longitudinal, pure lateral with and without camber, and
+// combined slip; steady-state and transient slip; both sides; two loads). One tire
+// of each pair is advanced on its own, the other in the batch, and their forces
+// and moments are compared.
+//
+// With the default build the batch evaluates the transcendental functions with the
+// same scalar calls, and the results are identical. With ENABLE_PACEJKA_VECTOR_MATH
+// they agree to round-off: the test accepts a difference of up to
+// 1e-9 * |F| + 1e-6 (N or Nm) on each force and moment.
+// =============================================================================
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "chrono/physics/ChBody.h"
+#include "chrono_vehicle/ChVehicleModelData.h"
+#include "chrono_vehicle/terrain/FlatTerrain.h"
+#include "chrono_vehicle/wheeled_vehicle/tire/ChPacejkaTireBatch.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+const int num_steps = 400;
+const double step_size = 0.01;
+const double rel_tol = 1e-9;
+const double abs_tol = 1e-6;
+
+enum SlipCase { LONGITUDINAL, LATERAL, LATERAL_GAMMA, COMBINED };
+
+struct TirePair {
+    SlipCase slip_case;
+    std::shared_ptr<ChPacejkaTire> scalar;
+    std::shared_ptr<ChPacejkaTire> batched;
+};
+
+// Slip quantities of the sweep at the specified step.
+void GetSlips(SlipCase slip_case, int step, double& kappa, double& alpha, double& gamma) {
+    double s = -1 + 2.0 * step / num_steps;
+    kappa = 0;
+    alpha = 0;
+    gamma = 0;
+    switch (slip_case) {
+        case LONGITUDINAL:
+            kappa = s;
+            break;
+        case LATERAL:
+            alpha = s * CH_C_PI_4 / 3;
+            break;
+        case LATERAL_GAMMA:
+            alpha = s * CH_C_PI_4 / 3;
+            gamma = 10 * CH_C_DEG_TO_RAD;
+            break;
+        case COMBINED:
+            kappa = s;
+            alpha = std::sin(3 * s) * CH_C_PI_4 / 3;
+            gamma = 0.1 * alpha;
+            break;
+    }
+}
+
+// Difference between two values, scaled by the tolerance (a result above 1 fails).
+double Error(double a, double b) {
+    return std::abs(a - b) / (rel_tol * std::abs(a) + abs_tol);
+}
+
+double Error(const ChVector<>& a, const ChVector<>& b) {
+    return std::max(Error(a.x, b.x), std::max(Error(a.y, b.y), Error(a.z, b.z)));
+}
+
+int main(int argc, char* argv[]) {
+    std::string param_file = vehicle::GetDataFile("hmmwv/pactest.tir");
+    FlatTerrain terrain(0);
+    auto wheel = std::make_shared<ChBody>();
+
+    std::vector<TirePair> pairs;
+    ChPacejkaTireBatch batch;
+    batch.SetNumThreads(2);
+    for (int slip_case = LONGITUDINAL; slip_case <= COMBINED; slip_case++) {
+        for (int transient = 0; transient < 2; transient++) {
+            for (int side = LEFT; side <= RIGHT; side++) {
+                double Fz = (side == LEFT) ? 8000 : 4000;
+                TirePair pair;
+                pair.slip_case = (SlipCase)slip_case;
+                pair.scalar = std::make_shared<ChPacejkaTire>("scalar", param_file, Fz, transient == 1);
+                pair.batched = std::make_shared<ChPacejkaTire>("batched", param_file, Fz, transient == 1);
+                pair.scalar->SetDrivenWheel(true);
+                pair.batched->SetDrivenWheel(true);
+                pair.scalar->Initialize(wheel, (VehicleSide)side);
+                pair.batched->Initialize(wheel, (VehicleSide)side);
+                batch.AddTire(pair.batched);
+                pairs.push_back(pair);
+            }
+        }
+    }
+
+    double max_error = 0;
+    double max_diff = 0;
+    double time = 0;
+    for (int step = 0; step <= num_steps; step++) {
+        for (size_t i = 0; i < pairs.size(); i++) {
+            double kappa, alpha, gamma;
+            GetSlips(pairs[i].slip_case, step, kappa, alpha, gamma);
+            double vel = pairs[i].scalar->get_longvl();
+            WheelState state = pairs[i].scalar->getState_from_KAG(kappa, alpha, gamma, vel);
+            pairs[i].scalar->Synchronize(time, state, terrain);
+            pairs[i].batched->Synchronize(time, state, terrain);
+            pairs[i].scalar->Advance(step_size);
+        }
+        batch.Advance(step_size);
+        time += step_size;
+
+        for (size_t i = 0; i < pairs.size(); i++) {
+            TireForce a = pairs[i].scalar->GetTireForce();
+            TireForce b = pairs[i].batched->GetTireForce();
+            double error = std::max(Error(a.force, b.force), Error(a.moment, b.moment));
+            max_error = std::max(max_error, error);
+            max_diff = std::max(max_diff, std::max((a.force - b.force).Length(), (a.moment - b.moment).Length()));
+            if (error > 1) {
+                std::cout << "Unit test check failed -- step " << step << " tire pair " << i << ": force "
+                          << a.force.x << " " << a.force.y << " " << a.force.z << " vs " << b.force.x << " "
+                          << b.force.y << " " << b.force.z << "  moment " << a.moment.x << " " << a.moment.y << " "
+                          << a.moment.z << " vs " << b.moment.x << " " << b.moment.y << " " << b.moment.z
+                          << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    // the sweeps must produce significant reactions
+    double max_force = 0;
+    for (size_t i = 0; i < pairs.size(); i++) {
+        const ChVector<>& force = pairs[i].scalar->GetTireForce().force;
+        max_force = std::max(max_force, std::sqrt(force.x * force.x + force.y * force.y));
+    }
+    if (max_force < 100) {
+        std::cout << "Unit test check failed -- no horizontal tire force: " << max_force << std::endl;
+        return 1;
+    }
+
+    std::cout << "Largest force/moment difference: " << max_diff << " (" << max_error << " of the tolerance)"
+              << std::endl;
+    std::cout << "Unit test check succeeded" << std::endl;
+    return 0;
+}
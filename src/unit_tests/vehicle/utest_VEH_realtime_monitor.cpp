@@ -0,0 +1,153 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Unit test for ChRealtimeMonitor: a paced loop with artificially slow steps
+// (sleeping longer than the period) followed by fast steps. Checks the count of
+// missed deadlines, the compute time and jitter histograms, the escalation and
+// recovery of ChVehicleDegradationPolicy, and that pacing without a busy-wait
+// window sleeps instead of spinning.
+// =============================================================================
+
+#include <chrono>
+#include <ctime>
+#include <iostream>
+#include <numeric>
+#include <thread>
+
+#include "chrono/physics/ChSystem.h"
+#include "chrono_vehicle/utils/ChRealtimeMonitor.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+const double period = 0.02;
+const int degrade_misses = 2;
+const int recover_steps = 3;
+
+void Sleep(double seconds) {
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+}
+
+long Total(const std::vector<long>& hist) {
+    return std::accumulate(hist.begin(), hist.end(), 0L);
+}
+
+int main(int argc, char* argv[]) {
+    ChSystem system;
+    system.SetMaxItersSolverSpeed(40);
+    system.SetMaxItersSolverStab(20);
+
+    auto policy = std::make_shared<ChVehicleDegradationPolicy>(&system);
+    ChRealtimeMonitor monitor(period);
+    monitor.SetDegradationPolicy(policy, degrade_misses, recover_steps, 0.5);
+    monitor.SetHistogramBins(10);
+
+    // Slow steps: every step misses its deadline and the level is raised
+    // after each group of consecutive misses, up to the maximum level.
+    int num_slow = degrade_misses * policy->GetMaxLevel();
+    for (int i = 0; i < num_slow; i++) {
+        monitor.BeginStep();
+        Sleep(1.5 * period);
+        if (monitor.EndStep()) {
+            std::cout << "Unit test check failed -- slow step " << i << " met its deadline" << std::endl;
+            return 1;
+        }
+        int level = (i + 1) / degrade_misses;
+        if (monitor.GetLevel() != level || policy->GetLevel() != level) {
+            std::cout << "Unit test check failed -- slow step " << i << ": level " << monitor.GetLevel()
+                      << " (policy " << policy->GetLevel() << "), expected " << level << std::endl;
+            return 1;
+        }
+    }
+    if (monitor.GetNumMisses() != num_slow) {
+        std::cout << "Unit test check failed -- missed deadlines: " << monitor.GetNumMisses() << ", expected "
+                  << num_slow << std::endl;
+        return 1;
+    }
+    if (system.GetMaxItersSolverSpeed() != 20 || system.GetMaxItersSolverStab() != 10 ||
+        policy->IsVisualizationFrame(1)) {
+        std::cout << "Unit test check failed -- degraded settings: solver iterations "
+                  << system.GetMaxItersSolverSpeed() << " " << system.GetMaxItersSolverStab() << std::endl;
+        return 1;
+    }
+
+    // Slow steps land in the compute time bins above the period.
+    const std::vector<long>& compute_hist = monitor.GetComputeHistogram();
+    int num_bins = (int)compute_hist.size() - 1;
+    long above = 0;
+    for (int i = num_bins / 2; i <= num_bins; i++)
+        above += compute_hist[i];
+    if (above != num_slow) {
+        std::cout << "Unit test check failed -- compute time histogram: " << above << " slow steps, expected "
+                  << num_slow << std::endl;
+        return 1;
+    }
+
+    // Fast steps, each released late by a fixed delay: the level is lowered after
+    // each group of consecutive fast steps, back to the nominal one. The pacing wait
+    // (no busy-wait window) must sleep, not spin.
+    double delay = 0.2 * period;
+    int num_fast = recover_steps * policy->GetMaxLevel();
+    std::clock_t cpu_start = std::clock();
+    auto wall_start = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_fast; i++) {
+        Sleep(delay);
+        monitor.BeginStep();
+        if (!monitor.EndStep()) {
+            std::cout << "Unit test check failed -- fast step " << i << " missed its deadline" << std::endl;
+            return 1;
+        }
+        int level = policy->GetMaxLevel() - (i + 1) / recover_steps;
+        if (monitor.GetLevel() != level) {
+            std::cout << "Unit test check failed -- fast step " << i << ": level " << monitor.GetLevel()
+                      << ", expected " << level << std::endl;
+            return 1;
+        }
+    }
+    double cpu = double(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+    if (cpu > 0.5 * wall) {
+        std::cout << "Unit test check failed -- pacing busy-waits: CPU time " << cpu << " s over " << wall << " s"
+                  << std::endl;
+        return 1;
+    }
+    if (system.GetMaxItersSolverSpeed() != 40 || system.GetMaxItersSolverStab() != 20 ||
+        !policy->IsVisualizationFrame(1)) {
+        std::cout << "Unit test check failed -- nominal settings not restored: solver iterations "
+                  << system.GetMaxItersSolverSpeed() << " " << system.GetMaxItersSolverStab() << std::endl;
+        return 1;
+    }
+
+    // Each fast step starts at least 'delay' after its release.
+    const std::vector<long>& jitter_hist = monitor.GetJitterHistogram();
+    int delay_bin = (int)(delay / period * num_bins);
+    long late = 0;
+    for (int i = delay_bin; i <= num_bins; i++)
+        late += jitter_hist[i];
+    if (late < num_fast || monitor.GetMaxJitter() < delay) {
+        std::cout << "Unit test check failed -- jitter histogram: " << late << " late steps, expected " << num_fast
+                  << "  max jitter " << monitor.GetMaxJitter() << std::endl;
+        return 1;
+    }
+
+    // Every step is counted once in each histogram and at one level.
+    long num_steps = num_slow + num_fast;
+    if (monitor.GetNumSteps() != num_steps || Total(compute_hist) != num_steps || Total(jitter_hist) != num_steps ||
+        Total(monitor.GetLevelSteps()) != num_steps) {
+        std::cout << "Unit test check failed -- step counts: " << monitor.GetNumSteps() << " " << Total(compute_hist)
+                  << " " << Total(jitter_hist) << " " << Total(monitor.GetLevelSteps()) << ", expected "
+                  << num_steps << std::endl;
+        return 1;
+    }
+
+    std::cout << "Unit test check succeeded" << std::endl;
+    return 0;
+}
@@ -0,0 +1,259 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Unit test for the height queries on a MESH RigidTerrain, which look up the
+// triangles through a uniform grid. The heights and normals are compared with a
+// brute-force vertical ray cast against all the mesh triangles, at random
+// points, at points on triangle edges and vertices, and at points outside the
+// grid. The test mesh is an irregular bumpy surface with an overlapping raised
+// platform (the highest hit must win) and vertical walls (never hit).
+// =============================================================================
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "chrono/geometry/ChTriangleMeshConnected.h"
+#include "chrono/physics/ChSystem.h"
+#include "chrono_vehicle/terrain/RigidTerrain.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+const std::string mesh_file = "utest_VEH_rigid_terrain_grid.obj";
+
+const int nx = 25;
+const int ny = 17;
+const double size_x = 20;
+const double size_y = 12;
+
+double Surface(double x, double y) {
+    return 0.4 * std::sin(0.7 * x) * std::cos(0.9 * y) + 0.05 * x;
+}
+
+// Write the test mesh: a jittered grid of vertices on the bumpy surface, a raised
+// platform above part of it, and a vertical wall along one of its sides.
+void WriteMesh() {
+    std::mt19937 gen(17);
+    std::uniform_real_distribution<double> jitter(-0.3, 0.3);
+    double dx = size_x / (nx - 1);
+    double dy = size_y / (ny - 1);
+
+    std::ofstream obj(mesh_file);
+    for (int iy = 0; iy < ny; iy++) {
+        for (int ix = 0; ix < nx; ix++) {
+            double x = ix * dx - size_x / 2;
+            double y = iy * dy - size_y / 2;
+            if (ix > 0 && ix < nx - 1)
+                x += jitter(gen) * dx;
+            if (iy > 0 && iy < ny - 1)
+                y += jitter(gen) * dy;
+            obj << "v " << x << " " << y << " " << Surface(x, y) << "\n";
+        }
+    }
+    for (int iy = 0; iy < ny - 1; iy++) {
+        for (int ix = 0; ix < nx - 1; ix++) {
+            int v0 = 1 + ix + nx * iy;
+            obj << "f " << v0 << " " << v0 + 1 << " " << v0 + nx + 1 << "\n";
+            obj << "f " << v0 << " " << v0 + nx + 1 << " " << v0 + nx << "\n";
+        }
+    }
+
+    int p0 = nx * ny + 1;
+    obj << "v -3.3 -2.1 1.5\n";
+    obj << "v 4.2 -2.7 1.9\n";
+    obj << "v 3.7 3.4 1.6\n";
+    obj << "v -2.9 2.8 1.2\n";
+    obj << "v -3.3 -2.1 -1\n";
+    obj << "v 4.2 -2.7 -1\n";
+    obj << "f " << p0 << " " << p0 + 1 << " " << p0 + 2 << "\n";
+    obj << "f " << p0 << " " << p0 + 2 << " " << p0 + 3 << "\n";
+    obj << "f " << p0 << " " << p0 + 4 << " " << p0 + 5 << "\n";
+    obj << "f " << p0 << " " << p0 + 5 << " " << p0 + 1 << "\n";
+}
+
+// Brute-force vertical ray cast from above against all triangles (Moller-Trumbore).
+// Returns false if no triangle is hit; 'margin' is the smallest barycentric coordinate
+// of the highest hit, i.e. how far inside its triangle the point is.
+bool RayCast(geometry::ChTriangleMeshConnected& mesh,
+             double x,
+             double y,
+             double& height,
+             ChVector<>& normal,
+             double& margin) {
+    const double eps = 1e-9;
+    ChVector<> orig(x, y, 1000);
+    ChVector<> dir(0, 0, -1);
+    std::vector<ChVector<> >& vertices = mesh.getCoordsVertices();
+    std::vector<ChVector<int> >& indices = mesh.getIndicesVertexes();
+    bool found = false;
+    for (size_t it = 0; it < indices.size(); it++) {
+        const ChVector<>& A = vertices[indices[it].x];
+        const ChVector<>& B = vertices[indices[it].y];
+        const ChVector<>& C = vertices[indices[it].z];
+        ChVector<> e1 = B - A;
+        ChVector<> e2 = C - A;
+        ChVector<> p = Vcross(dir, e2);
+        double det = Vdot(e1, p);
+        if (std::abs(det) < 1e-12 * e1.Length() * e2.Length())
+            continue;
+        ChVector<> s = orig - A;
+        double u = Vdot(s, p) / det;
+        ChVector<> q = Vcross(s, e1);
+        double v = Vdot(dir, q) / det;
+        if (u < -eps || v < -eps || u + v > 1 + eps)
+            continue;
+        double z = orig.z - Vdot(e2, q) / det;
+        if (found && z <= height)
+            continue;
+        found = true;
+        height = z;
+        normal = Vcross(e1, e2).GetNormalized();
+        if (normal.z < 0)
+            normal = -normal;
+        margin = std::min(std::min(u, v), 1 - u - v);
+    }
+    return found;
+}
+
+// Compare the terrain queries with the ray cast at the specified points.
+bool Check(const RigidTerrain& terrain,
+           geometry::ChTriangleMeshConnected& mesh,
+           const std::vector<ChVector2<> >& points,
+           const std::string& what,
+           int& num_hits) {
+    std::vector<double> heights;
+    std::vector<ChVector<> > normals;
+    terrain.GetHeightsAndNormals(points, heights, normals);
+
+    num_hits = 0;
+    for (size_t i = 0; i < points.size(); i++) {
+        double x = points[i].x;
+        double y = points[i].y;
+        double height = 0;
+        ChVector<> normal(0, 0, 1);
+        double margin = 1;
+        if (RayCast(mesh, x, y, height, normal, margin))
+            num_hits++;
+
+        double h = terrain.GetHeight(x, y);
+        ChVector<> n = terrain.GetNormal(x, y);
+        if (h != heights[i] || n != normals[i]) {
+            std::cout << "Unit test check failed -- " << what << " (" << x << ", " << y
+                      << "): GetHeight/GetNormal differ from GetHeightsAndNormals" << std::endl;
+            return false;
+        }
+        if (std::abs(h - height) > 1e-9) {
+            std::cout << "Unit test check failed -- " << what << " (" << x << ", " << y << "): height " << h
+                      << ", ray cast " << height << std::endl;
+            return false;
+        }
+        // On edges and vertices the normal is that of any of the adjacent triangles
+        if (margin > 1e-6 && (n - normal).Length() > 1e-9) {
+            std::cout << "Unit test check failed -- " << what << " (" << x << ", " << y << "): normal " << n.x
+                      << " " << n.y << " " << n.z << ", ray cast " << normal.x << " " << normal.y << " "
+                      << normal.z << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    WriteMesh();
+
+    ChSystem system;
+    RigidTerrain terrain(&system);
+    terrain.EnableVisualization(false);
+    terrain.Initialize(mesh_file, "test_mesh");
+
+    geometry::ChTriangleMeshConnected mesh;
+    mesh.LoadWavefrontMesh(mesh_file, false, false);
+    std::remove(mesh_file.c_str());
+    std::vector<ChVector<> >& vertices = mesh.getCoordsVertices();
+    std::vector<ChVector<int> >& indices = mesh.getIndicesVertexes();
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> ux(-size_x / 2, size_x / 2);
+    std::uniform_real_distribution<double> uy(-size_y / 2, size_y / 2);
+    std::uniform_real_distribution<double> u01(0, 1);
+    int num_hits;
+
+    // Random points inside the mesh
+    std::vector<ChVector2<> > points;
+    for (int i = 0; i < 5000; i++)
+        points.push_back(ChVector2<>(ux(gen), uy(gen)));
+    if (!Check(terrain, mesh, points, "random point", num_hits))
+        return 1;
+    if (num_hits != (int)points.size()) {
+        std::cout << "Unit test check failed -- ray cast missed " << points.size() - num_hits << " random points"
+                  << std::endl;
+        return 1;
+    }
+    int num_platform = 0;
+    for (size_t i = 0; i < points.size(); i++) {
+        if (terrain.GetHeight(points[i].x, points[i].y) > 1)
+            num_platform++;
+    }
+    if (num_platform == 0) {
+        std::cout << "Unit test check failed -- no random point on the raised platform" << std::endl;
+        return 1;
+    }
+
+    // Points on triangle edges and on vertices
+    points.clear();
+    for (size_t it = 0; it < indices.size(); it++) {
+        const ChVector<>& A = vertices[indices[it].x];
+        const ChVector<>& B = vertices[indices[it].y];
+        const ChVector<>& C = vertices[indices[it].z];
+        double s = u01(gen);
+        points.push_back(ChVector2<>(A.x + s * (B.x - A.x), A.y + s * (B.y - A.y)));
+        points.push_back(ChVector2<>(B.x + s * (C.x - B.x), B.y + s * (C.y - B.y)));
+        points.push_back(ChVector2<>(C.x + s * (A.x - C.x), C.y + s * (A.y - C.y)));
+        points.push_back(ChVector2<>(A.x, A.y));
+    }
+    if (!Check(terrain, mesh, points, "edge point", num_hits))
+        return 1;
+
+    // Points outside the grid: no triangle is hit, the height is 0 and the normal vertical
+    points.clear();
+    for (int i = 0; i < 200; i++) {
+        double x = ux(gen);
+        double y = uy(gen);
+        switch (i % 4) {
+            case 0:
+                x = -size_x / 2 - 0.01 - u01(gen);
+                break;
+            case 1:
+                x = size_x / 2 + 0.01 + u01(gen);
+                break;
+            case 2:
+                y = -size_y / 2 - 0.01 - u01(gen);
+                break;
+            case 3:
+                y = size_y / 2 + 0.01 + 100 * u01(gen);
+                break;
+        }
+        points.push_back(ChVector2<>(x, y));
+    }
+    if (!Check(terrain, mesh, points, "outside point", num_hits))
+        return 1;
+    if (num_hits != 0) {
+        std::cout << "Unit test check failed -- ray cast hit " << num_hits << " outside points" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Unit test check succeeded" << std::endl;
+    return 0;
+}
@@ -0,0 +1,250 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Unit test for the culling of the track shoes tested for contact with the
+// sprocket gear (ChSprocket::SelectContactCandidates):
+//  1) two M113 vehicles, with and without culling, are driven on flat terrain;
+//     at each step the candidate shoes of each sprocket must be the same (i.e.
+//     those of a full scan), no candidate may be reported missed, and the
+//     vehicle trajectories must be identical;
+//  2) the gear of one sprocket is moved down into the track loop, with a larger
+//     culling distance, so that the upper run of the track comes within range
+//     first and the lower run later, away from the shoes already selected. The
+//     candidates are compared with a brute-force selection at each pass: with a
+//     full scan at each pass, and with slow and fast sweeps using the default
+//     full scan interval. A slow sweep must track the lower run before it comes
+//     within range; a fast one, by more than a pitch per pass, may miss it, but
+//     only until the next full scan, which must count the missed shoes.
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "chrono_vehicle/terrain/RigidTerrain.h"
+
+#include "chrono_models/vehicle/m113/M113_SimplePowertrain.h"
+#include "chrono_models/vehicle/m113/M113_Vehicle.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+using namespace chrono::vehicle::m113;
+
+const int num_steps = 300;
+const double step_size = 1e-3;
+
+struct Model {
+    Model(bool culling) : vehicle(false, TrackShoeType::SINGLE_PIN, ChMaterialSurfaceBase::DVI) {
+        vehicle.GetSystem()->SetMaxItersSolverSpeed(50);
+        vehicle.GetSystem()->SetMaxItersSolverStab(50);
+        vehicle.Initialize(ChCoordsys<>(ChVector<>(0, 0, 1.1), QUNIT));
+        vehicle.GetTrackAssembly(LEFT)->GetSprocket()->SetShoeCulling(culling);
+        vehicle.GetTrackAssembly(RIGHT)->GetSprocket()->SetShoeCulling(culling);
+        terrain = std::make_shared<RigidTerrain>(vehicle.GetSystem());
+        terrain->Initialize(0, 100, 100);
+        powertrain.Initialize(vehicle.GetChassisBody(), vehicle.GetDriveshaft());
+    }
+
+    void Advance(double step) {
+        TrackShoeForces shoe_forces_left(vehicle.GetNumTrackShoes(LEFT));
+        TrackShoeForces shoe_forces_right(vehicle.GetNumTrackShoes(RIGHT));
+        double time = vehicle.GetChTime();
+        double throttle = 0.8;
+        double steering = time > 0.15 ? 0.5 : 0;
+        powertrain.Synchronize(time, throttle, vehicle.GetDriveshaftSpeed());
+        vehicle.Synchronize(time, steering, 0, powertrain.GetOutputTorque(), shoe_forces_left, shoe_forces_right);
+        terrain->Synchronize(time);
+        powertrain.Advance(step);
+        vehicle.Advance(step);
+        terrain->Advance(step);
+    }
+
+    M113_Vehicle vehicle;
+    M113_SimplePowertrain powertrain;
+    std::shared_ptr<RigidTerrain> terrain;
+};
+
+// Shoes whose reference point is within the specified distance from the gear axis.
+std::vector<size_t> FullScan(ChTrackAssembly* track, double radius) {
+    std::shared_ptr<ChBody> gear = track->GetSprocket()->GetGearBody();
+    std::vector<size_t> shoes;
+    for (size_t is = 0; is < track->GetNumTrackShoes(); is++) {
+        ChVector<> loc = gear->TransformPointParentToLocal(track->GetTrackShoePos(is));
+        if (loc.x * loc.x + loc.z * loc.z <= radius * radius)
+            shoes.push_back(is);
+    }
+    return shoes;
+}
+
+// Number of contiguous (cyclic) sequences of track shoes in the sorted list.
+int NumRuns(const std::vector<size_t>& shoes, size_t num_shoes) {
+    int num_runs = 0;
+    for (size_t k = 0; k < shoes.size(); k++) {
+        size_t prev = (shoes[k] + num_shoes - 1) % num_shoes;
+        if (!std::binary_search(shoes.begin(), shoes.end(), prev))
+            num_runs++;
+    }
+    return num_runs;
+}
+
+// Move the gear down into the track loop, by 'delta' at each pass after 'wait' passes at the top,
+// and compare the candidates with a full scan. The candidates must always be a subset of the full
+// scan, and may differ from it for fewer than 'interval' consecutive passes. Returns the number of
+// passes with differences.
+int Sweep(ChTrackAssembly* track,
+          int interval,
+          int wait,
+          double delta,
+          double radius,
+          double x,
+          double z_top,
+          double z_end) {
+    std::shared_ptr<ChSprocket> sprocket = track->GetSprocket();
+    std::shared_ptr<ChBody> gear = sprocket->GetGearBody();
+    sprocket->SetFullScanInterval(interval);
+    size_t missed = sprocket->GetNumMissedCandidates();
+
+    gear->SetPos(ChVector<>(x, gear->GetPos().y, z_top));
+    for (int pass = 0; pass < wait; pass++)
+        sprocket->SelectContactCandidates(track, radius);
+
+    // Once at the end, keep the gear there until the candidates are complete.
+    int num_differences = 0;
+    int streak = 0;
+    for (double z = z_top; z > z_end - delta / 2 || streak > 0; z -= delta) {
+        gear->SetPos(ChVector<>(x, gear->GetPos().y, std::max(z, z_end)));
+        sprocket->SelectContactCandidates(track, radius);
+        const std::vector<size_t>& candidates = sprocket->GetContactCandidates();
+        std::vector<size_t> shoes = FullScan(track, radius);
+        if (!std::includes(shoes.begin(), shoes.end(), candidates.begin(), candidates.end())) {
+            std::cout << "Unit test check failed -- sweep: candidate out of range" << std::endl;
+            exit(1);
+        }
+        if (candidates.size() == shoes.size()) {
+            streak = 0;
+            continue;
+        }
+        num_differences++;
+        if (++streak >= interval) {
+            std::cout << "Unit test check failed -- sweep: " << shoes.size() - candidates.size()
+                      << " shoes missed for " << streak << " passes (full scan interval " << interval << ")"
+                      << std::endl;
+            exit(1);
+        }
+    }
+
+    if (num_differences > 0 && sprocket->GetNumMissedCandidates() == missed) {
+        std::cout << "Unit test check failed -- sweep: missed shoes were not counted" << std::endl;
+        exit(1);
+    }
+
+    // The sweep ends with the gear between the two runs of the track
+    if (NumRuns(FullScan(track, radius), track->GetNumTrackShoes()) < 2) {
+        std::cout << "Unit test check failed -- sweep: the gear does not reach both runs of the track" << std::endl;
+        exit(1);
+    }
+
+    std::cout << "sweep by " << delta << ", full scan interval " << interval << ", " << wait
+              << " passes at the top: " << num_differences << " passes with missed shoes" << std::endl;
+    return num_differences;
+}
+
+int main(int argc, char* argv[]) {
+    // 1) M113 with and without culling
+    Model culled(true);
+    Model full(false);
+    VehicleSide sides[2] = {LEFT, RIGHT};
+    double avg_candidates = 0;
+    int num_changes = 0;
+    std::vector<size_t> previous[2];
+    for (int step = 0; step < num_steps; step++) {
+        culled.Advance(step_size);
+        full.Advance(step_size);
+        for (int i = 0; i < 2; i++) {
+            std::shared_ptr<ChSprocket> sprocket = culled.vehicle.GetTrackAssembly(sides[i])->GetSprocket();
+            const std::vector<size_t>& candidates = sprocket->GetContactCandidates();
+            const std::vector<size_t>& reference =
+                full.vehicle.GetTrackAssembly(sides[i])->GetSprocket()->GetContactCandidates();
+            if (candidates != reference) {
+                std::cout << "Unit test check failed -- step " << step << ", side " << i << ": "
+                          << candidates.size() << " candidates, " << reference.size() << " with a full scan"
+                          << std::endl;
+                return 1;
+            }
+            if (sprocket->GetNumMissedCandidates() != 0) {
+                std::cout << "Unit test check failed -- step " << step << ", side " << i << ": "
+                          << sprocket->GetNumMissedCandidates() << " missed candidates" << std::endl;
+                return 1;
+            }
+            avg_candidates += candidates.size();
+            if (candidates != previous[i])
+                num_changes++;
+            previous[i] = candidates;
+        }
+    }
+    avg_candidates /= 2 * num_steps;
+    std::cout << "average number of candidates: " << avg_candidates << " out of "
+              << culled.vehicle.GetNumTrackShoes(LEFT) << " shoes, " << num_changes << " changes" << std::endl;
+    if (avg_candidates < 1 || avg_candidates > culled.vehicle.GetNumTrackShoes(LEFT) / 2) {
+        std::cout << "Unit test check failed -- unexpected number of candidates" << std::endl;
+        return 1;
+    }
+
+    ChVector<> pos = culled.vehicle.GetVehiclePos();
+    ChVector<> pos_full = full.vehicle.GetVehiclePos();
+    if (pos != pos_full) {
+        std::cout << "Unit test check failed -- vehicle position " << pos.x << " " << pos.y << " " << pos.z
+                  << ", without culling " << pos_full.x << " " << pos_full.y << " " << pos_full.z << std::endl;
+        return 1;
+    }
+    if (num_changes < 10) {
+        std::cout << "Unit test check failed -- the track shoes did not move around the sprockets" << std::endl;
+        return 1;
+    }
+
+    // 2) Gear moved down into the track loop
+    ChTrackAssembly* track = culled.vehicle.GetTrackAssembly(LEFT).get();
+    double x_min = 1e10, x_max = -1e10, z_min = 1e10, z_max = -1e10;
+    for (size_t is = 0; is < track->GetNumTrackShoes(); is++) {
+        ChVector<> p = track->GetTrackShoePos(is);
+        x_min = std::min(x_min, p.x);
+        x_max = std::max(x_max, p.x);
+        z_min = std::min(z_min, p.z);
+        z_max = std::max(z_max, p.z);
+    }
+    double x = (x_min + x_max) / 2;
+    double z = (z_min + z_max) / 2;
+    double half_height = (z_max - z_min) / 2;
+    double radius = 1.2 * half_height;
+    double z_top = z + half_height + radius + 0.2;
+
+    double pitch = track->GetTrackShoe(0)->GetPitch();
+
+    Sweep(track, 1, 0, 2 * pitch, radius, x, z_top, z);
+    if (Sweep(track, 10, 0, pitch / 20, radius, x, z_top, z) != 0) {
+        std::cout << "Unit test check failed -- shoes missed in the slow sweep" << std::endl;
+        return 1;
+    }
+    // Fast sweeps, with all the phases of the full scans
+    int num_missed_sweeps = 0;
+    for (int wait = 0; wait < 10; wait++) {
+        if (Sweep(track, 10, wait, 2 * pitch, radius, x, z_top, z) > 0)
+            num_missed_sweeps++;
+    }
+    if (num_missed_sweeps == 0) {
+        std::cout << "Unit test check failed -- no shoes missed in the fast sweeps" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Unit test check succeeded" << std::endl;
+    return 0;
+}
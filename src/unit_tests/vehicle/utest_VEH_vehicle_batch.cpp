@@ -0,0 +1,186 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Unit test for ChWheeledVehicleBatch: three HMMWV vehicles (two on Pacejka
+// tires, advanced in the batched Pacejka evaluation, and one on Fiala tires),
+// each with its own driver inputs, are advanced on flat terrain through the
+// batch. The same vehicles are then simulated one at a time with the usual
+// single-vehicle loop, and the chassis and wheel states are compared.
+//
+// The vehicles share nothing but the terrain, so the results are identical with
+// the default build. With ENABLE_PACEJKA_VECTOR_MATH the Pacejka reactions agree
+// to round-off only, and the states drift apart slightly (mostly the speed of a
+// spinning wheel, by a few 1e-7 relative): each state may differ by up to
+// 1e-5 * |value| + 1e-6.
+// =============================================================================
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "chrono_vehicle/ChVehicleModelData.h"
+#include "chrono_vehicle/terrain/FlatTerrain.h"
+#include "chrono_vehicle/wheeled_vehicle/tire/ChPacejkaTire.h"
+#include "chrono_vehicle/wheeled_vehicle/utils/ChWheeledVehicleBatch.h"
+
+#include "chrono_models/vehicle/hmmwv/HMMWV_FialaTire.h"
+#include "chrono_models/vehicle/hmmwv/HMMWV_SimplePowertrain.h"
+#include "chrono_models/vehicle/hmmwv/HMMWV_VehicleReduced.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+using namespace chrono::vehicle::hmmwv;
+
+const int num_vehicles = 3;
+const int num_steps = 500;
+const double step_size = 1e-3;
+const double rel_tol = 1e-5;
+const double abs_tol = 1e-6;
+
+// Driver with prescribed inputs, different for each vehicle.
+class TestDriver : public ChDriver {
+  public:
+    TestDriver(ChVehicle& vehicle, int index) : ChDriver(vehicle), m_index(index) {}
+
+    virtual void Synchronize(double time) override {
+        SetThrottle(0.3 + 0.2 * m_index);
+        SetSteering(0.2 * (m_index - 1) * std::sin(4 * time));
+        SetBraking(m_index == 2 && time > 0.3 ? 0.3 : 0);
+    }
+
+  private:
+    int m_index;
+};
+
+struct Vehicle {
+    std::shared_ptr<HMMWV_VehicleReduced> vehicle;
+    std::shared_ptr<ChPowertrain> powertrain;
+    std::vector<std::shared_ptr<ChTire> > tires;
+    std::shared_ptr<ChDriver> driver;
+};
+
+Vehicle CreateVehicle(int index) {
+    Vehicle v;
+    v.vehicle = std::make_shared<HMMWV_VehicleReduced>(false, DrivelineType::RWD);
+    v.vehicle->Initialize(ChCoordsys<>(ChVector<>(0, 5.0 * index, 1), QUNIT), 2.0 + index);
+
+    v.powertrain = std::make_shared<HMMWV_SimplePowertrain>();
+    v.powertrain->Initialize(v.vehicle->GetChassisBody(), v.vehicle->GetDriveshaft());
+
+    std::string pacejka_file = vehicle::GetDataFile("hmmwv/tire/HMMWV_pacejka.tir");
+    const char* names[] = {"FL", "FR", "RL", "RR"};
+    for (int i = 0; i < 4; i++) {
+        if (index == 2) {
+            auto tire = std::make_shared<HMMWV_FialaTire>(names[i]);
+            tire->SetStepsize(step_size);
+            v.tires.push_back(tire);
+        } else {
+            auto tire = std::make_shared<ChPacejkaTire>(names[i], pacejka_file);
+            tire->SetDrivenWheel(i >= 2);
+            tire->SetStepsize(step_size);
+            v.tires.push_back(tire);
+        }
+        v.tires[i]->Initialize(v.vehicle->GetWheelBody(i), (i % 2 == 0) ? LEFT : RIGHT);
+    }
+
+    v.driver = std::make_shared<TestDriver>(*v.vehicle, index);
+    return v;
+}
+
+// Advance a vehicle on its own, as in a single-vehicle simulation loop.
+void Advance(Vehicle& v, ChTerrain& terrain, double step) {
+    double time = v.vehicle->GetChTime();
+    double throttle_input = v.driver->GetThrottle();
+    double steering_input = v.driver->GetSteering();
+    double braking_input = v.driver->GetBraking();
+    double powertrain_torque = v.powertrain->GetOutputTorque();
+    double driveshaft_speed = v.vehicle->GetDriveshaftSpeed();
+    TireForces tire_forces(4);
+    WheelStates wheel_states(4);
+    for (int i = 0; i < 4; i++) {
+        tire_forces[i] = v.tires[i]->GetTireForce();
+        wheel_states[i] = v.vehicle->GetWheelState(i);
+    }
+
+    v.driver->Synchronize(time);
+    terrain.Synchronize(time);
+    for (int i = 0; i < 4; i++)
+        v.tires[i]->Synchronize(time, wheel_states[i], terrain);
+    v.powertrain->Synchronize(time, throttle_input, driveshaft_speed);
+    v.vehicle->Synchronize(time, steering_input, braking_input, powertrain_torque, tire_forces);
+
+    v.driver->Advance(step);
+    terrain.Advance(step);
+    for (int i = 0; i < 4; i++)
+        v.tires[i]->Advance(step);
+    v.powertrain->Advance(step);
+    v.vehicle->Advance(step);
+}
+
+// Chassis position, orientation and velocity, and wheel angular speeds.
+std::vector<double> GetState(const Vehicle& v) {
+    std::shared_ptr<ChBodyAuxRef> chassis = v.vehicle->GetChassisBody();
+    const ChVector<>& pos = chassis->GetPos();
+    const ChQuaternion<>& rot = chassis->GetRot();
+    const ChVector<>& vel = chassis->GetPos_dt();
+    std::vector<double> state = {pos.x, pos.y, pos.z, rot.e0, rot.e1, rot.e2, rot.e3, vel.x, vel.y, vel.z};
+    for (int i = 0; i < 4; i++)
+        state.push_back(v.vehicle->GetWheelState(i).omega);
+    return state;
+}
+
+int main(int argc, char* argv[]) {
+    FlatTerrain terrain(0);
+
+    // Vehicles advanced through the batch
+    ChWheeledVehicleBatch batch(terrain);
+    batch.SetNumThreads(2);
+    std::vector<Vehicle> batched;
+    for (int i = 0; i < num_vehicles; i++) {
+        batched.push_back(CreateVehicle(i));
+        batch.AddVehicle(batched[i].vehicle, batched[i].powertrain, batched[i].tires, batched[i].driver);
+    }
+    std::vector<std::vector<double> > batch_states;
+    for (int step = 0; step < num_steps; step++)
+        batch.Advance(step_size);
+    for (int i = 0; i < num_vehicles; i++)
+        batch_states.push_back(GetState(batched[i]));
+
+    // Same vehicles, advanced one at a time
+    for (int i = 0; i < num_vehicles; i++) {
+        Vehicle v = CreateVehicle(i);
+        for (int step = 0; step < num_steps; step++)
+            Advance(v, terrain, step_size);
+        std::vector<double> state = GetState(v);
+
+        for (size_t k = 0; k < state.size(); k++) {
+            double diff = std::abs(state[k] - batch_states[i][k]);
+            if (diff > rel_tol * std::abs(state[k]) + abs_tol) {
+                std::cout << "Unit test check failed -- vehicle " << i << ", state " << k << ": " << state[k]
+                          << " (single) vs " << batch_states[i][k] << " (batch)" << std::endl;
+                return 1;
+            }
+        }
+        if (state[0] < 0.5) {
+            std::cout << "Unit test check failed -- vehicle " << i << " did not move: x = " << state[0]
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    if (std::abs(batch.GetChTime() - num_steps * step_size) > 1e-9) {
+        std::cout << "Unit test check failed -- batch time " << batch.GetChTime() << std::endl;
+        return 1;
+    }
+
+    std::cout << "Unit test check succeeded" << std::endl;
+    return 0;
+}